@@ -0,0 +1,45 @@
+#ifndef HOST_PLATFORM_H
+#define HOST_PLATFORM_H
+
+#include <cstdarg>
+#include <cstdio>
+#include <ctime>
+
+/**
+ * The Arduino pieces the pricing code uses, for a Linux build: the host
+ * String, Serial on stdout, a network that is always up and the socket and
+ * TLS clients from host/, shared with the host tests (OpenSSL; link with
+ * -lssl -lcrypto).
+ * Include before any source under src/.
+ */
+#include "../host/HostString.h"
+#define WString_h
+#define RESUMABLE_TLS_CLIENT_H
+#define HTTP_CLIENT_H
+
+#define WL_CONNECTED 3
+namespace {
+  struct HostWiFi {
+    int status() { return WL_CONNECTED; }
+  } WiFi;
+
+  struct HostSerial {
+    void printf(const char* format, ...) {
+      va_list args;
+      va_start(args, format);
+      vprintf(format, args);
+      va_end(args);
+    }
+    void println(const char* text) { puts(text); }
+  } Serial;
+}
+#define WiFi_h
+
+inline bool getLocalTime(struct tm* info) {
+  time_t now = time(nullptr);
+  return localtime_r(&now, info) != nullptr;
+}
+
+#include "../host/HostTlsClient.h"
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef LOG_DISPLAY_H
+#define LOG_DISPLAY_H
+
+#include "../src/display/IDisplay.h"
+#include "../src/pricing/PriceTime.h"
+
+// What the device would put on screen, as log lines
+class LogDisplay : public IDisplay {
+public:
+  void initialize() override {}
+
+  void showText(const String& l1, const String& l2 = "") override {
+    Serial.printf("[display] %s %s\n", l1.c_str(), l2.c_str());
+  }
+
+  void showLoadingIndicator() override {}
+  void showWifiIndicator() override {}
+
+  void showAnalysis(const PriceAnalysis& analysis) override {
+    char cheapest[6];
+    PriceTime::formatMinuteOfDay(analysis.cheapest90MinStart, cheapest);
+    Serial.printf("[display] now %.2f c/kWh, cheapest %.2f c/kWh @ %s\n", analysis.next90MinAvg * 100,
+                  analysis.cheapest90MinAvg * 100, cheapest);
+  }
+
+  void setBrightness(bool) override {}
+  void setBrightUntil(unsigned long) override {}
+  void updateBrightness(bool) override {}
+  bool isBright() const override { return false; }
+};
+
+#endif
@@ -0,0 +1,18 @@
+#include "PriceAggregator.h"
+
+bool PriceAggregator::tick(time_t now) {
+  FetchScheduler::Reason reason = fetchNeeded(now);
+  if (reason != FetchScheduler::NOT_NEEDED) {
+    Serial.printf("Fetching: %s\n", FetchScheduler::describe(reason));
+    if (fetchAndAnalyzePrices()) {
+      return true;
+    }
+  }
+  // Between fetches, or after a failed one while the old prices still
+  // cover the clock, the blob carries the current analysis
+  if (!refreshAnalysis(now)) {
+    return false;
+  }
+  saveCache();
+  return true;
+}
@@ -0,0 +1,22 @@
+#ifndef PRICE_AGGREGATOR_H
+#define PRICE_AGGREGATOR_H
+
+#include "../src/pricing/PriceMonitor.h"
+
+/**
+ * The device's PriceMonitor run once for the whole LAN: it polls upstream
+ * on the same schedule a device would, parses and analyzes, and "saves its
+ * cache" into the blob server, which is what devices then fetch.
+ */
+class PriceAggregator : public PriceMonitor {
+public:
+  PriceAggregator(IDisplay* log, IApiClient* upstream, IPriceStorage* blobs)
+    : PriceMonitor(log, upstream, blobs) {}
+
+  // Fetches when the prices on hand fall short of `now`, otherwise only
+  // brings the analysis up to it; either way republishes the blob. False
+  // when there is nothing current to publish.
+  bool tick(time_t now);
+};
+
+#endif
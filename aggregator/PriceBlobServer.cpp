@@ -0,0 +1,195 @@
+#include "PriceBlobServer.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include "../src/pricing/PriceCache.h"
+
+namespace {
+
+const size_t MAX_REQUEST_BYTES = 4096;
+
+bool sendAll(int fd, const char* data, size_t length) {
+  while (length > 0) {
+    ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+    if (n <= 0) {
+      return false;
+    }
+    data += n;
+    length -= (size_t)n;
+  }
+  return true;
+}
+
+// Value of a request header, or "" when absent
+std::string headerValue(const std::string& request, const char* name) {
+  size_t lineStart = request.find("\r\n");
+  size_t nameLength = strlen(name);
+  while (lineStart != std::string::npos) {
+    lineStart += 2;
+    size_t lineEnd = request.find("\r\n", lineStart);
+    if (lineEnd == std::string::npos || lineEnd == lineStart) {
+      break;
+    }
+    if (lineEnd - lineStart > nameLength && request[lineStart + nameLength] == ':' &&
+        strncasecmp(request.c_str() + lineStart, name, nameLength) == 0) {
+      size_t value = request.find_first_not_of(' ', lineStart + nameLength + 1);
+      return value < lineEnd ? request.substr(value, lineEnd - value) : std::string();
+    }
+    lineStart = lineEnd;
+  }
+  return std::string();
+}
+
+}  // namespace
+
+PriceBlobServer::PriceBlobServer()
+  : listenFd(-1), boundPort(0), running(false), seriesChecksum(0), served(0), notModified(0) {}
+
+PriceBlobServer::~PriceBlobServer() {
+  stop();
+}
+
+bool PriceBlobServer::start(int port) {
+  listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if (listenFd < 0) {
+    return false;
+  }
+  int reuse = 1;
+  setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  struct sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons((uint16_t)port);
+  socklen_t length = sizeof(address);
+  if (bind(listenFd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(listenFd, 16) != 0 ||
+      getsockname(listenFd, (struct sockaddr*)&address, &length) != 0) {
+    close(listenFd);
+    listenFd = -1;
+    return false;
+  }
+  boundPort = ntohs(address.sin_port);
+  running = true;
+  thread = std::thread(&PriceBlobServer::serve, this);
+  return true;
+}
+
+void PriceBlobServer::stop() {
+  running = false;
+  if (thread.joinable()) {
+    thread.join();
+  }
+  if (listenFd >= 0) {
+    close(listenFd);
+    listenFd = -1;
+  }
+}
+
+size_t PriceBlobServer::load(uint8_t* buffer, size_t capacity) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (blob.empty() || blob.size() > capacity) {
+    return 0;
+  }
+  memcpy(buffer, blob.data(), blob.size());
+  return blob.size();
+}
+
+// Every tick saves a fresh analysis; the validators only change with the series
+bool PriceBlobServer::save(const uint8_t* data, size_t length) {
+  PriceCache::Contents contents;
+  if (!PriceCache::decode(data, length, contents)) {
+    return false;
+  }
+  uint32_t checksum = contents.series.checksum();
+  std::lock_guard<std::mutex> guard(lock);
+  if (etag.empty() || checksum != seriesChecksum) {
+    char tag[16];
+    snprintf(tag, sizeof(tag), "\"%08x\"", (unsigned)checksum);
+    char date[40];
+    struct tm utc;
+    time_t fetchedAt = contents.fetchedAt;
+    gmtime_r(&fetchedAt, &utc);
+    strftime(date, sizeof(date), "%a, %d %b %Y %H:%M:%S GMT", &utc);
+    seriesChecksum = checksum;
+    etag = tag;
+    lastModified = date;
+  }
+  blob.assign(data, data + length);
+  return true;
+}
+
+// Wakes up now and then to notice stop()
+void PriceBlobServer::serve() {
+  while (running) {
+    struct pollfd waiting = {listenFd, POLLIN, 0};
+    if (poll(&waiting, 1, 200) <= 0) {
+      continue;
+    }
+    int client = accept(listenFd, nullptr, nullptr);
+    if (client < 0) {
+      continue;
+    }
+    respond(client);
+    close(client);
+  }
+}
+
+void PriceBlobServer::respond(int client) {
+  struct timeval timeout = {2, 0};
+  setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  std::string request;
+  char buffer[512];
+  while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+    ssize_t n = recv(client, buffer, sizeof(buffer), 0);
+    if (n <= 0) {
+      return;
+    }
+    request.append(buffer, (size_t)n);
+  }
+
+  std::vector<uint8_t> body;
+  std::string tag;
+  std::string modified;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    body = blob;
+    tag = etag;
+    modified = lastModified;
+  }
+  std::string noneMatch = headerValue(request, "If-None-Match");
+  // If-Modified-Since only counts without If-None-Match, and only as the
+  // date this server sent: the series changes at fetches, not on a clock
+  bool unchanged = noneMatch.empty() ? headerValue(request, "If-Modified-Since") == modified
+                                     : noneMatch == tag;
+  std::string validators = "ETag: " + tag + "\r\nLast-Modified: " + modified + "\r\n";
+
+  std::string head;
+  if (request.compare(0, 4, "GET ") != 0) {
+    head = "HTTP/1.0 405 Method Not Allowed\r\n";
+    body.clear();
+  } else if (body.empty()) {
+    head = "HTTP/1.0 503 Service Unavailable\r\nRetry-After: 60\r\n";
+  } else if (unchanged) {
+    head = "HTTP/1.0 304 Not Modified\r\n" + validators;
+    body.clear();
+    notModified++;
+  } else {
+    head = "HTTP/1.0 200 OK\r\nContent-Type: application/octet-stream\r\n"
+           "Content-Length: " + std::to_string(body.size()) + "\r\n" + validators;
+    served++;
+  }
+  head += "Cache-Control: no-cache\r\nConnection: close\r\n\r\n";
+  if (sendAll(client, head.data(), head.size()) && !body.empty()) {
+    sendAll(client, (const char*)body.data(), body.size());
+  }
+}
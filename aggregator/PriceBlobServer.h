@@ -0,0 +1,58 @@
+#ifndef PRICE_BLOB_SERVER_H
+#define PRICE_BLOB_SERVER_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/pricing/IPriceStorage.h"
+
+/**
+ * Serves the latest PriceCache image over plain HTTP/1.0 on the LAN, to
+ * any GET, one request per connection. The ETag is the checksum of the
+ * price series alone and Last-Modified the fetch that brought it, so the
+ * analysis moving on every save does not cost devices a body: one holding
+ * the same series gets a 304. Before the first image is saved requests get
+ * a 503.
+ *
+ * As IPriceStorage it is where the aggregator's PriceMonitor saves its
+ * cache: every save publishes.
+ */
+class PriceBlobServer : public IPriceStorage {
+public:
+  PriceBlobServer();
+  ~PriceBlobServer() override;
+
+  // Listens on all interfaces; port 0 takes any free one
+  bool start(int port);
+  void stop();
+  int port() const { return boundPort; }
+
+  size_t load(uint8_t* buffer, size_t capacity) override;
+  bool save(const uint8_t* data, size_t length) override;
+
+  int blobsServed() const { return served; }
+  int notModifiedServed() const { return notModified; }
+
+private:
+  void serve();
+  void respond(int client);
+
+  int listenFd;
+  int boundPort;
+  std::atomic<bool> running;
+  std::thread thread;
+
+  std::mutex lock;  // The accept thread reads what save() writes
+  std::vector<uint8_t> blob;
+  uint32_t seriesChecksum;
+  std::string etag;
+  std::string lastModified;  // HTTP date of the fetch the series came from
+
+  std::atomic<int> served;
+  std::atomic<int> notModified;
+};
+
+#endif
@@ -0,0 +1,100 @@
+// LAN price aggregator: fetches and analyzes the spot prices once for every
+// device on the network and serves them as a PriceCache image over HTTP.
+// Built from the device's own pricing sources; see README.md.
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "HostPlatform.h"
+
+#include "../src/pricing/InflateBodyReader.cpp"
+#include "../src/pricing/LanPriceClient.cpp"
+#include "../src/pricing/PriceAnalyzer.cpp"
+#include "../src/pricing/PriceApiClient.cpp"
+#include "../src/pricing/PriceCache.cpp"
+#include "../src/pricing/PriceMonitor.cpp"
+#include "../src/pricing/SpotPriceTokenizer.cpp"
+#include "../src/pricing/WindowPlanner.cpp"
+#include "LogDisplay.h"
+#include "PriceAggregator.cpp"
+#include "PriceBlobServer.cpp"
+
+const char* API_URL = "https://api.spot-hinta.fi/TodayAndDayForward?region=FI";
+
+namespace {
+
+volatile sig_atomic_t stopRequested = 0;
+
+void requestStop(int) {
+  stopRequested = 1;
+}
+
+void usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [--port N] [--upstream URL] [--interval SECONDS] [--ca-file PEM]\n"
+          "  --port      HTTP port devices fetch from (default 8080)\n"
+          "  --upstream  Price API; https:// or http:// (default %s)\n"
+          "  --interval  Seconds between checks (default 60)\n"
+          "  --ca-file   Certificates to trust upstream (default the system's)\n",
+          program, API_URL);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int port = 8080;
+  int interval = 60;
+  const char* caFile = nullptr;
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "--port") == 0 && hasValue) {
+      port = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--upstream") == 0 && hasValue) {
+      API_URL = argv[++i];
+    } else if (strcmp(argv[i], "--interval") == 0 && hasValue) {
+      interval = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--ca-file") == 0 && hasValue) {
+      caFile = argv[++i];
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (interval <= 0) {
+    usage(argv[0]);
+    return 2;
+  }
+  setvbuf(stdout, nullptr, _IOLBF, 0);
+  signal(SIGINT, requestStop);
+  signal(SIGTERM, requestStop);
+
+  PriceBlobServer server;
+  if (!server.start(port)) {
+    fprintf(stderr, "Cannot listen on port %d: %s\n", port, strerror(errno));
+    return 1;
+  }
+  Serial.printf("Serving prices on port %d, upstream %s\n", server.port(), API_URL);
+
+  // Unlike the device, which has no trust store, check who answers upstream
+  ResumableTlsClient::verifyServers(caFile);
+
+  // Same choice of client as the device makes for its API_URL
+  PriceApiClient tlsUpstream;
+  LanPriceClient plainUpstream;
+  IApiClient* upstream = strncmp(API_URL, "http://", 7) == 0 ? (IApiClient*)&plainUpstream : &tlsUpstream;
+  LogDisplay log;
+  PriceAggregator aggregator(&log, upstream, &server);
+
+  while (!stopRequested) {
+    if (!aggregator.tick(time(nullptr))) {
+      Serial.println("No current prices to serve");
+    }
+    for (int waited = 0; waited < interval && !stopRequested; waited++) {
+      sleep(1);
+    }
+  }
+  Serial.println("Stopping");
+  return 0;
+}
@@ -0,0 +1,233 @@
+#ifndef HOST_HTTP_CLIENT_H
+#define HOST_HTTP_CLIENT_H
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <strings.h>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+#include "HostString.h"
+#include "../src/pricing/FetchBudget.h"
+
+/**
+ * The parts of Arduino's Stream, WiFiClient, WiFiClientSecure and HTTPClient
+ * that the API clients use, over plain POSIX sockets, so host tests can talk
+ * to LocalHttpServer. WiFiClientSecure is plain TCP here: setInsecure() is
+ * accepted and TLS is skipped; HostTlsClient.h layers TLS on top. Define
+ * RESUMABLE_TLS_CLIENT_H and HTTP_CLIENT_H before including production
+ * headers, as with the in-memory mocks.
+ */
+class Stream {
+public:
+  virtual ~Stream() = default;
+  virtual size_t readBytes(char* buffer, size_t length) = 0;
+};
+
+class WiFiClient : public Stream {
+public:
+  ~WiFiClient() override { stop(); }
+
+  virtual bool connect(const std::string& host, int port) {
+    stop();
+    struct addrinfo* found = lookup(host, port);
+    bool ok = found && open(found);
+    if (found) freeaddrinfo(found);
+    return ok;
+  }
+
+  // The DNS and CONNECT stages of the device's budgeted connect
+  virtual bool connect(const std::string& host, int port, FetchBudget& budget) {
+    stop();
+    struct addrinfo* found = budget.begin(FetchBudget::DNS) > 0 ? lookup(host, port) : nullptr;
+    bool ok = !budget.expired() && found && budget.begin(FetchBudget::CONNECT) > 0 && open(found);
+    if (found) freeaddrinfo(found);
+    if (!ok) {
+      budget.expired();
+    }
+    return ok;
+  }
+
+  void setReceiveTimeout(unsigned long ms) {
+    struct timeval timeout = {(time_t)(ms / 1000), (suseconds_t)(ms % 1000 * 1000)};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  }
+
+  virtual bool write(const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+      ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+      if (n <= 0) return false;
+      sent += (size_t)n;
+    }
+    return true;
+  }
+
+  // Like Stream::readBytes: whatever arrives before the timeout, 0 at EOF
+  size_t readBytes(char* buffer, size_t length) override {
+    size_t got = 0;
+    while (fd >= 0 && got < length) {
+      ssize_t n = recv(fd, buffer + got, length - got, 0);
+      if (n <= 0) break;
+      got += (size_t)n;
+      bytesReceived += (size_t)n;
+    }
+    return got;
+  }
+
+  virtual void stop() {
+    if (fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+
+  int fd = -1;
+  size_t bytesReceived = 0;
+
+private:
+  struct addrinfo* lookup(const std::string& host, int port) {
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* found = nullptr;
+    return getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &found) == 0 ? found : nullptr;
+  }
+
+  bool open(struct addrinfo* address) {
+    fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (fd < 0 || ::connect(fd, address->ai_addr, address->ai_addrlen) != 0) {
+      stop();
+      return false;
+    }
+    setReceiveTimeout(2000);  // Stream's default timeout is 1 s; be lenient
+    return true;
+  }
+};
+
+class WiFiClientSecure : public WiFiClient {
+public:
+  void setInsecure() {}
+};
+
+class HTTPClient {
+public:
+  bool begin(WiFiClient& wifiClient, const char* url) {
+    client = &wifiClient;
+    requestHeaders.clear();
+    responseHeaders.clear();
+    // http[s]://host:port/path
+    std::string rest(url);
+    size_t scheme = rest.find("://");
+    if (scheme == std::string::npos) return false;
+    bool https = rest.compare(0, scheme, "https") == 0;
+    rest = rest.substr(scheme + 3);
+    size_t slash = rest.find('/');
+    std::string hostPort = rest.substr(0, slash);
+    path = slash == std::string::npos ? "/" : rest.substr(slash);
+    size_t colon = hostPort.find(':');
+    host = hostPort.substr(0, colon);
+    port = colon == std::string::npos ? (https ? 443 : 80) : atoi(hostPort.c_str() + colon + 1);
+    return !host.empty();
+  }
+
+  void useHTTP10(bool enabled) { http10 = enabled; }
+
+  // Loopback connects at once; kept for the calls the clients make
+  void setConnectTimeout(int32_t ms) { connectTimeout = ms; }
+
+  void setTimeout(uint16_t ms) {
+    timeout = ms;
+    if (client && client->fd >= 0) {
+      client->setReceiveTimeout(ms);
+    }
+  }
+
+  void addHeader(const String& name, const String& value) {
+    requestHeaders += std::string(name.c_str()) + ": " + value.c_str() + "\r\n";
+  }
+
+  void collectHeaders(const char* keys[], size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      responseHeaders[keys[i]] = "";
+    }
+  }
+
+  String header(const char* name) {
+    for (auto& kv : responseHeaders) {
+      if (strcasecmp(kv.first.c_str(), name) == 0) return String(kv.second);
+    }
+    return String();
+  }
+
+  // Sends the request and reads the status line and headers
+  int GET() {
+    // A connection made before GET() is reused, as on the device
+    if (client->fd < 0 && !client->connect(host, port)) return -1;
+    if (timeout > 0) client->setReceiveTimeout(timeout);
+    std::string request = "GET " + path + (http10 ? " HTTP/1.0\r\n" : " HTTP/1.1\r\n") +
+                          "Host: " + host + "\r\nConnection: close\r\n" + requestHeaders + "\r\n";
+    if (!client->write(request)) return -1;
+
+    std::string line;
+    int status = -1;
+    bool first = true;
+    char c;
+    while (client->readBytes(&c, 1) == 1) {
+      if (c != '\n') {
+        if (c != '\r') line += c;
+        continue;
+      }
+      if (line.empty()) return status;  // End of headers
+      if (first) {
+        size_t space = line.find(' ');
+        status = space == std::string::npos ? -1 : atoi(line.c_str() + space + 1);
+        first = false;
+      } else {
+        size_t colon = line.find(':');
+        std::string name = line.substr(0, colon);
+        size_t value = line.find_first_not_of(' ', colon + 1);
+        for (auto& kv : responseHeaders) {
+          if (strcasecmp(kv.first.c_str(), name.c_str()) == 0) {
+            kv.second = value == std::string::npos ? "" : line.substr(value);
+          }
+        }
+      }
+      line.clear();
+    }
+    return -1;  // Connection closed inside the headers
+  }
+
+  String getString() {
+    std::string body;
+    char buffer[512];
+    size_t n;
+    while ((n = client->readBytes(buffer, sizeof(buffer))) > 0) {
+      body.append(buffer, n);
+    }
+    return String(body);
+  }
+
+  Stream& getStream() { return *client; }
+
+  void end() { client->stop(); }
+
+private:
+  WiFiClient* client = nullptr;
+  std::string host;
+  std::string path;
+  int port = 80;
+  bool http10 = false;
+  int32_t connectTimeout = 5000;
+  uint16_t timeout = 0;
+  std::string requestHeaders;
+  std::map<std::string, std::string> responseHeaders;
+};
+
+#endif
@@ -1,7 +1,9 @@
-// String adapter for tests - wraps std::string with Arduino String API
-#ifndef TEST_STRING_ADAPTER_H
-#define TEST_STRING_ADAPTER_H
+// Arduino String for host builds - wraps std::string with the Arduino String API
+#ifndef HOST_STRING_H
+#define HOST_STRING_H
 
+#include <algorithm>
+#include <cctype>
 #include <string>
 #include <cstring>
 #include <sstream>
@@ -34,7 +36,28 @@ public:
     size_t len = (to > from) ? (to - from) : 0;
     return String(data.substr(from, len));
   }
-  
+
+  String substring(size_t from) const {
+    return from >= data.length() ? String() : String(data.substr(from));
+  }
+
+  int indexOf(char c, size_t from = 0) const {
+    size_t pos = data.find(c, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+  }
+
+  int indexOf(const char* str, size_t from = 0) const {
+    size_t pos = data.find(str, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+  }
+
+  bool equalsIgnoreCase(const String& other) const {
+    return data.size() == other.data.size() &&
+           std::equal(data.begin(), data.end(), other.data.begin(), [](char a, char b) {
+             return std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
+           });
+  }
+
   bool startsWith(const String& prefix) const {
     return data.rfind(prefix.data, 0) == 0;
   }
@@ -71,6 +94,10 @@ public:
   String operator+(const char* str) const {
     return String(data + (str ? str : ""));
   }
+
+  friend String operator+(const char* left, const String& right) {
+    return String(std::string(left ? left : "") + right.data);
+  }
   
   String& operator+=(const String& other) {
     data += other.data;
@@ -89,4 +116,4 @@ public:
   }
 };
 
-#endif // TEST_STRING_ADAPTER_H
+#endif // HOST_STRING_H
@@ -0,0 +1,192 @@
+#ifndef HOST_TLS_CLIENT_H
+#define HOST_TLS_CLIENT_H
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "HostHttpClient.h"
+
+/**
+ * Host stand-in for the device's ResumableTlsClient: the same session API
+ * over OpenSSL instead of mbedTLS, on the sockets of HostHttpClient.h.
+ * Capped at TLS 1.2 like the device, where tickets and session IDs resume
+ * within the handshake. Like the device it does not verify the server,
+ * whatever setInsecure() was called with, until verifyServers() turns
+ * that on for the whole process, as the aggregator does at startup.
+ * Define RESUMABLE_TLS_CLIENT_H before including production headers and
+ * link with -lssl -lcrypto.
+ */
+class ResumableTlsClient : public WiFiClientSecure {
+public:
+  ~ResumableTlsClient() override { stop(); }
+
+  bool setSession(const uint8_t* data, size_t length) {
+    offered.assign(data, data + length);
+    const unsigned char* p = data;
+    SSL_SESSION* session = d2i_SSL_SESSION(nullptr, &p, (long)length);
+    if (!session) {
+      offered.clear();
+      return false;
+    }
+    SSL_SESSION_free(session);
+    return true;
+  }
+
+  size_t getSession(uint8_t* out, size_t capacity) {
+    if (!ssl) return 0;
+    SSL_SESSION* session = SSL_get1_session(ssl);
+    if (!session) return 0;
+    int length = i2d_SSL_SESSION(session, nullptr);
+    size_t written = 0;
+    if (length > 0 && (size_t)length <= capacity) {
+      unsigned char* p = out;
+      written = (size_t)i2d_SSL_SESSION(session, &p);
+    }
+    SSL_SESSION_free(session);
+    return written;
+  }
+
+  // From now on, every handshake checks the server's chain against
+  // `caFile` (PEM), or the system's trust store when null, and its name or
+  // address against the host connected to
+  static void verifyServers(const char* caFile) {
+    trust().verify = true;
+    trust().caFile = caFile ? caFile : "";
+  }
+
+  static void acceptAnyServer() { trust() = Trust(); }
+
+  bool sessionResumed() const { return resumed; }
+  unsigned long handshakeMicros() const { return handshakeTime; }
+
+  bool connect(const std::string& host, int port) override {
+    stop();
+    return WiFiClientSecure::connect(host, port) && handshake(host);
+  }
+
+  // The TLS stage after the base class's DNS and CONNECT, the handshake
+  // bounded by the socket timeout as mbedTLS's read timeout bounds it
+  bool connect(const std::string& host, int port, FetchBudget& budget) override {
+    stop();
+    if (!WiFiClientSecure::connect(host, port, budget)) {
+      return false;
+    }
+    unsigned long handshakeMs = budget.begin(FetchBudget::TLS);
+    setReceiveTimeout(handshakeMs);
+    if (handshakeMs == 0 || !handshake(host)) {
+      budget.expired();
+      stop();
+      return false;
+    }
+    setReceiveTimeout(2000);
+    return true;
+  }
+
+  bool write(const std::string& data) override {
+    return ssl && SSL_write(ssl, data.data(), (int)data.size()) == (int)data.size();
+  }
+
+  size_t readBytes(char* buffer, size_t length) override {
+    size_t got = 0;
+    while (ssl && got < length) {
+      int n = SSL_read(ssl, buffer + got, (int)(length - got));
+      if (n <= 0) break;
+      got += (size_t)n;
+      bytesReceived += (size_t)n;
+    }
+    return got;
+  }
+
+  void stop() override {
+    if (ssl) {
+      SSL_shutdown(ssl);
+      SSL_free(ssl);
+      ssl = nullptr;
+    }
+    if (context) {
+      SSL_CTX_free(context);
+      context = nullptr;
+    }
+    ERR_clear_error();
+    WiFiClientSecure::stop();
+  }
+
+private:
+  bool handshake(const std::string& host) {
+    resumed = false;
+    handshakeTime = 0;
+    context = SSL_CTX_new(TLS_client_method());
+    SSL_CTX_set_max_proto_version(context, TLS1_2_VERSION);
+    ssl = SSL_new(context);
+    SSL_set_fd(ssl, fd);
+    SSL_set_tlsext_host_name(ssl, host.c_str());
+    if (!requireTrusted(host)) {
+      stop();
+      return false;
+    }
+    if (!offered.empty()) {
+      const unsigned char* p = offered.data();
+      SSL_SESSION* session = d2i_SSL_SESSION(nullptr, &p, (long)offered.size());
+      if (session) {
+        SSL_set_session(ssl, session);
+        SSL_SESSION_free(session);
+      }
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    if (SSL_connect(ssl) != 1) {
+      long verified = SSL_get_verify_result(ssl);
+      if (verified != X509_V_OK) {
+        fprintf(stderr, "TLS: %s not trusted: %s\n", host.c_str(), X509_verify_cert_error_string(verified));
+      }
+      ERR_clear_error();
+      stop();
+      return false;
+    }
+    handshakeTime = (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - started).count();
+    resumed = SSL_session_reused(ssl) == 1;
+    return true;
+  }
+
+  struct Trust {
+    bool verify = false;
+    std::string caFile;  // Empty for the system's trust store
+  };
+
+  static Trust& trust() {
+    static Trust shared;
+    return shared;
+  }
+
+  bool requireTrusted(const std::string& host) {
+    if (!trust().verify) {
+      SSL_CTX_set_verify(context, SSL_VERIFY_NONE, nullptr);
+      return true;
+    }
+    SSL_set_verify(ssl, SSL_VERIFY_PEER, nullptr);
+    int loaded = trust().caFile.empty()
+                   ? SSL_CTX_set_default_verify_paths(context)
+                   : SSL_CTX_load_verify_locations(context, trust().caFile.c_str(), nullptr);
+    if (loaded != 1) {
+      fprintf(stderr, "TLS: cannot load trusted certificates from %s\n",
+              trust().caFile.empty() ? "the system store" : trust().caFile.c_str());
+      return false;
+    }
+    X509_VERIFY_PARAM* param = SSL_get0_param(ssl);
+    return X509_VERIFY_PARAM_set1_ip_asc(param, host.c_str()) == 1 ||
+           X509_VERIFY_PARAM_set1_host(param, host.c_str(), 0) == 1;
+  }
+
+  SSL_CTX* context = nullptr;
+  SSL* ssl = nullptr;
+  std::vector<uint8_t> offered;
+  bool resumed = false;
+  unsigned long handshakeTime = 0;
+};
+
+#endif
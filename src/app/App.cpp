@@ -1,7 +1,21 @@
 #include "App.h"
 #include <M5AtomS3.h>
+#include <esp_random.h>
 
-App::App() : displayManager(&displayHardware), priceMonitor(&displayManager, &apiClient), timerManager(&timerHardware), wifiManager(&wifiHardware) {}
+// Kept through light and deep sleep and software resets; checked before use
+RTC_NOINIT_ATTR TlsSessionCache::Slot tlsSessionSlot;
+RTC_NOINIT_ATTR WiFiLinkCache::Slot wifiLinkSlot;
+RTC_NOINIT_ATTR TimeSyncPolicy::Slot timeSyncSlot;
+
+App::App() : displayManager(&displayHardware), wifiLinks(wifiLinkSlot), timePolicy(timeSyncSlot), wifiManager(&wifiHardware, &wifiLinks, &timePolicy), sessionStorage("tls"), tlsSessions(tlsSessionSlot, &sessionStorage), apiClient(&tlsSessions), priceMonitor(&displayManager, selectApiClient(), &priceStorage), timerManager(&timerHardware), spans(micros), retryPolicy(esp_random) {}
+
+// https:// is the public API; http:// is the aggregator on the LAN
+IApiClient* App::selectApiClient() {
+  if (strncmp(API_URL, "http://", 7) == 0) {
+    return &lanClient;
+  }
+  return &apiClient;
+}
 
 void App::setup() {
   auto cfg = M5.config();
@@ -16,24 +30,69 @@ void App::setup() {
   timerManager.setup();
 
   displayManager.initialize();
-  displayManager.showText("Connecting...", WIFI_SSID);
-  bool connected = wifiManager.connect();
+  
+  // Prices saved before the reset go on screen before the radio is up
+  bool cacheCurrent = priceMonitor.loadCache();
+  bool showingPrices = priceMonitor.getLastAnalysis().valid;
+  if (showingPrices) {
+    displayManager.showAnalysis(priceMonitor.getLastAnalysis());
+  }
+  if (cacheCurrent) {
+    FetchScheduler::Reason reason = priceMonitor.fetchNeeded(time(nullptr));
+    if (reason == FetchScheduler::NOT_NEEDED) {
+      Serial.println("Cached prices are current, skipping initial fetch");
+      setCpuFrequencyMhz(10);
+      timerManager.scheduleNextUpdate();
+      return;
+    }
+    Serial.printf("Fetching: %s\n", FetchScheduler::describe(reason));
+  }
+  
+  if (showingPrices) {
+    displayManager.showWifiIndicator();
+  } else {
+    displayManager.showText("Connecting...", WIFI_SSID);
+  }
+  // The "WiFi OK" pause below counts against the budget; it is short
+  spans.beginSession();
+  FetchBudget budget(millis);
+  budget.setTrace(&spans);
+  bool connected = wifiManager.connect(&budget);
   
   if (connected) {
-    displayManager.showText("WiFi OK", wifiManager.getIP());
-    delay(1500);
+    if (!showingPrices) {
+      spans.stage("show ip");
+      displayManager.showText("WiFi OK", wifiManager.getIP());
+      delay(1500);
+    }
     
     Serial.println("Fetching initial prices...");
-    bool success = priceMonitor.fetchAndAnalyzePrices();
+    bool success = priceMonitor.fetchAndAnalyzePrices(&budget);
+    logFetchBudget(budget);
+    retryPolicy.record(millis(), success, budget.elapsed());
+    spans.stage("display");
     if (success) {
       displayManager.showAnalysis(priceMonitor.getLastAnalysis());
+    } else if (cacheCurrent && priceMonitor.refreshAnalysis()) {
+      displayManager.showAnalysis(priceMonitor.getLastAnalysis());
     }
     
+    spans.stage("radio off");
     wifiManager.disconnect();
+    endFetchTrace();
     setCpuFrequencyMhz(10);
     Serial.println("CPU reduced to 10 MHz for idle");
     timerManager.scheduleNextUpdate();
+  } else if (cacheCurrent) {
+    // Cached prices stay on screen; the quarter-hour ticks retry the fetch
+    retryPolicy.record(millis(), false, budget.elapsed());
+    wifiManager.disconnect();
+    endFetchTrace();
+    setCpuFrequencyMhz(10);
+    timerManager.scheduleNextUpdate();
   } else {
+    retryPolicy.record(millis(), false, budget.elapsed());
+    endFetchTrace();
     displayManager.showText("WiFi FAILED", "Retrying...");
     delay(2000);
   }
@@ -42,6 +101,10 @@ void App::setup() {
 void App::loop() {
   AtomS3.update();
   
+  if (Serial.available() > 0) {
+    handleSerialCommand();
+  }
+  
   if (buttonWakeFlag) {
     buttonWakeFlag = false;
     handleButtonPress();
@@ -60,19 +123,36 @@ void App::loop() {
   }
 }
 
-bool App::fetchPriceWithWifi() {
+// `requested`: a button press rather than a scheduled tick
+bool App::fetchPriceWithWifi(bool requested) {
+  unsigned long now = millis();
+  RetryPolicy::Decision decision = retryPolicy.check(now, requested);
+  if (decision != RetryPolicy::ATTEMPT) {
+    unsigned long waitMin = (retryPolicy.waitMs(now) + 59999) / 60000;
+    Serial.printf("Fetch skipped: %s, %lu min to go\n", RetryPolicy::describe(decision), waitMin);
+    if (!priceMonitor.getLastAnalysis().valid) {
+      displayManager.showText("OFFLINE", String(waitMin) + " min");
+    }
+    return false;
+  }
+
   setCpuFrequencyMhz(80);
   Serial.println("CPU boosted to 80 MHz for WiFi");
   
   bool wasConnected = wifiManager.isConnected();
+  spans.beginSession();
+  FetchBudget budget(millis);
+  budget.setTrace(&spans);
   
   if (!wasConnected) {
     Serial.println("Connecting WiFi for price fetch...");
     if (priceMonitor.getLastAnalysis().valid) {
       displayManager.showWifiIndicator();
     }
-    bool connected = wifiManager.connect();
+    bool connected = wifiManager.connect(&budget);
     if (!connected) {
+      logFetchBudget(budget);
+      retryPolicy.record(millis(), false, budget.elapsed());
       displayManager.showText("WiFi FAILED");
       setCpuFrequencyMhz(10);
       Serial.println("CPU reduced to 10 MHz after WiFi failure");
@@ -80,8 +160,11 @@ bool App::fetchPriceWithWifi() {
     }
   }
   
-  bool success = priceMonitor.fetchAndAnalyzePrices();
+  bool success = priceMonitor.fetchAndAnalyzePrices(&budget);
+  logFetchBudget(budget);
+  retryPolicy.record(millis(), success, budget.elapsed());
   
+  spans.stage("radio off");
   wifiManager.disconnect();
   setCpuFrequencyMhz(10);
   Serial.println("CPU reduced to 10 MHz for idle");
@@ -89,27 +172,72 @@ bool App::fetchPriceWithWifi() {
   return success;
 }
 
+void App::logFetchBudget(const FetchBudget& budget) {
+  if (budget.exhausted()) {
+    Serial.printf("Fetch gave up after %lu ms: %s timed out\n", budget.elapsed(),
+                  FetchBudget::describe(budget.exhaustedStage()));
+  } else {
+    Serial.printf("Fetch took %lu ms\n", budget.elapsed());
+  }
+}
+
+// The fetch's session ends once its result is on screen; callers of
+// fetchPriceWithWifi() draw it first
+void App::endFetchTrace() {
+  if (!spans.active()) {
+    return;  // Held back by the retry policy; nothing was recorded
+  }
+  spans.endSession();
+  spans.printText(Serial, 1);
+}
+
+// 't' dumps the kept fetch timelines as text, 'j' as Chrome trace JSON
+void App::handleSerialCommand() {
+  int command = Serial.read();
+  if (command == 't') {
+    spans.printText(Serial);
+  } else if (command == 'j') {
+    spans.printJson(Serial);
+  }
+}
+
 void App::handleButtonPress() {
   Serial.println("Button pressed, fetching prices...");
   displayManager.setBrightness(true);
   
-  bool success = fetchPriceWithWifi();
+  bool success = fetchPriceWithWifi(true);
+  spans.stage("display");
   if (success) {
     displayManager.showAnalysis(priceMonitor.getLastAnalysis());
   } else if (priceMonitor.getLastAnalysis().valid) {
     displayManager.showAnalysis(priceMonitor.getLastAnalysis());
   }
+  endFetchTrace();
   
   displayManager.setBrightUntil(millis() + 5000);
 }
 
 void App::handleScheduledUpdate() {
   if (priceMonitor.isScheduledUpdateTime()) {
-    bool success = fetchPriceWithWifi();
+    FetchScheduler::Reason reason = priceMonitor.fetchNeeded(time(nullptr));
+    if (reason == FetchScheduler::NOT_NEEDED) {
+      // Radio stays off; the stored prices cover the new quarter hour
+      if (priceMonitor.refreshAnalysis()) {
+        displayManager.showAnalysis(priceMonitor.getLastAnalysis());
+        return;
+      }
+      reason = FetchScheduler::RUNNING_OUT;
+    }
+    
+    Serial.printf("Fetching: %s\n", FetchScheduler::describe(reason));
+    bool success = fetchPriceWithWifi(false);
+    spans.stage("display");
     if (success) {
       displayManager.showAnalysis(priceMonitor.getLastAnalysis());
-    } else if (priceMonitor.getLastAnalysis().valid) {
+    } else if (priceMonitor.refreshAnalysis()) {
+      // Fetch failed; the stored prices still cover the new quarter hour
       displayManager.showAnalysis(priceMonitor.getLastAnalysis());
     }
+    endFetchTrace();
   }
 }
@@ -6,7 +6,10 @@
 #include "../timing/M5TimerHardware.h"
 #include "../network/M5WiFiHardware.h"
 #include "../network/WiFiManager.h"
+#include "../network/RetryPolicy.h"
+#include "../pricing/LanPriceClient.h"
 #include "../pricing/PriceApiClient.h"
+#include "../pricing/NvsPriceStorage.h"
 #include "../pricing/PriceMonitor.h"
 #include "../timing/TimerManager.h"
 #include "IdleManager.h"
@@ -19,13 +22,25 @@ private:
   DisplayManager displayManager;
   M5TimerHardware timerHardware;
   M5WiFiHardware wifiHardware;
+  WiFiLinkCache wifiLinks;  // Last access point and lease, for a directed join
+  TimeSyncPolicy timePolicy;  // Measured clock drift and the last SNTP sync
   WiFiManager wifiManager;
+  NvsPriceStorage priceStorage;
+  NvsPriceStorage sessionStorage;
+  TlsSessionCache tlsSessions;
   PriceApiClient apiClient;
+  LanPriceClient lanClient;  // API_URL pointing at the LAN aggregator
   PriceMonitor priceMonitor;
   TimerManager timerManager;
   IdleManager idleManager;
+  SpanRecorder spans;  // The last fetches, phase by phase
+  RetryPolicy retryPolicy;  // Holds fetches back while WiFi or the API is down
 
-  bool fetchPriceWithWifi();
+  IApiClient* selectApiClient();
+  bool fetchPriceWithWifi(bool requested);
+  void logFetchBudget(const FetchBudget& budget);
+  void endFetchTrace();
+  void handleSerialCommand();
   void handleButtonPress();
   void handleScheduledUpdate();
 
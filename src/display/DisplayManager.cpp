@@ -53,13 +53,15 @@ void DisplayManager::showAnalysis(const PriceAnalysis& analysis) {
   hw->setTextColor(colors.text);
   
   // Top section: "Now HH:MM" label
-  String nowLabel("Nyt ");
-  nowLabel += analysis.currentPeriodStartTime;
+  char timeBuf[6];
+  char label[24];
+  PriceTime::formatMinuteOfDay(analysis.currentPeriodStart, timeBuf);
+  snprintf(label, sizeof(label), "Nyt %s", timeBuf);
   
   hw->setTextSize(1);
   hw->setTextColor(colors.text);
   hw->setCursor(4, 4);
-  hw->print(nowLabel);
+  hw->print(label);
   
   // Next 90min price - centered between "Nyt" and "Halvin" labels
   hw->setTextSize(3);
@@ -81,14 +83,11 @@ void DisplayManager::showAnalysis(const PriceAnalysis& analysis) {
   hw->setTextColor(colors.text);
   if (cheapestCents >= 0) {
     // Build the cheapest time string with optional (tom)
-    String cheapestLabel("Halvin ");
-    cheapestLabel += analysis.cheapest90MinTime;
-    if (analysis.cheapestIsTomorrow) {
-      cheapestLabel += " (huo)";
-    }
+    PriceTime::formatMinuteOfDay(analysis.cheapest90MinStart, timeBuf);
+    snprintf(label, sizeof(label), "Halvin %s%s", timeBuf, analysis.cheapestIsTomorrow ? " (huo)" : "");
     
     hw->setCursor(4, 68);
-    hw->print(cheapestLabel);
+    hw->print(label);
     
     // Cheapest price - centered between "Halvin" and "Päivitetty" labels
     hw->setTextSize(2);
@@ -98,6 +97,14 @@ void DisplayManager::showAnalysis(const PriceAnalysis& analysis) {
     int x = centerText(priceWidth);
     hw->setCursor(x, 88);
     hw->print(buf);
+    
+    // Runner-up periods in small print
+    if (analysis.cheapestCount > 1) {
+      formatRunnerUps(analysis, label, sizeof(label));
+      hw->setTextSize(1);
+      hw->setCursor(4, 106);
+      hw->print(label);
+    }
   } else {
     hw->setCursor(4, 88);
     hw->print("No data");
@@ -108,7 +115,8 @@ void DisplayManager::showAnalysis(const PriceAnalysis& analysis) {
   hw->setTextColor(colors.text);
   hw->setCursor(4, 116);
   hw->print("Päivitetty ");
-  hw->print(analysis.lastFetchTime);
+  PriceTime::formatMinuteOfDay(analysis.lastFetchTime, timeBuf);
+  hw->print(timeBuf);
 }
 
 void DisplayManager::setBrightness(bool shouldBeBright) {
@@ -158,6 +166,33 @@ DisplayManager::ColorScheme DisplayManager::determineColorScheme(float avgCents)
   return scheme;
 }
 
+// "Myös 18:00 huo 13:30": periods after the cheapest in time order, so the
+// tomorrow marker is needed only once and the line fits the screen
+void DisplayManager::formatRunnerUps(const PriceAnalysis& analysis, char* out, size_t size) {
+  int order[MAX_CHEAPEST_WINDOWS];
+  int others = 0;
+  for (int k = 1; k < analysis.cheapestCount; k++) {
+    int key = analysis.cheapestTomorrow[k] * 24 * 60 + analysis.cheapestStarts[k];
+    int j = others++;
+    while (j > 0 && analysis.cheapestTomorrow[order[j - 1]] * 24 * 60 + analysis.cheapestStarts[order[j - 1]] > key) {
+      order[j] = order[j - 1];
+      j--;
+    }
+    order[j] = k;
+  }
+  
+  char timeBuf[6];
+  int len = snprintf(out, size, "Myös");
+  bool tomorrowShown = false;
+  for (int j = 0; j < others && len < (int)size; j++) {
+    int k = order[j];
+    bool markTomorrow = analysis.cheapestTomorrow[k] && !tomorrowShown;
+    tomorrowShown = tomorrowShown || markTomorrow;
+    PriceTime::formatMinuteOfDay(analysis.cheapestStarts[k], timeBuf);
+    len += snprintf(out + len, size - len, " %s%s", markTomorrow ? "huo " : "", timeBuf);
+  }
+}
+
 int DisplayManager::centerText(int textWidth, int displayWidth) {
   int x = (displayWidth - textWidth) / 2;
   return (x < 0) ? 4 : x;  // Safety check
@@ -22,6 +22,7 @@ private:
   
   ColorScheme determineColorScheme(float avgCents);
   int centerText(int textWidth, int displayWidth = 128);
+  void formatRunnerUps(const PriceAnalysis& analysis, char* out, size_t size);
 
 public:
   DisplayManager(IDisplayHardware* hardware);
@@ -4,22 +4,56 @@
 #ifndef WString_h
 #include <WString.h>
 #endif
+#include <stdint.h>
+
+// The access point and address of a connection, enough to rejoin it
+// without a scan or DHCP. Addresses in network byte order, as IPAddress
+// converts to uint32_t.
+struct WiFiLink {
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint8_t reserved;
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+};
 
 // Hardware abstraction layer for WiFi operations
 class IWiFiHardware {
 public:
+  // What ended a wait for the connection
+  enum LinkEvent {
+    LINK_TIMEOUT,       // Nothing before the deadline
+    LINK_ASSOCIATED,    // Joined the access point; the address comes next
+    LINK_GOT_IP,        // Associated and addressed: ready for traffic
+    LINK_DISCONNECTED   // The join failed or the link dropped
+  };
+
   virtual ~IWiFiHardware() = default;
   
   // WiFi operations
   virtual int getStatus() = 0;
   virtual void setMode(int mode) = 0;
   virtual void disconnect(bool wifiOff) = 0;
-  virtual void begin(const char* ssid, const char* pass) = 0;
+  virtual void begin(const char* ssid, const char* pass) = 0;  // Scans, then DHCP
+  // Joins the access point in `link` on its channel, with its address
+  virtual void beginDirected(const char* ssid, const char* pass, const WiFiLink& link) = 0;
+  // The current connection's access point and lease; false when there is none
+  virtual bool readLink(WiFiLink& link) = 0;
+  // Returns at the next event since the last begin() or beginDirected(),
+  // or after `timeoutMs`. Events that came first are returned at once.
+  virtual LinkEvent waitForLink(unsigned long timeoutMs) = 0;
   virtual String getLocalIP() = 0;
   virtual void delayMs(unsigned long ms) = 0;
+  virtual unsigned long nowMs() = 0;  // For timing the connection phases
   
-  // Time synchronization
+  // Time synchronization: configTime() starts an SNTP request, which sets
+  // the clock when the reply arrives. waitForTimeSync() waits up to
+  // `timeoutMs` (0: just checks) for that; `correctionMs` is how far the
+  // reply moved the clock.
   virtual void configTime(long gmtOffset, int daylightOffset, const char* server) = 0;
+  virtual bool waitForTimeSync(unsigned long timeoutMs, long& correctionMs) = 0;
 };
 
 #endif // IWIFI_HARDWARE_H
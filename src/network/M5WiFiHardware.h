@@ -3,11 +3,19 @@
 
 #include "IWiFiHardware.h"
 #include <WiFi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <esp_sntp.h>
+#include <esp_timer.h>
+#include <sys/time.h>
+#include <string.h>
 #include <time.h>
 
 // M5AtomS3 implementation of WiFi hardware interface
 class M5WiFiHardware : public IWiFiHardware {
 public:
+  M5WiFiHardware() : events(nullptr) {}
+
   int getStatus() override {
     return WiFi.status();
   }
@@ -21,8 +29,49 @@ public:
   }
   
   void begin(const char* ssid, const char* pass) override {
+    // Back to DHCP after a directed join configured an address
+    WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+    armEvents();
     WiFi.begin(ssid, pass);
   }
+
+  void beginDirected(const char* ssid, const char* pass, const WiFiLink& link) override {
+    WiFi.config(IPAddress(link.ip), IPAddress(link.gateway), IPAddress(link.subnet), IPAddress(link.dns));
+    armEvents();
+    WiFi.begin(ssid, pass, link.channel, link.bssid);
+  }
+
+  bool readLink(WiFiLink& link) override {
+    uint8_t* bssid = WiFi.BSSID();
+    if (!bssid) {
+      return false;
+    }
+    memcpy(link.bssid, bssid, sizeof(link.bssid));
+    link.channel = (uint8_t)WiFi.channel();
+    link.reserved = 0;
+    link.ip = (uint32_t)WiFi.localIP();
+    link.gateway = (uint32_t)WiFi.gatewayIP();
+    link.subnet = (uint32_t)WiFi.subnetMask();
+    link.dns = (uint32_t)WiFi.dnsIP(0);
+    return link.ip != 0 && link.channel != 0;
+  }
+
+  LinkEvent waitForLink(unsigned long timeoutMs) override {
+    if (!events) {
+      return LINK_TIMEOUT;
+    }
+    EventBits_t bits = xEventGroupWaitBits(events, GOT_IP_BIT | DISCONNECTED_BIT | ASSOCIATED_BIT, pdTRUE,
+                                           pdFALSE, pdMS_TO_TICKS(timeoutMs));
+    // Only the latest event of a join is left set (see armEvents); an
+    // address comes with the association it was given on
+    if (bits & GOT_IP_BIT) {
+      return LINK_GOT_IP;
+    }
+    if (bits & DISCONNECTED_BIT) {
+      return LINK_DISCONNECTED;
+    }
+    return bits & ASSOCIATED_BIT ? LINK_ASSOCIATED : LINK_TIMEOUT;
+  }
   
   String getLocalIP() override {
     return WiFi.localIP().toString();
@@ -31,10 +80,96 @@ public:
   void delayMs(unsigned long ms) override {
     delay(ms);
   }
+
+  unsigned long nowMs() override {
+    return millis();
+  }
   
   void configTime(long gmtOffset, int daylightOffset, const char* server) override {
+    TimeSyncState& sync = timeSync();
+    if (!sync.done) {
+      sync.done = xEventGroupCreate();
+      sntp_set_time_sync_notification_cb(onTimeSync);
+    }
+    xEventGroupClearBits(sync.done, TIME_SYNCED_BIT);
+    struct timeval wall;
+    gettimeofday(&wall, nullptr);
+    sync.requestedWallUs = (int64_t)wall.tv_sec * 1000000 + wall.tv_usec;
+    sync.requestedUs = esp_timer_get_time();
     ::configTime(gmtOffset, daylightOffset, server);
   }
+
+  bool waitForTimeSync(unsigned long timeoutMs, long& correctionMs) override {
+    TimeSyncState& sync = timeSync();
+    if (!sync.done ||
+        !(xEventGroupWaitBits(sync.done, TIME_SYNCED_BIT, pdFALSE, pdFALSE, pdMS_TO_TICKS(timeoutMs)) &
+          TIME_SYNCED_BIT)) {
+      return false;
+    }
+    correctionMs = sync.correctionMs;
+    return true;
+  }
+
+private:
+  static const EventBits_t GOT_IP_BIT = BIT0;
+  static const EventBits_t DISCONNECTED_BIT = BIT1;
+  static const EventBits_t ASSOCIATED_BIT = BIT2;
+
+  // The WiFi event task sets the bits; waitForLink() sleeps on them. Events
+  // from before this join (the disconnect() that reset the radio) are cleared.
+  void armEvents() {
+    if (!events) {
+      events = xEventGroupCreate();
+      WiFi.onEvent([this](arduino_event_id_t, arduino_event_info_t) { record(GOT_IP_BIT, DISCONNECTED_BIT); },
+                   ARDUINO_EVENT_WIFI_STA_GOT_IP);
+      WiFi.onEvent(
+        [this](arduino_event_id_t, arduino_event_info_t) {
+          record(DISCONNECTED_BIT, GOT_IP_BIT | ASSOCIATED_BIT);
+        },
+        ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+      WiFi.onEvent(
+        [this](arduino_event_id_t, arduino_event_info_t) { record(ASSOCIATED_BIT, DISCONNECTED_BIT); },
+        ARDUINO_EVENT_WIFI_STA_CONNECTED);
+    }
+    xEventGroupClearBits(events, GOT_IP_BIT | DISCONNECTED_BIT | ASSOCIATED_BIT);
+  }
+
+  // The event task delivers one event at a time, so clearing the events
+  // `bit` overtakes leaves only the latest set for a wait that comes late:
+  // a drop after the address was given reports the drop, and a reconnect
+  // after a drop reports the reconnect.
+  void record(EventBits_t bit, EventBits_t overtakes) {
+    xEventGroupClearBits(events, overtakes);
+    xEventGroupSetBits(events, bit);
+  }
+
+  static const EventBits_t TIME_SYNCED_BIT = BIT0;
+
+  // Shared with the SNTP callback, which takes no context
+  struct TimeSyncState {
+    EventGroupHandle_t done;
+    int64_t requestedWallUs;  // The clock when the request went out...
+    int64_t requestedUs;      // ...and the uptime timer then
+    volatile long correctionMs;
+  };
+
+  static TimeSyncState& timeSync() {
+    static TimeSyncState state = {};
+    return state;
+  }
+
+  // Runs in the SNTP task once the clock is set to `tv`. Without the reply
+  // the clock would read what it read at the request plus the time since,
+  // which the uptime timer measures without a jump.
+  static void onTimeSync(struct timeval* tv) {
+    TimeSyncState& sync = timeSync();
+    int64_t expectedUs = sync.requestedWallUs + (esp_timer_get_time() - sync.requestedUs);
+    int64_t syncedUs = (int64_t)tv->tv_sec * 1000000 + tv->tv_usec;
+    sync.correctionMs = (long)((syncedUs - expectedUs) / 1000);
+    xEventGroupSetBits(sync.done, TIME_SYNCED_BIT);
+  }
+
+  EventGroupHandle_t events;
 };
 
 #endif // M5WIFI_HARDWARE_H
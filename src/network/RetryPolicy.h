@@ -0,0 +1,134 @@
+#ifndef RETRY_POLICY_H
+#define RETRY_POLICY_H
+
+#include <stdint.h>
+
+/**
+ * Decides whether a fetch may turn the radio on, so that an outage of the
+ * router or the API costs a few attempts an hour instead of one on every
+ * tick and button press. Failed attempts back off exponentially, with
+ * jitter so devices behind the same router do not retry in step. After
+ * BREAKER_FAILURES in a row the circuit opens: no attempts at all for
+ * OPEN_MS, then a single trial that either closes it or opens it again.
+ * On top of that, a day's failed attempts and their radio time are capped;
+ * fetches that get through, scheduled or from the button, are not counted.
+ *
+ * A button press skips the backoff, since someone is looking at the
+ * display, but not the open circuit or the spent budget. While attempts
+ * are held back the display keeps the stored prices.
+ *
+ * Times are milliseconds from millis(), compared as 32-bit differences so
+ * they stay correct across its wrap. The state is in RAM and starts over
+ * after a reset.
+ */
+class RetryPolicy {
+public:
+  enum Decision {
+    ATTEMPT,
+    BACKING_OFF,   // A scheduled fetch soon after a failure
+    CIRCUIT_OPEN,  // Too many failures in a row; waiting before the trial
+    BUDGET_SPENT   // The day's failed attempts or their radio time are used up
+  };
+
+  typedef uint32_t (*Random)();  // Like esp_random()
+
+  static constexpr unsigned long BASE_DELAY_MS = 5UL * 60 * 1000;  // After the first failure
+  static constexpr unsigned long MAX_DELAY_MS = 60UL * 60 * 1000;
+  static constexpr int BREAKER_FAILURES = 6;
+  static constexpr unsigned long OPEN_MS = 2UL * 3600 * 1000;
+  static constexpr unsigned long DAY_MS = 24UL * 3600 * 1000;
+  // Failed attempts only: a normal day takes under ten fetches, all successful
+  static constexpr int DAILY_ATTEMPTS = 40;
+  static constexpr unsigned long DAILY_RADIO_MS = 5UL * 60 * 1000;
+
+  explicit RetryPolicy(Random random)
+    : random(random), failures(0), lastFailureMs(0), backoffMs(0), windowStartMs(0), windowAttempts(0),
+      windowRadioMs(0) {}
+
+  // Whether a fetch may use the network at `nowMs`; `requested` for a button press
+  Decision check(unsigned long nowMs, bool requested) const {
+    if (budgetSpent(nowMs)) {
+      return BUDGET_SPENT;
+    }
+    uint32_t sinceFailure = since(nowMs, lastFailureMs);
+    if (failures >= BREAKER_FAILURES && sinceFailure < OPEN_MS) {
+      return CIRCUIT_OPEN;
+    }
+    if (failures > 0 && !requested && sinceFailure < backoffMs) {
+      return BACKING_OFF;
+    }
+    return ATTEMPT;
+  }
+
+  // After an attempt check() allowed: whether it fetched, and how long the
+  // radio was on for it
+  void record(unsigned long nowMs, bool success, unsigned long radioMs) {
+    if (success) {
+      failures = 0;
+      return;
+    }
+
+    if (windowAttempts == 0 || since(nowMs, windowStartMs) >= DAY_MS) {
+      windowStartMs = nowMs;
+      windowAttempts = 0;
+      windowRadioMs = 0;
+    }
+    windowAttempts++;
+    windowRadioMs += radioMs;
+    if (failures < BREAKER_FAILURES) {
+      failures++;
+    }
+    lastFailureMs = nowMs;
+    unsigned long delay = BASE_DELAY_MS;
+    for (int i = 1; i < failures && delay < MAX_DELAY_MS; i++) {
+      delay *= 2;
+    }
+    if (delay > MAX_DELAY_MS) {
+      delay = MAX_DELAY_MS;
+    }
+    // Within a quarter either way
+    backoffMs = delay - delay / 4 + random() % (delay / 2 + 1);
+  }
+
+  // How long check() keeps refusing a scheduled fetch; 0 when it allows one
+  unsigned long waitMs(unsigned long nowMs) const {
+    uint32_t sinceFailure = since(nowMs, lastFailureMs);
+    switch (check(nowMs, false)) {
+      case BUDGET_SPENT: return DAY_MS - since(nowMs, windowStartMs);
+      case CIRCUIT_OPEN: return OPEN_MS - sinceFailure;
+      case BACKING_OFF: return backoffMs - sinceFailure;
+      default: return 0;
+    }
+  }
+
+  int consecutiveFailures() const { return failures; }
+
+  static const char* describe(Decision decision) {
+    switch (decision) {
+      case BACKING_OFF: return "backing off";
+      case CIRCUIT_OPEN: return "circuit open";
+      case BUDGET_SPENT: return "daily budget spent";
+      default: return "attempt";
+    }
+  }
+
+private:
+  static uint32_t since(unsigned long nowMs, unsigned long thenMs) { return (uint32_t)(nowMs - thenMs); }
+
+  bool budgetSpent(unsigned long nowMs) const {
+    if (windowAttempts == 0 || since(nowMs, windowStartMs) >= DAY_MS) {
+      return false;
+    }
+    return windowAttempts >= DAILY_ATTEMPTS || windowRadioMs >= DAILY_RADIO_MS;
+  }
+
+  Random random;
+  int failures;  // In a row, up to BREAKER_FAILURES
+  unsigned long lastFailureMs;
+  unsigned long backoffMs;  // From lastFailureMs, jittered
+  unsigned long windowStartMs;  // The budget's day starts at its first failed attempt
+  int windowAttempts;
+  unsigned long windowRadioMs;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef WIFI_LINK_CACHE_H
+#define WIFI_LINK_CACHE_H
+
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include "IWiFiHardware.h"
+#include "../timing/TimeSyncPolicy.h"
+#include "../util/Checksum.h"
+
+/**
+ * The access point, channel and DHCP lease of the last connection, so the
+ * next one can join directly: no scan across the channels and no DHCP
+ * exchange, which together take most of the seconds a join costs.
+ *
+ * Only a wake from sleep finds the owner's Slot in RTC memory intact; after
+ * a reset the first join scans, as it would with nothing saved. The address
+ * is only reused for half a typical lease after DHCP handed it out; a
+ * directed join does not renew it, so after that the next join scans and
+ * asks again.
+ */
+class WiFiLinkCache {
+public:
+  static constexpr long MAX_LEASE_AGE_S = 12L * 3600;
+
+  struct Slot {
+    uint32_t magic;
+    uint32_t checksum;  // Over the rest
+    uint32_t ssidHash;  // Another network in config.h is another link
+    uint32_t leasedAt;  // time() when DHCP gave the address
+    WiFiLink link;
+  };
+
+  explicit WiFiLinkCache(Slot& rtcSlot) : slot(rtcSlot) {}
+
+  // The link saved for `ssid` while its lease is young enough at `now`
+  bool find(const char* ssid, time_t now, WiFiLink& link) const {
+    if (!valid() || slot.ssidHash != Checksum::fnv1a(ssid, strlen(ssid))) {
+      return false;
+    }
+    // The clock restarts from zero after a reset; such a lease is unknown
+    if (now < (time_t)slot.leasedAt || now - (time_t)slot.leasedAt > MAX_LEASE_AGE_S) {
+      return false;
+    }
+    link = slot.link;
+    return true;
+  }
+
+  // Keeps a link that DHCP just configured
+  void store(const char* ssid, const WiFiLink& link, time_t leasedAt) {
+    slot.ssidHash = Checksum::fnv1a(ssid, strlen(ssid));
+    slot.leasedAt = (uint32_t)leasedAt;
+    slot.link = link;
+    Checksum::seal(slot, MAGIC);
+  }
+
+  // The clock has just been set. The first join after power-on stamps its
+  // lease while time() still counts from 1970, which would make it look
+  // decades old at the next find(); it is dated to `now` instead, the join
+  // having been moments ago. Leases stamped by a set clock keep their age.
+  void clockSet(time_t now) {
+    if (valid() && (time_t)slot.leasedAt < TimeSyncPolicy::EARLIEST_TIME && now >= TimeSyncPolicy::EARLIEST_TIME) {
+      slot.leasedAt = (uint32_t)now;
+      Checksum::seal(slot, MAGIC);
+    }
+  }
+
+  // After a failed directed join: the access point moved or is gone
+  void forget() { slot.magic = 0; }
+
+private:
+  static constexpr uint32_t MAGIC = 0x574C4E4B;  // "WLNK"
+
+  // No join ends on channel 0 or with address 0.0.0.0
+  bool valid() const {
+    return Checksum::intact(slot, MAGIC) && slot.link.ip != 0 && slot.link.channel != 0;
+  }
+
+  Slot& slot;
+};
+
+#endif
@@ -1,34 +1,37 @@
 #include "WiFiManager.h"
 
+#include <time.h>
 #ifndef TESTING
 #include <WiFi.h>
-#include <time.h>
 #endif
 
-bool WiFiManager::connect() {
+bool WiFiManager::connect(FetchBudget* budget) {
   if (wifi->getStatus() == WL_CONNECTED) {
     Serial.println("WiFi already connected: " + wifi->getLocalIP());
     return true;
   }
+  if (budget && budget->begin(FetchBudget::WIFI) == 0) {
+    Serial.println("WiFi skipped: fetch budget spent");
+    return false;
+  }
 
+  timing = Timing();
   wifi->setMode(WIFI_STA);
-  wifi->disconnect(true);
-  wifi->delayMs(500);
-  
-  wifi->begin(WIFI_SSID, WIFI_PASS);
-  Serial.printf("Connecting to %s\n", WIFI_SSID);
-
-  for (int i = 0; i < 40 && wifi->getStatus() != WL_CONNECTED; ++i) {
-    wifi->delayMs(500);
-    if (i % 5 == 0) {
-      Serial.printf("WiFi status: %d\n", wifi->getStatus());
-    }
-  }
+  bool connected = joinDirected(budget) || (!(budget && budget->exhausted()) && joinScanning(budget));
 
-  if (wifi->getStatus() == WL_CONNECTED) {
+  if (connected) {
     String ip = wifi->getLocalIP();
     Serial.println("WiFi OK, IP: " + ip);
-    syncTime();
+    if (timing.directed) {
+      Serial.printf("WiFi joined directly in %lu ms\n", timing.directedMs);
+    } else if (timing.directedMs > 0) {
+      Serial.printf("WiFi joined by scan in %lu ms after %lu ms of directed join\n", timing.scanMs,
+                    timing.directedMs);
+    }
+    syncTime(budget);
+    if (links) {
+      links->clockSet(time(nullptr));
+    }
     return true;
   } else {
     Serial.println("WiFi FAILED, status: " + String(wifi->getStatus()));
@@ -36,7 +39,92 @@ bool WiFiManager::connect() {
   }
 }
 
+// The access point, channel and address of the last DHCP join, without
+// scanning or asking DHCP. The radio was turned off after the last fetch,
+// so there is nothing to reset first.
+bool WiFiManager::joinDirected(FetchBudget* budget) {
+  WiFiLink link;
+  if (!links || !links->find(WIFI_SSID, time(nullptr), link)) {
+    return false;
+  }
+  SpanRecorder::Scope span(FetchBudget::traceOf(budget), "directed");
+  unsigned long started = wifi->nowMs();
+  wifi->beginDirected(WIFI_SSID, WIFI_PASS, link);
+  Serial.printf("Joining %s directly on channel %d\n", WIFI_SSID, link.channel);
+  timing.directed = waitForConnection(budget, DIRECTED_TIMEOUT_MS, true, "address");
+  timing.directedMs = wifi->nowMs() - started;
+  if (!timing.directed) {
+    Serial.println("Directed join failed, scanning");
+    links->forget();
+  }
+  return timing.directed;
+}
+
+bool WiFiManager::joinScanning(FetchBudget* budget) {
+  SpanRecorder::Scope span(FetchBudget::traceOf(budget), "scan");
+  unsigned long started = wifi->nowMs();
+  wifi->disconnect(true);
+  wifi->delayMs(SETTLE_MS);
+  
+  wifi->begin(WIFI_SSID, WIFI_PASS);
+  Serial.printf("Connecting to %s\n", WIFI_SSID);
+
+  bool connected = waitForConnection(budget, CONNECT_TIMEOUT_MS, false, "dhcp");
+  timing.scanMs = wifi->nowMs() - started;
+  WiFiLink link;
+  if (connected && links && wifi->readLink(link)) {
+    links->store(WIFI_SSID, link, time(nullptr));
+  }
+  return connected;
+}
+
+// Sleeps until the got-IP event, up to `timeoutMs` or what the budget's
+// stage has left. A directed join gives up at the first drop, with the scan
+// to fall back on; during a scan the core retries the association itself.
+// The association and then `addressing` are traced as spans.
+bool WiFiManager::waitForConnection(FetchBudget* budget, unsigned long timeoutMs, bool dropEndsJoin,
+                                    const char* addressing) {
+  SpanRecorder::Scope phase(FetchBudget::traceOf(budget), "assoc");
+  unsigned long started = wifi->nowMs();
+  for (;;) {
+    unsigned long waited = wifi->nowMs() - started;
+    unsigned long left = waited < timeoutMs ? timeoutMs - waited : 0;
+    if (budget && budget->remaining() < left) {
+      left = budget->remaining();
+    }
+    if (left == 0) {
+      break;
+    }
+    IWiFiHardware::LinkEvent event = wifi->waitForLink(left);
+    if (event == IWiFiHardware::LINK_GOT_IP) {
+      return true;
+    }
+    if (event == IWiFiHardware::LINK_ASSOCIATED) {
+      phase.next(addressing);
+      continue;
+    }
+    if (event == IWiFiHardware::LINK_TIMEOUT || dropEndsJoin) {
+      break;
+    }
+    Serial.println("WiFi association dropped, waiting for a retry");
+    phase.next("assoc");
+  }
+  if (budget) {
+    budget->expired();
+  }
+  return false;
+}
+
 void WiFiManager::disconnect() {
+  long correctionMs;
+  if (syncPending && wifi->waitForTimeSync(0, correctionMs)) {
+    recordTimeSync(correctionMs);
+  }
+  syncPending = false;
+  // Without a policy nothing waited for SNTP; the reply may have come since
+  if (links) {
+    links->clockSet(time(nullptr));
+  }
   if (wifi->getStatus() == WL_CONNECTED) {
     wifi->disconnect(true);
     wifi->setMode(WIFI_OFF);
@@ -52,7 +140,41 @@ String WiFiManager::getIP() {
   return wifi->getLocalIP();
 }
 
-void WiFiManager::syncTime() {
+void WiFiManager::syncTime(FetchBudget* budget) {
+  if (!timePolicy) {
+    wifi->configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
+    Serial.println("Time sync initiated");
+    return;
+  }
+
+  time_t now = time(nullptr);
+  TimeSyncPolicy::Action action = timePolicy->decide(now);
+  if (action == TimeSyncPolicy::SKIP) {
+    Serial.printf("Time sync skipped, clock within %ld ms\n", timePolicy->expectedErrorMs(now));
+    return;
+  }
   wifi->configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
-  Serial.println("Time sync initiated");
+  syncPending = true;
+  if (action == TimeSyncPolicy::SYNC_IN_BACKGROUND) {
+    Serial.printf("Time sync requested, clock may be %ld ms off\n", timePolicy->expectedErrorMs(now));
+    return;
+  }
+
+  // Prices are indexed by the clock: it has to be right before they are used
+  unsigned long timeoutMs = TIME_SYNC_TIMEOUT_MS;
+  if (budget) {
+    timeoutMs = budget->begin(FetchBudget::TIME);
+  }
+  long correctionMs;
+  if (timeoutMs > 0 && wifi->waitForTimeSync(timeoutMs, correctionMs)) {
+    recordTimeSync(correctionMs);
+  } else {
+    Serial.println("Time sync did not complete; the clock is not set");
+  }
+}
+
+void WiFiManager::recordTimeSync(long correctionMs) {
+  syncPending = false;
+  timePolicy->synced(time(nullptr), correctionMs);
+  Serial.printf("Time synced, moved %ld ms; drift %ld ppm\n", correctionMs, (long)timePolicy->driftPpm());
 }
@@ -5,6 +5,9 @@
 #include <WString.h>
 #endif
 #include "IWiFiHardware.h"
+#include "WiFiLinkCache.h"
+#include "../timing/TimeSyncPolicy.h"
+#include "../pricing/FetchBudget.h"
 
 extern const char* WIFI_SSID;
 extern const char* WIFI_PASS;
@@ -14,16 +17,45 @@ extern const int DAYLIGHT_OFFSET_SEC;
 
 class WiFiManager {
 public:
-  WiFiManager(IWiFiHardware* wifi) : wifi(wifi) {}
+  // Milliseconds each phase of the last connect() took, 0 when it did not run
+  struct Timing {
+    unsigned long directedMs;  // Join to the cached access point and address
+    unsigned long scanMs;      // Reset, scan and DHCP
+    bool directed;             // The directed join connected
+  };
+
+  // With `links`, a join first goes straight to the last access point.
+  // With `timePolicy`, the clock is only synced when it has drifted too far;
+  // without, every connection asks SNTP and nothing waits for it.
+  WiFiManager(IWiFiHardware* wifi, WiFiLinkCache* links = nullptr, TimeSyncPolicy* timePolicy = nullptr)
+    : wifi(wifi), links(links), timePolicy(timePolicy), timing(), syncPending(false) {}
   
-  bool connect();
+  // Returns at the got-IP event. Gives up after CONNECT_TIMEOUT_MS, or when
+  // the budget's WIFI stage runs out.
+  bool connect(FetchBudget* budget = nullptr);
+  // Takes an SNTP reply that arrived while connected before the radio goes off
   void disconnect();
   bool isConnected();
   String getIP();
+  const Timing& lastTiming() const { return timing; }
 
 private:
-  void syncTime();
+  static const unsigned long SETTLE_MS = 500;  // After resetting the radio
+  static const unsigned long CONNECT_TIMEOUT_MS = 20000;
+  // A directed join takes a few hundred milliseconds; after 3 s it is not coming
+  static const unsigned long DIRECTED_TIMEOUT_MS = 3000;
+  static const unsigned long TIME_SYNC_TIMEOUT_MS = 3000;
+
+  bool joinDirected(FetchBudget* budget);
+  bool joinScanning(FetchBudget* budget);
+  bool waitForConnection(FetchBudget* budget, unsigned long timeoutMs, bool dropEndsJoin, const char* addressing);
+  void syncTime(FetchBudget* budget);
+  void recordTimeSync(long correctionMs);
   IWiFiHardware* wifi;
+  WiFiLinkCache* links;
+  TimeSyncPolicy* timePolicy;
+  Timing timing;
+  bool syncPending;  // Asked SNTP without waiting; the reply may still come
 };
 
 #endif
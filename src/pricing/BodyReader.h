@@ -0,0 +1,63 @@
+#ifndef BODY_READER_H
+#define BODY_READER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Byte source for a response body that is still arriving.
+ * read() and readBytes() follow Arduino's Stream, which also makes any
+ * BodyReader a custom reader for ArduinoJson's deserializeJson().
+ */
+class BodyReader {
+public:
+  virtual ~BodyReader() = default;
+  // Next byte, or -1 at the end of the body (or on timeout)
+  virtual int read() = 0;
+  virtual size_t readBytes(char* buffer, size_t length) = 0;
+};
+
+// Body already held in memory
+class StringBodyReader : public BodyReader {
+public:
+  StringBodyReader(const char* text, size_t length) : pos(text), end(text + length) {}
+  
+  int read() override { return pos < end ? (uint8_t)*pos++ : -1; }
+  
+  size_t readBytes(char* buffer, size_t length) override {
+    size_t n = 0;
+    while (n < length && pos < end) {
+      buffer[n++] = *pos++;
+    }
+    return n;
+  }
+
+private:
+  const char* pos;
+  const char* end;
+};
+
+// Replays bytes already taken from a body, then continues with the body
+// itself; lets a parser start over at something another one has peeked at
+class ReplayBodyReader : public BodyReader {
+public:
+  ReplayBodyReader(const char* consumed, size_t length, BodyReader& rest)
+    : pos(consumed), end(consumed + length), body(rest) {}
+  
+  int read() override { return pos < end ? (uint8_t)*pos++ : body.read(); }
+  
+  size_t readBytes(char* buffer, size_t length) override {
+    size_t n = 0;
+    while (n < length && pos < end) {
+      buffer[n++] = *pos++;
+    }
+    return n < length ? n + body.readBytes(buffer + n, length - n) : n;
+  }
+
+private:
+  const char* pos;
+  const char* end;
+  BodyReader& body;
+};
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef CONDITIONAL_GET_H
+#define CONDITIONAL_GET_H
+
+#ifndef WString_h
+#include <WString.h>
+#endif
+#ifndef HTTP_CLIENT_H
+#include <HTTPClient.h>
+#endif
+#ifndef WiFi_h
+#include <WiFi.h>
+#endif
+#include "FetchBudget.h"
+#include "HttpValidators.h"
+#include "IApiClient.h"
+
+/**
+ * One GET as both API clients make it: HTTP/1.0, so the body is never
+ * chunked and can be read straight off the socket; If-None-Match and
+ * If-Modified-Since from the last full response; a 304 reported as success
+ * without a body; and the validators kept only once a body has been read
+ * to the end within the budget. The clients bring the transport and what
+ * happens between the steps: TLS sessions and compression in
+ * PriceApiClient, a single connect stage in LanPriceClient.
+ *
+ * Each step returns false once the request is over, with the response
+ * saying why and the request ended.
+ */
+class ConditionalGet {
+public:
+  typedef IApiClient::ApiResponse ApiResponse;
+
+  ConditionalGet(HTTPClient& http, HttpValidators& validators, const char* url, ApiResponse& response)
+    : http(http), validators(validators), url(url), response(response) {
+    response.success = false;
+    response.httpCode = 0;
+  }
+
+  // Opens the request on `client`, collecting `extraHeader` besides the validators
+  template <typename Client>
+  bool begin(Client& client, const char* extraHeader = nullptr) {
+    if (WiFi.status() != WL_CONNECTED) {
+      response.error = "No WiFi connection";
+      return false;
+    }
+    if (!http.begin(client, url)) {
+      response.error = "HTTP begin failed";
+      return false;
+    }
+    http.useHTTP10(true);
+    validators.addTo(http, url);
+    const char* headers[] = {"ETag", "Last-Modified", extraHeader};
+    http.collectHeaders(headers, extraHeader ? 3 : 2);
+    return true;
+  }
+
+  void send() { response.httpCode = http.GET(); }
+
+  // After send(): whether a 200 body follows
+  bool bodyFollows(FetchBudget* budget) {
+    if (budget && response.httpCode < 0 && budget->expired()) {
+      return fail(IApiClient::timedOutError(*budget));
+    }
+    if (response.httpCode == 304) {
+      response.success = true;
+      response.notModified = true;
+      http.end();
+      return false;
+    }
+    if (response.httpCode != 200) {
+      return fail(String("HTTP error ") + String(response.httpCode));
+    }
+    return true;
+  }
+
+  // Gives the body its stage of `budget`
+  bool beginBody(FetchBudget* budget) {
+    if (!budget) {
+      return true;
+    }
+    unsigned long bodyMs = budget->begin(FetchBudget::BODY);
+    if (bodyMs == 0) {
+      return fail(IApiClient::timedOutError(*budget));
+    }
+    http.setTimeout(FetchBudget::httpTimeout(bodyMs));
+    return true;
+  }
+
+  // Once the body has been read: a body cut short by the budget fails the
+  // fetch, whatever the handler made of it
+  bool finish(FetchBudget* budget) {
+    if (budget && budget->exhausted()) {
+      return fail(IApiClient::timedOutError(*budget));
+    }
+    validators.remember(http, url);
+    http.end();
+    response.success = true;
+    return true;
+  }
+
+  bool fail(const String& error) {
+    response.error = error;
+    http.end();
+    return false;
+  }
+
+private:
+  HTTPClient& http;
+  HttpValidators& validators;
+  const char* url;
+  ApiResponse& response;
+};
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef FETCH_BUDGET_H
+#define FETCH_BUDGET_H
+
+#include <stdint.h>
+#include "../timing/SpanRecorder.h"
+
+/**
+ * Caps how long one fetch keeps the radio on, from WiFi association to the
+ * last body byte. Each stage gets its own timeout, cut to what is left of
+ * the total. The first stage to run out is recorded, and every stage after
+ * it gets no time at all, so an attempt that cannot succeed stops early.
+ *
+ * The budget only measures; each stage applies its timeout where it waits
+ * (the association wait, the socket, the handshake loop, the body reader)
+ * and reports back through expired(). With a SpanRecorder attached, each
+ * stage is also a span of the fetch's timeline, and the code it reaches
+ * records its own spans inside it through traceOf().
+ */
+class FetchBudget {
+public:
+  enum Stage {
+    WIFI,      // Association and DHCP
+    TIME,      // Waiting for SNTP, only while the clock cannot be trusted
+    DNS,
+    CONNECT,   // TCP
+    TLS,       // Handshake
+    RESPONSE,  // Request sent, waiting for the status line and headers
+    BODY,      // Receiving and parsing
+    STAGE_COUNT,
+    NONE = STAGE_COUNT
+  };
+
+  typedef unsigned long (*Clock)();  // Milliseconds, like millis()
+
+  struct Limits {
+    unsigned long totalMs;
+    unsigned long stageMs[STAGE_COUNT];
+  };
+
+  // A failed attempt costs at most TOTAL_MS of radio time; a good fetch
+  // takes 2-4 s, most of it association and the handshake
+  static constexpr unsigned long TOTAL_MS = 15000;
+  static Limits defaultLimits() {
+    Limits limits = {TOTAL_MS, {10000, 3000, 3000, 3000, 6000, 4000, 5000}};
+    return limits;
+  }
+
+  explicit FetchBudget(Clock clock) : FetchBudget(clock, defaultLimits()) {}
+
+  FetchBudget(Clock clock, const Limits& limits)
+    : clock(clock), limits(limits), started(clock()), stage(NONE), stageStarted(started), stageMs(0),
+      exhaustedIn(NONE), spans(nullptr) {}
+
+  void setTrace(SpanRecorder* recorder) { spans = recorder; }
+  // The recorder of a fetch that may run without a budget; null when none
+  static SpanRecorder* traceOf(const FetchBudget* budget) { return budget ? budget->spans : nullptr; }
+
+  // Starts `stage` and returns the milliseconds it may take: its own limit,
+  // or what is left of the total if that is less. 0 once the budget is spent,
+  // with `stage` recorded if nothing ran out before it.
+  unsigned long begin(Stage next) {
+    if (spans) {
+      spans->stage(describe(next));
+    }
+    stage = next;
+    stageStarted = clock();
+    unsigned long used = stageStarted - started;
+    unsigned long left = exhaustedIn != NONE || used >= limits.totalMs ? 0 : limits.totalMs - used;
+    stageMs = limits.stageMs[next] < left ? limits.stageMs[next] : left;
+    if (stageMs == 0) {
+      runOut();
+    }
+    return stageMs;
+  }
+
+  // Whether the current stage has used up its time; records it if so.
+  // Stages call this after a wait fails, to tell a timeout from an error.
+  bool expired() {
+    if (exhaustedIn != NONE) {
+      return true;
+    }
+    if (stage == NONE || clock() - stageStarted < stageMs) {
+      return false;
+    }
+    runOut();
+    return true;
+  }
+
+  // Milliseconds the current stage has left, for waits that take a deadline
+  unsigned long remaining() const {
+    if (exhaustedIn != NONE || stage == NONE) {
+      return 0;
+    }
+    unsigned long used = clock() - stageStarted;
+    return used < stageMs ? stageMs - used : 0;
+  }
+
+  bool exhausted() const { return exhaustedIn != NONE; }
+  // The stage that ran out first, NONE while time is left
+  Stage exhaustedStage() const { return exhaustedIn; }
+  Stage currentStage() const { return stage; }
+  unsigned long elapsed() const { return clock() - started; }
+
+  // HTTPClient::setTimeout() takes 16 bits of milliseconds
+  static uint16_t httpTimeout(unsigned long ms) { return ms < 0xFFFF ? (uint16_t)ms : 0xFFFF; }
+
+  static const char* describe(Stage stage) {
+    switch (stage) {
+      case WIFI: return "wifi";
+      case TIME: return "time";
+      case DNS: return "dns";
+      case CONNECT: return "connect";
+      case TLS: return "tls";
+      case RESPONSE: return "response";
+      case BODY: return "body";
+      default: return "none";
+    }
+  }
+
+private:
+  void runOut() {
+    if (exhaustedIn == NONE) {
+      exhaustedIn = stage;
+    }
+  }
+
+  Clock clock;
+  Limits limits;
+  unsigned long started;
+  Stage stage;
+  unsigned long stageStarted;
+  unsigned long stageMs;
+  Stage exhaustedIn;
+  SpanRecorder* spans;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef FETCH_SCHEDULER_H
+#define FETCH_SCHEDULER_H
+
+#include "PriceData.h"
+
+/**
+ * Decides whether a quarter-hour tick needs the network. Day-ahead prices
+ * are published once a day, so most ticks only re-analyze the stored
+ * series. A fetch is due when there is no series, when it is about to run
+ * out, or when tomorrow's prices should be out but are not held yet.
+ */
+class FetchScheduler {
+public:
+  enum Reason {
+    NOT_NEEDED,
+    NO_PRICES,
+    RUNNING_OUT,      // Less than MIN_COVERAGE_SECONDS of prices left
+    TOMORROW_MISSING  // Past PUBLISH_MINUTE and the series ends today
+  };
+
+  // Tomorrow's prices are out by about 14:00 Finnish time
+  static constexpr int PUBLISH_MINUTE = 14 * 60 + 15;
+  // Keeps the next 90 minutes covered with room for failed attempts
+  static constexpr int MIN_COVERAGE_SECONDS = 3 * 3600;
+  // While tomorrow is late or the prices run low, ask again about hourly;
+  // just under an hour so the tick an hour after a slightly late attempt
+  // still qualifies. Three hours of coverage leave room for three tries.
+  static constexpr int RETRY_SECONDS = 55 * 60;
+
+  // lastAttempt is the time of the last fetch, successful or not (0 if none)
+  static Reason check(const PriceSeries& series, time_t now, time_t lastAttempt) {
+    if (series.count == 0) {
+      return NO_PRICES;
+    }
+    bool triedRecently = lastAttempt != 0 && now - lastAttempt < RETRY_SECONDS;
+    if (series.slotEpoch(series.count) - now < MIN_COVERAGE_SECONDS) {
+      return triedRecently ? NOT_NEEDED : RUNNING_OUT;
+    }
+
+    // Local time as the latest prices give it
+    const int last = series.count - 1;
+    const int16_t offset = series.offsetAt(last);
+    if (series.localDay(last) > PriceTime::localDay(now, offset)) {
+      return NOT_NEEDED;  // Tomorrow is already here
+    }
+    if (PriceTime::localMinuteOfDay(now, offset) < PUBLISH_MINUTE) {
+      return NOT_NEEDED;
+    }
+    return triedRecently ? NOT_NEEDED : TOMORROW_MISSING;
+  }
+
+  static const char* describe(Reason reason) {
+    switch (reason) {
+      case NO_PRICES: return "no prices";
+      case RUNNING_OUT: return "prices running out";
+      case TOMORROW_MISSING: return "tomorrow missing";
+      default: return "cached prices cover the horizon";
+    }
+  }
+};
+
+#endif
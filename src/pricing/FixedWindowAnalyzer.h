@@ -0,0 +1,138 @@
+#ifndef FIXED_WINDOW_ANALYZER_H
+#define FIXED_WINDOW_ANALYZER_H
+
+#include "PriceData.h"
+#include "SlotMask.h"
+
+// Sum of N consecutive prices in micro-units, expanded at compile time
+template <int N>
+struct UnrolledPriceSum {
+  static int64_t of(const float* p) {
+    return UnrolledPriceSum<N - 1>::of(p) + priceToMicros(p[N - 1]);
+  }
+};
+
+template <>
+struct UnrolledPriceSum<0> {
+  static int64_t of(const float*) { return 0; }
+};
+
+/**
+ * Cheapest-window search with the window length and allowed hours fixed at
+ * compile time. A window of `Slots` 15-minute slots may start at or after
+ * StartHour:00 and must end by EndHour:00 local time.
+ *
+ * With 15-minute slots the valid starts of each local day are one constant
+ * range of slot-of-day numbers, so the scan visits only those starts and
+ * never looks up wall-clock time per slot. Each range starts with an
+ * unrolled window sum and then slides. Windows that straddle the DST
+ * switch, and series with other slot lengths, are tested against the
+ * series' valid-start mask instead.
+ */
+template <int Slots, int StartHour, int EndHour>
+class FixedWindowAnalyzer {
+  static_assert(Slots > 0, "window needs at least one slot");
+  static_assert(StartHour >= 0 && StartHour < EndHour && EndHour <= 24, "hours must satisfy 0 <= start < end <= 24");
+
+public:
+  static constexpr int SLOTS = Slots;
+  static constexpr int EARLIEST_START = StartHour * 60;  // Minutes since local midnight
+  static constexpr int LATEST_END = EndHour * 60;
+
+  static constexpr int SLOT_SECONDS = 900;
+  static constexpr int SLOTS_PER_DAY = 96;
+  // Slot-of-day range of valid starts; empty when the window cannot fit
+  static constexpr int FIRST_START_SLOT = StartHour * 4;
+  static constexpr int LAST_START_SLOT = EndHour * 4 - Slots;
+
+  static CheapestWindow findCheapest(const PriceSeries& prices) {
+    CheapestWindow result;
+    if (prices.count < Slots) {
+      return result;
+    }
+
+    int64_t cheapestSum = 0;
+    int cheapestIdx = -1;
+
+    int split = prices.dstSwitchIndex < prices.count ? prices.dstSwitchIndex : prices.count;
+    bool quarterHourSlots = prices.slotSeconds == SLOT_SECONDS && prices.minuteOfDay(0) % 15 == 0 &&
+                            (split == prices.count || prices.minuteOfDay(split) % 15 == 0);
+    if (!quarterHourSlots) {
+      SlotMask validStarts;
+      buildValidStarts(prices, validStarts);
+      scanMasked(prices, validStarts, 0, prices.count - Slots, cheapestSum, cheapestIdx);
+    } else {
+      scanSegment(prices, 0, split, cheapestSum, cheapestIdx);
+      if (split < prices.count) {
+        // Windows holding slots from both sides of the switch
+        SlotMask validStarts;
+        buildValidStarts(prices, validStarts);
+        int first = split - Slots + 1 > 0 ? split - Slots + 1 : 0;
+        int last = split - 1 < prices.count - Slots ? split - 1 : prices.count - Slots;
+        scanMasked(prices, validStarts, first, last, cheapestSum, cheapestIdx);
+        scanSegment(prices, split, prices.count, cheapestSum, cheapestIdx);
+      }
+    }
+
+    if (cheapestIdx >= 0) {
+      result.avg = (float)((double)cheapestSum / 1000000.0 / Slots);
+      result.startIndex = cheapestIdx;
+    }
+    return result;
+  }
+
+private:
+  // Windows inside slots [from, to), which share one UTC offset: walk each
+  // local day's valid range. Indices ascend, so the first of equal windows wins.
+  static void scanSegment(const PriceSeries& prices, int from, int to,
+                          int64_t& cheapestSum, int& cheapestIdx) {
+    if (LAST_START_SLOT < FIRST_START_SLOT) {
+      return;
+    }
+    const float* p = prices.prices;
+    int lastStart = to - Slots;
+    for (int dayStart = from - prices.minuteOfDay(from) / 15; dayStart <= lastStart; dayStart += SLOTS_PER_DAY) {
+      int first = dayStart + FIRST_START_SLOT > from ? dayStart + FIRST_START_SLOT : from;
+      int last = dayStart + LAST_START_SLOT < lastStart ? dayStart + LAST_START_SLOT : lastStart;
+      if (first > last) {
+        continue;
+      }
+      // Unrolled sum for the first start of the range, then slide
+      int64_t sum = UnrolledPriceSum<Slots>::of(p + first);
+      for (int i = first;; ) {
+        if (cheapestIdx < 0 || sum < cheapestSum) {
+          cheapestSum = sum;
+          cheapestIdx = i;
+        }
+        if (++i > last) {
+          break;
+        }
+        sum += priceToMicros(p[i + Slots - 1]) - priceToMicros(p[i - 1]);
+      }
+    }
+  }
+
+  static void buildValidStarts(const PriceSeries& prices, SlotMask& validStarts) {
+    AllowedSlots allowed;
+    allowed.build(prices, EARLIEST_START, LATEST_END);
+    allowed.windowStarts(Slots, validStarts);
+  }
+
+  // Starts in [first, last], each tested against the valid-start mask
+  static void scanMasked(const PriceSeries& prices, const SlotMask& validStarts, int first, int last,
+                         int64_t& cheapestSum, int& cheapestIdx) {
+    const float* p = prices.prices;
+    for (int i = first; i <= last; i++) {
+      if (!validStarts.test(i)) {
+        continue;
+      }
+      int64_t sum = UnrolledPriceSum<Slots>::of(p + i);
+      if (cheapestIdx < 0 || sum < cheapestSum) {
+        cheapestSum = sum;
+        cheapestIdx = i;
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef HTTP_VALIDATORS_H
+#define HTTP_VALIDATORS_H
+
+#ifndef WString_h
+#include <WString.h>
+#endif
+#ifndef HTTP_CLIENT_H
+#include <HTTPClient.h>
+#endif
+
+/**
+ * ETag and Last-Modified of the last full response, sent back as
+ * If-None-Match and If-Modified-Since so an unchanged body costs a 304.
+ * They are only sent to the URL they came from.
+ */
+class HttpValidators {
+public:
+  void addTo(HTTPClient& http, const char* url) const {
+    if (!(sourceUrl == url)) {
+      return;
+    }
+    if (etag.length() > 0) {
+      http.addHeader("If-None-Match", etag);
+    }
+    if (lastModified.length() > 0) {
+      http.addHeader("If-Modified-Since", lastModified);
+    }
+  }
+
+  // A response without validators clears the old ones
+  void remember(HTTPClient& http, const char* url) {
+    sourceUrl = url;
+    etag = http.header("ETag");
+    lastModified = http.header("Last-Modified");
+  }
+
+  void clear() {
+    sourceUrl = String();
+    etag = String();
+    lastModified = String();
+  }
+
+private:
+  String sourceUrl;
+  String etag;
+  String lastModified;
+};
+
+#endif
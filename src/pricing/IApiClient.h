@@ -4,6 +4,8 @@
 #ifndef WString_h
 #include <WString.h>
 #endif
+#include "BodyReader.h"
+#include "FetchBudget.h"
 
 /**
  * Interface for API client operations.
@@ -16,10 +18,47 @@ public:
     String payload;
     int httpCode;
     String error;
+    bool notModified = false;  // 304: the body we already have is current
+    unsigned long tlsHandshakeMicros = 0;  // 0 when no handshake took place
+    bool tlsResumed = false;               // Abbreviated handshake from a saved session
+    size_t compressedBytes = 0;            // Body as received, when it came compressed
+    size_t inflatedBytes = 0;              // The same body decompressed
+  };
+
+  // Consumes a response body while it is received
+  class BodyHandler {
+  public:
+    virtual ~BodyHandler() = default;
+    virtual void handleBody(BodyReader& body) = 0;
   };
 
   virtual ~IApiClient() = default;
   virtual ApiResponse fetchJson(const char* url) = 0;
+  
+  // Hands a successful response body to `handler` instead of returning it;
+  // payload stays empty. Clients that cannot stream buffer it with fetchJson().
+  // A not-modified response has no body and the handler is not called.
+  // Streaming clients give each stage its share of `budget` and fail the
+  // fetch, body included, once it runs out.
+  virtual ApiResponse streamJson(const char* url, BodyHandler& handler, FetchBudget* budget = nullptr) {
+    (void)budget;
+    ApiResponse response = fetchJson(url);
+    if (response.success && !response.notModified) {
+      StringBodyReader body(response.payload.c_str(), response.payload.length());
+      handler.handleBody(body);
+      response.payload = String();
+    }
+    return response;
+  }
+
+  // Clients that send conditional requests forget the validators they hold,
+  // so the next fetch returns the full body
+  virtual void clearValidators() {}
+
+  // The error of a fetch cut short by its budget, naming the stage
+  static String timedOutError(const FetchBudget& budget) {
+    return String("Timed out: ") + FetchBudget::describe(budget.exhaustedStage());
+  }
 };
 
 #endif
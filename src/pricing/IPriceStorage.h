@@ -0,0 +1,20 @@
+#ifndef IPRICE_STORAGE_H
+#define IPRICE_STORAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Keeps one opaque blob (the encoded price cache, or a TLS session) across resets.
+// The blob's own header tells a good copy from a stale or torn one.
+class IPriceStorage {
+public:
+  virtual ~IPriceStorage() = default;
+
+  // Copies the stored blob into buffer; returns its length, or 0 when
+  // nothing is stored or it does not fit
+  virtual size_t load(uint8_t* buffer, size_t capacity) = 0;
+  // Replaces the stored blob
+  virtual bool save(const uint8_t* data, size_t length) = 0;
+};
+
+#endif // IPRICE_STORAGE_H
@@ -0,0 +1,508 @@
+#include "InflateBodyReader.h"
+#include <string.h>
+#ifdef ESP_PLATFORM
+#include <esp_rom_crc.h>
+#endif
+
+namespace {
+
+// Longest run one step produces: a match, or a slice of a stored block
+const uint32_t MAX_STEP = 258;
+static_assert(InflateBodyReader::WINDOW_SIZE >= 4 * MAX_STEP, "INFLATE_WINDOW_BITS is too small");
+
+const short LENGTH_BASE[29] = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const short LENGTH_EXTRA[29] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const short DISTANCE_BASE[30] = {
+  1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+  8193, 12289, 16385, 24577};
+const short DISTANCE_EXTRA[30] = {
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// Order in which a dynamic block lists the code length code
+const uint8_t CODE_LENGTH_ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+// CRC-32 as zlib's crc32(): pass the previous result, 0 to start
+#ifdef ESP_PLATFORM
+uint32_t crc32(uint32_t crc, const uint8_t* bytes, uint32_t length) {
+  return esp_rom_crc32_le(crc, bytes, length);  // Table in ROM
+}
+#else
+// Four bits at a time: 64 bytes of table
+const uint32_t CRC_NIBBLE[16] = {
+  0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+  0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+
+uint32_t crc32(uint32_t crc, const uint8_t* bytes, uint32_t length) {
+  crc = ~crc;
+  for (uint32_t i = 0; i < length; i++) {
+    crc ^= bytes[i];
+    crc = CRC_NIBBLE[crc & 0x0F] ^ (crc >> 4);
+    crc = CRC_NIBBLE[crc & 0x0F] ^ (crc >> 4);
+  }
+  return ~crc;
+}
+#endif
+
+const uint32_t ADLER_MODULUS = 65521;
+
+// gzip header flags
+const uint8_t FHCRC = 0x02;
+const uint8_t FEXTRA = 0x04;
+const uint8_t FNAME = 0x08;
+const uint8_t FCOMMENT = 0x10;
+const uint8_t FRESERVED = 0xE0;
+
+}  // namespace
+
+InflateBodyReader::InflateBodyReader(BodyReader& source, Format format, uint8_t* window)
+  : source(source), format(format), zlib(false), window(window), state(HEADER), lastBlock(false),
+    ended(false), truncated(false), bitBuffer(0), bitCount(0), consumed(0), writePos(0), readPos(0), storedLeft(0),
+    crc(0), adlerA(1), adlerB(0) {
+  literalCode.symbol = literalSymbols;
+  distanceCode.symbol = distanceSymbols;
+}
+
+size_t InflateBodyReader::readBytes(char* buffer, size_t length) {
+  size_t n = 0;
+  while (n < length) {
+    if (readPos == writePos && !produce()) {
+      break;
+    }
+    uint32_t offset = readPos & WINDOW_MASK;
+    size_t chunk = writePos - readPos;
+    if (chunk > length - n) chunk = length - n;
+    if (chunk > WINDOW_SIZE - offset) chunk = WINDOW_SIZE - offset;
+    memcpy(buffer + n, window + offset, chunk);
+    readPos += (uint32_t)chunk;
+    n += chunk;
+  }
+  return n;
+}
+
+// Decodes a batch of at least MAX_STEP bytes, or up to the end of the
+// stream. Fewer than 2 * MAX_STEP bytes ever wait to be read, far less than
+// the window, so decoding never overwrites them.
+bool InflateBodyReader::produce() {
+  uint32_t batch = writePos;
+  while (writePos - readPos < MAX_STEP && state != DONE && state != FAILED) {
+    uint32_t from = writePos;
+    step();
+    if (state == FAILED) {
+      writePos = from;  // Nothing from a step that failed reaches the reader
+    } else if (state == TRAILER) {
+      updateCheck(batch);  // The trailer is checked against everything
+      batch = writePos;
+    }
+  }
+  updateCheck(batch);
+  return readPos != writePos;
+}
+
+void InflateBodyReader::step() {
+  switch (state) {
+    case HEADER:
+      state = readHeader() ? BLOCK_START : FAILED;
+      break;
+    case BLOCK_START:
+      if (lastBlock) {
+        state = TRAILER;
+      } else if (!startBlock()) {
+        fail();
+      }
+      break;
+    case STORED:
+      copyStored();
+      break;
+    case CODES:
+      decodeSymbol();
+      break;
+    case TRAILER:
+      state = readTrailer() ? DONE : FAILED;
+      break;
+    case DONE:
+    case FAILED:
+      break;
+  }
+}
+
+int InflateBodyReader::nextByte() {
+  int c = ended ? -1 : source.read();
+  if (c < 0) {
+    ended = true;
+    truncated = true;
+    return -1;
+  }
+  consumed++;
+  return c;
+}
+
+// Next `need` bits (at most 16), least significant first. Past the end of
+// the source it reads zeros and sets `truncated`, which callers check
+// before anything decoded from those bits is used.
+uint32_t InflateBodyReader::bits(int need) {
+  while (bitCount < need) {
+    int c = nextByte();
+    bitBuffer |= (uint32_t)(c < 0 ? 0 : c) << bitCount;
+    bitCount += 8;
+  }
+  uint32_t value = bitBuffer & ((1u << need) - 1);
+  bitBuffer >>= need;
+  bitCount -= need;
+  return value;
+}
+
+bool InflateBodyReader::readHeader() {
+  if (format == GZIP) {
+    return readGzipHeader();
+  }
+  int cmf = nextByte();
+  int flg = nextByte();
+  if (truncated) {
+    return false;
+  }
+  // zlib: deflate method, a window deflate allows, and a header checksum
+  if ((cmf & 0x0F) == 8 && (cmf >> 4) <= 7 && ((cmf << 8) | flg) % 31 == 0) {
+    zlib = true;
+    return (flg & 0x20) == 0;  // A preset dictionary we cannot know
+  }
+  // Raw deflate: the two bytes are the start of the first block
+  bitBuffer = (uint32_t)cmf | ((uint32_t)flg << 8);
+  bitCount = 16;
+  return true;
+}
+
+bool InflateBodyReader::readGzipHeader() {
+  uint8_t fixed[10];
+  for (int i = 0; i < 10; i++) {
+    fixed[i] = (uint8_t)nextByte();
+  }
+  uint8_t flags = fixed[3];
+  if (truncated || fixed[0] != 0x1F || fixed[1] != 0x8B || fixed[2] != 8 || (flags & FRESERVED)) {
+    return false;
+  }
+  if (flags & FEXTRA) {
+    int length = nextByte();
+    length |= nextByte() << 8;
+    while (length-- > 0 && !truncated) {
+      nextByte();
+    }
+  }
+  // File name and comment: zero-terminated
+  for (uint8_t field = FNAME; field <= FCOMMENT; field <<= 1) {
+    if (flags & field) {
+      int c;
+      do {
+        c = nextByte();
+      } while (c > 0);
+    }
+  }
+  if (flags & FHCRC) {
+    nextByte();
+    nextByte();
+  }
+  return !truncated;
+}
+
+bool InflateBodyReader::startBlock() {
+  lastBlock = bits(1) == 1;
+  uint32_t type = bits(2);
+  if (truncated) {
+    return false;
+  }
+  switch (type) {
+    case 0: {
+      bits(bitCount & 7);  // Stored blocks start on a byte boundary
+      uint32_t length = bits(16);
+      uint32_t complement = bits(16);
+      if (truncated || length != (~complement & 0xFFFF)) {
+        return false;
+      }
+      storedLeft = length;
+      state = STORED;
+      return true;
+    }
+    case 1:
+      state = CODES;
+      return fixedCodes();
+    case 2:
+      state = CODES;
+      return dynamicCodes();
+    default:
+      return false;
+  }
+}
+
+void InflateBodyReader::copyStored() {
+  uint32_t n = storedLeft < MAX_STEP ? storedLeft : MAX_STEP;
+  for (uint32_t i = 0; i < n; i++) {
+    emit((uint8_t)bits(8));
+  }
+  if (truncated) {
+    fail();
+    return;
+  }
+  storedLeft -= n;
+  if (storedLeft == 0) {
+    state = BLOCK_START;
+  }
+}
+
+// One literal, a back-reference, or the end of the block
+void InflateBodyReader::decodeSymbol() {
+  int symbol = decode(literalCode);
+  if (symbol < 256) {
+    if (symbol < 0 || truncated) {
+      fail();
+    } else {
+      emit((uint8_t)symbol);
+    }
+    return;
+  }
+  if (symbol == 256) {
+    state = truncated ? FAILED : BLOCK_START;
+    return;
+  }
+
+  symbol -= 257;
+  if (symbol >= 29) {
+    fail();
+    return;
+  }
+  uint32_t length = LENGTH_BASE[symbol] + bits(LENGTH_EXTRA[symbol]);
+  int distanceSymbol = decode(distanceCode);
+  if (distanceSymbol < 0 || distanceSymbol >= 30) {
+    fail();
+    return;
+  }
+  uint32_t distance = DISTANCE_BASE[distanceSymbol] + bits(DISTANCE_EXTRA[distanceSymbol]);
+  // Further back than the stream's start, or than the window reaches
+  if (truncated || distance > writePos || distance > WINDOW_SIZE) {
+    fail();
+    return;
+  }
+  // Byte by byte: a match may overlap the bytes it produces
+  for (uint32_t i = 0; i < length; i++) {
+    emit(window[(writePos - distance) & WINDOW_MASK]);
+  }
+}
+
+bool InflateBodyReader::readTrailer() {
+  bits(bitCount & 7);
+  if (format == GZIP) {
+    uint32_t expectedCrc = bits(16);
+    expectedCrc |= bits(16) << 16;
+    uint32_t expectedSize = bits(16);
+    expectedSize |= bits(16) << 16;
+    return !truncated && expectedCrc == crc && expectedSize == writePos;
+  }
+  if (zlib) {
+    uint32_t expected = 0;
+    for (int i = 0; i < 4; i++) {
+      expected = (expected << 8) | bits(8);
+    }
+    return !truncated && expected == ((adlerB << 16) | adlerA);
+  }
+  return !truncated;  // Raw deflate carries no check
+}
+
+void InflateBodyReader::updateCheck(uint32_t from) {
+  // At most two runs: the window may wrap around
+  while (from != writePos) {
+    uint32_t offset = from & WINDOW_MASK;
+    uint32_t length = writePos - from;
+    if (length > WINDOW_SIZE - offset) {
+      length = (uint32_t)WINDOW_SIZE - offset;
+    }
+    const uint8_t* bytes = window + offset;
+    if (format == GZIP) {
+      crc = crc32(crc, bytes, length);
+    } else if (zlib) {
+      // A batch is short enough that the sums cannot overflow before the modulo
+      for (uint32_t i = 0; i < length; i++) {
+        adlerA += bytes[i];
+        adlerB += adlerA;
+      }
+      adlerA %= ADLER_MODULUS;
+      adlerB %= ADLER_MODULUS;
+    }
+    from += length;
+  }
+}
+
+bool InflateBodyReader::fixedCodes() {
+  short lengths[MAX_LITERAL_CODES];
+  int symbol = 0;
+  for (; symbol < 144; symbol++) lengths[symbol] = 8;
+  for (; symbol < 256; symbol++) lengths[symbol] = 9;
+  for (; symbol < 280; symbol++) lengths[symbol] = 7;
+  for (; symbol < MAX_LITERAL_CODES; symbol++) lengths[symbol] = 8;
+  buildHuffman(literalCode, lengths, MAX_LITERAL_CODES);
+
+  for (symbol = 0; symbol < MAX_DISTANCE_CODES; symbol++) lengths[symbol] = 5;
+  buildHuffman(distanceCode, lengths, MAX_DISTANCE_CODES);
+  return true;
+}
+
+// Code lengths for both codes, themselves sent with a code length code
+bool InflateBodyReader::dynamicCodes() {
+  int literals = (int)bits(5) + 257;
+  int distances = (int)bits(5) + 1;
+  int codeLengths = (int)bits(4) + 4;
+  if (truncated || literals > 286 || distances > MAX_DISTANCE_CODES) {
+    return false;
+  }
+
+  short lengths[MAX_LITERAL_CODES + MAX_DISTANCE_CODES];
+  for (int i = 0; i < 19; i++) {
+    lengths[CODE_LENGTH_ORDER[i]] = i < codeLengths ? (short)bits(3) : 0;
+  }
+  // The code length code borrows the literal code's storage
+  if (truncated || buildHuffman(literalCode, lengths, 19) != 0) {
+    return false;
+  }
+
+  int index = 0;
+  while (index < literals + distances) {
+    int symbol = decode(literalCode);
+    if (symbol < 0 || truncated) {
+      return false;
+    }
+    if (symbol < 16) {
+      lengths[index++] = (short)symbol;
+      continue;
+    }
+    short repeated = 0;
+    int times;
+    if (symbol == 16) {
+      if (index == 0) {
+        return false;
+      }
+      repeated = lengths[index - 1];
+      times = 3 + (int)bits(2);
+    } else if (symbol == 17) {
+      times = 3 + (int)bits(3);
+    } else {
+      times = 11 + (int)bits(7);
+    }
+    if (index + times > literals + distances) {
+      return false;
+    }
+    while (times-- > 0) {
+      lengths[index++] = repeated;
+    }
+  }
+  if (truncated || lengths[256] == 0) {
+    return false;  // No way to end the block
+  }
+
+  // Incomplete codes are only allowed when they have a single code
+  int left = buildHuffman(literalCode, lengths, literals);
+  if (left < 0 || (left > 0 && literals - literalCode.count[0] != 1)) {
+    return false;
+  }
+  left = buildHuffman(distanceCode, lengths + literals, distances);
+  return left >= 0 && (left == 0 || distances - distanceCode.count[0] == 1);
+}
+
+// Returns 0 for a complete code, a positive number for an incomplete one
+// and a negative one for an over-subscribed one
+int InflateBodyReader::buildHuffman(Huffman& code, const short* lengths, int n) {
+  memset(code.fast, 0, sizeof(code.fast));
+  for (int length = 0; length <= MAX_BITS; length++) {
+    code.count[length] = 0;
+  }
+  for (int symbol = 0; symbol < n; symbol++) {
+    code.count[lengths[symbol]]++;
+  }
+  if (code.count[0] == n) {
+    return 0;  // No codes: complete, but decode() finds nothing
+  }
+
+  int left = 1;
+  for (int length = 1; length <= MAX_BITS; length++) {
+    left <<= 1;
+    left -= code.count[length];
+    if (left < 0) {
+      return left;
+    }
+  }
+
+  short offsets[MAX_BITS + 1];
+  offsets[1] = 0;
+  for (int length = 1; length < MAX_BITS; length++) {
+    offsets[length + 1] = offsets[length] + code.count[length];
+  }
+  for (int symbol = 0; symbol < n; symbol++) {
+    if (lengths[symbol] != 0) {
+      code.symbol[offsets[lengths[symbol]]++] = (short)symbol;
+    }
+  }
+
+  // Short codes, indexed by their bits as they arrive: reversed, since
+  // codes are sent most significant bit first
+  int value = 0;
+  int index = 0;
+  for (int length = 1; length <= FAST_BITS; length++) {
+    for (int k = 0; k < code.count[length]; k++, value++, index++) {
+      int reversed = 0;
+      for (int bit = 0; bit < length; bit++) {
+        reversed |= ((value >> bit) & 1) << (length - 1 - bit);
+      }
+      uint16_t entry = (uint16_t)((code.symbol[index] << 4) | length);
+      for (int fill = reversed; fill < (1 << FAST_BITS); fill += 1 << length) {
+        code.fast[fill] = entry;
+      }
+    }
+    value <<= 1;
+  }
+  return left;
+}
+
+// Short codes come from the table in one lookup. Longer ones are decoded
+// bit by bit: canonical codes of one length are consecutive, so that is
+// enough to tell which length the code has and where its symbol is.
+int InflateBodyReader::decode(const Huffman& code) {
+  while (bitCount < FAST_BITS && !ended) {
+    int c = source.read();
+    if (c < 0) {
+      ended = true;  // Not truncated unless the code needs the missing bits
+      break;
+    }
+    consumed++;
+    bitBuffer |= (uint32_t)c << bitCount;
+    bitCount += 8;
+  }
+  uint16_t entry = code.fast[bitBuffer & ((1u << FAST_BITS) - 1)];
+  if (entry != 0) {
+    int length = entry & 0x0F;
+    if (length > bitCount) {
+      truncated = true;
+      return -1;
+    }
+    bitBuffer >>= length;
+    bitCount -= length;
+    return entry >> 4;
+  }
+
+  int value = 0;
+  int first = 0;
+  int index = 0;
+  for (int length = 1; length <= MAX_BITS; length++) {
+    value |= (int)bits(1);
+    int count = code.count[length];
+    if (value - count < first) {
+      return code.symbol[index + (value - first)];
+    }
+    index += count;
+    first += count;
+    first <<= 1;
+    value <<= 1;
+  }
+  return -1;
+}
@@ -0,0 +1,124 @@
+#ifndef INFLATE_BODY_READER_H
+#define INFLATE_BODY_READER_H
+
+#include "BodyReader.h"
+
+// Deflate may refer back up to 32 KB; a smaller window only suits servers
+// known to compress with one (zlib's windowBits)
+#ifndef INFLATE_WINDOW_BITS
+#define INFLATE_WINDOW_BITS 15
+#endif
+
+/**
+ * Decompresses a gzip or deflate response body while it is received.
+ * The compressed bytes are pulled from `source` one at a time, as the
+ * reader is read, and decoded into the history window, from which they are
+ * also served: the window is the only buffer. Parsers see a plain body.
+ *
+ * The body ends at the end of the compressed stream. A truncated or corrupt
+ * stream, or one whose checksum does not match, also ends the body early;
+ * intact() tells a complete body from one that was cut short.
+ */
+class InflateBodyReader : public BodyReader {
+public:
+  static constexpr size_t WINDOW_SIZE = (size_t)1 << INFLATE_WINDOW_BITS;
+
+  enum Format {
+    GZIP,     // Content-Encoding: gzip
+    DEFLATE   // Content-Encoding: deflate; zlib-wrapped, or raw as some servers send it
+  };
+
+  // `window` holds WINDOW_SIZE bytes and outlives the reader
+  InflateBodyReader(BodyReader& source, Format format, uint8_t* window);
+
+  int read() override {
+    if (readPos == writePos && !produce()) {
+      return -1;
+    }
+    return window[readPos++ & WINDOW_MASK];
+  }
+
+  size_t readBytes(char* buffer, size_t length) override;
+
+  // The whole stream was decoded and its checksum and length matched
+  bool intact() const { return state == DONE; }
+  bool failed() const { return state == FAILED; }
+  // Compressed bytes taken from the source so far, and what they inflated to
+  size_t compressedBytes() const { return consumed; }
+  size_t inflatedBytes() const { return writePos; }
+
+private:
+  static constexpr uint32_t WINDOW_MASK = (uint32_t)WINDOW_SIZE - 1;
+  static constexpr int MAX_BITS = 15;
+  static constexpr int MAX_LITERAL_CODES = 288;
+  static constexpr int MAX_DISTANCE_CODES = 30;
+  static constexpr int FAST_BITS = 8;
+
+  enum State {
+    HEADER,
+    BLOCK_START,
+    STORED,
+    CODES,
+    TRAILER,
+    DONE,
+    FAILED
+  };
+
+  // Canonical Huffman code: codes per length, then symbols in code order.
+  // Codes of up to FAST_BITS bits also have a lookup table of
+  // (symbol << 4 | length), 0 where a longer code starts.
+  struct Huffman {
+    short count[MAX_BITS + 1];
+    short* symbol;
+    uint16_t fast[1 << FAST_BITS];
+  };
+
+  bool produce();
+  void step();
+  bool readHeader();
+  bool readGzipHeader();
+  bool startBlock();
+  void copyStored();
+  void decodeSymbol();
+  bool readTrailer();
+
+  bool fixedCodes();
+  bool dynamicCodes();
+  static int buildHuffman(Huffman& code, const short* lengths, int n);
+  int decode(const Huffman& code);
+
+  int nextByte();
+  uint32_t bits(int need);
+  void emit(uint8_t byte) { window[writePos++ & WINDOW_MASK] = byte; }
+  void updateCheck(uint32_t from);
+  void fail() { state = FAILED; }
+
+  BodyReader& source;
+  Format format;
+  bool zlib;   // DEFLATE with a zlib header and Adler-32 trailer
+  uint8_t* window;
+  State state;
+  bool lastBlock;
+  bool ended;      // The source has no more bytes
+  bool truncated;  // ...and the stream needed some
+
+  uint32_t bitBuffer;
+  int bitCount;
+  size_t consumed;
+
+  // Total bytes decoded and handed out; the window holds the last WINDOW_SIZE
+  uint32_t writePos;
+  uint32_t readPos;
+  uint32_t storedLeft;
+
+  uint32_t crc;
+  uint32_t adlerA;
+  uint32_t adlerB;
+
+  short literalSymbols[MAX_LITERAL_CODES];
+  short distanceSymbols[MAX_DISTANCE_CODES];
+  Huffman literalCode;
+  Huffman distanceCode;
+};
+
+#endif
@@ -0,0 +1,56 @@
+#include "LanPriceClient.h"
+
+// Sends the GET and returns true when a body follows. Otherwise fills in
+// the error, or marks the response not modified, and ends the request.
+bool LanPriceClient::beginGet(ConditionalGet& get, HTTPClient& http, WiFiClient& client, FetchBudget* budget) {
+  // The blob is under a kilobyte; HTTP/1.0 keeps it unchunked
+  if (!get.begin(client)) {
+    return false;
+  }
+
+  if (budget) {
+    // No TLS, and the aggregator is normally addressed by IP: one stage
+    // covers the connection and the response headers
+    unsigned long connectMs = budget->begin(FetchBudget::CONNECT);
+    if (connectMs == 0) {
+      return get.fail(timedOutError(*budget));
+    }
+    http.setConnectTimeout((int32_t)connectMs);
+    http.setTimeout(FetchBudget::httpTimeout(connectMs));
+  }
+
+  get.send();
+  return get.bodyFollows(budget);
+}
+
+void LanPriceClient::clearValidators() {
+  validators.clear();
+}
+
+LanPriceClient::ApiResponse LanPriceClient::fetchJson(const char* url) {
+  ApiResponse response;
+  WiFiClient client;
+  HTTPClient http;
+  ConditionalGet get(http, validators, url, response);
+
+  if (beginGet(get, http, client)) {
+    response.payload = http.getString();
+    get.finish(nullptr);
+  }
+  return response;
+}
+
+LanPriceClient::ApiResponse LanPriceClient::streamJson(const char* url, BodyHandler& handler,
+                                                       FetchBudget* budget) {
+  ApiResponse response;
+  WiFiClient client;
+  HTTPClient http;
+  ConditionalGet get(http, validators, url, response);
+
+  if (beginGet(get, http, client, budget) && get.beginBody(budget)) {
+    StreamBodyReader body(http.getStream(), budget);
+    handler.handleBody(body);
+    get.finish(budget);
+  }
+  return response;
+}
@@ -0,0 +1,35 @@
+#ifndef LAN_PRICE_CLIENT_H
+#define LAN_PRICE_CLIENT_H
+
+#ifndef WString_h
+#include <WString.h>
+#endif
+#ifndef HTTP_CLIENT_H
+#include <HTTPClient.h>
+#include <WiFiClient.h>
+#endif
+#include "ConditionalGet.h"
+#include "FetchBudget.h"
+#include "HttpValidators.h"
+#include "IApiClient.h"
+#include "StreamBodyReader.h"
+
+/**
+ * Fetches prices from the aggregator on the local network (aggregator/):
+ * plain HTTP, no TLS, and a body that is the PriceCache image the service
+ * encoded rather than the upstream JSON. PriceMonitor tells the two apart
+ * by the first byte, so this client also works against a JSON server.
+ */
+class LanPriceClient : public IApiClient {
+public:
+  ApiResponse fetchJson(const char* url) override;
+  ApiResponse streamJson(const char* url, BodyHandler& handler, FetchBudget* budget = nullptr) override;
+  void clearValidators() override;
+
+private:
+  bool beginGet(ConditionalGet& get, HTTPClient& http, WiFiClient& client, FetchBudget* budget = nullptr);
+
+  HttpValidators validators;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef NVS_PRICE_STORAGE_H
+#define NVS_PRICE_STORAGE_H
+
+#include "IPriceStorage.h"
+#include <Preferences.h>
+
+// ESP32 implementation: one NVS blob per key. NVS writes the new entry
+// before erasing the old one, so a reset mid-save leaves the previous copy.
+class NvsPriceStorage : public IPriceStorage {
+public:
+  explicit NvsPriceStorage(const char* blobKey = "cache") : key(blobKey) {}
+  
+  size_t load(uint8_t* buffer, size_t capacity) override {
+    Preferences prefs;
+    if (!prefs.begin(NAMESPACE, true)) {
+      return 0;
+    }
+    size_t length = prefs.getBytesLength(key);
+    size_t read = (length > 0 && length <= capacity) ? prefs.getBytes(key, buffer, capacity) : 0;
+    prefs.end();
+    return read;
+  }
+
+  bool save(const uint8_t* data, size_t length) override {
+    Preferences prefs;
+    if (!prefs.begin(NAMESPACE, false)) {
+      return false;
+    }
+    size_t written = prefs.putBytes(key, data, length);
+    prefs.end();
+    return written == length;
+  }
+
+private:
+  static constexpr const char* NAMESPACE = "prices";
+  const char* key;
+};
+
+#endif // NVS_PRICE_STORAGE_H
@@ -1,139 +1,319 @@
 #include "PriceAnalyzer.h"
 #include <time.h>
-#include <cstdio>
+#include <cstdint>
+#include <algorithm>
 
-PriceAnalysis PriceAnalyzer::analyzePrices(const std::vector<PriceEntry>& prices) {
+namespace {
+
+struct WindowCandidate {
+  int64_t sum;
+  int start;
+};
+
+// Cheaper first; equal sums keep the earlier start
+bool cheaperCandidate(const WindowCandidate& a, const WindowCandidate& b) {
+  return a.sum < b.sum || (a.sum == b.sum && a.start < b.start);
+}
+
+// Orders slot indices by price, earlier slot first on ties
+struct CheaperSlot {
+  const float* prices;
+  bool operator()(uint16_t a, uint16_t b) const {
+    return prices[a] < prices[b] || (prices[a] == prices[b] && a < b);
+  }
+};
+
+}  // namespace
+
+PriceAnalysis PriceAnalyzer::analyzePrices(const PriceSeries& prices) {
+  return analyzePrices(prices, time(nullptr));
+}
+
+PriceAnalysis PriceAnalyzer::analyzePrices(const PriceSeries& prices, time_t now) {
+  AllowedSlots allowed;
+  allowed.build(prices, ALLOWED_START_HOUR * 60, ALLOWED_END_HOUR * 60);
+  SlotMask validStarts;
+  allowed.windowStarts(Window90MinAnalyzer::SLOTS, validStarts);
+  CheapestWindows windows;
+  return analyzePrices(prices, validStarts, now, windows);
+}
+
+PriceAnalysis PriceAnalyzer::analyzePrices(const PriceSeries& prices, const SlotMask& validStarts, time_t now,
+                                           CheapestWindows& windows) {
   PriceAnalysis result;
+  windows = CheapestWindows();
   
   if (prices.empty()) {
     return result;
   }
   
-  int currentIdx = findCurrentPriceIndex(prices);
+  int currentIdx = findCurrentPriceIndex(prices, now);
   if (currentIdx < 0) {
     return result;
   }
   
-  result.currentPeriodStartTime = prices[currentIdx].dateTime.substring(11, 16); // Extract HH:MM
+  result.currentPeriodStart = prices.minuteOfDay(currentIdx);
   
   // Calculate next 90 minutes average (6 periods of 15 min)
   result.next90MinAvg = calculate90MinAverage(prices, currentIdx);
   
-  // Find cheapest 90 minute period
-  Cheapest90Min cheapest = findCheapest90MinPeriod(prices);
-  result.cheapest90MinAvg = cheapest.avg;
-  if (cheapest.startIndex >= 0) {
-    result.cheapest90MinTime = prices[cheapest.startIndex].dateTime.substring(11, 16);
-    
-    // Check if cheapest period is tomorrow
-    String currentDate = prices[currentIdx].dateTime.substring(0, 10);
-    String cheapestDate = prices[cheapest.startIndex].dateTime.substring(0, 10);
-    result.cheapestIsTomorrow = (currentDate != cheapestDate);
-  }
+  // Cheapest 90 minute periods that have not started yet
+  windows = findUpcomingWindows(prices, validStarts, currentIdx);
+  setCheapest(prices, windows, currentIdx, result);
   
   // Only valid if we have both next 90min average and cheapest period
   result.valid = (result.next90MinAvg >= 0 && result.cheapest90MinAvg >= 0);
   return result;
 }
 
-int PriceAnalyzer::findCurrentPriceIndex(const std::vector<PriceEntry>& prices) {
-  time_t now = time(nullptr);
-  struct tm* timeinfo = localtime(&now);
-  
-  // Round down to nearest 15 minutes
-  int currentMinute = (timeinfo->tm_min / 15) * 15;
-  
-  char currentTimeBuf[20];
-  snprintf(currentTimeBuf, sizeof(currentTimeBuf), "%04d-%02d-%02dT%02d:%02d:00",
-           timeinfo->tm_year + 1900, timeinfo->tm_mon + 1, timeinfo->tm_mday,
-           timeinfo->tm_hour, currentMinute);
+bool PriceAnalyzer::advanceAnalysis(const PriceSeries& prices, const PricePrefixSums& sums,
+                                    const SlotMask& validStarts, time_t now,
+                                    CheapestWindows& windows, PriceAnalysis& analysis) {
+  int currentIdx = findCurrentPriceIndex(prices, now);
+  if (currentIdx < 0 || sums.count != prices.count) {
+    analysis.valid = false;
+    return false;
+  }
   
-  String currentTime = String(currentTimeBuf);
+  const int slots = Window90MinAnalyzer::SLOTS;
+  analysis.currentPeriodStart = prices.minuteOfDay(currentIdx);
+  analysis.next90MinAvg = currentIdx + slots <= prices.count
+    ? (float)((double)sums.windowSum(currentIdx, slots) / 1000000.0 / slots)
+    : -1;
   
-  // Find matching entry
-  for (size_t i = 0; i < prices.size(); i++) {
-    if (prices[i].dateTime.startsWith(currentTime.substring(0, 16))) {
-      return i;
+  // Dropping starts that have passed leaves the picks unchanged unless one
+  // of the picks is among them
+  for (int k = 0; k < windows.count; k++) {
+    if (windows.windows[k].startIndex < currentIdx) {
+      windows = findUpcomingWindows(prices, validStarts, currentIdx);
+      break;
     }
   }
+  setCheapest(prices, windows, currentIdx, analysis);
   
-  return -1;
+  analysis.valid = (analysis.next90MinAvg >= 0 && analysis.cheapest90MinAvg >= 0);
+  return analysis.valid;
+}
+
+CheapestWindows PriceAnalyzer::findUpcomingWindows(const PriceSeries& prices, const SlotMask& validStarts,
+                                                   int currentIdx) {
+  SlotMask upcoming = validStarts;
+  upcoming.clearBelow(currentIdx);
+  return findCheapestWindows(prices, upcoming, Window90MinAnalyzer::SLOTS);
 }
 
-float PriceAnalyzer::calculate90MinAverage(const std::vector<PriceEntry>& prices, int startIdx) {
-  const int periods = 6; // 6 * 15min = 90min
+void PriceAnalyzer::setCheapest(const PriceSeries& prices, const CheapestWindows& windows, int currentIdx,
+                                PriceAnalysis& analysis) {
+  int32_t today = prices.localDay(currentIdx);
+  analysis.cheapestCount = windows.count;
+  for (int k = 0; k < MAX_CHEAPEST_WINDOWS; k++) {
+    int startIdx = windows.windows[k].startIndex;
+    bool found = k < windows.count;
+    analysis.cheapestAvgs[k] = found ? windows.windows[k].avg : -1;
+    analysis.cheapestStarts[k] = found ? prices.minuteOfDay(startIdx) : -1;
+    analysis.cheapestTomorrow[k] = found && prices.localDay(startIdx) != today;
+  }
   
-  if (startIdx + periods > (int)prices.size()) {
+  analysis.cheapest90MinAvg = analysis.cheapestAvgs[0];
+  analysis.cheapest90MinStart = analysis.cheapestStarts[0];
+  analysis.cheapestIsTomorrow = analysis.cheapestTomorrow[0];
+}
+
+int PriceAnalyzer::findCurrentPriceIndex(const PriceSeries& prices) {
+  return findCurrentPriceIndex(prices, time(nullptr));
+}
+
+// Returns PriceSeries::OUTSIDE_SERIES when `now` is before or after the data
+int PriceAnalyzer::findCurrentPriceIndex(const PriceSeries& prices, time_t now) {
+  return prices.slotIndexAt(now);
+}
+
+float PriceAnalyzer::calculate90MinAverage(const PriceSeries& prices, int startIdx) {
+  return calculateAverage(prices, startIdx, Window90MinAnalyzer::SLOTS);
+}
+
+float PriceAnalyzer::calculateAverage(const PriceSeries& prices, int startIdx, int periods) {
+  if (periods <= 0 || startIdx < 0 || startIdx + periods > prices.count) {
     return -1; // Not enough data
   }
   
-  float sum = 0;
+  // Same micro-unit sum the prefix sums give, so re-analysis agrees exactly
+  int64_t sum = 0;
   for (int i = 0; i < periods; i++) {
-    sum += prices[startIdx + i].priceWithTax;
+    sum += priceToMicros(prices.prices[startIdx + i]);
   }
   
-  return sum / periods;
+  return (float)((double)sum / 1000000.0 / periods);
+}
+
+Cheapest90Min PriceAnalyzer::findCheapest90MinPeriod(const PriceSeries& prices) {
+  return Window90MinAnalyzer::findCheapest(prices);
+}
+
+Cheapest90Min PriceAnalyzer::findCheapestPeriod(const PriceSeries& prices, int periods) {
+  AllowedSlots allowed;
+  allowed.build(prices, ALLOWED_START_HOUR * 60, ALLOWED_END_HOUR * 60);
+  SlotMask validStarts;
+  allowed.windowStarts(periods, validStarts);
+  return findCheapestPeriod(prices, validStarts, periods);
 }
 
-Cheapest90Min PriceAnalyzer::findCheapest90MinPeriod(const std::vector<PriceEntry>& prices) {
-  const int periods = 6; // 6 * 15min = 90min
+Cheapest90Min PriceAnalyzer::findCheapestPeriod(const PriceSeries& prices, const SlotMask& validStarts,
+                                                int periods) {
   Cheapest90Min result;
   
-  if (prices.size() < (size_t)periods) {
+  if (periods <= 0 || prices.count < periods) {
     return result; // Not enough data
   }
   
-  float cheapestAvg = 999999.0f;
+  // Prime the window with the first (periods - 1) slots, then slide:
+  // each step adds the entering slot and drops the leaving one.
+  int64_t windowSum = 0;
+  for (int i = 0; i < periods - 1; i++) {
+    windowSum += priceToMicros(prices.prices[i]);
+  }
+  
+  int64_t cheapestSum = 0;
   int cheapestIdx = -1;
   
-  // Sliding window through all available prices
-  for (size_t i = 0; i <= prices.size() - periods; i++) {
-    float avg = calculate90MinAverage(prices, i);
-    if (avg >= 0 && avg < cheapestAvg) {
-      // Check time constraints: period must start at or after 7:00 and end at or before 23:00
-      // Extract hour and minute from start time (format: "YYYY-MM-DDTHH:MM:SS")
-      String startTime = prices[i].dateTime.substring(11, 16); // HH:MM
-      const char* startStr = startTime.c_str();
-      int startHour = (startStr[0] - '0') * 10 + (startStr[1] - '0');
-      
-      // End time is 90 minutes (6 periods) after start
-      // Last period is at index i+5, which ends 15 minutes later
-      String endTime = prices[i + periods - 1].dateTime.substring(11, 16);
-      const char* endStr = endTime.c_str();
-      int endHour = (endStr[0] - '0') * 10 + (endStr[1] - '0');
-      int endMinute = (endStr[3] - '0') * 10 + (endStr[4] - '0');
-      
-      // Add 15 minutes to end time to get actual end
-      endMinute += 15;
-      if (endMinute >= 60) {
-        endMinute -= 60;
-        endHour += 1;
-        if (endHour >= 24) {
-          endHour = 0;  // Wrap to next day
-        }
-      }
-      
-      // Check if period is within valid hours (7:00-23:00)
-      // Start must be >= 7:00
-      bool startValid = (startHour >= 7);
-      // End must be <= 23:00 and not wrap past midnight
-      bool endValid = (endHour < 23) || (endHour == 23 && endMinute == 0);
-      // If end hour is less than start hour, we've crossed midnight (invalid)
-      if (endHour < startHour) {
-        endValid = false;
-      }
-      
-      if (startValid && endValid) {
-        cheapestAvg = avg;
-        cheapestIdx = i;
-      }
+  const float* p = prices.prices;
+  for (int i = 0; i + periods <= prices.count; i++) {
+    windowSum += priceToMicros(p[i + periods - 1]);
+    if (i > 0) {
+      windowSum -= priceToMicros(p[i - 1]);
+    }
+    
+    // Time constraints (allowed hours, no midnight crossing) live in the mask
+    if (validStarts.test(i) && (cheapestIdx < 0 || windowSum < cheapestSum)) {
+      cheapestSum = windowSum;
+      cheapestIdx = i;
     }
   }
   
   if (cheapestIdx >= 0) {
-    result.avg = cheapestAvg;
+    result.avg = (float)((double)cheapestSum / 1000000.0 / periods);
     result.startIndex = cheapestIdx;
   }
   
   return result;
 }
+
+int PriceAnalyzer::maxWindowsFor(int periods) {
+  // Each pick rules out at most 2 * periods - 1 starts (itself and its
+  // overlaps), so the k-th pick is among the best (k - 1)(2 * periods - 1) + 1
+  if (periods <= 0) {
+    return 0;
+  }
+  return 1 + (MAX_WINDOW_CANDIDATES - 1) / (2 * periods - 1);
+}
+
+CheapestWindows PriceAnalyzer::findCheapestWindows(const PriceSeries& prices, int periods, int maxWindows) {
+  AllowedSlots allowed;
+  allowed.build(prices, ALLOWED_START_HOUR * 60, ALLOWED_END_HOUR * 60);
+  SlotMask validStarts;
+  allowed.windowStarts(periods, validStarts);
+  return findCheapestWindows(prices, validStarts, periods, maxWindows);
+}
+
+CheapestWindows PriceAnalyzer::findCheapestWindows(const PriceSeries& prices, const SlotMask& validStarts,
+                                                   int periods, int maxWindows) {
+  CheapestWindows result;
+  
+  maxWindows = std::min(maxWindows, std::min(MAX_CHEAPEST_WINDOWS, maxWindowsFor(periods)));
+  if (maxWindows <= 0 || prices.count < periods) {
+    return result;
+  }
+  
+  // Greedy selection only ever reaches this many of the cheapest starts
+  const int keep = (maxWindows - 1) * (2 * periods - 1) + 1;
+  
+  // Pass 1: rolling sums, keeping the `keep` cheapest starts in a max-heap
+  // whose top is the most expensive candidate kept so far
+  WindowCandidate heap[MAX_WINDOW_CANDIDATES];
+  int heapSize = 0;
+  
+  int64_t windowSum = 0;
+  for (int i = 0; i < periods - 1; i++) {
+    windowSum += priceToMicros(prices.prices[i]);
+  }
+  
+  const float* p = prices.prices;
+  for (int i = 0; i + periods <= prices.count; i++) {
+    windowSum += priceToMicros(p[i + periods - 1]);
+    if (i > 0) {
+      windowSum -= priceToMicros(p[i - 1]);
+    }
+    if (!validStarts.test(i)) {
+      continue;
+    }
+    
+    WindowCandidate candidate = {windowSum, i};
+    if (heapSize < keep) {
+      heap[heapSize++] = candidate;
+      std::push_heap(heap, heap + heapSize, cheaperCandidate);
+    } else if (cheaperCandidate(candidate, heap[0])) {
+      std::pop_heap(heap, heap + heapSize, cheaperCandidate);
+      heap[heapSize - 1] = candidate;
+      std::push_heap(heap, heap + heapSize, cheaperCandidate);
+    }
+  }
+  
+  // Pass 2: cheapest first, skipping candidates that overlap an earlier pick
+  std::sort_heap(heap, heap + heapSize, cheaperCandidate);
+  for (int c = 0; c < heapSize && result.count < maxWindows; c++) {
+    bool overlaps = false;
+    for (int k = 0; k < result.count; k++) {
+      int gap = heap[c].start - result.windows[k].startIndex;
+      if (gap < periods && gap > -periods) {
+        overlaps = true;
+        break;
+      }
+    }
+    if (!overlaps) {
+      CheapestWindow& window = result.windows[result.count++];
+      window.startIndex = heap[c].start;
+      window.avg = (float)((double)heap[c].sum / 1000000.0 / periods);
+    }
+  }
+  
+  return result;
+}
+
+CheapestSlots PriceAnalyzer::findCheapestSlots(const PriceSeries& prices, time_t now, time_t deadline,
+                                               int slotCount) {
+  CheapestSlots result;
+  if (prices.empty() || slotCount <= 0) {
+    return result;
+  }
+  
+  // Slots [first, last): the current one is still usable, the last must end by the deadline
+  int first = now <= prices.baseEpoch ? 0 : (int)((now - prices.baseEpoch) / prices.slotSeconds);
+  int last = deadline <= prices.baseEpoch ? 0 : (int)std::min<time_t>(
+    (deadline - prices.baseEpoch) / prices.slotSeconds, prices.count);
+  if (first >= last) {
+    return result;
+  }
+  
+  static_assert(PriceSeries::MAX_SLOTS <= 65536, "slot indices are stored as uint16_t");
+  uint16_t order[PriceSeries::MAX_SLOTS];
+  int available = last - first;
+  for (int i = 0; i < available; i++) {
+    order[i] = (uint16_t)(first + i);
+  }
+  
+  // Partition so the `picked` cheapest come first, in no particular order
+  int picked = std::min(slotCount, available);
+  CheaperSlot cheaper = {prices.prices};
+  if (picked < available) {
+    std::nth_element(order, order + picked, order + available, cheaper);
+  }
+  
+  int64_t sum = 0;
+  for (int i = 0; i < picked; i++) {
+    result.slots.set(order[i]);
+    sum += priceToMicros(prices.prices[order[i]]);
+  }
+  result.count = picked;
+  result.avg = (float)((double)sum / 1000000.0 / picked);
+  return result;
+}
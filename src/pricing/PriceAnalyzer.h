@@ -1,17 +1,72 @@
 #ifndef PRICE_ANALYZER_H
 #define PRICE_ANALYZER_H
 
-#include <vector>
 #include "PriceData.h"
+#include "FixedWindowAnalyzer.h"
+#include "SlotMask.h"
+#include "WindowPlanner.h"
+
+// The display's 90-minute window (6 x 15 min) within the allowed hours
+typedef FixedWindowAnalyzer<6, ALLOWED_START_HOUR, ALLOWED_END_HOUR> Window90MinAnalyzer;
+
+// Slots picked for a load that can run in any order, e.g. EV charging
+struct CheapestSlots {
+  SlotMask slots;  // Bit i set when slot i is picked
+  int count;       // Slots picked; fewer than asked if the range is too short
+  float avg;       // Average price of the picked slots, -1 when none
+  
+  CheapestSlots() : count(0), avg(-1) {}
+};
 
 class PriceAnalyzer {
 public:
-  static PriceAnalysis analyzePrices(const std::vector<PriceEntry>& prices);
+  // Heap capacity for findCheapestWindows; see maxWindowsFor()
+  static constexpr int MAX_WINDOW_CANDIDATES = 64;
+  
+  static PriceAnalysis analyzePrices(const PriceSeries& prices);
+  static PriceAnalysis analyzePrices(const PriceSeries& prices, time_t now);
+  // Full analysis against a prebuilt mask of valid 90-minute starts; also
+  // returns the cheapest windows by index for advanceAnalysis()
+  static PriceAnalysis analyzePrices(const PriceSeries& prices, const SlotMask& validStarts, time_t now,
+                                     CheapestWindows& windows);
+  
+  // Moves an earlier analysis of the same series to `now`. Constant time:
+  // the next-90 average comes from the prefix sums and the cheapest windows
+  // are searched again only once one of them has started. Returns the new
+  // validity; false also when `now` is outside the series.
+  static bool advanceAnalysis(const PriceSeries& prices, const PricePrefixSums& sums,
+                              const SlotMask& validStarts, time_t now,
+                              CheapestWindows& windows, PriceAnalysis& analysis);
+  
+  // Up to maxWindows cheapest valid windows that do not share a slot, cheapest
+  // first, ties to the earlier start. Keeps only the best candidates in a
+  // bounded heap, so it runs in O(n log K) with no allocation.
+  static CheapestWindows findCheapestWindows(const PriceSeries& prices, int periods,
+                                             int maxWindows = MAX_CHEAPEST_WINDOWS);
+  static CheapestWindows findCheapestWindows(const PriceSeries& prices, const SlotMask& validStarts,
+                                             int periods, int maxWindows = MAX_CHEAPEST_WINDOWS);
+  
+  // The slotCount cheapest slots, not necessarily adjacent, among those
+  // that have not ended at `now` and end by `deadline`. Equal prices go to
+  // the earlier slot. Linear-time selection over at most one series.
+  static CheapestSlots findCheapestSlots(const PriceSeries& prices, time_t now, time_t deadline, int slotCount);
+  
+  // Most windows findCheapestWindows can pick for this length within the heap capacity
+  static int maxWindowsFor(int periods);
   
   // Exposed for testing
-  static float calculate90MinAverage(const std::vector<PriceEntry>& prices, int startIdx);
-  static Cheapest90Min findCheapest90MinPeriod(const std::vector<PriceEntry>& prices);
-  static int findCurrentPriceIndex(const std::vector<PriceEntry>& prices);
+  static float calculate90MinAverage(const PriceSeries& prices, int startIdx);
+  static float calculateAverage(const PriceSeries& prices, int startIdx, int periods);
+  static Cheapest90Min findCheapest90MinPeriod(const PriceSeries& prices);
+  static Cheapest90Min findCheapestPeriod(const PriceSeries& prices, int periods);
+  static Cheapest90Min findCheapestPeriod(const PriceSeries& prices, const SlotMask& validStarts, int periods);
+  static int findCurrentPriceIndex(const PriceSeries& prices);
+  static int findCurrentPriceIndex(const PriceSeries& prices, time_t now);
+
+private:
+  static CheapestWindows findUpcomingWindows(const PriceSeries& prices, const SlotMask& validStarts, int currentIdx);
+  static void setCheapest(const PriceSeries& prices, const CheapestWindows& windows, int currentIdx,
+                          PriceAnalysis& analysis);
 };
 
 #endif
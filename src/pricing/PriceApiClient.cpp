@@ -1,36 +1,157 @@
 #include "PriceApiClient.h"
-#ifndef WiFi_h
-#include <WiFi.h>
-#endif
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+// "host[:port]" of an absolute URL; sessions are kept per server
+String urlAuthority(const char* url) {
+  String text(url);
+  int start = text.indexOf("://");
+  start = start < 0 ? 0 : start + 3;
+  int end = text.indexOf('/', start);
+  return end < 0 ? text.substring(start) : text.substring(start, end);
+}
+
+// Port of an authority from urlAuthority(), or the scheme's default
+uint16_t authorityPort(const String& authority, const char* url) {
+  int colon = authority.indexOf(':');
+  if (colon >= 0) {
+    return (uint16_t)atoi(authority.c_str() + colon + 1);
+  }
+  return strncmp(url, "http://", 7) == 0 ? 80 : 443;
+}
+
+}  // namespace
+
+// The window is taken from the heap at the first streamed fetch, while the
+// heap is still whole, and kept: allocating it per fetch churned the heap
+// and, once fragmented, left fetches uncompressed. A device fetching from
+// the LAN aggregator never reserves it. Without it the body is asked for
+// uncompressed.
+bool PriceApiClient::reserveInflateWindow() {
+  if (!inflateWindow) {
+    inflateWindow = new (std::nothrow) uint8_t[InflateBodyReader::WINDOW_SIZE];
+  }
+  return inflateWindow != nullptr;
+}
+
+// Sends the GET and returns true when a body follows. Otherwise fills in
+// the error, or marks the response not modified, and ends the request.
+bool PriceApiClient::beginGet(ConditionalGet& get, HTTPClient& http, ResumableTlsClient& client, const char* url,
+                              ApiResponse& response, bool acceptCompressed, FetchBudget* budget) {
+  client.setInsecure();
+  
+  String host = urlAuthority(url);
+  bool offered = false;
+  if (sessions) {
+    size_t length = 0;
+    const uint8_t* saved = sessions->find(host.c_str(), length);
+    offered = saved && client.setSession(saved, length);
+  }
+
+  if (!get.begin(client, "Content-Encoding")) {
+    return false;
+  }
+  if (acceptCompressed) {
+    http.addHeader("Accept-Encoding", "gzip, deflate");
+  }
+
+  if (budget) {
+    // Connected here, stage by stage, rather than inside GET(), which then
+    // reuses the connection. A connection that fails counts as GET() failing.
+    int colon = host.indexOf(':');
+    String name = colon < 0 ? host : host.substring(0, colon);
+    if (!client.connect(name.c_str(), authorityPort(host, url), *budget)) {
+      response.httpCode = -1;
+      rememberSession(client, host, offered, response);
+      return get.fail(budget->exhausted() ? timedOutError(*budget) : String("Connection failed"));
+    }
+    unsigned long responseMs = budget->begin(FetchBudget::RESPONSE);
+    http.setTimeout(FetchBudget::httpTimeout(responseMs));
+  }
+
+  get.send();
+  rememberSession(client, host, offered, response);
+  return get.bodyFollows(budget);
+}
+
+// Reports the handshake and keeps the session it produced for next time
+void PriceApiClient::rememberSession(ResumableTlsClient& client, const String& host, bool offered,
+                                     ApiResponse& response) {
+  response.tlsHandshakeMicros = client.handshakeMicros();
+  response.tlsResumed = client.sessionResumed();
+  if (!sessions) {
+    return;
+  }
+  if (response.httpCode < 0) {
+    // No connection; if a session was offered, do not offer it again
+    if (offered) {
+      sessions->forget();
+    }
+    return;
+  }
+  // Static: 2 KB would sit on the loop task's stack next to the live TLS context
+  static uint8_t session[TlsSessionCache::MAX_SESSION_BYTES];
+  size_t length = client.getSession(session, sizeof(session));
+  if (length > 0) {
+    sessions->store(host.c_str(), session, length);
+  }
+}
+
+void PriceApiClient::clearValidators() {
+  validators.clear();
+}
 
 PriceApiClient::ApiResponse PriceApiClient::fetchJson(const char* url) {
   ApiResponse response;
-  response.success = false;
-  response.httpCode = 0;
+  ResumableTlsClient client;
+  HTTPClient http;
+  ConditionalGet get(http, validators, url, response);
 
-  if (WiFi.status() != WL_CONNECTED) {
-    response.error = "No WiFi connection";
-    return response;
+  if (beginGet(get, http, client, url, response)) {
+    response.payload = http.getString();
+    get.finish(nullptr);
   }
+  return response;
+}
 
-  WiFiClientSecure client;
-  client.setInsecure();
+// The handler parses while bytes arrive; nothing is buffered beyond the
+// socket's own receive window and, for a compressed body, the inflate window
+PriceApiClient::ApiResponse PriceApiClient::streamJson(const char* url, BodyHandler& handler,
+                                                       FetchBudget* budget) {
+  ApiResponse response;
+  ResumableTlsClient client;
   HTTPClient http;
+  ConditionalGet get(http, validators, url, response);
 
-  if (!http.begin(client, url)) {
-    response.error = "HTTP begin failed";
+  if (!beginGet(get, http, client, url, response, reserveInflateWindow(), budget) || !get.beginBody(budget)) {
     return response;
   }
 
-  response.httpCode = http.GET();
-  if (response.httpCode != 200) {
-    response.error = String("HTTP error ") + String(response.httpCode);
-    http.end();
+  StreamBodyReader socket(http.getStream(), budget);
+  String encoding = http.header("Content-Encoding");
+  if (encoding.length() == 0 || encoding.equalsIgnoreCase("identity")) {
+    handler.handleBody(socket);
+  } else if (inflateWindow && (encoding.equalsIgnoreCase("gzip") || encoding.equalsIgnoreCase("deflate"))) {
+    InflateBodyReader body(socket, encoding.equalsIgnoreCase("gzip") ? InflateBodyReader::GZIP
+                                                                     : InflateBodyReader::DEFLATE,
+                           inflateWindow);
+    handler.handleBody(body);
+    // The parser stops at the closing bracket; the checksum comes after it
+    while (body.read() >= 0) {
+    }
+    response.compressedBytes = body.compressedBytes();
+    response.inflatedBytes = body.inflatedBytes();
+    if (!body.intact()) {
+      get.fail(budget && budget->exhausted() ? timedOutError(*budget) : String("Corrupt compressed body"));
+      return response;
+    }
+  } else {
+    get.fail(String("Unsupported Content-Encoding ") + encoding);
     return response;
   }
-
-  response.payload = http.getString();
-  http.end();
-  response.success = true;
+  get.finish(budget);
   return response;
 }
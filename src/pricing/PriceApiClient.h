@@ -4,17 +4,44 @@
 #ifndef WString_h
 #include <WString.h>
 #endif
-#ifndef WIFI_CLIENT_SECURE_H
-#include <WiFiClientSecure.h>
+#ifndef RESUMABLE_TLS_CLIENT_H
+#include "ResumableTlsClient.h"
 #endif
 #ifndef HTTP_CLIENT_H
 #include <HTTPClient.h>
 #endif
+#include "ConditionalGet.h"
+#include "FetchBudget.h"
+#include "HttpValidators.h"
 #include "IApiClient.h"
+#include "InflateBodyReader.h"
+#include "StreamBodyReader.h"
+#include "TlsSessionCache.h"
 
 class PriceApiClient : public IApiClient {
 public:
+  // Without a session cache every connection makes a full TLS handshake
+  explicit PriceApiClient(TlsSessionCache* sessionCache = nullptr)
+    : sessions(sessionCache), inflateWindow(nullptr) {}
+  ~PriceApiClient() { delete[] inflateWindow; }
+  
   ApiResponse fetchJson(const char* url) override;
+  ApiResponse streamJson(const char* url, BodyHandler& handler, FetchBudget* budget = nullptr) override;
+  void clearValidators() override;
+
+private:
+  bool beginGet(ConditionalGet& get, HTTPClient& http, ResumableTlsClient& client, const char* url,
+                ApiResponse& response, bool acceptCompressed = false, FetchBudget* budget = nullptr);
+  void rememberSession(ResumableTlsClient& client, const String& host, bool offered, ApiResponse& response);
+
+  PriceApiClient(const PriceApiClient&) = delete;
+  PriceApiClient& operator=(const PriceApiClient&) = delete;
+
+  bool reserveInflateWindow();
+
+  TlsSessionCache* sessions;
+  HttpValidators validators;
+  uint8_t* inflateWindow;  // 32 KB with the default INFLATE_WINDOW_BITS, from the first streamed fetch
 };
 
 #endif
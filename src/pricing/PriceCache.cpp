@@ -0,0 +1,203 @@
+#include "PriceCache.h"
+#include <string.h>
+#include "../util/Checksum.h"
+
+namespace {
+
+class Writer {
+public:
+  Writer(uint8_t* out, size_t capacity) : out(out), capacity(capacity), pos(0), overflow(false) {}
+
+  void u8(uint8_t value) { bytes(&value, 1); }
+  void u16(uint16_t value) { uint(value, 2); }
+  void u32(uint32_t value) { uint(value, 4); }
+  void i16(int value) { uint((uint16_t)(int16_t)value, 2); }
+  void i32(int32_t value) { uint((uint32_t)value, 4); }
+  void i64(int64_t value) { uint((uint64_t)value, 8); }
+  void f32(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    u32(bits);
+  }
+
+  size_t length() const { return overflow ? 0 : pos; }
+  uint8_t* at(size_t offset) { return out + offset; }
+
+private:
+  void uint(uint64_t value, int size) {
+    uint8_t le[8];
+    for (int i = 0; i < size; i++) {
+      le[i] = (uint8_t)(value >> (8 * i));
+    }
+    bytes(le, size);
+  }
+
+  void bytes(const uint8_t* data, size_t size) {
+    if (overflow || capacity - pos < size) {
+      overflow = true;
+      return;
+    }
+    memcpy(out + pos, data, size);
+    pos += size;
+  }
+
+  uint8_t* out;
+  size_t capacity;
+  size_t pos;
+  bool overflow;
+};
+
+class Reader {
+public:
+  Reader(const uint8_t* data, size_t length) : data(data), length(length), pos(0), underflow(false) {}
+
+  uint8_t u8() { return (uint8_t)uint(1); }
+  uint16_t u16() { return (uint16_t)uint(2); }
+  uint32_t u32() { return (uint32_t)uint(4); }
+  int16_t i16() { return (int16_t)(uint16_t)uint(2); }
+  int32_t i32() { return (int32_t)(uint32_t)uint(4); }
+  int64_t i64() { return (int64_t)uint(8); }
+  float f32() {
+    uint32_t bits = u32();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  bool ok() const { return !underflow; }
+  bool atEnd() const { return !underflow && pos == length; }
+
+private:
+  uint64_t uint(int size) {
+    if (underflow || length - pos < (size_t)size) {
+      underflow = true;
+      return 0;
+    }
+    uint64_t value = 0;
+    for (int i = 0; i < size; i++) {
+      value |= (uint64_t)data[pos + i] << (8 * i);
+    }
+    pos += size;
+    return value;
+  }
+
+  const uint8_t* data;
+  size_t length;
+  size_t pos;
+  bool underflow;
+};
+
+}  // namespace
+
+size_t PriceCache::encode(const PriceSeries& series, const PriceAnalysis& analysis, time_t fetchedAt,
+                          uint8_t* out, size_t capacity) {
+  Writer writer(out, capacity);
+  writer.u32(MAGIC);
+  writer.u16(VERSION);
+  writer.u16(0);  // Payload length, filled in below
+  writer.u32(0);  // Checksum
+
+  writer.i64(fetchedAt);
+
+  writer.i64(series.baseEpoch);
+  writer.i32(series.slotSeconds);
+  writer.i16(series.utcOffsetMin);
+  writer.i16(series.altOffsetMin);
+  writer.i16(series.dstSwitchIndex);
+  writer.i16(series.count);
+  for (int i = 0; i < series.count; i++) {
+    writer.f32(series.prices[i]);
+  }
+
+  writer.u8((analysis.valid ? 1 : 0) | (analysis.cheapestIsTomorrow ? 2 : 0));
+  writer.f32(analysis.next90MinAvg);
+  writer.f32(analysis.cheapest90MinAvg);
+  writer.i16(analysis.cheapest90MinStart);
+  writer.i16(analysis.currentPeriodStart);
+  writer.i16(analysis.lastFetchTime);
+  writer.u8((uint8_t)analysis.cheapestCount);
+  for (int k = 0; k < MAX_CHEAPEST_WINDOWS; k++) {
+    writer.f32(analysis.cheapestAvgs[k]);
+    writer.i16(analysis.cheapestStarts[k]);
+    writer.u8(analysis.cheapestTomorrow[k] ? 1 : 0);
+  }
+
+  size_t length = writer.length();
+  if (length == 0 || length - HEADER_BYTES > 0xFFFF) {
+    return 0;
+  }
+  Writer header(out, HEADER_BYTES);
+  header.u32(MAGIC);
+  header.u16(VERSION);
+  header.u16((uint16_t)(length - HEADER_BYTES));
+  header.u32(Checksum::fnv1a(out + HEADER_BYTES, length - HEADER_BYTES));
+  return length;
+}
+
+size_t PriceCache::encodedLength(const uint8_t* header) {
+  Reader reader(header, HEADER_BYTES);
+  uint32_t magic = reader.u32();
+  uint16_t version = reader.u16();
+  uint16_t payloadLength = reader.u16();
+  if (magic != MAGIC || version != VERSION || HEADER_BYTES + payloadLength > MAX_BYTES) {
+    return 0;
+  }
+  return HEADER_BYTES + payloadLength;
+}
+
+bool PriceCache::decode(const uint8_t* data, size_t length, Contents& contents) {
+  Reader header(data, length);
+  uint32_t magic = header.u32();
+  uint16_t version = header.u16();
+  uint16_t payloadLength = header.u16();
+  uint32_t checksum = header.u32();
+  if (!header.ok() || magic != MAGIC || version != VERSION ||
+      length != HEADER_BYTES + payloadLength ||
+      Checksum::fnv1a(data + HEADER_BYTES, payloadLength) != checksum) {
+    return false;
+  }
+
+  Reader reader(data + HEADER_BYTES, payloadLength);
+  time_t fetchedAt = (time_t)reader.i64();
+
+  PriceSeries series;
+  series.baseEpoch = (time_t)reader.i64();
+  series.slotSeconds = reader.i32();
+  series.utcOffsetMin = reader.i16();
+  series.altOffsetMin = reader.i16();
+  series.dstSwitchIndex = reader.i16();
+  series.count = reader.i16();
+  // Written by another build, or not by us at all
+  if (!reader.ok() || series.count < 0 || series.count > PriceSeries::MAX_SLOTS ||
+      series.slotSeconds <= 0 || series.dstSwitchIndex < 0 ||
+      series.dstSwitchIndex > PriceSeries::MAX_SLOTS) {
+    return false;
+  }
+  for (int i = 0; i < series.count; i++) {
+    series.prices[i] = reader.f32();
+  }
+
+  PriceAnalysis analysis;
+  uint8_t flags = reader.u8();
+  analysis.valid = (flags & 1) != 0;
+  analysis.cheapestIsTomorrow = (flags & 2) != 0;
+  analysis.next90MinAvg = reader.f32();
+  analysis.cheapest90MinAvg = reader.f32();
+  analysis.cheapest90MinStart = reader.i16();
+  analysis.currentPeriodStart = reader.i16();
+  analysis.lastFetchTime = reader.i16();
+  analysis.cheapestCount = reader.u8();
+  for (int k = 0; k < MAX_CHEAPEST_WINDOWS; k++) {
+    analysis.cheapestAvgs[k] = reader.f32();
+    analysis.cheapestStarts[k] = reader.i16();
+    analysis.cheapestTomorrow[k] = reader.u8() != 0;
+  }
+  if (!reader.atEnd() || analysis.cheapestCount > MAX_CHEAPEST_WINDOWS) {
+    return false;
+  }
+
+  contents.series = series;
+  contents.analysis = analysis;
+  contents.fetchedAt = fetchedAt;
+  return true;
+}
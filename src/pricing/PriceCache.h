@@ -0,0 +1,48 @@
+#ifndef PRICE_CACHE_H
+#define PRICE_CACHE_H
+
+#include "PriceData.h"
+
+/**
+ * Binary image of the price series and the last analysis, so a reset can
+ * show prices again without the network. Fields are written one by one in
+ * little-endian order rather than as struct dumps, so the format does not
+ * depend on padding or on MAX_SLOTS.
+ *
+ * Header: magic, version, payload length, FNV-1a of the payload. A copy
+ * with another version, a torn write or a flipped bit fails to decode and
+ * the caller fetches instead.
+ */
+class PriceCache {
+public:
+  static constexpr uint32_t MAGIC = 0x53485043;  // "SHPC"
+  // First byte of an encoded image; 'C', which no JSON body starts with
+  static constexpr uint8_t FIRST_BYTE = (uint8_t)MAGIC;
+  static constexpr uint16_t VERSION = 1;
+  static constexpr size_t HEADER_BYTES = 4 + 2 + 2 + 4;
+  static constexpr size_t SERIES_BYTES = 8 + 4 + 2 + 2 + 2 + 2;  // Without prices
+  static constexpr size_t WINDOW_BYTES = 4 + 2 + 1;
+  static constexpr size_t ANALYSIS_BYTES = 1 + 4 + 4 + 2 + 2 + 2 + 1 + MAX_CHEAPEST_WINDOWS * WINDOW_BYTES;
+  // fetchedAt, series, prices, analysis
+  static constexpr size_t MAX_BYTES = HEADER_BYTES + 8 + SERIES_BYTES +
+                                      PriceSeries::MAX_SLOTS * 4 + ANALYSIS_BYTES;
+
+  struct Contents {
+    PriceSeries series;
+    PriceAnalysis analysis;
+    time_t fetchedAt;  // Last fetch attempt, UTC seconds
+
+    Contents() : fetchedAt(0) {}
+  };
+
+  // Returns the encoded length, or 0 if it does not fit in capacity
+  static size_t encode(const PriceSeries& series, const PriceAnalysis& analysis, time_t fetchedAt,
+                       uint8_t* out, size_t capacity);
+  // Length of the whole image from its first HEADER_BYTES, or 0 when they
+  // are not a header of this version; lets a reader take no more than that
+  static size_t encodedLength(const uint8_t* header);
+  // Fills `contents` only from a complete, intact copy of this version
+  static bool decode(const uint8_t* data, size_t length, Contents& contents);
+};
+
+#endif
@@ -1,32 +1,175 @@
 #ifndef PRICE_DATA_H
 #define PRICE_DATA_H
 
-#ifndef WString_h
-  #include <WString.h>
-#endif
+#include "PriceTime.h"
+#include "../util/Checksum.h"
 
 struct PriceEntry {
-  String dateTime;
+  time_t epoch;          // Slot start, UTC seconds
+  int16_t utcOffsetMin;  // Offset the API published the slot with (+120 / +180)
   float priceWithTax;
+  
+  PriceEntry() : epoch(0), utcOffsetMin(0), priceWithTax(0) {}
+  PriceEntry(time_t slotEpoch, int16_t offsetMin, float price)
+    : epoch(slotEpoch), utcOffsetMin(offsetMin), priceWithTax(price) {}
+  // Parses an ISO-8601 timestamp; epoch stays 0 if it is malformed
+  PriceEntry(const char* isoDateTime, float price) : epoch(0), utcOffsetMin(0), priceWithTax(price) {
+    PriceTime::parseIso8601(isoDateTime, epoch, utcOffsetMin);
+  }
+  
+  int32_t localDay() const { return PriceTime::localDay(epoch, utcOffsetMin); }
+  int minuteOfDay() const { return PriceTime::localMinuteOfDay(epoch, utcOffsetMin); }
 };
 
-struct Cheapest90Min {
+// Prices are summed in integer micro-units so running sums never drift and
+// equal windows compare equal no matter where they start.
+inline int64_t priceToMicros(float price) {
+  return (int64_t)(price * 1000000.0f + (price < 0 ? -0.5f : 0.5f));
+}
+
+// Today + tomorrow, with room for a 25-hour (100-slot) DST day.
+// Host benchmarks raise this to hold long synthetic series.
+#ifndef PRICE_SERIES_MAX_SLOTS
+#define PRICE_SERIES_MAX_SLOTS 200
+#endif
+
+/**
+ * Contiguous, fixed-capacity price series.
+ * Slot i starts at baseEpoch + i * slotSeconds; prices live in one flat array
+ * so scans are cache-friendly and a fetch never touches the heap.
+ * At most one UTC offset change (DST switch) is stored, since the series
+ * never spans more than two local days.
+ */
+struct PriceSeries {
+  static constexpr int MAX_SLOTS = PRICE_SERIES_MAX_SLOTS;
+  static constexpr int DEFAULT_SLOT_SECONDS = 900;
+  static constexpr int OUTSIDE_SERIES = -1;  // slotIndexAt() result for instants not covered
+  
+  time_t baseEpoch;        // Start of slot 0, UTC seconds
+  int32_t slotSeconds;     // Slot length (900 for 15-minute data)
+  int16_t utcOffsetMin;    // Offset in effect at slot 0
+  int16_t altOffsetMin;    // Offset from dstSwitchIndex onwards
+  int dstSwitchIndex;      // First slot using altOffsetMin (MAX_SLOTS if no switch)
+  int count;
+  float prices[MAX_SLOTS];
+  
+  PriceSeries() { clear(); }
+  
+  void clear() {
+    baseEpoch = 0;
+    slotSeconds = DEFAULT_SLOT_SECONDS;
+    utcOffsetMin = 0;
+    altOffsetMin = 0;
+    dstSwitchIndex = MAX_SLOTS;
+    count = 0;
+  }
+  
+  bool empty() const { return count == 0; }
+  int size() const { return count; }
+  
+  // Appends the next slot. Fails when full or when the entry is not
+  // exactly one slot after the previous one (gap, duplicate, out of order).
+  bool append(const PriceEntry& entry) {
+    if (count >= MAX_SLOTS) return false;
+    
+    if (count == 0) {
+      baseEpoch = entry.epoch;
+      utcOffsetMin = entry.utcOffsetMin;
+      altOffsetMin = entry.utcOffsetMin;
+    } else if (count == 1) {
+      time_t step = entry.epoch - baseEpoch;
+      if (step <= 0 || step > 24 * 3600) return false;
+      slotSeconds = (int32_t)step;
+    } else if (entry.epoch != slotEpoch(count)) {
+      return false;
+    }
+    
+    if (entry.utcOffsetMin != offsetAt(count)) {
+      if (dstSwitchIndex < count) return false;  // Only one switch fits
+      dstSwitchIndex = count;
+      altOffsetMin = entry.utcOffsetMin;
+    }
+    
+    prices[count++] = entry.priceWithTax;
+    return true;
+  }
+  
+  // Index of the slot containing a UTC instant. Slots are contiguous in UTC,
+  // so this holds across DST switches without consulting the offsets.
+  int slotIndexAt(time_t epoch) const {
+    if (count == 0 || epoch < baseEpoch) return OUTSIDE_SERIES;
+    time_t index = (epoch - baseEpoch) / slotSeconds;
+    return index < count ? (int)index : OUTSIDE_SERIES;
+  }
+  
+  time_t slotEpoch(int i) const { return baseEpoch + (time_t)i * slotSeconds; }
+  int16_t offsetAt(int i) const { return i < dstSwitchIndex ? utcOffsetMin : altOffsetMin; }
+  int32_t localDay(int i) const { return PriceTime::localDay(slotEpoch(i), offsetAt(i)); }
+  int minuteOfDay(int i) const { return PriceTime::localMinuteOfDay(slotEpoch(i), offsetAt(i)); }
+  int slotMinutes() const { return slotSeconds / 60; }
+  
+  // FNV-1a over the slot layout and prices: tells a refetch of the same
+  // data apart from a new series without keeping a second copy
+  uint32_t checksum() const {
+    int64_t base = baseEpoch;
+    uint32_t hash = Checksum::fnv1a(&base, sizeof(base));
+    hash = Checksum::fnv1a(&slotSeconds, sizeof(slotSeconds), hash);
+    hash = Checksum::fnv1a(&utcOffsetMin, sizeof(utcOffsetMin), hash);
+    hash = Checksum::fnv1a(&altOffsetMin, sizeof(altOffsetMin), hash);
+    hash = Checksum::fnv1a(&dstSwitchIndex, sizeof(dstSwitchIndex), hash);
+    hash = Checksum::fnv1a(&count, sizeof(count), hash);
+    return Checksum::fnv1a(prices, sizeof(float) * count, hash);
+  }
+};
+
+// Appliances may start from 7:00 and must finish by 23:00 local time
+constexpr int ALLOWED_START_HOUR = 7;
+constexpr int ALLOWED_END_HOUR = 23;
+
+struct CheapestWindow {
   float avg;
   int startIndex;  // Index in prices array where cheapest period starts
   
-  Cheapest90Min() : avg(-1), startIndex(-1) {}
+  CheapestWindow() : avg(-1), startIndex(-1) {}
+};
+
+typedef CheapestWindow Cheapest90Min;
+
+// How many non-overlapping cheap windows the analysis keeps
+constexpr int MAX_CHEAPEST_WINDOWS = 3;
+
+// Cheapest non-overlapping windows, cheapest first
+struct CheapestWindows {
+  CheapestWindow windows[MAX_CHEAPEST_WINDOWS];
+  int count;
+  
+  CheapestWindows() : count(0) {}
 };
 
 struct PriceAnalysis {
   float next90MinAvg;
   float cheapest90MinAvg;
-  String cheapest90MinTime;
-  String currentPeriodStartTime;          // Current period start time (HH:MM)
-  String lastFetchTime;       // When data was last fetched (HH:MM)
+  int cheapest90MinStart;     // Cheapest period start (minutes since local midnight)
+  int currentPeriodStart;     // Current period start (minutes since local midnight)
+  int lastFetchTime;          // When data was last fetched (minutes since local midnight)
   bool cheapestIsTomorrow;
   bool valid;
   
-  PriceAnalysis() : next90MinAvg(-1), cheapest90MinAvg(-1), cheapestIsTomorrow(false), valid(false) {}
+  // Best non-overlapping 90-minute periods, cheapest first; entry 0 repeats the fields above
+  int cheapestCount;
+  float cheapestAvgs[MAX_CHEAPEST_WINDOWS];
+  int cheapestStarts[MAX_CHEAPEST_WINDOWS];       // Minutes since local midnight
+  bool cheapestTomorrow[MAX_CHEAPEST_WINDOWS];
+  
+  PriceAnalysis() : next90MinAvg(-1), cheapest90MinAvg(-1), cheapest90MinStart(-1),
+                    currentPeriodStart(-1), lastFetchTime(-1), cheapestIsTomorrow(false), valid(false),
+                    cheapestCount(0) {
+    for (int k = 0; k < MAX_CHEAPEST_WINDOWS; k++) {
+      cheapestAvgs[k] = -1;
+      cheapestStarts[k] = -1;
+      cheapestTomorrow[k] = false;
+    }
+  }
 };
 
 #endif
@@ -0,0 +1,30 @@
+#ifndef PRICE_JSON_FILTER_H
+#define PRICE_JSON_FILTER_H
+
+#include <ArduinoJson.h>
+
+/**
+ * ArduinoJson filter keeping only the fields a price entry is built from.
+ * Rank, PriceNoTax and anything else the API adds are dropped while the
+ * input is read, so they never take space in the document.
+ */
+class PriceJsonFilter {
+public:
+  // Filter for one entry object, or with wholeArray for an array of them
+  explicit PriceJsonFilter(bool wholeArray = false) {
+    if (wholeArray) {
+      filter[0]["DateTime"] = true;
+      filter[0]["PriceWithTax"] = true;
+    } else {
+      filter["DateTime"] = true;
+      filter["PriceWithTax"] = true;
+    }
+  }
+
+  DeserializationOption::Filter option() const { return DeserializationOption::Filter(filter); }
+
+private:
+  JsonDocument filter;
+};
+
+#endif
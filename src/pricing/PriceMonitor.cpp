@@ -1,48 +1,165 @@
 #include "PriceMonitor.h"
 #include "PriceAnalyzer.h"
+#include "SpotPriceTokenizer.h"
+#include "PriceJsonFilter.h"
+#include "PriceCache.h"
 #include <ArduinoJson.h>
 #include <time.h>
-#include <vector>
 
-PriceMonitor::PriceMonitor(IDisplay* displayMgr, IApiClient* client) 
-  : display(displayMgr), apiClient(client) {}
+PriceMonitor::PriceMonitor(IDisplay* displayMgr, IApiClient* client, IPriceStorage* priceStorage) 
+  : display(displayMgr), apiClient(client), storage(priceStorage) {}
 
-std::vector<PriceEntry> PriceMonitor::parseJsonToEntries(const String& json) {
-  std::vector<PriceEntry> prices;
-  
+namespace {
+
+int nextToken(BodyReader& body) {
+  int c;
+  do {
+    c = body.read();
+  } while (c == ' ' || c == '\n' || c == '\r' || c == '\t');
+  return c;
+}
+
+// Timestamps are parsed here once; everything downstream uses integers
+bool readEntry(JsonObject obj, PriceEntry& entry) {
+  const char* dt = obj["DateTime"];
+  if (!PriceTime::parseIso8601(dt, entry.epoch, entry.utcOffsetMin)) {
+    Serial.printf("Skipping entry with bad DateTime: %s\n", dt ? dt : "(null)");
+    return false;
+  }
+  entry.priceWithTax = obj["PriceWithTax"].as<float>();
+  return true;
+}
+
+// Built on first use and kept; the fields it drops never reach a document
+const PriceJsonFilter& entryFilter() {
+  static PriceJsonFilter filter;
+  return filter;
+}
+
+// Elements the tokenizer does not expect go through ArduinoJson
+bool parseElementWithArduinoJson(BodyReader& element, PriceEntry& entry, bool& hasTime) {
   JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, json.c_str());
-  
+  DeserializationError error = deserializeJson(doc, element, entryFilter().option());
   if (error) {
     Serial.printf("JSON parse error: %s\n", error.c_str());
-    return prices; // empty vector indicates error
+    return false;
   }
+  hasTime = readEntry(doc.as<JsonObject>(), entry);
+  return true;
+}
 
-  if (!doc.is<JsonArray>()) {
-    Serial.println("JSON is not an array");
-    return prices;
+}  // namespace
+
+int PriceMonitor::parseJsonToEntries(const String& json, PriceSeries& out) {
+  StringBodyReader body(json.c_str(), json.length());
+  return parseJsonStream(body, out);
+}
+
+// Reads the top-level array one element at a time, so memory use is one
+// element however long the response is. Any syntax error discards the
+// whole series, as a whole-document parse would.
+int PriceMonitor::parseJsonStream(BodyReader& body, PriceSeries& out) {
+  SpotPriceTokenizer::Stats stats;
+  int count = SpotPriceTokenizer::parse(body, out, &parseElementWithArduinoJson, &stats);
+  if (count > 0 && count < stats.elements - stats.skipped) {
+    // Series must stay contiguous; the rest of the body is left unread
+    Serial.printf("Price series stops after %d entries\n", count);
   }
+  Serial.printf("Parsed %d price entries (%d via ArduinoJson)\n", stats.elements, stats.fallbacks);
+  return count;
+}
 
-  JsonArray priceArray = doc.as<JsonArray>();
-  Serial.printf("Parsed %d price entries\n", priceArray.size());
+// The same array read with ArduinoJson for every element; the reference
+// the tokenizer is compared against
+int PriceMonitor::parseJsonStreamDocument(BodyReader& body, PriceSeries& out) {
+  out.clear();
   
-  prices.reserve(priceArray.size());
+  int c = nextToken(body);
+  if (c != '[') {
+    Serial.println(c < 0 ? "JSON parse error: EmptyInput" : "JSON is not an array");
+    return 0;
+  }
   
-  for (JsonObject obj : priceArray) {
+  JsonDocument doc;
+  int elements = 0;
+  c = nextToken(body);
+  while (c != ']') {
+    char first = (char)c;
+    ReplayBodyReader element(&first, c < 0 ? 0 : 1, body);
+    DeserializationError error = deserializeJson(doc, element, entryFilter().option());
+    if (error) {
+      Serial.printf("JSON parse error: %s\n", error.c_str());
+      out.clear();
+      return 0;
+    }
+    elements++;
+    
     PriceEntry entry;
-    const char* dt = obj["DateTime"];
-    if (dt) entry.dateTime = String(dt);
-    entry.priceWithTax = obj["PriceWithTax"].as<float>();
-    prices.push_back(entry);
+    if (readEntry(doc.as<JsonObject>(), entry) && !out.append(entry)) {
+      // Series must stay contiguous; keep what we have up to the break
+      // and leave the rest of the body unread
+      break;
+    }
+    
+    c = nextToken(body);
+    if (c == ',') {
+      c = nextToken(body);
+      if (c == ']') {
+        c = -1;  // Trailing comma
+      }
+    } else if (c != ']') {
+      c = -1;
+    }
+    if (c < 0) {
+      Serial.println("JSON parse error: expected ',' or ']'");
+      out.clear();
+      return 0;
+    }
   }
   
-  return prices;
+  Serial.printf("Parsed %d price entries\n", elements);
+  return out.count;
+}
+
+// The LAN aggregator sends the series already encoded as a PriceCache
+// image; anything else is the upstream JSON
+void PriceMonitor::handleBody(BodyReader& body) {
+  SpanRecorder::Scope span(spans, "parse");
+  int first = body.read();
+  if (first == PriceCache::FIRST_BYTE) {
+    parsedCount = readPriceBlob(body);
+    return;
+  }
+  char c = (char)first;
+  ReplayBodyReader json(&c, first < 0 ? 0 : 1, body);
+  parsedCount = parseJsonStream(json, incoming);
+}
+
+// Takes the series from an image whose first byte was already read. Its
+// analysis is not used: the window indices advancing it need are not in it.
+int PriceMonitor::readPriceBlob(BodyReader& body) {
+  cacheBuffer[0] = PriceCache::FIRST_BYTE;
+  size_t length = 1 + body.readBytes((char*)cacheBuffer + 1, PriceCache::HEADER_BYTES - 1);
+  size_t expected = length == PriceCache::HEADER_BYTES ? PriceCache::encodedLength(cacheBuffer) : 0;
+  if (expected > length) {
+    // Exactly the image: a socket would wait out its timeout for more
+    length += body.readBytes((char*)cacheBuffer + length, expected - length);
+  }
+  PriceCache::Contents blob;
+  if (expected == 0 || !PriceCache::decode(cacheBuffer, length, blob)) {
+    Serial.println("Price blob rejected");
+    incoming.clear();
+    return 0;
+  }
+  incoming = blob.series;
+  Serial.printf("Received %d prices as a blob\n", incoming.count);
+  return incoming.count;
 }
 
 void PriceMonitor::handleApiError(const IApiClient::ApiResponse& response) {
   if (response.error == "No WiFi connection") {
     display->showText("NO WIFI");
-  } else if (response.httpCode > 0) {
+  } else if (response.httpCode > 0 && response.httpCode != 200) {
     display->showText("HTTP ERROR", String(response.httpCode));
   } else {
     display->showText("HTTP FAILED", response.error);
@@ -52,51 +169,91 @@ void PriceMonitor::handleApiError(const IApiClient::ApiResponse& response) {
 void PriceMonitor::stampAnalysisTime() {
   time_t now = time(nullptr);
   struct tm* timeinfo = localtime(&now);
-  char timeBuf[6];
-  snprintf(timeBuf, sizeof(timeBuf), "%02d:%02d", timeinfo->tm_hour, timeinfo->tm_min);
-  lastAnalysis.lastFetchTime = String(timeBuf);
+  lastAnalysis.lastFetchTime = timeinfo->tm_hour * 60 + timeinfo->tm_min;
 }
 
-bool PriceMonitor::fetchAndAnalyzePrices() {
+bool PriceMonitor::fetchAndAnalyzePrices(FetchBudget* budget) {
   FetchGuard guard(isFetching);
   
   if (lastAnalysis.valid) {
     display->showLoadingIndicator();
   }
 
-  IApiClient::ApiResponse response = apiClient->fetchJson(API_URL);
+  lastFetchAttempt = time(nullptr);
+  
+  // The body is parsed while it is received, next to the prices already
+  // held; they are only replaced once the whole fetch has succeeded
+  incoming.clear();
+  parsedCount = 0;
+  spans = FetchBudget::traceOf(budget);
+  IApiClient::ApiResponse response = apiClient->streamJson(API_URL, *this, budget);
+  spans = nullptr;
+  if (response.tlsHandshakeMicros > 0) {
+    Serial.printf("TLS handshake %lu ms (%s)\n", response.tlsHandshakeMicros / 1000,
+                  response.tlsResumed ? "resumed" : "full");
+  }
+  if (response.compressedBytes > 0) {
+    Serial.printf("Body %u bytes compressed, %u inflated\n", (unsigned)response.compressedBytes,
+                  (unsigned)response.inflatedBytes);
+  }
   
   if (!response.success) {
+    // Whatever was parsed came from a body cut short or failing its
+    // checksum. The held prices and their analysis carry on; validators are
+    // only taken from successful responses, so they still match them.
     handleApiError(response);
     return false;
   }
 
-  Serial.println("API Response received, parsing...");
-
-  std::vector<PriceEntry> prices = this->parseJsonToEntries(response.payload);
-  
-  if (prices.empty()) {
+  SpanRecorder* trace = FetchBudget::traceOf(budget);
+  if (trace) {
+    trace->stage("analyze");
+  }
+  if (response.notModified && series.count > 0) {
+    // The server says our copy is current: no body, nothing to parse
+    Serial.println("Prices not modified");
+  } else if (parsedCount == 0) {
+    // Make the next request unconditional, or a 304 would vouch for a body
+    // we could not read
+    apiClient->clearValidators();
     display->showText("JSON ERROR");
     return false;
+  } else {
+    series = incoming;
+    uint32_t checksum = series.checksum();
+    if (checksum != seriesChecksum || prefixSums.count != series.count) {
+      seriesChecksum = checksum;
+      rebuildSeriesState();
+    } else {
+      Serial.println("Prices unchanged");
+    }
   }
   
-  lastAnalysis = PriceAnalyzer::analyzePrices(prices);
-  
-  if (!lastAnalysis.valid) {
+  if (!refreshAnalysis(time(nullptr))) {
     display->showText("ANALYSIS FAILED");
     return false;
   }
   
   stampAnalysisTime();
+  if (trace) {
+    trace->stage("save");
+  }
+  saveCache();
 
   Serial.printf("Next 90min avg: %.2f c/kWh\n", lastAnalysis.next90MinAvg * 100);
+  char cheapestTime[6];
+  PriceTime::formatMinuteOfDay(lastAnalysis.cheapest90MinStart, cheapestTime);
   Serial.printf("Cheapest 90min: %.2f c/kWh @ %s\n", 
                 lastAnalysis.cheapest90MinAvg * 100, 
-                lastAnalysis.cheapest90MinTime.c_str());
+                cheapestTime);
   
   return true;
 }
 
+FetchScheduler::Reason PriceMonitor::fetchNeeded(time_t now) const {
+  return FetchScheduler::check(series, now, lastFetchAttempt);
+}
+
 bool PriceMonitor::isScheduledUpdateTime() {
   struct tm timeinfo;
   if (!getLocalTime(&timeinfo)) {
@@ -116,10 +273,92 @@ bool PriceMonitor::isScheduledUpdateTime() {
   return false;
 }
 
+// New prices: everything later refreshes rely on, plus a full analysis next
+void PriceMonitor::rebuildSeriesState() {
+  prefixSums.build(series);
+  AllowedSlots allowed;
+  allowed.build(series, ALLOWED_START_HOUR * 60, ALLOWED_END_HOUR * 60);
+  allowed.windowStarts(Window90MinAnalyzer::SLOTS, windowStarts);
+  lastAnalysis = PriceAnalysis();
+}
+
+bool PriceMonitor::refreshAnalysis() {
+  return refreshAnalysis(time(nullptr));
+}
+
+bool PriceMonitor::refreshAnalysis(time_t now) {
+  if (series.empty() || prefixSums.count != series.count) {
+    return false;
+  }
+  
+  // A restored analysis has no window indices behind it; start it afresh
+  if (lastAnalysis.valid && cheapestWindows.count > 0) {
+    return PriceAnalyzer::advanceAnalysis(series, prefixSums, windowStarts, now, cheapestWindows, lastAnalysis);
+  }
+  
+  int lastFetchTime = lastAnalysis.lastFetchTime;
+  lastAnalysis = PriceAnalyzer::analyzePrices(series, windowStarts, now, cheapestWindows);
+  lastAnalysis.lastFetchTime = lastFetchTime;
+  return lastAnalysis.valid;
+}
+
+void PriceMonitor::saveCache() {
+  if (!storage) {
+    return;
+  }
+  size_t length = PriceCache::encode(series, lastAnalysis, lastFetchAttempt, cacheBuffer, sizeof(cacheBuffer));
+  if (length == 0 || !storage->save(cacheBuffer, length)) {
+    Serial.println("Price cache not saved");
+  }
+}
+
+bool PriceMonitor::loadCache() {
+  return loadCache(time(nullptr));
+}
+
+bool PriceMonitor::loadCache(time_t now) {
+  if (!storage) {
+    return false;
+  }
+  size_t length = storage->load(cacheBuffer, sizeof(cacheBuffer));
+  PriceCache::Contents cached;
+  if (length == 0 || !PriceCache::decode(cacheBuffer, length, cached)) {
+    Serial.println(length == 0 ? "No price cache" : "Price cache rejected");
+    return false;
+  }
+  
+  series = cached.series;
+  seriesChecksum = series.checksum();
+  rebuildSeriesState();
+  cheapestWindows = CheapestWindows();
+  lastFetchAttempt = cached.fetchedAt;
+  lastAnalysis.lastFetchTime = cached.analysis.lastFetchTime;
+  
+  if (refreshAnalysis(now)) {
+    Serial.printf("Restored %d cached prices\n", series.count);
+    return true;
+  }
+  
+  // The clock is not set yet (power-on) or the prices have run out: what
+  // was on screen before the reset beats a blank screen until a fetch
+  Serial.println("Cached prices do not cover the clock");
+  lastAnalysis = cached.analysis;
+  return false;
+}
+
 const PriceAnalysis& PriceMonitor::getLastAnalysis() const {
   return lastAnalysis;
 }
 
+bool PriceMonitor::planWindows(const WindowRequest* requests, int requestCount,
+                               CheapestWindow* results) const {
+  return WindowPlanner::plan(series, prefixSums, requests, requestCount, results);
+}
+
+CheapestSlots PriceMonitor::planSlots(int slotCount, time_t deadline) const {
+  return PriceAnalyzer::findCheapestSlots(series, time(nullptr), deadline, slotCount);
+}
+
 bool PriceMonitor::isFetchingPrice() const {
   return isFetching;
 }
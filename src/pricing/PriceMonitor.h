@@ -1,36 +1,75 @@
 #ifndef PRICE_MONITOR_H
 #define PRICE_MONITOR_H
 
-#include <vector>
 #ifndef WString_h
 #include <WString.h>
 #endif
 #include "../display/IDisplay.h"
 #include "IApiClient.h"
+#include "IPriceStorage.h"
 #include "PriceData.h"
+#include "PriceCache.h"
+#include "WindowPlanner.h"
+#include "PriceAnalyzer.h"
 #include "FetchGuard.h"
+#include "FetchScheduler.h"
 
 extern const char* API_URL;
 
-class PriceMonitor {
+class PriceMonitor : private IApiClient::BodyHandler {
 private:
   PriceAnalysis lastAnalysis;
+  PriceSeries series;
+  // Derived from the series once per new data set; a refetch of the same
+  // prices or a quarter-hour refresh only advances the analysis
+  uint32_t seriesChecksum = 0;
+  PricePrefixSums prefixSums;
+  SlotMask windowStarts;           // Valid 90-minute starts
+  CheapestWindows cheapestWindows; // Indices behind lastAnalysis' cheapest periods
+  PriceSeries incoming;  // The body being received; replaces the series once the fetch succeeds
+  int parsedCount = 0;  // Entries the last streamed body yielded
+  SpanRecorder* spans = nullptr;  // The fetch's, while its body streams in
+  time_t lastFetchAttempt = 0;
   int lastScheduledMinute = -1;
   bool isFetching = false;
   IDisplay* display;
   IApiClient* apiClient;
+  IPriceStorage* storage;  // Optional; keeps the prices across resets
+  // Encoded images are built and read here rather than on the loop task's stack
+  uint8_t cacheBuffer[PriceCache::MAX_BYTES];
 
 protected:
   // Helper methods for testability
-  std::vector<PriceEntry> parseJsonToEntries(const String& json);
+  int parseJsonToEntries(const String& json, PriceSeries& out);
+  int parseJsonStream(BodyReader& body, PriceSeries& out);
+  int parseJsonStreamDocument(BodyReader& body, PriceSeries& out);
+  void handleBody(BodyReader& body) override;
+  int readPriceBlob(BodyReader& body);
   void handleApiError(const IApiClient::ApiResponse& response);
   void stampAnalysisTime();
+  void rebuildSeriesState();
+  void saveCache();
 
 public:
-  PriceMonitor(IDisplay* displayMgr, IApiClient* client);
-  bool fetchAndAnalyzePrices();
+  PriceMonitor(IDisplay* displayMgr, IApiClient* client, IPriceStorage* priceStorage = nullptr);
+  // Restores the prices and analysis saved by the last fetch. Returns true
+  // when they cover `now`; otherwise the saved analysis is kept for display
+  // until a fetch, and fetchNeeded() cannot be trusted.
+  bool loadCache();
+  bool loadCache(time_t now);
+  // With a budget the fetch gives up, keeping what it has, once it runs out
+  bool fetchAndAnalyzePrices(FetchBudget* budget = nullptr);
+  // Brings the analysis up to the current time from the stored prices,
+  // without fetching. Returns false when they no longer cover it.
+  bool refreshAnalysis();
+  bool refreshAnalysis(time_t now);
   bool isScheduledUpdateTime();
+  // Whether a tick at `now` should fetch, or can work from the stored prices
+  FetchScheduler::Reason fetchNeeded(time_t now) const;
   const PriceAnalysis& getLastAnalysis() const;
+  bool planWindows(const WindowRequest* requests, int requestCount, CheapestWindow* results) const;
+  // Cheapest slotCount slots from now until `deadline` (UTC), e.g. for charging
+  CheapestSlots planSlots(int slotCount, time_t deadline) const;
   bool isFetchingPrice() const;
 };
 
@@ -0,0 +1,112 @@
+#ifndef PRICE_TIME_H
+#define PRICE_TIME_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * Integer date/time helpers for API timestamps.
+ * A timestamp is parsed once into UTC epoch seconds plus the UTC offset it
+ * was published with, after which local day and time of day are arithmetic.
+ */
+class PriceTime {
+public:
+  static constexpr int32_t SECONDS_PER_DAY = 86400;
+
+  // Parses "YYYY-MM-DDTHH:MM[:SS[.fff]][Z|+HH:MM|-HH:MM]".
+  // A timestamp without an offset is taken as UTC (offset 0).
+  static bool parseIso8601(const char* s, time_t& epoch, int16_t& utcOffsetMin) {
+    if (!s) return false;
+
+    // Each field is checked before the next is read so short input never overruns
+    int year, month, day, hour, minute;
+    if ((year = digits(s, 4)) < 0 || s[4] != '-' ||
+        (month = digits(s + 5, 2)) < 0 || s[7] != '-' ||
+        (day = digits(s + 8, 2)) < 0 || s[10] != 'T' ||
+        (hour = digits(s + 11, 2)) < 0 || s[13] != ':' ||
+        (minute = digits(s + 14, 2)) < 0) {
+      return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59) {
+      return false;
+    }
+
+    const char* p = s + 16;
+    int second = 0;
+    if (*p == ':') {
+      second = digits(p + 1, 2);
+      if (second < 0 || second > 59) return false;
+      p += 3;
+      if (*p == '.') {
+        p++;
+        while (*p >= '0' && *p <= '9') p++;
+      }
+    }
+
+    int offset = 0;
+    if (*p == '+' || *p == '-') {
+      int offHour, offMinute;
+      if ((offHour = digits(p + 1, 2)) < 0 || p[3] != ':' ||
+          (offMinute = digits(p + 4, 2)) < 0) {
+        return false;
+      }
+      offset = offHour * 60 + offMinute;
+      if (*p == '-') offset = -offset;
+      p += 6;
+    } else if (*p == 'Z') {
+      p++;
+    }
+    if (*p != '\0') return false;
+
+    time_t localSeconds = (time_t)daysFromCivil(year, month, day) * SECONDS_PER_DAY
+                        + hour * 3600 + minute * 60 + second;
+    epoch = localSeconds - offset * 60;
+    utcOffsetMin = (int16_t)offset;
+    return true;
+  }
+
+  // Days since 1970-01-01 for a proleptic Gregorian date
+  static int32_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    int32_t era = (year >= 0 ? year : year - 399) / 400;
+    int32_t yoe = year - era * 400;
+    int32_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+  }
+
+  // Local calendar day (days since 1970-01-01) of a UTC instant
+  static int32_t localDay(time_t epoch, int utcOffsetMin) {
+    time_t local = epoch + utcOffsetMin * 60;
+    return (int32_t)((local >= 0 ? local : local - SECONDS_PER_DAY + 1) / SECONDS_PER_DAY);
+  }
+
+  // Local minutes since midnight (0-1439) of a UTC instant
+  static int localMinuteOfDay(time_t epoch, int utcOffsetMin) {
+    time_t local = epoch + utcOffsetMin * 60;
+    int32_t secondOfDay = (int32_t)(local - (time_t)localDay(epoch, utcOffsetMin) * SECONDS_PER_DAY);
+    return secondOfDay / 60;
+  }
+
+  // Writes "HH:MM" (or "--:--" for a negative value) into a 6-byte buffer
+  static void formatMinuteOfDay(int minuteOfDay, char* buf) {
+    if (minuteOfDay < 0) {
+      snprintf(buf, 6, "--:--");
+      return;
+    }
+    snprintf(buf, 6, "%02d:%02d", (minuteOfDay / 60) % 24, minuteOfDay % 60);
+  }
+
+private:
+  static int digits(const char* s, int count) {
+    int value = 0;
+    for (int i = 0; i < count; i++) {
+      if (s[i] < '0' || s[i] > '9') return -1;
+      value = value * 10 + (s[i] - '0');
+    }
+    return value;
+  }
+};
+
+#endif
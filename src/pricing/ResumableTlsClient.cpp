@@ -0,0 +1,312 @@
+#include "ResumableTlsClient.h"
+#ifndef Arduino_h
+#include <Arduino.h>
+#endif
+#ifndef WiFi_h
+#include <WiFi.h>
+#endif
+#include <fcntl.h>
+#include <string.h>
+#include <mbedtls/version.h>
+#if defined(MBEDTLS_USE_PSA_CRYPTO) || defined(MBEDTLS_SSL_PROTO_TLS1_3)
+#include <psa/crypto.h>
+#endif
+
+// mbedTLS 3 hides struct fields behind this macro; 2.x has none
+#ifndef MBEDTLS_PRIVATE
+#define MBEDTLS_PRIVATE(member) member
+#endif
+
+ResumableTlsClient::ResumableTlsClient()
+  : haveOffered(false), haveEstablished(false), active(false), peerClosed(false), resumed(false),
+    handshakeTime(0), peeked(-1) {
+  mbedtls_ssl_session_init(&offered);
+  mbedtls_ssl_session_init(&established);
+}
+
+ResumableTlsClient::~ResumableTlsClient() {
+  stop();
+  mbedtls_ssl_session_free(&offered);
+  mbedtls_ssl_session_free(&established);
+}
+
+bool ResumableTlsClient::setSession(const uint8_t* data, size_t length) {
+  mbedtls_ssl_session_free(&offered);
+  mbedtls_ssl_session_init(&offered);
+  haveOffered = mbedtls_ssl_session_load(&offered, data, length) == 0;
+  return haveOffered;
+}
+
+size_t ResumableTlsClient::getSession(uint8_t* out, size_t capacity) {
+  size_t length = 0;
+  if (!active || !haveEstablished || mbedtls_ssl_session_save(&established, out, capacity, &length) != 0) {
+    return 0;
+  }
+  return length;
+}
+
+int ResumableTlsClient::connect(IPAddress ip, uint16_t port) {
+  return connect(ip, port, HANDSHAKE_TIMEOUT_MS);
+}
+
+int ResumableTlsClient::connect(const char* host, uint16_t port) {
+  return connect(host, port, HANDSHAKE_TIMEOUT_MS);
+}
+
+int ResumableTlsClient::connect(IPAddress ip, uint16_t port, int32_t timeout) {
+  String host = ip.toString();
+  stop();
+  if (!WiFiClient::connect(ip, port, timeout)) {
+    return 0;
+  }
+  if (!handshake(host.c_str(), HANDSHAKE_TIMEOUT_MS)) {
+    stop();
+    return 0;
+  }
+  return 1;
+}
+
+int ResumableTlsClient::connect(const char* host, uint16_t port, int32_t timeout) {
+  stop();
+  if (!WiFiClient::connect(host, port, timeout)) {
+    return 0;
+  }
+  if (!handshake(host, HANDSHAKE_TIMEOUT_MS)) {
+    stop();
+    return 0;
+  }
+  return 1;
+}
+
+// A stage that fails is checked against its time, so the budget records
+// timeouts but not refusals. The core's DNS lookup cannot be cut short;
+// one that returns late still ends the fetch.
+int ResumableTlsClient::connect(const char* host, uint16_t port, FetchBudget& budget) {
+  stop();
+  IPAddress ip;
+  bool resolved = budget.begin(FetchBudget::DNS) > 0 && WiFi.hostByName(host, ip);
+  if (budget.expired() || !resolved) {
+    return 0;
+  }
+  unsigned long connectMs = budget.begin(FetchBudget::CONNECT);
+  if (connectMs == 0 || !WiFiClient::connect(ip, port, (int32_t)connectMs)) {
+    budget.expired();
+    return 0;
+  }
+  unsigned long handshakeMs = budget.begin(FetchBudget::TLS);
+  if (handshakeMs == 0 || !handshake(host, handshakeMs)) {
+    budget.expired();
+    stop();
+    return 0;
+  }
+  return 1;
+}
+
+bool ResumableTlsClient::handshake(const char* host, unsigned long timeoutMs) {
+  mbedtls_ssl_init(&ssl);
+  mbedtls_ssl_config_init(&conf);
+  mbedtls_entropy_init(&entropy);
+  mbedtls_ctr_drbg_init(&drbg);
+  mbedtls_net_init(&net);
+  active = true;  // release() frees them from here on
+  peerClosed = false;
+  resumed = false;
+  handshakeTime = 0;
+  peeked = -1;
+
+#if defined(MBEDTLS_USE_PSA_CRYPTO) || defined(MBEDTLS_SSL_PROTO_TLS1_3)
+  if (psa_crypto_init() != PSA_SUCCESS) {
+    return false;
+  }
+#endif
+  if (mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &entropy, nullptr, 0) != 0 ||
+      mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                  MBEDTLS_SSL_PRESET_DEFAULT) != 0) {
+    return false;
+  }
+  // TLS 1.3 tickets arrive after the handshake; 1.2 resumes without that
+#if MBEDTLS_VERSION_MAJOR >= 3
+  mbedtls_ssl_conf_max_tls_version(&conf, MBEDTLS_SSL_VERSION_TLS1_2);
+#else
+  mbedtls_ssl_conf_max_version(&conf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+#endif
+  mbedtls_ssl_conf_authmode(&conf, MBEDTLS_SSL_VERIFY_NONE);
+  mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &drbg);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+  mbedtls_ssl_conf_session_tickets(&conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+  if (mbedtls_ssl_setup(&ssl, &conf) != 0 || mbedtls_ssl_set_hostname(&ssl, host) != 0) {
+    return false;
+  }
+  if (haveOffered) {
+    mbedtls_ssl_set_session(&ssl, &offered);
+  }
+
+  // Non-blocking like WiFiClientSecure, so read() returns when nothing has arrived
+  net.fd = fd();
+  fcntl(net.fd, F_SETFL, fcntl(net.fd, F_GETFL, 0) | O_NONBLOCK);
+  mbedtls_ssl_set_bio(&ssl, &net, mbedtls_net_send, mbedtls_net_recv, nullptr);
+
+  unsigned long started = micros();
+  int ret;
+  while ((ret = mbedtls_ssl_handshake(&ssl)) != 0) {
+    if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+      log_e("TLS handshake failed: -0x%04x", -ret);
+      return false;
+    }
+    if (micros() - started > timeoutMs * 1000) {
+      log_e("TLS handshake timed out");
+      return false;
+    }
+    delay(1);
+  }
+  handshakeTime = micros() - started;
+
+  // Since mbedTLS 3 a session can only be exported once per connection, so
+  // it is taken here for both the check below and getSession()
+  haveEstablished = mbedtls_ssl_get_session(&ssl, &established) == 0;
+  // A resumed session keeps its master secret; a full handshake makes a new one
+  resumed = haveOffered && haveEstablished &&
+            memcmp(established.MBEDTLS_PRIVATE(master), offered.MBEDTLS_PRIVATE(master),
+                   sizeof(established.MBEDTLS_PRIVATE(master))) == 0;
+  return true;
+}
+
+// Decrypted bytes, -1 when none have arrived yet or the connection is gone
+int ResumableTlsClient::pull(uint8_t* buffer, size_t size) {
+  if (!active || peerClosed) {
+    return -1;
+  }
+  int ret = mbedtls_ssl_read(&ssl, buffer, size);
+  if (ret > 0) {
+    return ret;
+  }
+  if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+    peerClosed = true;  // close_notify, EOF or a fatal alert
+  }
+  return -1;
+}
+
+size_t ResumableTlsClient::write(uint8_t data) {
+  return write(&data, 1);
+}
+
+size_t ResumableTlsClient::write(const uint8_t* buffer, size_t size) {
+  if (!active || peerClosed) {
+    return 0;
+  }
+  size_t sent = 0;
+  unsigned long started = millis();
+  while (sent < size) {
+    int ret = mbedtls_ssl_write(&ssl, buffer + sent, size - sent);
+    if (ret > 0) {
+      sent += ret;
+    } else if ((ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) ||
+               millis() - started > HANDSHAKE_TIMEOUT_MS) {
+      break;
+    } else {
+      delay(1);
+    }
+  }
+  return sent;
+}
+
+int ResumableTlsClient::available() {
+  if (!active) {
+    return 0;
+  }
+  if (mbedtls_ssl_get_bytes_avail(&ssl) == 0 && !peerClosed) {
+    // Decrypts the next record if one has arrived
+    int ret = mbedtls_ssl_read(&ssl, nullptr, 0);
+    if (ret < 0 && ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+      peerClosed = true;
+    }
+  }
+  return (int)mbedtls_ssl_get_bytes_avail(&ssl) + (peeked >= 0 ? 1 : 0);
+}
+
+int ResumableTlsClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int ResumableTlsClient::read(uint8_t* buffer, size_t size) {
+  if (size == 0) {
+    return 0;
+  }
+  int got = 0;
+  if (peeked >= 0) {
+    buffer[got++] = (uint8_t)peeked;
+    peeked = -1;
+  }
+  if ((size_t)got < size && (got == 0 || mbedtls_ssl_get_bytes_avail(&ssl) > 0)) {
+    int n = pull(buffer + got, size - got);
+    if (n > 0) {
+      got += n;
+    }
+  }
+  return got > 0 ? got : -1;
+}
+
+// Like Stream::readBytes: waits up to the stream timeout for more bytes
+size_t ResumableTlsClient::readBytes(char* buffer, size_t length) {
+  size_t got = 0;
+  unsigned long started = millis();
+  while (got < length && millis() - started < getTimeout()) {
+    int n = read((uint8_t*)buffer + got, length - got);
+    if (n > 0) {
+      got += n;
+      started = millis();
+    } else if (peerClosed) {
+      break;
+    } else {
+      delay(1);
+    }
+  }
+  return got;
+}
+
+int ResumableTlsClient::peek() {
+  if (peeked < 0) {
+    uint8_t c;
+    if (pull(&c, 1) == 1) {
+      peeked = c;
+    }
+  }
+  return peeked;
+}
+
+void ResumableTlsClient::flush() {}
+
+void ResumableTlsClient::stop() {
+  if (active) {
+    if (!peerClosed) {
+      mbedtls_ssl_close_notify(&ssl);
+    }
+    release();
+  }
+  WiFiClient::stop();
+}
+
+uint8_t ResumableTlsClient::connected() {
+  if (!active) {
+    return 0;
+  }
+  if (peeked >= 0 || mbedtls_ssl_get_bytes_avail(&ssl) > 0) {
+    return 1;
+  }
+  return !peerClosed && WiFiClient::connected();
+}
+
+// The socket itself belongs to WiFiClient
+void ResumableTlsClient::release() {
+  mbedtls_ssl_free(&ssl);
+  mbedtls_ssl_config_free(&conf);
+  mbedtls_ctr_drbg_free(&drbg);
+  mbedtls_entropy_free(&entropy);
+  mbedtls_ssl_session_free(&established);
+  mbedtls_ssl_session_init(&established);
+  haveEstablished = false;
+  active = false;
+  peeked = -1;
+}
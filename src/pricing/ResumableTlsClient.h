@@ -0,0 +1,79 @@
+#ifndef RESUMABLE_TLS_CLIENT_H
+#define RESUMABLE_TLS_CLIENT_H
+
+#ifndef WIFI_CLIENT_H
+#include <WiFiClient.h>
+#endif
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/ssl.h>
+#include "FetchBudget.h"
+
+/**
+ * TLS over a WiFiClient socket that can resume an earlier session.
+ * WiFiClientSecure starts every connection with a full handshake and has
+ * no way to hand mbedTLS a saved session, so this drives mbedTLS itself.
+ *
+ * Resumption uses TLS 1.2 session tickets or session IDs, whichever the
+ * server offers. As with WiFiClientSecure::setInsecure(), the server
+ * certificate is not verified. The host tests build this file against the
+ * system mbedTLS over test/mocks/HostWiFiClient.h.
+ */
+class ResumableTlsClient : public WiFiClient {
+public:
+  static constexpr unsigned long HANDSHAKE_TIMEOUT_MS = 10000;
+
+  ResumableTlsClient();
+  ~ResumableTlsClient();
+
+  void setInsecure() {}
+
+  // Offers a session from getSession() on the next connect; a session the
+  // server no longer knows just means a full handshake
+  bool setSession(const uint8_t* data, size_t length);
+  // Serializes the current session; 0 when not connected or it does not fit
+  size_t getSession(uint8_t* out, size_t capacity);
+  bool sessionResumed() const { return resumed; }
+  unsigned long handshakeMicros() const { return handshakeTime; }
+
+  int connect(IPAddress ip, uint16_t port) override;
+  int connect(const char* host, uint16_t port) override;
+  int connect(IPAddress ip, uint16_t port, int32_t timeout);
+  int connect(const char* host, uint16_t port, int32_t timeout);
+  // Looks up, connects and shakes hands as the budget's DNS, CONNECT and
+  // TLS stages, each within its time
+  int connect(const char* host, uint16_t port, FetchBudget& budget);
+  size_t write(uint8_t data) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  int available() override;
+  int read() override;
+  int read(uint8_t* buffer, size_t size) override;
+  size_t readBytes(char* buffer, size_t length);
+  int peek() override;
+  void flush() override;
+  void stop() override;
+  uint8_t connected() override;
+
+private:
+  bool handshake(const char* host, unsigned long timeoutMs);
+  int pull(uint8_t* buffer, size_t size);
+  void release();
+
+  mbedtls_ssl_context ssl;
+  mbedtls_ssl_config conf;
+  mbedtls_entropy_context entropy;
+  mbedtls_ctr_drbg_context drbg;
+  mbedtls_net_context net;
+  mbedtls_ssl_session offered;
+  mbedtls_ssl_session established;  // Exported once per handshake, see handshake()
+  bool haveOffered;
+  bool haveEstablished;
+  bool active;     // Contexts above are initialized
+  bool peerClosed;
+  bool resumed;
+  unsigned long handshakeTime;
+  int peeked;
+};
+
+#endif
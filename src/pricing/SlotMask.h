@@ -0,0 +1,105 @@
+#ifndef SLOT_MASK_H
+#define SLOT_MASK_H
+
+#include "PriceData.h"
+
+// One bit per slot of a PriceSeries
+struct SlotMask {
+  static constexpr int WORDS = (PriceSeries::MAX_SLOTS + 63) / 64;
+
+  uint64_t words[WORDS];
+
+  SlotMask() { clear(); }
+
+  void clear() {
+    for (int w = 0; w < WORDS; w++) words[w] = 0;
+  }
+
+  void set(int i) { words[i >> 6] |= (uint64_t)1 << (i & 63); }
+  bool test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+
+  // Clears every bit below index n
+  void clearBelow(int n) {
+    for (int w = 0; w < WORDS && (w + 1) * 64 <= n; w++) words[w] = 0;
+    if (n > 0 && n < WORDS * 64 && (n & 63)) {
+      words[n >> 6] &= ~(uint64_t)0 << (n & 63);
+    }
+  }
+
+  // Words needed to hold `count` bits
+  static int wordsFor(int count) { return (count + 63) >> 6; }
+
+  // Keeps bit i only where other's bit i + shift is set, in the first wordCount words
+  void andShiftedDown(const SlotMask& other, int shift, int wordCount = WORDS) {
+    int wordShift = shift >> 6;
+    int bitShift = shift & 63;
+    for (int w = 0; w < wordCount; w++) {
+      int src = w + wordShift;
+      uint64_t lo = src < WORDS ? other.words[src] : 0;
+      uint64_t hi = src + 1 < WORDS ? other.words[src + 1] : 0;
+      words[w] &= bitShift ? (lo >> bitShift) | (hi << (64 - bitShift)) : lo;
+    }
+  }
+};
+
+/**
+ * Which slots of a series fall inside the allowed hours, derived once per
+ * series from each slot's local time of day.
+ *
+ * A window may start on any allowed slot. Every later slot in it must also
+ * be allowed and must follow its predecessor forward in local time. Local
+ * time steps back at midnight and at the autumn DST change, so windows
+ * never span either. A DST-shortened day simply has fewer slots.
+ */
+struct AllowedSlots {
+  SlotMask allowed;   // Slot lies within [earliestStart, latestEnd)
+  SlotMask joinable;  // Allowed and local time advanced from the previous slot
+  int count;
+
+  AllowedSlots() : count(0) {}
+
+  void build(const PriceSeries& series, int earliestStart, int latestEnd) {
+    allowed.clear();
+    joinable.clear();
+    count = series.count;
+    if (count == 0) {
+      return;
+    }
+
+    // Time of day steps by one slot, restarting only where the offset changes
+    const int slotMinutes = series.slotMinutes();
+    int minute = series.minuteOfDay(0);
+    int previous = -1;
+    for (int i = 0; i < count; i++) {
+      if (i == series.dstSwitchIndex) {
+        minute = series.minuteOfDay(i);
+      }
+      if (minute >= earliestStart && minute + slotMinutes <= latestEnd) {
+        allowed.set(i);
+        if (i > 0 && minute > previous) {
+          joinable.set(i);
+        }
+      }
+      previous = minute;
+      minute += slotMinutes;  // Slots are at most a day long
+      if (minute >= 24 * 60) {
+        minute -= 24 * 60;
+      }
+    }
+  }
+
+  // Valid starts for a window of `slots` slots: one mask, any window length
+  void windowStarts(int slots, SlotMask& out) const {
+    out = allowed;
+    if (slots <= 0) {
+      out.clear();
+      return;
+    }
+    int words = SlotMask::wordsFor(count);
+    for (int k = 1; k < slots; k++) {
+      out.andShiftedDown(joinable, k, words);
+    }
+  }
+};
+
+#endif
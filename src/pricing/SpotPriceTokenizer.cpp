@@ -0,0 +1,260 @@
+#include "SpotPriceTokenizer.h"
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+enum ElementResult {
+  ELEMENT_OK,
+  ELEMENT_UNEXPECTED  // Not the expected shape; let the fallback decide
+};
+
+// Reads the body byte by byte, keeping the current element's bytes so the
+// fallback parser can be shown the element from its start
+class ElementCursor {
+public:
+  explicit ElementCursor(BodyReader& source) : body(source), length(0), overflow(false) {}
+
+  int next() {
+    int c = body.read();
+    if (c >= 0) {
+      if (length < SpotPriceTokenizer::ELEMENT_BUFFER) {
+        bytes[length++] = (char)c;
+      } else {
+        overflow = true;
+      }
+    }
+    return c;
+  }
+
+  static bool isSpace(int c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+  int nextToken() {
+    int c;
+    do {
+      c = next();
+    } while (isSpace(c));
+    return c;
+  }
+
+  // `first` has just been read and starts a new element
+  void startElement(int first) {
+    bytes[0] = (char)first;
+    length = 1;
+    overflow = false;
+  }
+
+  BodyReader& body;
+  char bytes[SpotPriceTokenizer::ELEMENT_BUFFER];
+  int length;
+  bool overflow;
+};
+
+// Reads the rest of a string whose opening quote has been read. Stores up
+// to cap - 1 characters (none if out is null) and returns the full length,
+// or -1 for an escape (when storing), a control character or end of input.
+int readString(ElementCursor& in, char* out, int cap) {
+  int n = 0;
+  for (;;) {
+    int c = in.next();
+    if (c == '"') break;
+    if (c < 0x20) return -1;  // Also end of input
+    if (c == '\\') {
+      if (out) return -1;
+      if (in.next() < 0) return -1;
+    }
+    if (out && n < cap - 1) out[n] = (char)c;
+    n++;
+  }
+  if (out) out[n < cap - 1 ? n : cap - 1] = '\0';
+  return n;
+}
+
+// Rest of true/false/null after its first letter
+bool readLiteral(ElementCursor& in, const char* rest) {
+  for (; *rest; rest++) {
+    if (in.next() != *rest) return false;
+  }
+  return true;
+}
+
+// -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+bool isJsonNumber(const char* s) {
+  if (*s == '-') s++;
+  if (*s == '0') {
+    s++;
+  } else if (*s >= '1' && *s <= '9') {
+    while (*s >= '0' && *s <= '9') s++;
+  } else {
+    return false;
+  }
+  if (*s == '.') {
+    s++;
+    if (*s < '0' || *s > '9') return false;
+    while (*s >= '0' && *s <= '9') s++;
+  }
+  if (*s == 'e' || *s == 'E') {
+    s++;
+    if (*s == '+' || *s == '-') s++;
+    if (*s < '0' || *s > '9') return false;
+    while (*s >= '0' && *s <= '9') s++;
+  }
+  return *s == '\0';
+}
+
+// Reads a number starting with `first`. Returns the byte after it, or -2
+// if it is not a plain JSON number that fits the buffer.
+int readNumber(ElementCursor& in, int first, double& value) {
+  char buf[32];
+  int n = 0;
+  int c = first;
+  while ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+    if (n == (int)sizeof(buf) - 1) return -2;
+    buf[n++] = (char)c;
+    c = in.next();
+  }
+  buf[n] = '\0';
+  if (!isJsonNumber(buf)) return -2;
+  value = strtod(buf, nullptr);
+  return c;
+}
+
+enum Field { FIELD_OTHER, FIELD_DATE_TIME, FIELD_PRICE };
+
+// Fast path for {"DateTime":"...","PriceWithTax":0.1234,...}; `in` holds
+// the opening brace
+ElementResult readElement(ElementCursor& in, PriceEntry& entry, bool& hasTime) {
+  if (in.bytes[0] != '{') return ELEMENT_UNEXPECTED;
+
+  bool seenTime = false;
+  bool seenPrice = false;
+  int c = in.nextToken();
+  if (c == '}') return ELEMENT_OK;
+
+  for (;;) {
+    char key[16];
+    if (c != '"') return ELEMENT_UNEXPECTED;
+    int keyLength = readString(in, key, sizeof(key));
+    if (keyLength < 0) return ELEMENT_UNEXPECTED;
+    Field field = FIELD_OTHER;
+    if (keyLength == 8 && strcmp(key, "DateTime") == 0) {
+      field = FIELD_DATE_TIME;
+    } else if (keyLength == 12 && strcmp(key, "PriceWithTax") == 0) {
+      field = FIELD_PRICE;
+    }
+    if (in.nextToken() != ':') return ELEMENT_UNEXPECTED;
+    c = in.nextToken();
+
+    if (field == FIELD_DATE_TIME) {
+      if (seenTime) return ELEMENT_UNEXPECTED;
+      seenTime = true;
+      if (c == '"') {
+        char dt[40];
+        int n = readString(in, dt, sizeof(dt));
+        if (n < 0 || n >= (int)sizeof(dt)) return ELEMENT_UNEXPECTED;
+        hasTime = PriceTime::parseIso8601(dt, entry.epoch, entry.utcOffsetMin);
+      } else if (c != 'n' || !readLiteral(in, "ull")) {
+        return ELEMENT_UNEXPECTED;
+      }
+      c = in.nextToken();
+    } else if (field == FIELD_PRICE) {
+      if (seenPrice) return ELEMENT_UNEXPECTED;
+      seenPrice = true;
+      if (c == '-' || (c >= '0' && c <= '9')) {
+        double value;
+        c = readNumber(in, c, value);
+        if (c == -2) return ELEMENT_UNEXPECTED;
+        entry.priceWithTax = (float)value;
+        if (ElementCursor::isSpace(c)) c = in.nextToken();
+      } else if (c == 'n' && readLiteral(in, "ull")) {
+        entry.priceWithTax = 0;
+        c = in.nextToken();
+      } else {
+        return ELEMENT_UNEXPECTED;  // Strings and booleans get ArduinoJson's conversion
+      }
+    } else {
+      // Fields we do not keep (Rank, PriceNoTax, ...) are skipped if scalar
+      if (c == '"') {
+        if (readString(in, nullptr, 0) < 0) return ELEMENT_UNEXPECTED;
+        c = in.nextToken();
+      } else if (c == '-' || (c >= '0' && c <= '9')) {
+        double ignored;
+        c = readNumber(in, c, ignored);
+        if (c == -2) return ELEMENT_UNEXPECTED;
+        if (ElementCursor::isSpace(c)) c = in.nextToken();
+      } else if ((c == 't' && readLiteral(in, "rue")) || (c == 'f' && readLiteral(in, "alse")) ||
+                 (c == 'n' && readLiteral(in, "ull"))) {
+        c = in.nextToken();
+      } else {
+        return ELEMENT_UNEXPECTED;
+      }
+    }
+
+    if (c == '}') return ELEMENT_OK;
+    if (c != ',') return ELEMENT_UNEXPECTED;
+    c = in.nextToken();
+  }
+}
+
+}  // namespace
+
+int SpotPriceTokenizer::parse(BodyReader& body, PriceSeries& out, ElementParser fallback, Stats* stats) {
+  Stats local;
+  Stats& counts = stats ? *stats : local;
+  counts = Stats();
+  out.clear();
+
+  ElementCursor in(body);
+  if (in.nextToken() != '[') {
+    return 0;
+  }
+
+  int c = in.nextToken();
+  if (c < 0) {
+    return 0;
+  }
+  while (c != ']') {
+    in.startElement(c);
+    PriceEntry entry;
+    bool hasTime = false;
+    if (readElement(in, entry, hasTime) != ELEMENT_OK) {
+      // The fallback re-reads the element from its first byte
+      if (!fallback || in.overflow) {
+        out.clear();
+        return 0;
+      }
+      counts.fallbacks++;
+      ReplayBodyReader element(in.bytes, in.length, body);
+      entry = PriceEntry();
+      hasTime = false;
+      if (!fallback(element, entry, hasTime)) {
+        out.clear();
+        return 0;
+      }
+    }
+    counts.elements++;
+
+    if (!hasTime) {
+      counts.skipped++;
+    } else if (!out.append(entry)) {
+      break;  // Gap or full: keep what we have and leave the rest unread
+    }
+
+    c = in.nextToken();
+    if (c == ',') {
+      c = in.nextToken();
+      if (c == ']') {
+        c = -1;  // Trailing comma
+      }
+    } else if (c != ']') {
+      out.clear();
+      return 0;
+    }
+    if (c < 0) {
+      out.clear();
+      return 0;
+    }
+  }
+
+  return out.count;
+}
@@ -0,0 +1,39 @@
+#ifndef SPOT_PRICE_TOKENIZER_H
+#define SPOT_PRICE_TOKENIZER_H
+
+#include "BodyReader.h"
+#include "PriceData.h"
+
+/**
+ * Single-pass reader for the spot-hinta response: a flat array of objects
+ * with scalar fields, of which only DateTime and PriceWithTax are kept.
+ * No DOM and no allocation; each field is copied into a small stack buffer.
+ *
+ * An element it does not expect (nested values, escapes, a price given as
+ * a string, duplicate keys) is handed to a general JSON parser instead. The
+ * bytes already read from that element are replayed first, so the fallback
+ * sees the whole element and the stream is never rewound.
+ */
+class SpotPriceTokenizer {
+public:
+  // Bytes of an element kept for replay; longer elements cannot fall back
+  static constexpr int ELEMENT_BUFFER = 192;
+
+  // Parses one array element from its first byte. Returns false on a syntax
+  // error; hasTime is false when the element carries no usable DateTime.
+  typedef bool (*ElementParser)(BodyReader& element, PriceEntry& entry, bool& hasTime);
+
+  struct Stats {
+    int elements;   // Array elements read
+    int skipped;    // Elements without a usable DateTime
+    int fallbacks;  // Elements handed to the fallback parser
+
+    Stats() : elements(0), skipped(0), fallbacks(0) {}
+  };
+
+  // Fills `out` like the ArduinoJson path: stops at a gap or a full series,
+  // and returns 0 with `out` cleared on any syntax error.
+  static int parse(BodyReader& body, PriceSeries& out, ElementParser fallback, Stats* stats = nullptr);
+};
+
+#endif
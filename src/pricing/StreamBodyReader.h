@@ -0,0 +1,60 @@
+#ifndef STREAM_BODY_READER_H
+#define STREAM_BODY_READER_H
+
+#ifndef HTTP_CLIENT_H
+#include <Stream.h>
+#endif
+#include "BodyReader.h"
+#include "FetchBudget.h"
+
+// Reads a socket through Stream::readBytes, which waits up to the stream
+// timeout for data instead of returning -1 between TCP segments. With a
+// budget the body also ends once its BODY stage has run out, checked every
+// CHECK_BYTES bytes so a slow trickle cannot keep the radio on.
+class StreamBodyReader : public BodyReader {
+public:
+  static constexpr int CHECK_BYTES = 256;
+
+  explicit StreamBodyReader(Stream& source, FetchBudget* fetchBudget = nullptr)
+    : stream(source), budget(fetchBudget), untilCheck(CHECK_BYTES) {}
+  
+  int read() override {
+    if (budget && --untilCheck <= 0 && outOfTime()) {
+      return -1;
+    }
+    char c;
+    return stream.readBytes(&c, 1) == 1 ? (uint8_t)c : ended();
+  }
+
+  size_t readBytes(char* buffer, size_t length) override {
+    if (budget && outOfTime()) {
+      return 0;
+    }
+    size_t n = stream.readBytes(buffer, length);
+    if (n < length) {
+      ended();
+    }
+    return n;
+  }
+
+private:
+  bool outOfTime() {
+    untilCheck = CHECK_BYTES;
+    return budget->expired();
+  }
+
+  // The stream closed or timed out; a timeout past the stage's time is
+  // recorded against the budget
+  int ended() {
+    if (budget) {
+      budget->expired();
+    }
+    return -1;
+  }
+
+  Stream& stream;
+  FetchBudget* budget;
+  int untilCheck;
+};
+
+#endif
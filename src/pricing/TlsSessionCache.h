@@ -0,0 +1,101 @@
+#ifndef TLS_SESSION_CACHE_H
+#define TLS_SESSION_CACHE_H
+
+#include <string.h>
+#include "IPriceStorage.h"
+#include "../util/Checksum.h"
+
+/**
+ * The TLS session from the last handshake with the price server, so the
+ * next connection can resume it: an abbreviated handshake skips the
+ * certificate and key exchange that dominate a fetch at 80 MHz.
+ *
+ * The owner's Slot in RTC memory carries the session across sleep. A reset
+ * clears it, and the copy in storage is read once instead. Only the used
+ * part of the session buffer is sealed and saved, so the copy in storage
+ * is as long as the session it holds.
+ */
+class TlsSessionCache {
+public:
+  // A saved mbedTLS session keeps the peer certificate, about 1.5 KB
+  static constexpr size_t MAX_SESSION_BYTES = 2048;
+  static constexpr size_t MAX_HOST = 64;  // "host:port", NUL included
+
+  struct Slot {
+    uint32_t magic;
+    uint32_t checksum;  // Over length, host and data
+    uint16_t length;
+    char host[MAX_HOST];
+    uint8_t data[MAX_SESSION_BYTES];
+  };
+
+  explicit TlsSessionCache(Slot& rtcSlot, IPriceStorage* storage = nullptr)
+    : slot(rtcSlot), storage(storage), storageChecked(false) {}
+
+  // Session saved for host, or nullptr. Falls back to storage once when
+  // the RTC copy is missing (power-on) or belongs to nothing.
+  const uint8_t* find(const char* host, size_t& length) {
+    if (!valid() && storage && !storageChecked) {
+      storageChecked = true;
+      size_t loaded = storage->load((uint8_t*)&slot, sizeof(slot));
+      if (loaded != usedBytes()) {
+        slot.magic = 0;  // Short read or another layout
+      }
+    }
+    if (!valid() || strcmp(slot.host, host) != 0) {
+      return nullptr;
+    }
+    length = slot.length;
+    return slot.data;
+  }
+
+  // Keeps the session for the next connection. Storage is only written
+  // when the session changed, since a resumed one usually does not.
+  void store(const char* host, const uint8_t* data, size_t length) {
+    if (length == 0 || length > MAX_SESSION_BYTES || strlen(host) >= MAX_HOST) {
+      return;
+    }
+    if (valid() && slot.length == length && strcmp(slot.host, host) == 0 &&
+        memcmp(slot.data, data, length) == 0) {
+      return;
+    }
+    memset(slot.host, 0, sizeof(slot.host));
+    strcpy(slot.host, host);
+    slot.length = (uint16_t)length;
+    memcpy(slot.data, data, length);
+    Checksum::seal(slot, MAGIC, usedBytes());
+    if (storage) {
+      storage->save((const uint8_t*)&slot, usedBytes());
+    }
+  }
+
+  // After a failed connection the session may be what the server refused
+  void forget() {
+    if (!valid()) {
+      return;
+    }
+    slot.magic = 0;
+    if (storage) {
+      storage->save((const uint8_t*)&slot, offsetof(Slot, data));
+    }
+  }
+
+private:
+  static constexpr uint32_t MAGIC = 0x544C5331;  // "TLS1"
+
+  // The length is checked first, as it bounds the bytes the seal covers
+  bool valid() const {
+    return slot.length > 0 && slot.length <= MAX_SESSION_BYTES && memchr(slot.host, 0, MAX_HOST) != nullptr &&
+           Checksum::intact(slot, MAGIC, usedBytes());
+  }
+
+  size_t usedBytes() const {
+    return offsetof(Slot, data) + (slot.length <= MAX_SESSION_BYTES ? slot.length : 0);
+  }
+
+  Slot& slot;
+  IPriceStorage* storage;
+  bool storageChecked;
+};
+
+#endif
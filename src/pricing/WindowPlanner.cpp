@@ -0,0 +1,46 @@
+#include "WindowPlanner.h"
+
+bool WindowPlanner::plan(const PriceSeries& prices, const PricePrefixSums& sums,
+                         const WindowRequest* requests, int requestCount, CheapestWindow* results) {
+  if (sums.count != prices.count || requestCount < 0 || requestCount > MAX_REQUESTS) {
+    return false;
+  }
+
+  // Valid starts per request; requests sharing allowed hours share one slot mask
+  int64_t cheapestSum[MAX_REQUESTS];
+  SlotMask validStarts[MAX_REQUESTS];
+  AllowedSlots allowed;
+  int builtEarliest = -1;
+  int builtLatest = -1;
+  for (int k = 0; k < requestCount; k++) {
+    results[k] = CheapestWindow();
+    cheapestSum[k] = 0;
+    if (requests[k].earliestStart != builtEarliest || requests[k].latestEnd != builtLatest) {
+      builtEarliest = requests[k].earliestStart;
+      builtLatest = requests[k].latestEnd;
+      allowed.build(prices, builtEarliest, builtLatest);
+    }
+    allowed.windowStarts(requests[k].slots, validStarts[k]);
+  }
+
+  for (int i = 0; i < prices.count; i++) {
+    for (int k = 0; k < requestCount; k++) {
+      if (!validStarts[k].test(i)) {
+        continue;
+      }
+      int64_t windowSum = sums.windowSum(i, requests[k].slots);
+      if (results[k].startIndex < 0 || windowSum < cheapestSum[k]) {
+        cheapestSum[k] = windowSum;
+        results[k].startIndex = i;
+      }
+    }
+  }
+
+  for (int k = 0; k < requestCount; k++) {
+    if (results[k].startIndex >= 0) {
+      results[k].avg = (float)((double)cheapestSum[k] / 1000000.0 / requests[k].slots);
+    }
+  }
+
+  return true;
+}
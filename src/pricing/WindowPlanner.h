@@ -0,0 +1,55 @@
+#ifndef WINDOW_PLANNER_H
+#define WINDOW_PLANNER_H
+
+#include "PriceData.h"
+#include "SlotMask.h"
+
+// One appliance run: `slots` consecutive slots that must start at or after
+// earliestStart and finish by latestEnd (minutes since local midnight).
+// The defaults are the analyzer's 7:00-23:00 rule.
+struct WindowRequest {
+  static constexpr int DEFAULT_EARLIEST_START = ALLOWED_START_HOUR * 60;
+  static constexpr int DEFAULT_LATEST_END = ALLOWED_END_HOUR * 60;
+
+  int slots;
+  int earliestStart;
+  int latestEnd;
+
+  WindowRequest() : slots(0), earliestStart(DEFAULT_EARLIEST_START), latestEnd(DEFAULT_LATEST_END) {}
+  WindowRequest(int windowSlots, int earliest = DEFAULT_EARLIEST_START, int latest = DEFAULT_LATEST_END)
+    : slots(windowSlots), earliestStart(earliest), latestEnd(latest) {}
+};
+
+/**
+ * Running totals of a series in micro-units: sums[i] is the sum of the first
+ * i prices, so any window sum is one subtraction. Built once per fetch.
+ */
+struct PricePrefixSums {
+  int count;  // Number of prices the sums cover
+  int64_t sums[PriceSeries::MAX_SLOTS + 1];
+
+  PricePrefixSums() : count(0) { sums[0] = 0; }
+
+  void build(const PriceSeries& series) {
+    sums[0] = 0;
+    for (int i = 0; i < series.count; i++) {
+      sums[i + 1] = sums[i] + priceToMicros(series.prices[i]);
+    }
+    count = series.count;
+  }
+
+  int64_t windowSum(int start, int slots) const { return sums[start + slots] - sums[start]; }
+};
+
+class WindowPlanner {
+public:
+  static constexpr int MAX_REQUESTS = 8;
+
+  // Finds the cheapest valid start for every request in one pass over the
+  // series. results[k] stays at startIndex -1 when requests[k] cannot be met.
+  // Returns false if the sums do not match the series or there are too many requests.
+  static bool plan(const PriceSeries& prices, const PricePrefixSums& sums,
+                   const WindowRequest* requests, int requestCount, CheapestWindow* results);
+};
+
+#endif
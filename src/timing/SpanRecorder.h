@@ -0,0 +1,226 @@
+#ifndef SPAN_RECORDER_H
+#define SPAN_RECORDER_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * Where the time of a fetch goes: named spans with microsecond timestamps,
+ * grouped into sessions, one per fetch from radio on to display. The last
+ * MAX_SESSIONS complete sessions are kept in a fixed ring; recording a span
+ * is a few stores, and nothing is formatted until a dump is asked for.
+ *
+ * Spans nest. begin() opens one inside whatever is open; stage() closes
+ * everything open and starts a top-level one, as the fetch moves from one
+ * FetchBudget stage to the next. Names must outlive the recorder (string
+ * literals). Spans past MAX_SPANS or MAX_DEPTH are counted, not kept.
+ */
+class SpanRecorder {
+public:
+  typedef unsigned long (*Clock)();  // Microseconds, like micros()
+
+  static constexpr int MAX_SESSIONS = 8;
+  static constexpr int MAX_SPANS = 24;
+  static constexpr int MAX_DEPTH = 4;
+  static constexpr int NO_SPAN = -1;  // From begin() when the span is not kept
+
+  struct Span {
+    const char* name;
+    uint32_t startUs;     // From the start of the session
+    uint32_t durationUs;  // Set when it ends
+    uint8_t depth;        // 0 for a stage
+    bool open;
+  };
+
+  struct Session {
+    uint32_t number;  // Counts from 1 since boot
+    uint32_t durationUs;
+    uint8_t count;
+    uint8_t dropped;
+    Span spans[MAX_SPANS];
+  };
+
+  // Ends its span when it goes out of scope; a null recorder records nothing
+  class Scope {
+  public:
+    Scope(SpanRecorder* recorder, const char* name)
+      : recorder(recorder), span(recorder ? recorder->begin(name) : NO_SPAN) {}
+    ~Scope() {
+      if (recorder) {
+        recorder->end(span);
+      }
+    }
+
+    // Ends this span and opens `name` in its place
+    void next(const char* name) {
+      if (recorder) {
+        recorder->end(span);
+        span = recorder->begin(name);
+      }
+    }
+
+  private:
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+
+    SpanRecorder* recorder;
+    int span;
+  };
+
+  explicit SpanRecorder(Clock clock) : clock(clock), started(0), sessionStartedUs(0), recording(false), depth(0) {}
+
+  // Starts a session in place of the oldest; spans are recorded until endSession()
+  void beginSession() {
+    if (recording) {
+      endSession();
+    }
+    started++;
+    Session& session = current();
+    session.number = started;
+    session.durationUs = 0;
+    session.count = 0;
+    session.dropped = 0;
+    sessionStartedUs = clock();
+    recording = true;
+    depth = 0;
+  }
+
+  void endSession() {
+    if (!recording) {
+      return;
+    }
+    closeFrom(0);
+    current().durationUs = elapsedUs();
+    recording = false;
+  }
+
+  bool active() const { return recording; }
+
+  // Opens `name` inside the innermost open span
+  int begin(const char* name) {
+    if (!recording) {
+      return NO_SPAN;
+    }
+    Session& session = current();
+    if (session.count == MAX_SPANS || depth == MAX_DEPTH) {
+      if (session.dropped < 0xFF) {
+        session.dropped++;
+      }
+      return NO_SPAN;
+    }
+    Span& span = session.spans[session.count];
+    span.name = name;
+    span.startUs = elapsedUs();
+    span.durationUs = 0;
+    span.depth = depth++;
+    span.open = true;
+    return session.count++;
+  }
+
+  // Ends whatever is open and opens `name` at the top level
+  int stage(const char* name) {
+    if (recording) {
+      closeFrom(0);
+    }
+    return begin(name);
+  }
+
+  // Ends `span` and any span still open inside it
+  void end(int span) {
+    if (recording && span >= 0 && span < current().count && current().spans[span].open) {
+      closeFrom(span);
+    }
+  }
+
+  // Complete sessions kept, and one of them; 0 is the oldest
+  int sessionCount() const {
+    uint32_t complete = recording ? started - 1 : started;
+    uint32_t slots = MAX_SESSIONS - (recording ? 1 : 0);  // The one being recorded
+    return (int)(complete < slots ? complete : slots);
+  }
+
+  const Session& session(int index) const {
+    uint32_t newest = recording ? started - 1 : started;
+    return sessions[(newest - sessionCount() + index) % MAX_SESSIONS];
+  }
+
+  // One session per block, one span per line: start and duration in ms,
+  // children indented under their stage. `last` limits it to the newest.
+  template <class Output>
+  void printText(Output& out, int last = MAX_SESSIONS) const {
+    int count = sessionCount();
+    for (int i = count > last ? count - last : 0; i < count; i++) {
+      const Session& s = session(i);
+      char line[64];
+      snprintf(line, sizeof(line), "fetch %lu: %lu.%03lu ms\n", (unsigned long)s.number,
+               (unsigned long)(s.durationUs / 1000), (unsigned long)(s.durationUs % 1000));
+      out.print(line);
+      for (int j = 0; j < s.count; j++) {
+        const Span& span = s.spans[j];
+        int indent = 2 + 2 * span.depth;
+        snprintf(line, sizeof(line), "%*s%-*s %6lu.%03lu %6lu.%03lu\n", indent, "", 22 - indent, span.name,
+                 (unsigned long)(span.startUs / 1000), (unsigned long)(span.startUs % 1000),
+                 (unsigned long)(span.durationUs / 1000), (unsigned long)(span.durationUs % 1000));
+        out.print(line);
+      }
+      if (s.dropped > 0) {
+        snprintf(line, sizeof(line), "  (%u spans dropped)\n", (unsigned)s.dropped);
+        out.print(line);
+      }
+    }
+  }
+
+  // The same in Chrome's trace event format, for chrome://tracing or
+  // Perfetto: each session is a thread, timed from its own start
+  template <class Output>
+  void printJson(Output& out) const {
+    char event[160];
+    out.print("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    for (int i = 0; i < sessionCount(); i++) {
+      const Session& s = session(i);
+      snprintf(event, sizeof(event),
+               "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"fetch %lu\"}}",
+               first ? "" : ",", (unsigned long)s.number, (unsigned long)s.number);
+      out.print(event);
+      first = false;
+      for (int j = 0; j < s.count; j++) {
+        const Span& span = s.spans[j];
+        snprintf(event, sizeof(event), ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%lu,\"dur\":%lu}",
+                 span.name, (unsigned long)s.number, (unsigned long)span.startUs,
+                 (unsigned long)span.durationUs);
+        out.print(event);
+      }
+    }
+    out.print("\n]}\n");
+  }
+
+private:
+  Session& current() { return sessions[(started - 1) % MAX_SESSIONS]; }
+
+  // 32 bits of microseconds: a session is over long before they wrap
+  uint32_t elapsedUs() const { return (uint32_t)(clock() - sessionStartedUs); }
+
+  // Open spans form a stack, so the ones after `first` are inside it
+  void closeFrom(int first) {
+    Session& session = current();
+    uint32_t now = elapsedUs();
+    for (int i = first; i < session.count; i++) {
+      Span& span = session.spans[i];
+      if (span.open) {
+        span.durationUs = now - span.startUs;
+        span.open = false;
+        depth--;
+      }
+    }
+  }
+
+  Clock clock;
+  Session sessions[MAX_SESSIONS];
+  uint32_t started;  // Sessions begun since boot
+  unsigned long sessionStartedUs;
+  bool recording;
+  uint8_t depth;  // Spans open in the current session
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef TIME_SYNC_POLICY_H
+#define TIME_SYNC_POLICY_H
+
+#include <stdint.h>
+#include <time.h>
+#include "../util/Checksum.h"
+
+/**
+ * Decides whether a connection should ask SNTP for the time, from how far
+ * the clock is expected to have drifted since the last sync. The drift is
+ * measured from the correction each sync makes, so a well-behaved clock is
+ * synced every few hours instead of on every wake.
+ *
+ * Waiting for the reply is only worth the radio time when the clock cannot
+ * be trusted: never synced, reset (time() restarts at 1970), or drifted far
+ * enough to misplace a price slot. Otherwise the reply is taken if it
+ * arrives while the radio is on anyway.
+ *
+ * The measured drift is kept in the owner's Slot in RTC memory, since it
+ * takes syncs hours apart to measure. Power loss clears it along with the
+ * time, and the next sync starts again from DEFAULT_DRIFT_PPM.
+ */
+class TimeSyncPolicy {
+public:
+  enum Action {
+    SKIP,                // The clock is close enough
+    SYNC_IN_BACKGROUND,  // Ask, but do not wait for the reply
+    SYNC_AND_WAIT        // The clock is unknown or too far off to use
+  };
+
+  static constexpr long SYNC_ABOVE_MS = 1000;
+  static constexpr long WAIT_ABOVE_MS = 60000;
+  static constexpr long SNTP_ERROR_MS = 50;      // Of a sync itself, over WiFi
+  static constexpr int32_t DEFAULT_DRIFT_PPM = 500;  // Until measured; the RTC oscillator in sleep
+  static constexpr long MIN_MEASURE_S = 600;     // Shorter spans are all SNTP jitter
+  static constexpr time_t EARLIEST_TIME = 1704067200;  // 2024-01-01: before it, never set
+
+  struct Slot {
+    uint32_t magic;
+    uint32_t checksum;  // Over the rest
+    uint32_t lastSync;  // time() just after the last confirmed sync
+    int32_t driftPpm;   // Positive: the clock ran slow and was moved forward
+    uint32_t measurements;
+  };
+
+  explicit TimeSyncPolicy(Slot& rtcSlot) : slot(rtcSlot) {}
+
+  Action decide(time_t now) const {
+    if (!trusted(now)) {
+      return SYNC_AND_WAIT;
+    }
+    long error = expectedErrorMs(now);
+    if (error > WAIT_ABOVE_MS) {
+      return SYNC_AND_WAIT;
+    }
+    return error > SYNC_ABOVE_MS ? SYNC_IN_BACKGROUND : SKIP;
+  }
+
+  // Whether `now` comes from a synced clock that has not been reset since
+  bool trusted(time_t now) const {
+    return valid() && now >= EARLIEST_TIME && now >= (time_t)slot.lastSync;
+  }
+
+  // How far off the clock may be by now, from the drift measured so far
+  long expectedErrorMs(time_t now) const {
+    if (!trusted(now)) {
+      return -1;
+    }
+    int64_t drift = slot.driftPpm < 0 ? -(int64_t)slot.driftPpm : slot.driftPpm;
+    int64_t error = SNTP_ERROR_MS + drift * (int64_t)(now - (time_t)slot.lastSync) / 1000;
+    return error > 0x7FFFFFFF ? 0x7FFFFFFF : (long)error;
+  }
+
+  // A sync moved the clock by `correctionMs` and it now reads `now`. The
+  // correction only measures drift when the clock before it was trusted.
+  void synced(time_t now, long correctionMs) {
+    time_t before = now - correctionMs / 1000;
+    bool measurable = trusted(before) && before - (time_t)slot.lastSync >= MIN_MEASURE_S;
+    if (measurable) {
+      int32_t measured = (int32_t)((int64_t)correctionMs * 1000 / (before - (time_t)slot.lastSync));
+      // One sync's SNTP error would swing a single estimate; average them
+      slot.driftPpm = slot.measurements == 0 ? measured : (3 * slot.driftPpm + measured) / 4;
+      slot.measurements++;
+    } else if (!valid()) {
+      slot.driftPpm = DEFAULT_DRIFT_PPM;
+      slot.measurements = 0;
+    }
+    slot.lastSync = (uint32_t)now;
+    Checksum::seal(slot, MAGIC);
+  }
+
+  int32_t driftPpm() const { return valid() ? slot.driftPpm : DEFAULT_DRIFT_PPM; }
+
+private:
+  static constexpr uint32_t MAGIC = 0x4E545031;  // "NTP1"
+
+  bool valid() const { return Checksum::intact(slot, MAGIC); }
+
+  Slot& slot;
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * FNV-1a, the one checksum the firmware uses: cheap on bytes at a time and
+ * good enough to tell a changed series or a damaged copy apart. Chaining
+ * calls through `hash` equals hashing the pieces back to back.
+ */
+namespace Checksum {
+
+constexpr uint32_t FNV_OFFSET = 2166136261u;
+
+inline uint32_t fnv1a(const void* data, size_t size, uint32_t hash = FNV_OFFSET) {
+  const uint8_t* bytes = (const uint8_t*)data;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+// The slots kept in RTC memory open with `uint32_t magic; uint32_t
+// checksum;`, the checksum covering what follows up to `used` bytes of the
+// slot. A seal is what tells a slot written by this firmware from the
+// garbage RTC_NOINIT memory holds after power-on.
+template <typename Slot>
+uint32_t slotHash(const Slot& slot, size_t used = sizeof(Slot)) {
+  const size_t start = offsetof(Slot, checksum) + sizeof(slot.checksum);
+  return fnv1a((const uint8_t*)&slot + start, used - start);
+}
+
+template <typename Slot>
+bool intact(const Slot& slot, uint32_t magic, size_t used = sizeof(Slot)) {
+  return slot.magic == magic && slot.checksum == slotHash(slot, used);
+}
+
+template <typename Slot>
+void seal(Slot& slot, uint32_t magic, size_t used = sizeof(Slot)) {
+  slot.checksum = slotHash(slot, used);
+  slot.magic = magic;
+}
+
+}  // namespace Checksum
+
+#endif
@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+#include <string>
+
+// 2025-11-18 12:30 UTC, within the test payload
+extern "C" time_t time(time_t* t) {
+  time_t now = 1763424000 + 12 * 3600 + 30 * 60;
+  if (t) *t = now;
+  return now;
+}
+
+// The service's own Linux platform: host String, Serial, sockets and TLS
+#include "../../aggregator/HostPlatform.h"
+#include "../mocks/LocalHttpServer.h"
+#include "../mocks/LocalTlsServer.h"
+
+#include "../../src/pricing/InflateBodyReader.cpp"
+#include "../../src/pricing/LanPriceClient.cpp"
+#include "../../src/pricing/PriceAnalyzer.cpp"
+#include "../../src/pricing/PriceApiClient.cpp"
+#include "../../src/pricing/PriceCache.cpp"
+#include "../../src/pricing/PriceMonitor.cpp"
+#include "../../src/pricing/SpotPriceTokenizer.cpp"
+#include "../../src/pricing/WindowPlanner.cpp"
+#include "../../aggregator/LogDisplay.h"
+#include "../../aggregator/PriceAggregator.cpp"
+#include "../../aggregator/PriceBlobServer.cpp"
+#include "../pricing/spot_hinta_payloads.h"
+
+// Upstream for the aggregator, the blob server for devices; set per fetch
+const char* API_URL = "";
+
+// A device on the LAN, fetching with the client App picks for http:// URLs
+class Device : public PriceMonitor {
+public:
+  Device() : PriceMonitor(&display, &client) {}
+
+  bool fetchFrom(const std::string& url) {
+    API_URL = url.c_str();
+    return fetchAndAnalyzePrices();
+  }
+
+  LogDisplay display;
+  LanPriceClient client;
+};
+
+class PriceAggregatorTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_TRUE(upstream.listening());
+    upstream.setBody(PAYLOAD_TWO_DAYS);
+    ASSERT_TRUE(blobs.start(0));
+    upstreamUrl = upstream.url();
+    blobUrl = "http://127.0.0.1:" + std::to_string(blobs.port()) + "/prices";
+  }
+
+  bool tick() {
+    API_URL = upstreamUrl.c_str();
+    return aggregator.tick(time(nullptr));
+  }
+
+  LocalHttpServer upstream;
+  PriceBlobServer blobs;
+  std::string upstreamUrl;
+  std::string blobUrl;
+  LogDisplay log;
+  LanPriceClient upstreamClient;
+  PriceAggregator aggregator{&log, &upstreamClient, &blobs};
+};
+
+static void expectSameAnalysis(const PriceAnalysis& actual, const PriceAnalysis& expected) {
+  EXPECT_EQ(actual.valid, expected.valid);
+  EXPECT_EQ(actual.currentPeriodStart, expected.currentPeriodStart);
+  EXPECT_FLOAT_EQ(actual.next90MinAvg, expected.next90MinAvg);
+  EXPECT_EQ(actual.cheapest90MinStart, expected.cheapest90MinStart);
+  EXPECT_FLOAT_EQ(actual.cheapest90MinAvg, expected.cheapest90MinAvg);
+  ASSERT_EQ(actual.cheapestCount, expected.cheapestCount);
+  for (int k = 0; k < actual.cheapestCount; k++) {
+    EXPECT_EQ(actual.cheapestStarts[k], expected.cheapestStarts[k]);
+  }
+}
+
+// Test Suite: aggregator polling upstream, devices fetching the blob
+
+TEST_F(PriceAggregatorTest, DeviceGetsTheAnalysisItWouldFromJson) {
+  ASSERT_TRUE(tick());
+  Device fromBlob;
+  Device fromJson;
+
+  ASSERT_TRUE(fromBlob.fetchFrom(blobUrl));
+  ASSERT_TRUE(fromJson.fetchFrom(upstreamUrl));
+
+  ASSERT_TRUE(fromBlob.getLastAnalysis().valid);
+  expectSameAnalysis(fromBlob.getLastAnalysis(), fromJson.getLastAnalysis());
+  EXPECT_EQ(fromBlob.fetchNeeded(time(nullptr)), FetchScheduler::NOT_NEEDED);
+  EXPECT_EQ(blobs.blobsServed(), 1);
+}
+
+TEST_F(PriceAggregatorTest, BlobIsUnderOneKilobyte) {
+  ASSERT_TRUE(tick());
+  uint8_t blob[PriceCache::MAX_BYTES];
+  size_t length = blobs.load(blob, sizeof(blob));
+
+  EXPECT_GT(length, 0u);
+  EXPECT_LT(length, 1024u);
+  printf("Body per device: %zu bytes JSON, %zu bytes blob\n", strlen(PAYLOAD_TWO_DAYS), length);
+}
+
+TEST_F(PriceAggregatorTest, UpstreamPolledOnceForAllDevices) {
+  ASSERT_TRUE(tick());
+  Device devices[5];
+
+  for (Device& device : devices) {
+    EXPECT_TRUE(device.fetchFrom(blobUrl));
+  }
+  ASSERT_TRUE(tick());  // Prices still cover the clock: no fetch
+
+  EXPECT_EQ(upstream.requests().size(), 1u);
+  EXPECT_EQ(blobs.blobsServed(), 5);
+}
+
+TEST_F(PriceAggregatorTest, SameBlobIsNotModified) {
+  ASSERT_TRUE(tick());
+  Device device;
+
+  ASSERT_TRUE(device.fetchFrom(blobUrl));
+  ASSERT_TRUE(device.fetchFrom(blobUrl));
+
+  EXPECT_EQ(blobs.blobsServed(), 1);
+  EXPECT_EQ(blobs.notModifiedServed(), 1);
+  EXPECT_TRUE(device.getLastAnalysis().valid);
+}
+
+// Republishes the blob with `change` applied, as a later save would
+template <typename Change>
+static void republish(PriceBlobServer& blobs, Change change) {
+  uint8_t blob[PriceCache::MAX_BYTES];
+  size_t length = blobs.load(blob, sizeof(blob));
+  PriceCache::Contents contents;
+  ASSERT_TRUE(PriceCache::decode(blob, length, contents));
+  change(contents);
+  length = PriceCache::encode(contents.series, contents.analysis, contents.fetchedAt, blob, sizeof(blob));
+  ASSERT_TRUE(blobs.save(blob, length));
+}
+
+TEST_F(PriceAggregatorTest, NewAnalysisOfTheSameSeriesIsNotModified) {
+  ASSERT_TRUE(tick());
+  Device device;
+  ASSERT_TRUE(device.fetchFrom(blobUrl));
+
+  // A quarter of an hour on: the analysis moves, the prices do not
+  republish(blobs, [](PriceCache::Contents& contents) {
+    contents.analysis.currentPeriodStart += 15;
+    contents.analysis.next90MinAvg += 0.01f;
+  });
+  ASSERT_TRUE(device.fetchFrom(blobUrl));
+
+  EXPECT_EQ(blobs.blobsServed(), 1);
+  EXPECT_EQ(blobs.notModifiedServed(), 1);
+}
+
+TEST_F(PriceAggregatorTest, NewSeriesIsServed) {
+  ASSERT_TRUE(tick());
+  Device device;
+  ASSERT_TRUE(device.fetchFrom(blobUrl));
+
+  republish(blobs, [](PriceCache::Contents& contents) {
+    contents.series.prices[contents.series.count - 1] += 0.01f;
+    contents.fetchedAt += 3600;
+  });
+  ASSERT_TRUE(device.fetchFrom(blobUrl));
+
+  EXPECT_EQ(blobs.blobsServed(), 2);
+  EXPECT_EQ(blobs.notModifiedServed(), 0);
+}
+
+TEST_F(PriceAggregatorTest, LastModifiedIsTheFetchTime) {
+  ASSERT_TRUE(tick());
+  const char* keys[] = {"Last-Modified"};
+  WiFiClient client;
+  HTTPClient http;
+
+  ASSERT_TRUE(http.begin(client, blobUrl.c_str()));
+  http.collectHeaders(keys, 1);
+  ASSERT_EQ(http.GET(), 200);
+  String lastModified = http.header("Last-Modified");
+  http.end();
+  EXPECT_STREQ(lastModified.c_str(), "Tue, 18 Nov 2025 12:30:00 GMT");
+
+  republish(blobs, [](PriceCache::Contents& contents) { contents.analysis.currentPeriodStart += 15; });
+  ASSERT_TRUE(http.begin(client, blobUrl.c_str()));
+  http.addHeader("If-Modified-Since", lastModified);
+  EXPECT_EQ(http.GET(), 304);
+  http.end();
+}
+
+TEST_F(PriceAggregatorTest, NothingServedBeforeFirstFetch) {
+  upstream.setBody("not json");
+  Device device;
+
+  EXPECT_FALSE(tick());
+  EXPECT_FALSE(device.fetchFrom(blobUrl));
+
+  EXPECT_EQ(blobs.blobsServed(), 0);
+  EXPECT_EQ(device.fetchNeeded(time(nullptr)), FetchScheduler::NO_PRICES);
+}
+
+TEST_F(PriceAggregatorTest, BrokenUpstreamKeepsCurrentPricesServed) {
+  ASSERT_TRUE(tick());
+  upstream.setBody("not json");
+  Device device;
+
+  // Nothing to fetch yet, so the old prices are republished as they are
+  ASSERT_TRUE(tick());
+  ASSERT_TRUE(device.fetchFrom(blobUrl));
+
+  EXPECT_TRUE(device.getLastAnalysis().valid);
+  EXPECT_EQ(upstream.requests().size(), 1u);
+}
+
+// Test Suite: an https:// upstream, verified as the service verifies it
+
+class VerifiedUpstreamTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_TRUE(upstream.listening());
+    upstream.setBody(PAYLOAD_TWO_DAYS);
+    ASSERT_TRUE(blobs.start(0));
+    upstreamUrl = upstream.url();
+    caFile = ::testing::TempDir() + "upstream_ca.pem";
+  }
+
+  void TearDown() override {
+    ResumableTlsClient::acceptAnyServer();
+    unlink(caFile.c_str());
+  }
+
+  bool tick() {
+    API_URL = upstreamUrl.c_str();
+    return aggregator.tick(time(nullptr));
+  }
+
+  LocalTlsServer upstream;
+  PriceBlobServer blobs;
+  std::string upstreamUrl;
+  std::string caFile;
+  LogDisplay log;
+  PriceApiClient upstreamClient;
+  PriceAggregator aggregator{&log, &upstreamClient, &blobs};
+};
+
+TEST_F(VerifiedUpstreamTest, TrustedServerIsFetched) {
+  ASSERT_TRUE(upstream.saveCertificate(caFile.c_str()));
+  ResumableTlsClient::verifyServers(caFile.c_str());
+
+  EXPECT_TRUE(tick());
+  EXPECT_EQ(upstream.requests().size(), 1u);
+}
+
+TEST_F(VerifiedUpstreamTest, OtherCertificateIsRefused) {
+  LocalTlsServer impostor;
+  ASSERT_TRUE(impostor.saveCertificate(caFile.c_str()));
+  ResumableTlsClient::verifyServers(caFile.c_str());
+
+  EXPECT_FALSE(tick());
+  EXPECT_EQ(upstream.requests().size(), 0u);
+  EXPECT_EQ(upstream.fullHandshakes(), 0);
+}
+
+TEST_F(VerifiedUpstreamTest, SelfSignedIsRefusedByTheSystemStore) {
+  ResumableTlsClient::verifyServers(nullptr);
+
+  EXPECT_FALSE(tick());
+  EXPECT_EQ(upstream.requests().size(), 0u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+// Host benchmark for parsing the spot-hinta response.
+// Build and run with `make bench` from the test directory.
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+// Use test String adapter before including production headers
+#include "../../host/HostString.h"
+#define WString_h  // Prevent Arduino WString.h inclusion
+
+// Serial and clock stand-ins for PriceMonitor
+namespace {
+  struct QuietSerial {
+    void printf(const char*, ...) {}
+    void println(const char*) {}
+  } Serial;
+}
+
+extern "C" {
+  bool getLocalTime(struct tm* info) {
+    info->tm_hour = 12;
+    info->tm_min = 30;
+    return true;
+  }
+}
+
+#include <ArduinoJson.h>
+
+extern const char* API_URL;
+const char* API_URL = "bench";
+
+#include "../../src/pricing/PriceAnalyzer.cpp"
+#include "../../src/pricing/WindowPlanner.cpp"
+#include "../../src/pricing/SpotPriceTokenizer.cpp"
+#include "../../src/pricing/PriceCache.cpp"
+#include "../../src/pricing/PriceMonitor.cpp"
+#include "../pricing/spot_hinta_payloads.h"
+
+class BenchMonitor : public PriceMonitor {
+public:
+  BenchMonitor() : PriceMonitor(nullptr, nullptr) {}
+  using PriceMonitor::parseJsonStreamDocument;
+};
+
+// Whole response as one document, the way the first version parsed it
+static int parseWholeDocument(const std::string& json, PriceSeries& out, const PriceJsonFilter* filter) {
+  out.clear();
+  JsonDocument doc;
+  DeserializationError error = filter ? deserializeJson(doc, json.c_str(), json.size(), filter->option())
+                                      : deserializeJson(doc, json.c_str(), json.size());
+  if (error) {
+    return 0;
+  }
+  for (JsonObject obj : doc.as<JsonArray>()) {
+    PriceEntry entry;
+    if (readEntry(obj, entry) && !out.append(entry)) {
+      break;
+    }
+  }
+  return out.count;
+}
+
+template <typename Fn>
+static void run(const char* name, const std::string& json, int iterations, Fn fn) {
+  volatile int sink = 0;
+  PriceSeries out;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    sink = sink + fn(json, out);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+  printf("%-22s %8.0f ns/response  %6.1f MB/s  (%d entries)\n",
+         name, ns, json.size() / ns * 1e3, sink / iterations);
+}
+
+int main() {
+  const std::string payloads[] = {PAYLOAD_TWO_DAYS, PAYLOAD_PRETTY};
+  const char* labels[] = {"compact, 192 entries", "pretty, 8 entries"};
+  const int iterations = 2000;
+  BenchMonitor monitor;
+
+  for (int p = 0; p < 2; p++) {
+    const std::string& json = payloads[p];
+    printf("\n%s, %zu bytes\n", labels[p], json.size());
+
+    run("tokenizer", json, iterations, [](const std::string& body, PriceSeries& out) {
+      StringBodyReader reader(body.c_str(), body.size());
+      return SpotPriceTokenizer::parse(reader, out, nullptr);
+    });
+    run("ArduinoJson per entry", json, iterations, [&monitor](const std::string& body, PriceSeries& out) {
+      StringBodyReader reader(body.c_str(), body.size());
+      return monitor.parseJsonStreamDocument(reader, out);
+    });
+    run("ArduinoJson document", json, iterations, [](const std::string& body, PriceSeries& out) {
+      return parseWholeDocument(body, out, nullptr);
+    });
+    run("  filtered", json, iterations, [](const std::string& body, PriceSeries& out) {
+      static PriceJsonFilter filter(true);
+      return parseWholeDocument(body, out, &filter);
+    });
+  }
+  return 0;
+}
@@ -0,0 +1,163 @@
+// Host benchmark for PriceAnalyzer cheapest-window search.
+// Build and run with `make bench` from the test directory.
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_RDTSC 1
+#endif
+
+// Use test String adapter before including production headers
+#include "../../host/HostString.h"
+#define WString_h  // Prevent Arduino WString.h inclusion
+
+// Room for a year of 15-minute slots
+#define PRICE_SERIES_MAX_SLOTS 35040
+#include "../../src/pricing/PriceData.h"
+#include "../../src/pricing/PriceAnalyzer.cpp"
+
+// Previous search: re-sums every candidate window before checking its hours
+static Cheapest90Min legacyFindCheapest90MinPeriod(const PriceSeries& prices) {
+  const int periods = 6;
+  Cheapest90Min result;
+  if (prices.count < periods) return result;
+
+  float cheapestAvg = 999999.0f;
+  int cheapestIdx = -1;
+  for (int i = 0; i <= prices.count - periods; i++) {
+    float avg = PriceAnalyzer::calculate90MinAverage(prices, i);
+    if (avg >= 0 && avg < cheapestAvg) {
+      int start = prices.minuteOfDay(i);
+      int lastStart = prices.minuteOfDay(i + periods - 1);
+      if (start >= 7 * 60 && lastStart + 15 <= 23 * 60 && lastStart >= start) {
+        cheapestAvg = avg;
+        cheapestIdx = i;
+      }
+    }
+  }
+  if (cheapestIdx >= 0) {
+    result.avg = cheapestAvg;
+    result.startIndex = cheapestIdx;
+  }
+  return result;
+}
+
+// Runtime-configured search: rolling sum over the valid-start mask, which
+// it builds from local time on every call
+static Cheapest90Min rollingFindCheapest90MinPeriod(const PriceSeries& prices) {
+  return PriceAnalyzer::findCheapestPeriod(prices, 6);
+}
+
+// Runtime search against a valid-start mask built once per series
+static SlotMask benchValidStarts;
+static Cheapest90Min maskedFindCheapest90MinPeriod(const PriceSeries& prices) {
+  return PriceAnalyzer::findCheapestPeriod(prices, benchValidStarts, 6);
+}
+
+// Consecutive 15-minute slots starting 2025-01-01 00:00 with a daily price curve
+static void makeSeries(int slots, PriceSeries& prices) {
+  prices.clear();
+  time_t base = 1735689600;  // 2025-01-01T00:00:00Z
+  for (int i = 0; i < slots; i++) {
+    int hour = (i / 4) % 24;
+    float price = 0.05f + 0.01f * ((i * 7919) % 23) + (hour >= 17 && hour < 21 ? 0.10f : 0.0f);
+    prices.append(PriceEntry(base + (time_t)i * 900, 0, price));
+  }
+}
+
+static uint64_t cycles() {
+#ifdef HAVE_RDTSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+template <typename Fn>
+static void run(const char* name, const PriceSeries& prices, int iterations, Fn fn) {
+  volatile int sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  uint64_t c0 = cycles();
+  for (int i = 0; i < iterations; i++) {
+    sink = sink + fn(prices).startIndex;
+  }
+  uint64_t c1 = cycles();
+  auto t1 = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+  printf("%-8s %6d slots  %12.0f ns/analysis  %12.0f cycles/analysis\n",
+         name, prices.count, ns, (double)(c1 - c0) / iterations);
+}
+
+int main() {
+#ifndef HAVE_RDTSC
+  printf("(cycle counter unavailable on this host, cycles column is 0)\n");
+#endif
+  const int sizes[] = {96, 192, 35040};
+  for (int slots : sizes) {
+    static PriceSeries prices;  // Too large for the stack at a year of slots
+    makeSeries(slots, prices);
+    int iterations = slots > 1000 ? 50 : 5000;
+
+    Cheapest90Min legacy = legacyFindCheapest90MinPeriod(prices);
+    Cheapest90Min rolling = rollingFindCheapest90MinPeriod(prices);
+    static AllowedSlots allowed;
+    allowed.build(prices, ALLOWED_START_HOUR * 60, ALLOWED_END_HOUR * 60);
+    allowed.windowStarts(6, benchValidStarts);
+    Cheapest90Min masked = maskedFindCheapest90MinPeriod(prices);
+    Cheapest90Min fixed = Window90MinAnalyzer::findCheapest(prices);
+    if (legacy.startIndex != rolling.startIndex || legacy.startIndex != masked.startIndex ||
+        legacy.startIndex != fixed.startIndex) {
+      printf("MISMATCH at %d slots: legacy %d, rolling %d, masked %d, fixed %d\n",
+             slots, legacy.startIndex, rolling.startIndex, masked.startIndex, fixed.startIndex);
+      return 1;
+    }
+
+    run("legacy", prices, iterations, legacyFindCheapest90MinPeriod);
+    run("rolling", prices, iterations, rollingFindCheapest90MinPeriod);
+    run("masked", prices, iterations, maskedFindCheapest90MinPeriod);
+    run("fixed", prices, iterations, Window90MinAnalyzer::findCheapest);
+  }
+
+  // Quarter-hour ticks over an unchanged two-day series: full re-analysis
+  // versus advancing the previous one
+  static PriceSeries prices;
+  makeSeries(192, prices);
+  static PricePrefixSums sums;
+  sums.build(prices);
+  static AllowedSlots allowed;
+  allowed.build(prices, ALLOWED_START_HOUR * 60, ALLOWED_END_HOUR * 60);
+  allowed.windowStarts(Window90MinAnalyzer::SLOTS, benchValidStarts);
+  const int ticks = 96;  // One day of slots, both days' windows still ahead
+  const int rounds = 200;
+  volatile int sink = 0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    CheapestWindows windows;
+    for (int i = 0; i < ticks; i++) {
+      sink = sink + PriceAnalyzer::analyzePrices(prices, benchValidStarts, prices.slotEpoch(i), windows).cheapestCount;
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    CheapestWindows windows;
+    PriceAnalysis analysis = PriceAnalyzer::analyzePrices(prices, benchValidStarts, prices.slotEpoch(0), windows);
+    for (int i = 1; i < ticks; i++) {
+      PriceAnalyzer::advanceAnalysis(prices, sums, benchValidStarts, prices.slotEpoch(i), windows, analysis);
+    }
+    sink = sink + analysis.cheapestCount;
+  }
+  auto t2 = std::chrono::steady_clock::now();
+  printf("tick full     %12.0f ns/tick\n", std::chrono::duration<double, std::nano>(t1 - t0).count() / (rounds * ticks));
+  printf("tick advance  %12.0f ns/tick\n", std::chrono::duration<double, std::nano>(t2 - t1).count() / (rounds * ticks));
+
+  // Charging plan: 16 cheapest quarter-hours over the whole two-day horizon
+  for (int r = 0; r < rounds * ticks; r++) {
+    sink = sink + PriceAnalyzer::findCheapestSlots(prices, prices.slotEpoch(r % 32), prices.slotEpoch(192), 16).count;
+  }
+  auto t3 = std::chrono::steady_clock::now();
+  printf("16 cheapest slots of 192  %8.0f ns/plan\n",
+         std::chrono::duration<double, std::nano>(t3 - t2).count() / (rounds * ticks));
+  return 0;
+}
@@ -2,6 +2,7 @@
 #include <gmock/gmock.h>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 // Mock Arduino String class
 class String {
@@ -82,9 +83,9 @@ TEST(DisplayManager, HighPriceShowsRedBackground) {
   analysis.valid = true;
   analysis.next90MinAvg = 0.20f;  // 20 cents - expensive
   analysis.cheapest90MinAvg = 0.05f;
-  analysis.currentPeriodStartTime = "14:00";
-  analysis.cheapest90MinTime = "02:00";
-  analysis.lastFetchTime = "14:05";
+  analysis.currentPeriodStart = 14 * 60;
+  analysis.cheapest90MinStart = 2 * 60;
+  analysis.lastFetchTime = 14 * 60 + 5;
   analysis.cheapestIsTomorrow = true;
   
   // Expect red background
@@ -105,9 +106,9 @@ TEST(DisplayManager, LowPriceShowsGreenBackground) {
   analysis.valid = true;
   analysis.next90MinAvg = 0.05f;  // 5 cents - cheap
   analysis.cheapest90MinAvg = 0.03f;
-  analysis.currentPeriodStartTime = "14:00";
-  analysis.cheapest90MinTime = "02:00";
-  analysis.lastFetchTime = "14:05";
+  analysis.currentPeriodStart = 14 * 60;
+  analysis.cheapest90MinStart = 2 * 60;
+  analysis.lastFetchTime = 14 * 60 + 5;
   analysis.cheapestIsTomorrow = false;
   
   // Expect green background
@@ -128,9 +129,9 @@ TEST(DisplayManager, TextIsCentered) {
   analysis.valid = true;
   analysis.next90MinAvg = 0.10f;  // 10 cents
   analysis.cheapest90MinAvg = 0.05f;
-  analysis.currentPeriodStartTime = "14:00";
-  analysis.cheapest90MinTime = "02:00";
-  analysis.lastFetchTime = "14:05";
+  analysis.currentPeriodStart = 14 * 60;
+  analysis.cheapest90MinStart = 2 * 60;
+  analysis.lastFetchTime = 14 * 60 + 5;
   analysis.cheapestIsTomorrow = false;
   
   // Verify centered text positioning
@@ -148,6 +149,67 @@ TEST(DisplayManager, TextIsCentered) {
   display.showAnalysis(analysis);
 }
 
+TEST(DisplayManager, TimeLabelsFormattedFromMinutes) {
+  MockDisplayHardware mock;
+  DisplayManager display(&mock);
+  
+  PriceAnalysis analysis;
+  analysis.valid = true;
+  analysis.next90MinAvg = 0.10f;
+  analysis.cheapest90MinAvg = 0.05f;
+  analysis.currentPeriodStart = 14 * 60 + 15;
+  analysis.cheapest90MinStart = 7 * 60 + 30;
+  analysis.lastFetchTime = 14 * 60 + 16;
+  analysis.cheapestIsTomorrow = true;
+  
+  std::vector<std::string> printed;
+  EXPECT_CALL(mock, fillScreen(_)).Times(::testing::AnyNumber());
+  EXPECT_CALL(mock, setTextColor(_)).Times(::testing::AnyNumber());
+  EXPECT_CALL(mock, setTextSize(_)).Times(::testing::AnyNumber());
+  EXPECT_CALL(mock, setCursor(_, _)).Times(::testing::AnyNumber());
+  EXPECT_CALL(mock, print(_)).WillRepeatedly([&printed](const String& text) {
+    printed.push_back(text.c_str());
+  });
+  
+  display.showAnalysis(analysis);
+  
+  EXPECT_THAT(printed, ::testing::Contains("Nyt 14:15"));
+  EXPECT_THAT(printed, ::testing::Contains("Halvin 07:30 (huo)"));
+  EXPECT_THAT(printed, ::testing::Contains("14:16"));
+}
+
+TEST(DisplayManager, RunnerUpPeriodsListedInTimeOrder) {
+  MockDisplayHardware mock;
+  DisplayManager display(&mock);
+  
+  PriceAnalysis analysis;
+  analysis.valid = true;
+  analysis.next90MinAvg = 0.10f;
+  analysis.cheapest90MinAvg = 0.05f;
+  analysis.currentPeriodStart = 14 * 60 + 15;
+  analysis.cheapest90MinStart = 20 * 60;
+  analysis.lastFetchTime = 14 * 60 + 16;
+  analysis.cheapestCount = 3;
+  analysis.cheapestStarts[0] = 20 * 60;
+  analysis.cheapestStarts[1] = 13 * 60 + 30;  // Tomorrow
+  analysis.cheapestTomorrow[1] = true;
+  analysis.cheapestStarts[2] = 17 * 60 + 45;  // Today
+  
+  std::vector<std::string> printed;
+  EXPECT_CALL(mock, fillScreen(_)).Times(::testing::AnyNumber());
+  EXPECT_CALL(mock, setTextColor(_)).Times(::testing::AnyNumber());
+  EXPECT_CALL(mock, setTextSize(_)).Times(::testing::AnyNumber());
+  EXPECT_CALL(mock, setCursor(_, _)).Times(::testing::AnyNumber());
+  EXPECT_CALL(mock, print(_)).WillRepeatedly([&printed](const String& text) {
+    printed.push_back(text.c_str());
+  });
+  
+  display.showAnalysis(analysis);
+  
+  EXPECT_THAT(printed, ::testing::Contains("Halvin 20:00"));
+  EXPECT_THAT(printed, ::testing::Contains("Myös 17:45 huo 13:30"));
+}
+
 TEST(DisplayManager, CallOrderIsCorrect) {
   MockDisplayHardware mock;
   DisplayManager display(&mock);
@@ -156,9 +218,9 @@ TEST(DisplayManager, CallOrderIsCorrect) {
   analysis.valid = true;
   analysis.next90MinAvg = 0.10f;
   analysis.cheapest90MinAvg = 0.05f;
-  analysis.currentPeriodStartTime = "14:00";
-  analysis.cheapest90MinTime = "02:00";
-  analysis.lastFetchTime = "14:05";
+  analysis.currentPeriodStart = 14 * 60;
+  analysis.cheapest90MinStart = 2 * 60;
+  analysis.lastFetchTime = 14 * 60 + 5;
   analysis.cheapestIsTomorrow = false;
   
   // Verify fillScreen is called before any text operations
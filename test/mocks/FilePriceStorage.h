@@ -0,0 +1,50 @@
+#ifndef FILE_PRICE_STORAGE_H
+#define FILE_PRICE_STORAGE_H
+
+#include <cstdio>
+#include <string>
+
+#include "../../src/pricing/IPriceStorage.h"
+
+/**
+ * Host implementation of IPriceStorage: one file, replaced through a
+ * temporary and rename() so a crash mid-save keeps the old copy, as NVS
+ * does on the device. Lets tests restart a PriceMonitor against what a
+ * previous instance saved.
+ */
+class FilePriceStorage : public IPriceStorage {
+public:
+  explicit FilePriceStorage(const std::string& filePath) : path(filePath) {}
+
+  size_t load(uint8_t* buffer, size_t capacity) override {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+      return 0;
+    }
+    size_t read = fread(buffer, 1, capacity, file);
+    bool fits = fgetc(file) == EOF;
+    fclose(file);
+    return fits ? read : 0;
+  }
+
+  bool save(const uint8_t* data, size_t length) override {
+    std::string temp = path + ".tmp";
+    FILE* file = fopen(temp.c_str(), "wb");
+    if (!file) {
+      return false;
+    }
+    bool written = fwrite(data, 1, length, file) == length;
+    written = fclose(file) == 0 && written;
+    saves++;
+    return written && rename(temp.c_str(), path.c_str()) == 0;
+  }
+
+  void remove() { std::remove(path.c_str()); }
+
+  int saves = 0;
+
+private:
+  std::string path;
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef HOST_WIFI_CLIENT_H
+#define HOST_WIFI_CLIENT_H
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "../../host/HostString.h"
+
+/**
+ * Arduino's WiFiClient over a POSIX socket, with the parts of Arduino.h and
+ * WiFi.h around it that the device's ResumableTlsClient uses, so that file
+ * builds on the host against the system mbedTLS. Unlike HostHttpClient.h,
+ * which stands in for the whole HTTP stack, this keeps the device's own
+ * signatures: ResumableTlsClient.cpp overrides them.
+ *
+ * Define Arduino_h, WiFi_h and WIFI_CLIENT_H before including production
+ * headers, and link with -lmbedtls -lmbedx509 -lmbedcrypto.
+ */
+
+inline unsigned long millis() {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline unsigned long micros() {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+#define log_e(format, ...) fprintf(stderr, "[E] " format "\n", ##__VA_ARGS__)
+
+class IPAddress {
+public:
+  IPAddress() : address(0) {}
+  explicit IPAddress(uint32_t networkOrder) : address(networkOrder) {}
+
+  String toString() const {
+    struct in_addr in;
+    in.s_addr = address;
+    char text[INET_ADDRSTRLEN];
+    return String(inet_ntop(AF_INET, &in, text, sizeof(text)) ? text : "");
+  }
+
+  uint32_t address;  // Network byte order
+};
+
+struct HostWiFiClass {
+  int lookups = 0;
+
+  int hostByName(const char* host, IPAddress& result) {
+    lookups++;
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* found = nullptr;
+    if (getaddrinfo(host, nullptr, &hints, &found) != 0 || !found) {
+      return 0;
+    }
+    result = IPAddress(((struct sockaddr_in*)found->ai_addr)->sin_addr.s_addr);
+    freeaddrinfo(found);
+    return 1;
+  }
+};
+
+static HostWiFiClass WiFi;
+
+class WiFiClient {
+public:
+  virtual ~WiFiClient() { WiFiClient::stop(); }
+
+  virtual int connect(IPAddress ip, uint16_t port) { return connect(ip, port, 3000); }
+  virtual int connect(const char* host, uint16_t port) { return connect(host, port, 3000); }
+
+  // Like the core's: a non-blocking connect that waits at most `timeout` ms
+  int connect(IPAddress ip, uint16_t port, int32_t timeout) {
+    stop();
+    sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) {
+      return 0;
+    }
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = ip.address;
+    addr.sin_port = htons(port);
+    int flags = fcntl(sock, F_GETFL, 0);
+    fcntl(sock, F_SETFL, flags | O_NONBLOCK);
+    int ret = ::connect(sock, (struct sockaddr*)&addr, sizeof(addr));
+    if (ret != 0 && errno == EINPROGRESS) {
+      struct pollfd writable = {sock, POLLOUT, 0};
+      int error = 0;
+      socklen_t length = sizeof(error);
+      ret = poll(&writable, 1, timeout) == 1 && getsockopt(sock, SOL_SOCKET, SO_ERROR, &error, &length) == 0 &&
+                error == 0 ? 0 : -1;
+    }
+    if (ret != 0) {
+      stop();
+      return 0;
+    }
+    fcntl(sock, F_SETFL, flags);
+    return 1;
+  }
+
+  int connect(const char* host, uint16_t port, int32_t timeout) {
+    IPAddress ip;
+    return WiFi.hostByName(host, ip) && connect(ip, port, timeout);
+  }
+
+  virtual size_t write(uint8_t data) { return write(&data, 1); }
+
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    ssize_t n = sock < 0 ? -1 : send(sock, buffer, size, MSG_NOSIGNAL);
+    return n > 0 ? (size_t)n : 0;
+  }
+
+  virtual int available() {
+    int count = 0;
+    return sock >= 0 && ioctl(sock, FIONREAD, &count) == 0 ? count : 0;
+  }
+
+  virtual int read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+
+  virtual int read(uint8_t* buffer, size_t size) {
+    ssize_t n = sock < 0 ? -1 : recv(sock, buffer, size, MSG_DONTWAIT);
+    return n > 0 ? (int)n : -1;
+  }
+
+  virtual int peek() {
+    uint8_t c;
+    return sock >= 0 && recv(sock, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? c : -1;
+  }
+
+  virtual void flush() {}
+
+  virtual void stop() {
+    if (sock >= 0) {
+      close(sock);
+      sock = -1;
+    }
+  }
+
+  // Open until the peer's FIN is the next thing to read
+  virtual uint8_t connected() {
+    if (sock < 0) {
+      return 0;
+    }
+    uint8_t c;
+    ssize_t n = recv(sock, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    return n > 0 || (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+  }
+
+  int fd() const { return sock; }
+  void setTimeout(unsigned long ms) { timeoutMs = ms; }
+  unsigned long getTimeout() const { return timeoutMs; }
+
+private:
+  int sock = -1;
+  unsigned long timeoutMs = 1000;  // Stream's default
+};
+
+#endif
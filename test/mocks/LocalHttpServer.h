@@ -0,0 +1,240 @@
+#ifndef LOCAL_HTTP_SERVER_H
+#define LOCAL_HTTP_SERVER_H
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <strings.h>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Stand-in for the price API on 127.0.0.1, one connection at a time.
+ * Serves a single body with optional ETag and Last-Modified validators and
+ * answers conditional GETs with 304 the way a caching origin would:
+ * If-None-Match decides when present, otherwise If-Modified-Since.
+ * An encoded copy of the body (say, gzip) is served instead to requests
+ * whose Accept-Encoding names its encoding.
+ */
+class LocalHttpServer {
+public:
+  struct Request {
+    std::string path;
+    std::map<std::string, std::string> headers;  // Names lowercased
+
+    bool has(const char* name) const { return headers.count(name) > 0; }
+    std::string get(const char* name) const {
+      auto it = headers.find(name);
+      return it == headers.end() ? std::string() : it->second;
+    }
+  };
+
+  LocalHttpServer() : LocalHttpServer(true) {}
+
+  virtual ~LocalHttpServer() {
+    shutdown();
+    close(listenFd);
+  }
+
+  bool listening() const { return boundPort > 0; }
+  std::string url(const char* path = "/prices") const {
+    return std::string(scheme()) + "://127.0.0.1:" + std::to_string(boundPort) + path;
+  }
+
+  // Empty validators are left out of the response
+  void setBody(const std::string& text, const std::string& newEtag = "", const std::string& newLastModified = "") {
+    std::lock_guard<std::mutex> lock(mutex);
+    body = text;
+    etag = newEtag;
+    lastModified = newLastModified;
+  }
+
+  // Compressed by the caller; empty serves the plain body to everyone
+  void setEncodedBody(const std::string& encoding, const std::string& bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    contentEncoding = encoding;
+    encodedBody = bytes;
+  }
+
+  std::vector<Request> requests() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return received;
+  }
+
+  int fullResponses() const { return full; }
+  int notModifiedResponses() const { return notModified; }
+  int encodedResponses() const { return encoded; }
+  size_t bodyBytesSent() const { return bodyBytes; }
+
+protected:
+  // A subclass that wraps connections starts serving once it is built,
+  // and stops before it is torn down
+  explicit LocalHttpServer(bool serveNow) {
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    int yes = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;  // Any free port
+    bind(listenFd, (struct sockaddr*)&addr, sizeof(addr));
+    listen(listenFd, 4);
+    socklen_t length = sizeof(addr);
+    getsockname(listenFd, (struct sockaddr*)&addr, &length);
+    boundPort = ntohs(addr.sin_port);
+    if (serveNow) {
+      start();
+    }
+  }
+
+  void start() {
+    running = true;
+    worker = std::thread([this] { serve(); });
+  }
+
+  void shutdown() {
+    running = false;
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+
+  // Per-connection transport; plain TCP here
+  virtual const char* scheme() const { return "http"; }
+  virtual bool open(int) { return true; }
+  virtual void finish(int) {}
+  virtual ssize_t receive(int fd, char* buffer, size_t length) { return recv(fd, buffer, length, 0); }
+  virtual ssize_t transmit(int fd, const char* data, size_t length) {
+    return send(fd, data, length, MSG_NOSIGNAL);
+  }
+
+private:
+  void serve() {
+    while (running) {
+      struct pollfd waiting = {listenFd, POLLIN, 0};
+      if (poll(&waiting, 1, 20) <= 0) {
+        continue;
+      }
+      int fd = accept(listenFd, nullptr, nullptr);
+      if (fd >= 0) {
+        if (open(fd)) {
+          handle(fd);
+        }
+        finish(fd);
+        close(fd);
+      }
+    }
+  }
+
+  void handle(int fd) {
+    Request request;
+    if (!readRequest(fd, request)) {
+      return;
+    }
+
+    std::string response;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      received.push_back(request);
+      bool current;
+      if (request.has("if-none-match")) {
+        std::string tag = request.get("if-none-match");
+        current = !etag.empty() && (tag == etag || tag == "*");
+      } else {
+        current = request.has("if-modified-since") && !lastModified.empty() &&
+                  request.get("if-modified-since") == lastModified;
+      }
+
+      std::string validators;
+      if (!etag.empty()) validators += "ETag: " + etag + "\r\n";
+      if (!lastModified.empty()) validators += "Last-Modified: " + lastModified + "\r\n";
+      if (current) {
+        response = "HTTP/1.0 304 Not Modified\r\n" + validators + "\r\n";
+        notModified++;
+      } else {
+        bool encode = !contentEncoding.empty() &&
+                      request.get("accept-encoding").find(contentEncoding) != std::string::npos;
+        const std::string& payload = encode ? encodedBody : body;
+        if (encode) {
+          validators += "Content-Encoding: " + contentEncoding + "\r\n";
+          encoded++;
+        }
+        response = "HTTP/1.0 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+                   std::to_string(payload.size()) + "\r\n" + validators + "\r\n" + payload;
+        full++;
+        bodyBytes += payload.size();
+      }
+    }
+
+    size_t sent = 0;
+    while (sent < response.size()) {
+      ssize_t n = transmit(fd, response.data() + sent, response.size() - sent);
+      if (n <= 0) break;
+      sent += (size_t)n;
+    }
+  }
+
+  // Request line and headers; GET has no body
+  bool readRequest(int fd, Request& request) {
+    std::string text;
+    char c;
+    while (text.size() < 8192 && receive(fd, &c, 1) == 1) {
+      text += c;
+      if (text.size() >= 4 && text.compare(text.size() - 4, 4, "\r\n\r\n") == 0) {
+        break;
+      }
+    }
+    size_t lineEnd = text.find("\r\n");
+    if (lineEnd == std::string::npos) {
+      return false;
+    }
+    std::string requestLine = text.substr(0, lineEnd);
+    size_t first = requestLine.find(' ');
+    size_t second = requestLine.find(' ', first + 1);
+    request.path = requestLine.substr(first + 1, second - first - 1);
+
+    size_t pos = lineEnd + 2;
+    while (pos < text.size()) {
+      size_t end = text.find("\r\n", pos);
+      if (end == std::string::npos || end == pos) break;
+      std::string line = text.substr(pos, end - pos);
+      size_t colon = line.find(':');
+      if (colon != std::string::npos) {
+        std::string name = line.substr(0, colon);
+        for (auto& ch : name) ch = (char)tolower((unsigned char)ch);
+        size_t value = line.find_first_not_of(' ', colon + 1);
+        request.headers[name] = value == std::string::npos ? "" : line.substr(value);
+      }
+      pos = end + 2;
+    }
+    return true;
+  }
+
+  int listenFd = -1;
+  int boundPort = 0;
+  std::atomic<bool> running{false};
+  std::thread worker;
+
+  mutable std::mutex mutex;
+  std::string body;
+  std::string etag;
+  std::string lastModified;
+  std::string contentEncoding;
+  std::string encodedBody;
+  std::vector<Request> received;
+  std::atomic<int> full{0};
+  std::atomic<int> notModified{0};
+  std::atomic<int> encoded{0};
+  std::atomic<size_t> bodyBytes{0};
+};
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef LOCAL_TLS_SERVER_H
+#define LOCAL_TLS_SERVER_H
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+#include <cstdio>
+
+#include "LocalHttpServer.h"
+
+/**
+ * LocalHttpServer over TLS 1.2 with a throwaway self-signed certificate
+ * for 127.0.0.1 and localhost, which saveCertificate() writes out for a
+ * client that verifies its servers.
+ * Resumes sessions from tickets or, with tickets off, from its session ID
+ * cache, and counts full and resumed handshakes. forgetSessions() acts
+ * like a server restart: new ticket keys and an empty cache. Without
+ * close_notify a connection ends at the bare TCP close.
+ * Link with -lssl -lcrypto.
+ */
+class LocalTlsServer : public LocalHttpServer {
+public:
+  LocalTlsServer() : LocalHttpServer(false) {
+    key = EVP_EC_gen("prime256v1");
+    certificate = selfSigned(key);
+    context = newContext(true);
+    start();
+  }
+
+  ~LocalTlsServer() override {
+    shutdown();
+    SSL_CTX_free(context);
+    X509_free(certificate);
+    EVP_PKEY_free(key);
+  }
+
+  // Off: sessions resume by ID from the server's cache only
+  void setTickets(bool enabled) {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    SSL_CTX_free(context);
+    context = newContext(enabled);
+  }
+
+  void forgetSessions() {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    bool tickets = (SSL_CTX_get_options(context) & SSL_OP_NO_TICKET) == 0;
+    SSL_CTX_free(context);
+    context = newContext(tickets);
+  }
+
+  void setCloseNotify(bool enabled) { closeNotify = enabled; }
+
+  // As PEM, for trusting this server and no other
+  bool saveCertificate(const char* path) const {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+      return false;
+    }
+    bool written = PEM_write_X509(file, certificate) == 1;
+    return fclose(file) == 0 && written;
+  }
+
+  int fullHandshakes() const { return full; }
+  int resumedHandshakes() const { return resumed; }
+
+protected:
+  const char* scheme() const override { return "https"; }
+
+  bool open(int fd) override {
+    {
+      std::lock_guard<std::mutex> lock(contextMutex);
+      ssl = SSL_new(context);
+    }
+    SSL_set_fd(ssl, fd);
+    if (SSL_accept(ssl) != 1) {
+      ERR_clear_error();
+      return false;
+    }
+    if (SSL_session_reused(ssl)) {
+      resumed++;
+    } else {
+      full++;
+    }
+    return true;
+  }
+
+  void finish(int) override {
+    if (ssl) {
+      if (closeNotify) {
+        SSL_shutdown(ssl);
+      }
+      SSL_free(ssl);
+      ssl = nullptr;
+    }
+    ERR_clear_error();
+  }
+
+  ssize_t receive(int, char* buffer, size_t length) override {
+    return SSL_read(ssl, buffer, (int)length);
+  }
+
+  ssize_t transmit(int, const char* data, size_t length) override {
+    return SSL_write(ssl, data, (int)length);
+  }
+
+private:
+  static X509* selfSigned(EVP_PKEY* key) {
+    X509* cert = X509_new();
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char*)"127.0.0.1", -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    X509_EXTENSION* altNames = X509V3_EXT_conf_nid(nullptr, nullptr, NID_subject_alt_name,
+                                                   "IP:127.0.0.1,DNS:localhost");
+    X509_add_ext(cert, altNames, -1);
+    X509_EXTENSION_free(altNames);
+    X509_sign(cert, key, EVP_sha256());
+    return cert;
+  }
+
+  SSL_CTX* newContext(bool tickets) {
+    SSL_CTX* ctx = SSL_CTX_new(TLS_server_method());
+    SSL_CTX_set_max_proto_version(ctx, TLS1_2_VERSION);
+    SSL_CTX_use_certificate(ctx, certificate);
+    SSL_CTX_use_PrivateKey(ctx, key);
+    static const unsigned char sessionContext[] = "prices";
+    SSL_CTX_set_session_id_context(ctx, sessionContext, sizeof(sessionContext) - 1);
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+    if (!tickets) {
+      SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+    }
+    return ctx;
+  }
+
+  EVP_PKEY* key = nullptr;
+  X509* certificate = nullptr;
+  std::mutex contextMutex;
+  SSL_CTX* context = nullptr;
+  SSL* ssl = nullptr;  // Current connection; one at a time
+  std::atomic<bool> closeNotify{true};
+  std::atomic<int> full{0};
+  std::atomic<int> resumed{0};
+};
+
+#endif
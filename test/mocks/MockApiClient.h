@@ -2,7 +2,7 @@
 #define MOCK_API_CLIENT_H
 
 #include "../../src/pricing/IApiClient.h"
-#include "../TestStringAdapter.h"
+#include "../../host/HostString.h"
 
 /**
  * Mock implementation of IApiClient for testing.
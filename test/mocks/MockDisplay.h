@@ -2,7 +2,7 @@
 #define MOCK_DISPLAY_H
 
 #include "../../src/display/IDisplay.h"
-#include "../TestStringAdapter.h"
+#include "../../host/HostString.h"
 
 /**
  * Mock implementation of IDisplay for testing.
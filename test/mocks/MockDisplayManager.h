@@ -1,7 +1,7 @@
 #ifndef MOCK_DISPLAY_MANAGER_H
 #define MOCK_DISPLAY_MANAGER_H
 
-#include "../TestStringAdapter.h"
+#include "../../host/HostString.h"
 #include "../../src/PriceData.h"
 
 class DisplayManager {
@@ -1,7 +1,7 @@
 #ifndef MOCK_PRICE_API_CLIENT_H
 #define MOCK_PRICE_API_CLIENT_H
 
-#include "../TestStringAdapter.h"
+#include "../../host/HostString.h"
 
 class PriceApiClient {
 public:
@@ -0,0 +1,16 @@
+#ifndef MOCK_WIFI_H
+#define MOCK_WIFI_H
+
+// Stands in for WiFi.h where only WiFi.status() is asked: connected unless
+// a test sets mockStatus. Include before the production headers.
+#define WL_CONNECTED 3
+namespace {
+  struct MockWiFiClass {
+    int status() { return mockStatus; }
+    static int mockStatus;
+  } WiFi;
+  int MockWiFiClass::mockStatus = WL_CONNECTED;
+}
+#define WiFi_h
+
+#endif
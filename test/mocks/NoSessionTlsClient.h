@@ -0,0 +1,15 @@
+#ifndef NO_SESSION_TLS_CLIENT_H
+#define NO_SESSION_TLS_CLIENT_H
+
+// ResumableTlsClient for PriceApiClient tests without TLS: the test's own
+// WiFiClientSecure underneath, and no session to keep. Define
+// RESUMABLE_TLS_CLIENT_H and declare WiFiClientSecure before including.
+class ResumableTlsClient : public WiFiClientSecure {
+public:
+  bool setSession(const uint8_t*, size_t) { return false; }
+  size_t getSession(uint8_t*, size_t) { return 0; }
+  bool sessionResumed() const { return false; }
+  unsigned long handshakeMicros() const { return 0; }
+};
+
+#endif
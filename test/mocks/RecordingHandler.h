@@ -0,0 +1,23 @@
+#ifndef RECORDING_HANDLER_H
+#define RECORDING_HANDLER_H
+
+#include <string>
+#include "../../src/pricing/IApiClient.h"
+
+// Keeps the last body it was handed, read to the end, and counts the calls
+class RecordingHandler : public IApiClient::BodyHandler {
+public:
+  std::string received;
+  int calls = 0;
+
+  void handleBody(BodyReader& body) override {
+    calls++;
+    received.clear();
+    int c;
+    while ((c = body.read()) >= 0) {
+      received += (char)c;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef SCRIPTED_WIFI_HARDWARE_H
+#define SCRIPTED_WIFI_HARDWARE_H
+
+#include <cstring>
+#include <vector>
+
+#include "../../src/network/IWiFiHardware.h"
+
+/**
+ * A radio whose joins follow a script: each begin() or beginDirected()
+ * schedules the script's events at their offsets from the join, on a
+ * virtual clock. waitForLink() jumps the clock to the next event, or by the
+ * whole timeout when none comes sooner, so tests see exactly when connect()
+ * returned relative to the event. An SNTP reply arrives `timeSyncAfterMs`
+ * after configTime() (never when negative) and moves the clock by
+ * `timeSyncCorrectionMs`. Define String and the WL_ and WIFI_ constants
+ * before including.
+ */
+class ScriptedWiFiHardware : public IWiFiHardware {
+public:
+  struct Step {
+    unsigned long atMs;  // After the join starts
+    LinkEvent event;
+  };
+
+  std::vector<Step> scanJoin = {{1700, LINK_ASSOCIATED}, {2000, LINK_GOT_IP}};
+  std::vector<Step> directedJoin = {{120, LINK_ASSOCIATED}, {150, LINK_GOT_IP}};
+  WiFiLink lease = {{0x10, 0x20, 0x30, 0x40, 0x50, 0x60}, 6, 0, 0x3201A8C0, 0x0101A8C0, 0x00FFFFFF, 0x0101A8C0};
+
+  unsigned long clockMs = 0;
+  int scans = 0;
+  int directedJoins = 0;
+  int resets = 0;
+  WiFiLink directedTo = {};
+  unsigned long lastEventAt = 0;  // Clock when the last event was delivered
+
+  long timeSyncAfterMs = 80;
+  long timeSyncCorrectionMs = 0;
+  int timeRequests = 0;
+  int timeWaits = 0;  // Blocking ones; a zero timeout only checks
+
+  int getStatus() override { return linked ? WL_CONNECTED : WL_DISCONNECTED; }
+  void setMode(int) override {}
+
+  void disconnect(bool) override {
+    resets++;
+    linked = false;
+    pending.clear();
+  }
+
+  void begin(const char*, const char*) override {
+    scans++;
+    start(scanJoin);
+  }
+
+  void beginDirected(const char*, const char*, const WiFiLink& link) override {
+    directedJoins++;
+    directedTo = link;
+    start(directedJoin);
+  }
+
+  bool readLink(WiFiLink& link) override {
+    if (!linked) {
+      return false;
+    }
+    link = lease;
+    return true;
+  }
+
+  LinkEvent waitForLink(unsigned long timeoutMs) override {
+    if (pending.empty() || pending.front().atMs > clockMs + timeoutMs) {
+      clockMs += timeoutMs;
+      return LINK_TIMEOUT;
+    }
+    Step step = pending.front();
+    pending.erase(pending.begin());
+    if (step.atMs > clockMs) {
+      clockMs = step.atMs;
+    }
+    lastEventAt = clockMs;
+    linked = step.event == LINK_GOT_IP;
+    return step.event;
+  }
+
+  String getLocalIP() override { return String(linked ? "192.168.1.50" : "0.0.0.0"); }
+  void delayMs(unsigned long ms) override { clockMs += ms; }
+  unsigned long nowMs() override { return clockMs; }
+  void configTime(long, int, const char*) override {
+    timeRequests++;
+    timeSyncDueAt = timeSyncAfterMs < 0 ? -1 : (long)(clockMs + timeSyncAfterMs);
+  }
+
+  bool waitForTimeSync(unsigned long timeoutMs, long& correctionMs) override {
+    if (timeoutMs > 0) {
+      timeWaits++;
+    }
+    if (timeSyncDueAt < 0 || (unsigned long)timeSyncDueAt > clockMs + timeoutMs) {
+      clockMs += timeoutMs;
+      return false;
+    }
+    if ((unsigned long)timeSyncDueAt > clockMs) {
+      clockMs = timeSyncDueAt;
+    }
+    correctionMs = timeSyncCorrectionMs;
+    return true;
+  }
+
+  // The radio switched off between fetches
+  void sleep() {
+    linked = false;
+    pending.clear();
+  }
+
+private:
+  void start(const std::vector<Step>& script) {
+    linked = false;
+    pending.clear();
+    for (const Step& step : script) {
+      pending.push_back({clockMs + step.atMs, step.event});
+    }
+  }
+
+  bool linked = false;
+  std::vector<Step> pending;  // At absolute clock times
+  long timeSyncDueAt = -1;
+};
+
+#endif
@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+
+#include "../../src/network/RetryPolicy.h"
+
+static uint32_t randomValue = 0;
+static uint32_t fakeRandom() { return randomValue; }
+
+static const unsigned long MINUTE = 60UL * 1000;
+static const unsigned long FAILED_ATTEMPT_MS = 15000;  // A spent FetchBudget
+
+// Fails `count` attempts, each as soon as scheduled fetches are allowed again
+static unsigned long failInARow(RetryPolicy& policy, unsigned long now, int count) {
+  for (int i = 0; i < count; i++) {
+    now += policy.waitMs(now);
+    policy.record(now, false, FAILED_ATTEMPT_MS);
+  }
+  return now;
+}
+
+// Test Suite: backoff
+
+TEST(RetryPolicy, FirstAttemptIsAllowed) {
+  RetryPolicy policy(fakeRandom);
+
+  EXPECT_EQ(policy.check(0, false), RetryPolicy::ATTEMPT);
+  EXPECT_EQ(policy.waitMs(0), 0u);
+}
+
+TEST(RetryPolicy, BackoffDoubles) {
+  randomValue = 0;  // The shortest jitter: three quarters of the delay
+  RetryPolicy policy(fakeRandom);
+  unsigned long now = 1000;
+
+  policy.record(now, false, FAILED_ATTEMPT_MS);
+  EXPECT_EQ(policy.check(now + 3 * MINUTE, false), RetryPolicy::BACKING_OFF);
+  EXPECT_EQ(policy.waitMs(now), RetryPolicy::BASE_DELAY_MS * 3 / 4);
+  EXPECT_EQ(policy.check(now + RetryPolicy::BASE_DELAY_MS * 3 / 4, false), RetryPolicy::ATTEMPT);
+
+  now += 4 * MINUTE;
+  policy.record(now, false, FAILED_ATTEMPT_MS);
+  EXPECT_EQ(policy.waitMs(now), RetryPolicy::BASE_DELAY_MS * 2 * 3 / 4);
+
+  now += 8 * MINUTE;
+  policy.record(now, false, FAILED_ATTEMPT_MS);
+  EXPECT_EQ(policy.waitMs(now), RetryPolicy::BASE_DELAY_MS * 4 * 3 / 4);
+}
+
+TEST(RetryPolicy, JitterStaysWithinAQuarter) {
+  RetryPolicy::Random randoms[] = {[]() -> uint32_t { return 0; }, []() -> uint32_t { return 0xFFFFFFFF; },
+                                   []() -> uint32_t { return 123456789; }};
+  for (RetryPolicy::Random random : randoms) {
+    RetryPolicy policy(random);
+    policy.record(0, false, FAILED_ATTEMPT_MS);
+    EXPECT_GE(policy.waitMs(0), RetryPolicy::BASE_DELAY_MS * 3 / 4);
+    EXPECT_LE(policy.waitMs(0), RetryPolicy::BASE_DELAY_MS * 5 / 4);
+  }
+}
+
+TEST(RetryPolicy, DelayIsCapped) {
+  randomValue = 0;
+  RetryPolicy policy(fakeRandom);
+  unsigned long now = failInARow(policy, 0, RetryPolicy::BREAKER_FAILURES - 1);
+
+  EXPECT_EQ(policy.waitMs(now), RetryPolicy::MAX_DELAY_MS * 3 / 4);
+}
+
+TEST(RetryPolicy, ButtonPressSkipsBackoff) {
+  RetryPolicy policy(fakeRandom);
+  policy.record(0, false, FAILED_ATTEMPT_MS);
+
+  EXPECT_EQ(policy.check(MINUTE, false), RetryPolicy::BACKING_OFF);
+  EXPECT_EQ(policy.check(MINUTE, true), RetryPolicy::ATTEMPT);
+}
+
+TEST(RetryPolicy, SuccessResets) {
+  RetryPolicy policy(fakeRandom);
+  unsigned long now = failInARow(policy, 0, 3);
+  now += policy.waitMs(now);
+  policy.record(now, true, 3000);
+
+  EXPECT_EQ(policy.consecutiveFailures(), 0);
+  EXPECT_EQ(policy.check(now + 1, false), RetryPolicy::ATTEMPT);
+
+  // The next failure starts over at the base delay
+  randomValue = 0;
+  policy.record(now + 1, false, FAILED_ATTEMPT_MS);
+  EXPECT_EQ(policy.waitMs(now + 1), RetryPolicy::BASE_DELAY_MS * 3 / 4);
+}
+
+// Test Suite: circuit breaker
+
+TEST(RetryPolicy, CircuitOpensAfterFailuresInARow) {
+  RetryPolicy policy(fakeRandom);
+  unsigned long now = failInARow(policy, 0, RetryPolicy::BREAKER_FAILURES);
+
+  EXPECT_EQ(policy.check(now + MINUTE, false), RetryPolicy::CIRCUIT_OPEN);
+  EXPECT_EQ(policy.check(now + MINUTE, true), RetryPolicy::CIRCUIT_OPEN);  // Button too
+  EXPECT_EQ(policy.waitMs(now + MINUTE), RetryPolicy::OPEN_MS - MINUTE);
+  EXPECT_EQ(policy.check(now + RetryPolicy::OPEN_MS, false), RetryPolicy::ATTEMPT);
+}
+
+TEST(RetryPolicy, FailedTrialReopens) {
+  RetryPolicy policy(fakeRandom);
+  unsigned long now = failInARow(policy, 0, RetryPolicy::BREAKER_FAILURES);
+
+  now += RetryPolicy::OPEN_MS;
+  policy.record(now, false, FAILED_ATTEMPT_MS);
+  EXPECT_EQ(policy.check(now + MINUTE, true), RetryPolicy::CIRCUIT_OPEN);
+  EXPECT_EQ(policy.waitMs(now), RetryPolicy::OPEN_MS);
+}
+
+TEST(RetryPolicy, SuccessfulTrialCloses) {
+  RetryPolicy policy(fakeRandom);
+  unsigned long now = failInARow(policy, 0, RetryPolicy::BREAKER_FAILURES);
+
+  now += RetryPolicy::OPEN_MS;
+  policy.record(now, true, 3000);
+  EXPECT_EQ(policy.check(now + MINUTE, true), RetryPolicy::ATTEMPT);
+  EXPECT_EQ(policy.check(now + MINUTE, false), RetryPolicy::ATTEMPT);
+}
+
+// Test Suite: daily budget
+
+TEST(RetryPolicy, DailyAttemptsAreCapped) {
+  RetryPolicy policy(fakeRandom);
+  unsigned long now = 0;
+  // Each failure followed by a fetch that gets through, so the circuit stays closed
+  for (int i = 0; i < RetryPolicy::DAILY_ATTEMPTS; i++) {
+    ASSERT_EQ(policy.check(now, true), RetryPolicy::ATTEMPT);
+    policy.record(now, false, 1000);
+    policy.record(now + MINUTE, true, 1000);
+    now += 10 * MINUTE;
+  }
+
+  EXPECT_EQ(policy.check(now, true), RetryPolicy::BUDGET_SPENT);
+  // The day counts from its first failed attempt
+  EXPECT_EQ(policy.waitMs(now), RetryPolicy::DAY_MS - now);
+  EXPECT_EQ(policy.check(RetryPolicy::DAY_MS, true), RetryPolicy::ATTEMPT);
+}
+
+TEST(RetryPolicy, DailyRadioTimeIsCapped) {
+  RetryPolicy policy(fakeRandom);
+  unsigned long now = 0;
+  int attempts = 0;
+  // Failures that keep the radio on for a minute each
+  while (policy.check(now, true) == RetryPolicy::ATTEMPT && attempts < 100) {
+    policy.record(now, false, 60000);
+    policy.record(now, true, 1000);
+    attempts++;
+    now += MINUTE;
+  }
+
+  EXPECT_EQ(attempts, (int)(RetryPolicy::DAILY_RADIO_MS / 60000));
+  EXPECT_EQ(policy.check(now, true), RetryPolicy::BUDGET_SPENT);
+}
+
+TEST(RetryPolicy, SuccessfulFetchesAreNotCounted) {
+  RetryPolicy policy(fakeRandom);
+  unsigned long now = 0;
+  // Far more scheduled fetches and button presses than the day allows
+  // failures, each with a long radio time
+  for (int i = 0; i < 4 * RetryPolicy::DAILY_ATTEMPTS; i++) {
+    ASSERT_EQ(policy.check(now, i % 2 == 0), RetryPolicy::ATTEMPT);
+    policy.record(now, true, 60000);
+    now += 5 * MINUTE;
+  }
+
+  // The budget is untouched: the day's first failure only backs off
+  policy.record(now, false, 1000);
+  EXPECT_EQ(policy.check(now + MINUTE, false), RetryPolicy::BACKING_OFF);
+  EXPECT_EQ(policy.check(now + MINUTE, true), RetryPolicy::ATTEMPT);
+}
+
+TEST(RetryPolicy, SurvivesMillisWrap) {
+  randomValue = 0;
+  RetryPolicy policy(fakeRandom);
+  unsigned long now = 0xFFFFFFFFUL - MINUTE;
+  policy.record(now, false, FAILED_ATTEMPT_MS);
+
+  unsigned long later = (now + 2 * MINUTE) & 0xFFFFFFFFUL;  // millis() on the device is 32 bits
+  EXPECT_EQ(policy.check(later, false), RetryPolicy::BACKING_OFF);
+  EXPECT_EQ(policy.waitMs(later), RetryPolicy::BASE_DELAY_MS * 3 / 4 - 2 * MINUTE);
+}
+
+// Test Suite: a simulated outage. Quarter-hour ticks and a button press
+// every two hours, on a clock the test advances; every attempt while the
+// router is down spends a whole fetch budget.
+
+struct Outcome {
+  int attempts = 0;
+  unsigned long radioMs = 0;
+  unsigned long recoveredAt = 0;  // First successful fetch after the outage
+};
+
+static Outcome simulate(RetryPolicy* policy, unsigned long outageMs, unsigned long totalMs) {
+  const unsigned long TICK = 15 * MINUTE;
+  Outcome outcome;
+  for (unsigned long now = TICK; now <= totalMs; now += TICK) {
+    bool pressed = now % (120 * MINUTE) == 0;
+    if (policy && policy->check(now, pressed) != RetryPolicy::ATTEMPT) {
+      continue;
+    }
+    bool up = now >= outageMs;
+    unsigned long radioMs = up ? 3000 : FAILED_ATTEMPT_MS;
+    outcome.attempts++;
+    outcome.radioMs += radioMs;
+    if (policy) {
+      policy->record(now, up, radioMs);
+    }
+    if (up && outcome.recoveredAt == 0) {
+      outcome.recoveredAt = now;
+    }
+  }
+  return outcome;
+}
+
+TEST(RetryPolicySimulation, DayLongOutage) {
+  const unsigned long DAY = RetryPolicy::DAY_MS;
+  randomValue = 0x9E3779B9;
+
+  // Without the policy every tick tries; fetches the scheduler would skip
+  // once prices are back are not counted here
+  Outcome unlimited = simulate(nullptr, DAY, DAY - 1);
+  RetryPolicy policy(fakeRandom);
+  Outcome limited = simulate(&policy, DAY, DAY - 1);
+
+  EXPECT_EQ(unlimited.attempts, 95);
+  EXPECT_LT(limited.attempts, 25);
+  EXPECT_LE(limited.radioMs, RetryPolicy::DAILY_RADIO_MS + FAILED_ATTEMPT_MS);
+  EXPECT_LT(limited.radioMs * 4, unlimited.radioMs);
+}
+
+TEST(RetryPolicySimulation, RecoversWithinTheOpenPeriod) {
+  randomValue = 0x9E3779B9;
+  RetryPolicy policy(fakeRandom);
+  const unsigned long outage = 5 * 3600 * 1000UL;
+
+  Outcome outcome = simulate(&policy, outage, 12 * 3600 * 1000UL);
+
+  ASSERT_GT(outcome.recoveredAt, 0u);
+  EXPECT_LE(outcome.recoveredAt - outage, RetryPolicy::OPEN_MS);
+  EXPECT_EQ(policy.consecutiveFailures(), 0);
+}
+
+TEST(RetryPolicySimulation, ShortDropoutCostsOneBackoff) {
+  randomValue = 0;
+  RetryPolicy policy(fakeRandom);
+
+  // Down for one tick only: the next tick is already past the first delay
+  Outcome outcome = simulate(&policy, 20 * MINUTE, 3600 * 1000UL);
+
+  EXPECT_EQ(outcome.recoveredAt, 30 * MINUTE);
+  EXPECT_EQ(outcome.attempts, 4);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
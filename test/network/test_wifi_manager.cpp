@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <cstring>
 #include <string>
 
 // Mock Arduino String class
@@ -53,9 +54,16 @@ public:
   MOCK_METHOD(void, setMode, (int mode), (override));
   MOCK_METHOD(void, disconnect, (bool wifiOff), (override));
   MOCK_METHOD(void, begin, (const char* ssid, const char* pass), (override));
+  MOCK_METHOD(void, beginDirected, (const char* ssid, const char* pass, const WiFiLink& link), (override));
+  MOCK_METHOD(bool, readLink, (WiFiLink& link), (override));
+  MOCK_METHOD(LinkEvent, waitForLink, (unsigned long timeoutMs), (override));
   MOCK_METHOD(String, getLocalIP, (), (override));
   MOCK_METHOD(void, delayMs, (unsigned long ms), (override));
   MOCK_METHOD(void, configTime, (long gmtOffset, int daylightOffset, const char* server), (override));
+  MOCK_METHOD(bool, waitForTimeSync, (unsigned long timeoutMs, long& correctionMs), (override));
+
+  unsigned long nowMs() override { return clockMs; }
+  unsigned long clockMs = 0;
 };
 
 // Test configuration constants
@@ -68,9 +76,12 @@ const int DAYLIGHT_OFFSET_SEC = 3600;
 // WiFi status constants from WiFi.h
 #define WL_CONNECTED 3
 #define WL_CONNECT_FAILED 4
+#define WL_DISCONNECTED 6
 #define WIFI_STA 1
 #define WIFI_OFF 0
 
+#include "../mocks/ScriptedWiFiHardware.h"
+
 #define WIFI_MANAGER_GLOBALS_DEFINED
 #include "../../src/network/WiFiManager.cpp"
 
@@ -89,7 +100,7 @@ TEST(WiFiManagerTest, ConnectWhenAlreadyConnected) {
   EXPECT_TRUE(result);
 }
 
-// Test: Successful connection on first attempt
+// Test: Successful connection on the got-IP event
 TEST(WiFiManagerTest, ConnectSuccess) {
   MockWiFiHardware mockWifi;
   WiFiManager manager(&mockWifi);
@@ -106,13 +117,11 @@ TEST(WiFiManagerTest, ConnectSuccess) {
   EXPECT_CALL(mockWifi, delayMs(500));
   EXPECT_CALL(mockWifi, begin(Eq(WIFI_SSID), Eq(WIFI_PASS)));
   
-  // Connection loop - connect on first iteration
-  EXPECT_CALL(mockWifi, getStatus())
-    .WillOnce(Return(WL_CONNECTED));
+  // One wait, for as long as a join may take
+  EXPECT_CALL(mockWifi, waitForLink(20000))
+    .WillOnce(Return(IWiFiHardware::LINK_GOT_IP));
   
   // Success path
-  EXPECT_CALL(mockWifi, getStatus())
-    .WillOnce(Return(WL_CONNECTED));
   EXPECT_CALL(mockWifi, getLocalIP())
     .WillOnce(Return(String("192.168.1.50")));
   EXPECT_CALL(mockWifi, configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, Eq(NTP_SERVER)));
@@ -122,32 +131,23 @@ TEST(WiFiManagerTest, ConnectSuccess) {
   EXPECT_TRUE(result);
 }
 
-// Test: Connection after multiple retries
-TEST(WiFiManagerTest, ConnectAfterRetries) {
+// Test: A dropped association during a scan is retried by the core; the wait goes on
+TEST(WiFiManagerTest, ConnectAfterDrop) {
   MockWiFiHardware mockWifi;
   WiFiManager manager(&mockWifi);
 
-  // Don't use InSequence for this test - just use Times()
-  
-  // Initial status check
   EXPECT_CALL(mockWifi, getStatus())
-    .Times(7)  // Initial + 3 loop checks + final check + check for printing + success check
-    .WillOnce(Return(WL_CONNECT_FAILED))   // Initial
-    .WillOnce(Return(WL_CONNECT_FAILED))   // Loop iteration 0
-    .WillOnce(Return(WL_CONNECT_FAILED))   // Status check for print (i=0)
-    .WillOnce(Return(WL_CONNECT_FAILED))   // Loop iteration 1
-    .WillOnce(Return(WL_CONNECT_FAILED))   // Loop iteration 2
-    .WillOnce(Return(WL_CONNECTED))        // Loop check - breaks
-    .WillOnce(Return(WL_CONNECTED));       // Final success check
-  
-  // Setup
+    .WillOnce(Return(WL_CONNECT_FAILED));
   EXPECT_CALL(mockWifi, setMode(WIFI_STA));
   EXPECT_CALL(mockWifi, disconnect(true));
-  EXPECT_CALL(mockWifi, delayMs(500))
-    .Times(4);  // Once for setup, 3 times in loop
+  EXPECT_CALL(mockWifi, delayMs(500));
   EXPECT_CALL(mockWifi, begin(Eq(WIFI_SSID), Eq(WIFI_PASS)));
-  
-  // Success path
+  EXPECT_CALL(mockWifi, waitForLink(_))
+    .WillOnce([&mockWifi](unsigned long) {
+      mockWifi.clockMs += 1200;
+      return IWiFiHardware::LINK_DISCONNECTED;
+    })
+    .WillOnce(Return(IWiFiHardware::LINK_GOT_IP));
   EXPECT_CALL(mockWifi, getLocalIP())
     .WillOnce(Return(String("192.168.1.75")));
   EXPECT_CALL(mockWifi, configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, Eq(NTP_SERVER)));
@@ -157,7 +157,7 @@ TEST(WiFiManagerTest, ConnectAfterRetries) {
   EXPECT_TRUE(result);
 }
 
-// Test: Connection timeout after 40 retries
+// Test: No event within 20 s
 TEST(WiFiManagerTest, ConnectTimeout) {
   MockWiFiHardware mockWifi;
   WiFiManager manager(&mockWifi);
@@ -174,22 +174,13 @@ TEST(WiFiManagerTest, ConnectTimeout) {
   EXPECT_CALL(mockWifi, delayMs(500));
   EXPECT_CALL(mockWifi, begin(Eq(WIFI_SSID), Eq(WIFI_PASS)));
   
-  // Connection loop - fail all 40 attempts
-  for (int i = 0; i < 40; ++i) {
-    EXPECT_CALL(mockWifi, getStatus())
-      .WillOnce(Return(WL_CONNECT_FAILED));
-    EXPECT_CALL(mockWifi, delayMs(500));
-    
-    // Status check every 5 iterations
-    if (i % 5 == 0) {
-      EXPECT_CALL(mockWifi, getStatus())
-        .WillOnce(Return(WL_CONNECT_FAILED));
-    }
-  }
+  EXPECT_CALL(mockWifi, waitForLink(20000))
+    .WillOnce([&mockWifi](unsigned long ms) {
+      mockWifi.clockMs += ms;
+      return IWiFiHardware::LINK_TIMEOUT;
+    });
   
-  // Final status check - still failed
-  EXPECT_CALL(mockWifi, getStatus())
-    .WillOnce(Return(WL_CONNECT_FAILED));
+  // Status for the failure message
   EXPECT_CALL(mockWifi, getStatus())
     .WillOnce(Return(WL_CONNECT_FAILED));
 
@@ -198,6 +189,274 @@ TEST(WiFiManagerTest, ConnectTimeout) {
   EXPECT_FALSE(result);
 }
 
+// Milliseconds for FetchBudget, advanced by the mocked waits
+static unsigned long fakeMillis = 0;
+static unsigned long fakeClock() { return fakeMillis; }
+
+// Test: A budget cuts the wait to what its WIFI stage has left
+TEST(WiFiManagerTest, ConnectStopsWhenBudgetRunsOut) {
+  MockWiFiHardware mockWifi;
+  WiFiManager manager(&mockWifi);
+  fakeMillis = 0;
+  FetchBudget::Limits limits = {15000, {3000, 3000, 3000, 3000, 6000, 4000, 5000}};
+  FetchBudget budget(fakeClock, limits);
+
+  EXPECT_CALL(mockWifi, getStatus()).WillRepeatedly(Return(WL_CONNECT_FAILED));
+  EXPECT_CALL(mockWifi, setMode(WIFI_STA));
+  EXPECT_CALL(mockWifi, disconnect(true));
+  EXPECT_CALL(mockWifi, begin(Eq(WIFI_SSID), Eq(WIFI_PASS)));
+  EXPECT_CALL(mockWifi, delayMs(500)).WillOnce([](unsigned long ms) { fakeMillis += ms; });
+  // The settle delay took 500 ms of the 3 s stage
+  EXPECT_CALL(mockWifi, waitForLink(2500))
+    .WillOnce([](unsigned long ms) {
+      fakeMillis += ms;
+      return IWiFiHardware::LINK_TIMEOUT;
+    });
+  EXPECT_CALL(mockWifi, configTime(_, _, _)).Times(0);
+
+  EXPECT_FALSE(manager.connect(&budget));
+  EXPECT_EQ(budget.exhaustedStage(), FetchBudget::WIFI);
+}
+
+// Test: A spent budget does not turn the radio on
+TEST(WiFiManagerTest, ConnectSkippedWhenBudgetSpent) {
+  MockWiFiHardware mockWifi;
+  WiFiManager manager(&mockWifi);
+  fakeMillis = 0;
+  FetchBudget budget(fakeClock);
+  fakeMillis = FetchBudget::TOTAL_MS;
+
+  EXPECT_CALL(mockWifi, getStatus()).WillRepeatedly(Return(WL_CONNECT_FAILED));
+  EXPECT_CALL(mockWifi, setMode(_)).Times(0);
+  EXPECT_CALL(mockWifi, begin(_, _)).Times(0);
+
+  EXPECT_FALSE(manager.connect(&budget));
+  EXPECT_EQ(budget.exhaustedStage(), FetchBudget::WIFI);
+}
+
+// Test: connect() returns at the got-IP event, not at the next poll
+TEST(WiFiManagerTest, ReturnsAtGotIpEvent) {
+  ScriptedWiFiHardware wifi;
+  wifi.scanJoin = {{310, IWiFiHardware::LINK_GOT_IP}};
+  WiFiManager manager(&wifi);
+
+  ASSERT_TRUE(manager.connect());
+
+  EXPECT_LT(wifi.nowMs() - wifi.lastEventAt, 1u);
+  EXPECT_EQ(manager.lastTiming().scanMs, 500u + 310u);  // Settle delay, then the join
+}
+
+// Test: A drop during a scan waits for the core's retry within the same deadline
+TEST(WiFiManagerTest, ScanSurvivesDrop) {
+  ScriptedWiFiHardware wifi;
+  wifi.scanJoin = {{800, IWiFiHardware::LINK_DISCONNECTED}, {2400, IWiFiHardware::LINK_GOT_IP}};
+  WiFiManager manager(&wifi);
+
+  ASSERT_TRUE(manager.connect());
+  EXPECT_EQ(wifi.nowMs(), wifi.lastEventAt);
+  EXPECT_EQ(manager.lastTiming().scanMs, 500u + 2400u);
+}
+
+// RTC memory after power-on holds whatever the cells settled to
+static void powerOn(WiFiLinkCache::Slot& slot) {
+  memset(&slot, 0xA5, sizeof(slot));
+}
+
+// Test: The first join scans and keeps the link; the next goes straight to it
+TEST(WiFiManagerTest, SecondJoinIsDirected) {
+  ScriptedWiFiHardware wifi;
+  WiFiLinkCache::Slot slot;
+  powerOn(slot);
+  WiFiLinkCache links(slot);
+  WiFiManager manager(&wifi, &links);
+
+  ASSERT_TRUE(manager.connect());
+  EXPECT_EQ(wifi.scans, 1);
+  EXPECT_EQ(wifi.directedJoins, 0);
+  EXPECT_FALSE(manager.lastTiming().directed);
+
+  wifi.sleep();
+  unsigned long started = wifi.nowMs();
+  ASSERT_TRUE(manager.connect());
+
+  EXPECT_EQ(wifi.scans, 1);
+  EXPECT_EQ(wifi.directedJoins, 1);
+  EXPECT_EQ(wifi.resets, 1);  // Only the scan resets the radio
+  EXPECT_EQ(memcmp(&wifi.directedTo, &wifi.lease, sizeof(WiFiLink)), 0);
+  EXPECT_TRUE(manager.lastTiming().directed);
+  EXPECT_EQ(manager.lastTiming().directedMs, 150u);
+  EXPECT_EQ(wifi.nowMs() - started, 150u);
+}
+
+// Test: A directed join that is refused falls back to a scan at once, and
+// the scan's lease replaces the cached one
+TEST(WiFiManagerTest, RefusedDirectedJoinScans) {
+  ScriptedWiFiHardware wifi;
+  wifi.directedJoin = {{40, IWiFiHardware::LINK_DISCONNECTED}};
+  WiFiLinkCache::Slot slot;
+  powerOn(slot);
+  WiFiLinkCache links(slot);
+  WiFiLink moved = wifi.lease;
+  moved.channel = 11;
+  links.store(WIFI_SSID, moved, time(nullptr));
+  WiFiManager manager(&wifi, &links);
+
+  ASSERT_TRUE(manager.connect());
+
+  EXPECT_EQ(wifi.directedJoins, 1);
+  EXPECT_EQ(wifi.scans, 1);
+  EXPECT_FALSE(manager.lastTiming().directed);
+  EXPECT_EQ(manager.lastTiming().directedMs, 40u);
+  WiFiLink cached;
+  ASSERT_TRUE(links.find(WIFI_SSID, time(nullptr), cached));
+  EXPECT_EQ(cached.channel, 6);
+}
+
+// Test: A directed join that hears nothing gives up after 3 s
+TEST(WiFiManagerTest, SilentDirectedJoinScans) {
+  ScriptedWiFiHardware wifi;
+  wifi.directedJoin = {};
+  WiFiLinkCache::Slot slot;
+  powerOn(slot);
+  WiFiLinkCache links(slot);
+  links.store(WIFI_SSID, wifi.lease, time(nullptr));
+  WiFiManager manager(&wifi, &links);
+
+  ASSERT_TRUE(manager.connect());
+  EXPECT_EQ(manager.lastTiming().directedMs, 3000u);
+  EXPECT_EQ(wifi.scans, 1);
+}
+
+// Test: An address leased too long ago is not reused
+TEST(WiFiManagerTest, OldLeaseScans) {
+  ScriptedWiFiHardware wifi;
+  WiFiLinkCache::Slot slot;
+  powerOn(slot);
+  WiFiLinkCache links(slot);
+  links.store(WIFI_SSID, wifi.lease, time(nullptr) - WiFiLinkCache::MAX_LEASE_AGE_S - 60);
+  WiFiManager manager(&wifi, &links);
+
+  EXPECT_TRUE(manager.connect());
+  EXPECT_EQ(wifi.directedJoins, 0);
+  EXPECT_EQ(wifi.scans, 1);
+}
+
+// Test: The cached link belongs to one network and one run of the clock
+TEST(WiFiLinkCacheTest, RejectsGarbageOtherNetworkAndClockReset) {
+  WiFiLinkCache::Slot slot;
+  powerOn(slot);
+  WiFiLinkCache links(slot);
+  WiFiLink link = {{1, 2, 3, 4, 5, 6}, 1, 0, 0x0A00000A, 0x0100000A, 0x00FFFFFF, 0x0100000A};
+  WiFiLink found;
+  EXPECT_FALSE(links.find(WIFI_SSID, 1000000, found));
+
+  links.store(WIFI_SSID, link, 1000000);
+  EXPECT_TRUE(links.find(WIFI_SSID, 1000000 + 3600, found));
+  EXPECT_EQ(memcmp(&found, &link, sizeof(link)), 0);
+  EXPECT_FALSE(links.find("OtherSSID", 1000000, found));
+  EXPECT_FALSE(links.find(WIFI_SSID, 5, found));  // Reset: time() starts over
+
+  slot.link.channel ^= 1;  // A flipped bit in RTC memory
+  EXPECT_FALSE(links.find(WIFI_SSID, 1000000, found));
+
+  links.store(WIFI_SSID, link, 1000000);
+  links.forget();
+  EXPECT_FALSE(links.find(WIFI_SSID, 1000000, found));
+}
+
+// Test: The first join after power-on stamps its lease before SNTP has set
+// the clock; once set, the lease is dated to the sync and found afterwards
+TEST(WiFiLinkCacheTest, LeaseFromUnsetClockIsRedatedWhenTheClockIsSet) {
+  WiFiLinkCache::Slot slot;
+  powerOn(slot);
+  WiFiLinkCache links(slot);
+  WiFiLink link = {{1, 2, 3, 4, 5, 6}, 1, 0, 0x0A00000A, 0x0100000A, 0x00FFFFFF, 0x0100000A};
+  WiFiLink found;
+  const time_t synced = TimeSyncPolicy::EARLIEST_TIME + 86400;
+
+  links.store(WIFI_SSID, link, 12);  // Seconds after boot, in 1970
+  EXPECT_FALSE(links.find(WIFI_SSID, synced, found));
+
+  links.clockSet(synced);
+  EXPECT_TRUE(links.find(WIFI_SSID, synced + 3600, found));
+  EXPECT_FALSE(links.find(WIFI_SSID, synced + WiFiLinkCache::MAX_LEASE_AGE_S + 60, found));
+
+  // A lease stamped by a set clock keeps its age through later syncs
+  links.store(WIFI_SSID, link, synced);
+  links.clockSet(synced + WiFiLinkCache::MAX_LEASE_AGE_S);
+  EXPECT_FALSE(links.find(WIFI_SSID, synced + WiFiLinkCache::MAX_LEASE_AGE_S + 60, found));
+}
+
+// Test: After power-on the clock is unknown: connect() waits for SNTP
+TEST(WiFiManagerTest, UnknownClockWaitsForSync) {
+  ScriptedWiFiHardware wifi;
+  TimeSyncPolicy::Slot slot;
+  memset(&slot, 0xA5, sizeof(slot));
+  TimeSyncPolicy policy(slot);
+  WiFiManager manager(&wifi, nullptr, &policy);
+
+  ASSERT_TRUE(manager.connect());
+
+  EXPECT_EQ(wifi.timeRequests, 1);
+  EXPECT_EQ(wifi.timeWaits, 1);
+  EXPECT_EQ(wifi.nowMs(), 500u + 2000u + 80u);  // Returned with the reply
+  EXPECT_TRUE(policy.trusted(time(nullptr)));
+}
+
+// Test: A recent sync and a small drift: no SNTP at all
+TEST(WiFiManagerTest, RecentSyncSkipsSntp) {
+  ScriptedWiFiHardware wifi;
+  TimeSyncPolicy::Slot slot;
+  TimeSyncPolicy policy(slot);
+  policy.synced(time(nullptr) - 60, 0);
+  WiFiManager manager(&wifi, nullptr, &policy);
+
+  ASSERT_TRUE(manager.connect());
+  manager.disconnect();
+
+  EXPECT_EQ(wifi.timeRequests, 0);
+}
+
+// Test: A clock that may be seconds off is synced without holding up the
+// fetch; the reply is taken when the radio goes off
+TEST(WiFiManagerTest, DriftedClockSyncsInBackground) {
+  ScriptedWiFiHardware wifi;
+  wifi.timeSyncCorrectionMs = 1800;
+  TimeSyncPolicy::Slot slot;
+  TimeSyncPolicy policy(slot);
+  policy.synced(time(nullptr) - 3 * 3600, 0);
+  WiFiManager manager(&wifi, nullptr, &policy);
+
+  ASSERT_TRUE(manager.connect());
+  EXPECT_EQ(wifi.timeRequests, 1);
+  EXPECT_EQ(wifi.timeWaits, 0);
+  EXPECT_EQ(wifi.nowMs(), 500u + 2000u);
+
+  wifi.delayMs(1000);  // The fetch
+  manager.disconnect();
+
+  // 1.8 s over three hours
+  EXPECT_NEAR(policy.driftPpm(), 167, 1);
+  EXPECT_LT(policy.expectedErrorMs(time(nullptr)), 100);
+}
+
+// Test: A reply that has not come by disconnect() is not waited for
+TEST(WiFiManagerTest, LateSntpReplyIsNotAwaited) {
+  ScriptedWiFiHardware wifi;
+  wifi.timeSyncAfterMs = 5000;
+  TimeSyncPolicy::Slot slot;
+  TimeSyncPolicy policy(slot);
+  policy.synced(time(nullptr) - 3 * 3600, 0);
+  WiFiManager manager(&wifi, nullptr, &policy);
+
+  ASSERT_TRUE(manager.connect());
+  unsigned long connected = wifi.nowMs();
+  manager.disconnect();
+
+  EXPECT_EQ(wifi.nowMs(), connected);
+  EXPECT_GT(policy.expectedErrorMs(time(nullptr)), TimeSyncPolicy::SYNC_ABOVE_MS);
+}
+
 // Test: Disconnect when connected
 TEST(WiFiManagerTest, DisconnectWhenConnected) {
   MockWiFiHardware mockWifi;
@@ -0,0 +1,453 @@
+#ifndef SPOT_HINTA_PAYLOADS_H
+#define SPOT_HINTA_PAYLOADS_H
+
+// Responses in the shape api.spot-hinta.fi/TodayAndDayForward returns,
+// used to check the tokenizer against ArduinoJson field by field
+
+// Today and tomorrow, 15-minute slots, with a few negative prices
+static const char PAYLOAD_TWO_DAYS[] =
+  "[{\"Rank\":32,\"DateTime\":\"2025-11-17T00:00:00+02:00\",\"PriceNoTax\":0.0331,\"PriceWithTax\":0.04154},"
+  "{\"Rank\":31,\"DateTime\":\"2025-11-17T00:15:00+02:00\",\"PriceNoTax\":0.03232,\"PriceWithTax\":0.04056},"
+  "{\"Rank\":17,\"DateTime\":\"2025-11-17T00:30:00+02:00\",\"PriceNoTax\":0.01397,\"PriceWithTax\":0.01753},"
+  "{\"Rank\":9,\"DateTime\":\"2025-11-17T00:45:00+02:00\",\"PriceNoTax\":-0.00112,\"PriceWithTax\":-0.00112},"
+  "{\"Rank\":1,\"DateTime\":\"2025-11-17T01:00:00+02:00\",\"PriceNoTax\":-0.00596,\"PriceWithTax\":-0.00596},"
+  "{\"Rank\":15,\"DateTime\":\"2025-11-17T01:15:00+02:00\",\"PriceNoTax\":0.01229,\"PriceWithTax\":0.01542},"
+  "{\"Rank\":10,\"DateTime\":\"2025-11-17T01:30:00+02:00\",\"PriceNoTax\":-0.00067,\"PriceWithTax\":-0.00067},"
+  "{\"Rank\":20,\"DateTime\":\"2025-11-17T01:45:00+02:00\",\"PriceNoTax\":0.01883,\"PriceWithTax\":0.02363},"
+  "{\"Rank\":13,\"DateTime\":\"2025-11-17T02:00:00+02:00\",\"PriceNoTax\":0.00372,\"PriceWithTax\":0.00467},"
+  "{\"Rank\":12,\"DateTime\":\"2025-11-17T02:15:00+02:00\",\"PriceNoTax\":0.00208,\"PriceWithTax\":0.00261},"
+  "{\"Rank\":28,\"DateTime\":\"2025-11-17T02:30:00+02:00\",\"PriceNoTax\":0.02919,\"PriceWithTax\":0.03663},"
+  "{\"Rank\":29,\"DateTime\":\"2025-11-17T02:45:00+02:00\",\"PriceNoTax\":0.02937,\"PriceWithTax\":0.03686},"
+  "{\"Rank\":5,\"DateTime\":\"2025-11-17T03:00:00+02:00\",\"PriceNoTax\":-0.00345,\"PriceWithTax\":-0.00345},"
+  "{\"Rank\":16,\"DateTime\":\"2025-11-17T03:15:00+02:00\",\"PriceNoTax\":0.01239,\"PriceWithTax\":0.01555},"
+  "{\"Rank\":21,\"DateTime\":\"2025-11-17T03:30:00+02:00\",\"PriceNoTax\":0.02197,\"PriceWithTax\":0.02757},"
+  "{\"Rank\":18,\"DateTime\":\"2025-11-17T03:45:00+02:00\",\"PriceNoTax\":0.01478,\"PriceWithTax\":0.01855},"
+  "{\"Rank\":22,\"DateTime\":\"2025-11-17T04:00:00+02:00\",\"PriceNoTax\":0.02239,\"PriceWithTax\":0.0281},"
+  "{\"Rank\":37,\"DateTime\":\"2025-11-17T04:15:00+02:00\",\"PriceNoTax\":0.03751,\"PriceWithTax\":0.04708},"
+  "{\"Rank\":41,\"DateTime\":\"2025-11-17T04:30:00+02:00\",\"PriceNoTax\":0.04762,\"PriceWithTax\":0.05976},"
+  "{\"Rank\":56,\"DateTime\":\"2025-11-17T04:45:00+02:00\",\"PriceNoTax\":0.07076,\"PriceWithTax\":0.0888},"
+  "{\"Rank\":59,\"DateTime\":\"2025-11-17T05:00:00+02:00\",\"PriceNoTax\":0.07394,\"PriceWithTax\":0.09279},"
+  "{\"Rank\":45,\"DateTime\":\"2025-11-17T05:15:00+02:00\",\"PriceNoTax\":0.04994,\"PriceWithTax\":0.06267},"
+  "{\"Rank\":44,\"DateTime\":\"2025-11-17T05:30:00+02:00\",\"PriceNoTax\":0.04932,\"PriceWithTax\":0.0619},"
+  "{\"Rank\":46,\"DateTime\":\"2025-11-17T05:45:00+02:00\",\"PriceNoTax\":0.05031,\"PriceWithTax\":0.06314},"
+  "{\"Rank\":7,\"DateTime\":\"2025-11-17T06:00:00+02:00\",\"PriceNoTax\":-0.00143,\"PriceWithTax\":-0.00143},"
+  "{\"Rank\":50,\"DateTime\":\"2025-11-17T06:15:00+02:00\",\"PriceNoTax\":0.05859,\"PriceWithTax\":0.07353},"
+  "{\"Rank\":43,\"DateTime\":\"2025-11-17T06:30:00+02:00\",\"PriceNoTax\":0.04931,\"PriceWithTax\":0.06188},"
+  "{\"Rank\":60,\"DateTime\":\"2025-11-17T06:45:00+02:00\",\"PriceNoTax\":0.07893,\"PriceWithTax\":0.09906},"
+  "{\"Rank\":57,\"DateTime\":\"2025-11-17T07:00:00+02:00\",\"PriceNoTax\":0.07127,\"PriceWithTax\":0.08944},"
+  "{\"Rank\":55,\"DateTime\":\"2025-11-17T07:15:00+02:00\",\"PriceNoTax\":0.06903,\"PriceWithTax\":0.08663},"
+  "{\"Rank\":79,\"DateTime\":\"2025-11-17T07:30:00+02:00\",\"PriceNoTax\":0.10524,\"PriceWithTax\":0.13208},"
+  "{\"Rank\":80,\"DateTime\":\"2025-11-17T07:45:00+02:00\",\"PriceNoTax\":0.10689,\"PriceWithTax\":0.13415},"
+  "{\"Rank\":76,\"DateTime\":\"2025-11-17T08:00:00+02:00\",\"PriceNoTax\":0.10038,\"PriceWithTax\":0.12598},"
+  "{\"Rank\":88,\"DateTime\":\"2025-11-17T08:15:00+02:00\",\"PriceNoTax\":0.11601,\"PriceWithTax\":0.14559},"
+  "{\"Rank\":84,\"DateTime\":\"2025-11-17T08:30:00+02:00\",\"PriceNoTax\":0.11034,\"PriceWithTax\":0.13848},"
+  "{\"Rank\":69,\"DateTime\":\"2025-11-17T08:45:00+02:00\",\"PriceNoTax\":0.09026,\"PriceWithTax\":0.11328},"
+  "{\"Rank\":61,\"DateTime\":\"2025-11-17T09:00:00+02:00\",\"PriceNoTax\":0.07993,\"PriceWithTax\":0.10031},"
+  "{\"Rank\":71,\"DateTime\":\"2025-11-17T09:15:00+02:00\",\"PriceNoTax\":0.09318,\"PriceWithTax\":0.11694},"
+  "{\"Rank\":66,\"DateTime\":\"2025-11-17T09:30:00+02:00\",\"PriceNoTax\":0.08634,\"PriceWithTax\":0.10836},"
+  "{\"Rank\":83,\"DateTime\":\"2025-11-17T09:45:00+02:00\",\"PriceNoTax\":0.10904,\"PriceWithTax\":0.13685},"
+  "{\"Rank\":77,\"DateTime\":\"2025-11-17T10:00:00+02:00\",\"PriceNoTax\":0.10113,\"PriceWithTax\":0.12692},"
+  "{\"Rank\":86,\"DateTime\":\"2025-11-17T10:15:00+02:00\",\"PriceNoTax\":0.11454,\"PriceWithTax\":0.14375},"
+  "{\"Rank\":94,\"DateTime\":\"2025-11-17T10:30:00+02:00\",\"PriceNoTax\":0.1308,\"PriceWithTax\":0.16415},"
+  "{\"Rank\":89,\"DateTime\":\"2025-11-17T10:45:00+02:00\",\"PriceNoTax\":0.11603,\"PriceWithTax\":0.14562},"
+  "{\"Rank\":78,\"DateTime\":\"2025-11-17T11:00:00+02:00\",\"PriceNoTax\":0.10441,\"PriceWithTax\":0.13103},"
+  "{\"Rank\":96,\"DateTime\":\"2025-11-17T11:15:00+02:00\",\"PriceNoTax\":0.13804,\"PriceWithTax\":0.17324},"
+  "{\"Rank\":81,\"DateTime\":\"2025-11-17T11:30:00+02:00\",\"PriceNoTax\":0.10777,\"PriceWithTax\":0.13525},"
+  "{\"Rank\":82,\"DateTime\":\"2025-11-17T11:45:00+02:00\",\"PriceNoTax\":0.10897,\"PriceWithTax\":0.13676},"
+  "{\"Rank\":93,\"DateTime\":\"2025-11-17T12:00:00+02:00\",\"PriceNoTax\":0.12506,\"PriceWithTax\":0.15695},"
+  "{\"Rank\":95,\"DateTime\":\"2025-11-17T12:15:00+02:00\",\"PriceNoTax\":0.13678,\"PriceWithTax\":0.17166},"
+  "{\"Rank\":91,\"DateTime\":\"2025-11-17T12:30:00+02:00\",\"PriceNoTax\":0.11944,\"PriceWithTax\":0.1499},"
+  "{\"Rank\":92,\"DateTime\":\"2025-11-17T12:45:00+02:00\",\"PriceNoTax\":0.11991,\"PriceWithTax\":0.15049},"
+  "{\"Rank\":73,\"DateTime\":\"2025-11-17T13:00:00+02:00\",\"PriceNoTax\":0.09532,\"PriceWithTax\":0.11963},"
+  "{\"Rank\":90,\"DateTime\":\"2025-11-17T13:15:00+02:00\",\"PriceNoTax\":0.11626,\"PriceWithTax\":0.14591},"
+  "{\"Rank\":72,\"DateTime\":\"2025-11-17T13:30:00+02:00\",\"PriceNoTax\":0.09414,\"PriceWithTax\":0.11815},"
+  "{\"Rank\":74,\"DateTime\":\"2025-11-17T13:45:00+02:00\",\"PriceNoTax\":0.09687,\"PriceWithTax\":0.12157},"
+  "{\"Rank\":87,\"DateTime\":\"2025-11-17T14:00:00+02:00\",\"PriceNoTax\":0.11482,\"PriceWithTax\":0.1441},"
+  "{\"Rank\":67,\"DateTime\":\"2025-11-17T14:15:00+02:00\",\"PriceNoTax\":0.08791,\"PriceWithTax\":0.11033},"
+  "{\"Rank\":63,\"DateTime\":\"2025-11-17T14:30:00+02:00\",\"PriceNoTax\":0.08198,\"PriceWithTax\":0.10288},"
+  "{\"Rank\":85,\"DateTime\":\"2025-11-17T14:45:00+02:00\",\"PriceNoTax\":0.11277,\"PriceWithTax\":0.14153},"
+  "{\"Rank\":6,\"DateTime\":\"2025-11-17T15:00:00+02:00\",\"PriceNoTax\":-0.00245,\"PriceWithTax\":-0.00245},"
+  "{\"Rank\":70,\"DateTime\":\"2025-11-17T15:15:00+02:00\",\"PriceNoTax\":0.09198,\"PriceWithTax\":0.11543},"
+  "{\"Rank\":62,\"DateTime\":\"2025-11-17T15:30:00+02:00\",\"PriceNoTax\":0.08139,\"PriceWithTax\":0.10214},"
+  "{\"Rank\":58,\"DateTime\":\"2025-11-17T15:45:00+02:00\",\"PriceNoTax\":0.07251,\"PriceWithTax\":0.091},"
+  "{\"Rank\":52,\"DateTime\":\"2025-11-17T16:00:00+02:00\",\"PriceNoTax\":0.06545,\"PriceWithTax\":0.08214},"
+  "{\"Rank\":75,\"DateTime\":\"2025-11-17T16:15:00+02:00\",\"PriceNoTax\":0.09694,\"PriceWithTax\":0.12166},"
+  "{\"Rank\":65,\"DateTime\":\"2025-11-17T16:30:00+02:00\",\"PriceNoTax\":0.08601,\"PriceWithTax\":0.10794},"
+  "{\"Rank\":68,\"DateTime\":\"2025-11-17T16:45:00+02:00\",\"PriceNoTax\":0.08922,\"PriceWithTax\":0.11197},"
+  "{\"Rank\":64,\"DateTime\":\"2025-11-17T17:00:00+02:00\",\"PriceNoTax\":0.08556,\"PriceWithTax\":0.10738},"
+  "{\"Rank\":51,\"DateTime\":\"2025-11-17T17:15:00+02:00\",\"PriceNoTax\":0.05935,\"PriceWithTax\":0.07448},"
+  "{\"Rank\":54,\"DateTime\":\"2025-11-17T17:30:00+02:00\",\"PriceNoTax\":0.06862,\"PriceWithTax\":0.08612},"
+  "{\"Rank\":49,\"DateTime\":\"2025-11-17T17:45:00+02:00\",\"PriceNoTax\":0.05347,\"PriceWithTax\":0.0671},"
+  "{\"Rank\":48,\"DateTime\":\"2025-11-17T18:00:00+02:00\",\"PriceNoTax\":0.05301,\"PriceWithTax\":0.06653},"
+  "{\"Rank\":42,\"DateTime\":\"2025-11-17T18:15:00+02:00\",\"PriceNoTax\":0.04777,\"PriceWithTax\":0.05995},"
+  "{\"Rank\":40,\"DateTime\":\"2025-11-17T18:30:00+02:00\",\"PriceNoTax\":0.04425,\"PriceWithTax\":0.05553},"
+  "{\"Rank\":34,\"DateTime\":\"2025-11-17T18:45:00+02:00\",\"PriceNoTax\":0.03536,\"PriceWithTax\":0.04438},"
+  "{\"Rank\":53,\"DateTime\":\"2025-11-17T19:00:00+02:00\",\"PriceNoTax\":0.0661,\"PriceWithTax\":0.08296},"
+  "{\"Rank\":8,\"DateTime\":\"2025-11-17T19:15:00+02:00\",\"PriceNoTax\":-0.00133,\"PriceWithTax\":-0.00133},"
+  "{\"Rank\":30,\"DateTime\":\"2025-11-17T19:30:00+02:00\",\"PriceNoTax\":0.0321,\"PriceWithTax\":0.04029},"
+  "{\"Rank\":3,\"DateTime\":\"2025-11-17T19:45:00+02:00\",\"PriceNoTax\":-0.00357,\"PriceWithTax\":-0.00357},"
+  "{\"Rank\":47,\"DateTime\":\"2025-11-17T20:00:00+02:00\",\"PriceNoTax\":0.05105,\"PriceWithTax\":0.06407},"
+  "{\"Rank\":27,\"DateTime\":\"2025-11-17T20:15:00+02:00\",\"PriceNoTax\":0.02736,\"PriceWithTax\":0.03434},"
+  "{\"Rank\":4,\"DateTime\":\"2025-11-17T20:30:00+02:00\",\"PriceNoTax\":-0.00356,\"PriceWithTax\":-0.00356},"
+  "{\"Rank\":26,\"DateTime\":\"2025-11-17T20:45:00+02:00\",\"PriceNoTax\":0.02595,\"PriceWithTax\":0.03257},"
+  "{\"Rank\":25,\"DateTime\":\"2025-11-17T21:00:00+02:00\",\"PriceNoTax\":0.02561,\"PriceWithTax\":0.03214},"
+  "{\"Rank\":23,\"DateTime\":\"2025-11-17T21:15:00+02:00\",\"PriceNoTax\":0.0231,\"PriceWithTax\":0.02899},"
+  "{\"Rank\":35,\"DateTime\":\"2025-11-17T21:30:00+02:00\",\"PriceNoTax\":0.03699,\"PriceWithTax\":0.04642},"
+  "{\"Rank\":39,\"DateTime\":\"2025-11-17T21:45:00+02:00\",\"PriceNoTax\":0.04088,\"PriceWithTax\":0.0513},"
+  "{\"Rank\":36,\"DateTime\":\"2025-11-17T22:00:00+02:00\",\"PriceNoTax\":0.03721,\"PriceWithTax\":0.0467},"
+  "{\"Rank\":14,\"DateTime\":\"2025-11-17T22:15:00+02:00\",\"PriceNoTax\":0.01052,\"PriceWithTax\":0.0132},"
+  "{\"Rank\":19,\"DateTime\":\"2025-11-17T22:30:00+02:00\",\"PriceNoTax\":0.01656,\"PriceWithTax\":0.02078},"
+  "{\"Rank\":2,\"DateTime\":\"2025-11-17T22:45:00+02:00\",\"PriceNoTax\":-0.00482,\"PriceWithTax\":-0.00482},"
+  "{\"Rank\":38,\"DateTime\":\"2025-11-17T23:00:00+02:00\",\"PriceNoTax\":0.03807,\"PriceWithTax\":0.04778},"
+  "{\"Rank\":33,\"DateTime\":\"2025-11-17T23:15:00+02:00\",\"PriceNoTax\":0.0334,\"PriceWithTax\":0.04192},"
+  "{\"Rank\":24,\"DateTime\":\"2025-11-17T23:30:00+02:00\",\"PriceNoTax\":0.0255,\"PriceWithTax\":0.032},"
+  "{\"Rank\":11,\"DateTime\":\"2025-11-17T23:45:00+02:00\",\"PriceNoTax\":0.00009,\"PriceWithTax\":0.00011},"
+  "{\"Rank\":36,\"DateTime\":\"2025-11-18T00:00:00+02:00\",\"PriceNoTax\":0.03958,\"PriceWithTax\":0.04967},"
+  "{\"Rank\":24,\"DateTime\":\"2025-11-18T00:15:00+02:00\",\"PriceNoTax\":0.02538,\"PriceWithTax\":0.03185},"
+  "{\"Rank\":20,\"DateTime\":\"2025-11-18T00:30:00+02:00\",\"PriceNoTax\":0.0207,\"PriceWithTax\":0.02598},"
+  "{\"Rank\":28,\"DateTime\":\"2025-11-18T00:45:00+02:00\",\"PriceNoTax\":0.02861,\"PriceWithTax\":0.03591},"
+  "{\"Rank\":26,\"DateTime\":\"2025-11-18T01:00:00+02:00\",\"PriceNoTax\":0.02858,\"PriceWithTax\":0.03587},"
+  "{\"Rank\":15,\"DateTime\":\"2025-11-18T01:15:00+02:00\",\"PriceNoTax\":0.00955,\"PriceWithTax\":0.01199},"
+  "{\"Rank\":29,\"DateTime\":\"2025-11-18T01:30:00+02:00\",\"PriceNoTax\":0.03221,\"PriceWithTax\":0.04042},"
+  "{\"Rank\":41,\"DateTime\":\"2025-11-18T01:45:00+02:00\",\"PriceNoTax\":0.04421,\"PriceWithTax\":0.05548},"
+  "{\"Rank\":3,\"DateTime\":\"2025-11-18T02:00:00+02:00\",\"PriceNoTax\":-0.00254,\"PriceWithTax\":-0.00254},"
+  "{\"Rank\":14,\"DateTime\":\"2025-11-18T02:15:00+02:00\",\"PriceNoTax\":0.00651,\"PriceWithTax\":0.00817},"
+  "{\"Rank\":11,\"DateTime\":\"2025-11-18T02:30:00+02:00\",\"PriceNoTax\":0.00314,\"PriceWithTax\":0.00394},"
+  "{\"Rank\":40,\"DateTime\":\"2025-11-18T02:45:00+02:00\",\"PriceNoTax\":0.04228,\"PriceWithTax\":0.05306},"
+  "{\"Rank\":37,\"DateTime\":\"2025-11-18T03:00:00+02:00\",\"PriceNoTax\":0.04022,\"PriceWithTax\":0.05048},"
+  "{\"Rank\":45,\"DateTime\":\"2025-11-18T03:15:00+02:00\",\"PriceNoTax\":0.04725,\"PriceWithTax\":0.0593},"
+  "{\"Rank\":47,\"DateTime\":\"2025-11-18T03:30:00+02:00\",\"PriceNoTax\":0.05,\"PriceWithTax\":0.06275},"
+  "{\"Rank\":39,\"DateTime\":\"2025-11-18T03:45:00+02:00\",\"PriceNoTax\":0.04159,\"PriceWithTax\":0.0522},"
+  "{\"Rank\":31,\"DateTime\":\"2025-11-18T04:00:00+02:00\",\"PriceNoTax\":0.0333,\"PriceWithTax\":0.04179},"
+  "{\"Rank\":17,\"DateTime\":\"2025-11-18T04:15:00+02:00\",\"PriceNoTax\":0.01925,\"PriceWithTax\":0.02416},"
+  "{\"Rank\":8,\"DateTime\":\"2025-11-18T04:30:00+02:00\",\"PriceNoTax\":-0.00059,\"PriceWithTax\":-0.00059},"
+  "{\"Rank\":51,\"DateTime\":\"2025-11-18T04:45:00+02:00\",\"PriceNoTax\":0.06603,\"PriceWithTax\":0.08287},"
+  "{\"Rank\":52,\"DateTime\":\"2025-11-18T05:00:00+02:00\",\"PriceNoTax\":0.0672,\"PriceWithTax\":0.08434},"
+  "{\"Rank\":44,\"DateTime\":\"2025-11-18T05:15:00+02:00\",\"PriceNoTax\":0.04678,\"PriceWithTax\":0.05871},"
+  "{\"Rank\":38,\"DateTime\":\"2025-11-18T05:30:00+02:00\",\"PriceNoTax\":0.04049,\"PriceWithTax\":0.05081},"
+  "{\"Rank\":1,\"DateTime\":\"2025-11-18T05:45:00+02:00\",\"PriceNoTax\":-0.00317,\"PriceWithTax\":-0.00317},"
+  "{\"Rank\":46,\"DateTime\":\"2025-11-18T06:00:00+02:00\",\"PriceNoTax\":0.04996,\"PriceWithTax\":0.0627},"
+  "{\"Rank\":54,\"DateTime\":\"2025-11-18T06:15:00+02:00\",\"PriceNoTax\":0.07127,\"PriceWithTax\":0.08944},"
+  "{\"Rank\":57,\"DateTime\":\"2025-11-18T06:30:00+02:00\",\"PriceNoTax\":0.07696,\"PriceWithTax\":0.09658},"
+  "{\"Rank\":63,\"DateTime\":\"2025-11-18T06:45:00+02:00\",\"PriceNoTax\":0.08714,\"PriceWithTax\":0.10936},"
+  "{\"Rank\":74,\"DateTime\":\"2025-11-18T07:00:00+02:00\",\"PriceNoTax\":0.09717,\"PriceWithTax\":0.12195},"
+  "{\"Rank\":70,\"DateTime\":\"2025-11-18T07:15:00+02:00\",\"PriceNoTax\":0.09201,\"PriceWithTax\":0.11547},"
+  "{\"Rank\":2,\"DateTime\":\"2025-11-18T07:30:00+02:00\",\"PriceNoTax\":-0.00276,\"PriceWithTax\":-0.00276},"
+  "{\"Rank\":79,\"DateTime\":\"2025-11-18T07:45:00+02:00\",\"PriceNoTax\":0.1014,\"PriceWithTax\":0.12726},"
+  "{\"Rank\":83,\"DateTime\":\"2025-11-18T08:00:00+02:00\",\"PriceNoTax\":0.10382,\"PriceWithTax\":0.13029},"
+  "{\"Rank\":60,\"DateTime\":\"2025-11-18T08:15:00+02:00\",\"PriceNoTax\":0.08309,\"PriceWithTax\":0.10428},"
+  "{\"Rank\":61,\"DateTime\":\"2025-11-18T08:30:00+02:00\",\"PriceNoTax\":0.08441,\"PriceWithTax\":0.10593},"
+  "{\"Rank\":75,\"DateTime\":\"2025-11-18T08:45:00+02:00\",\"PriceNoTax\":0.09718,\"PriceWithTax\":0.12196},"
+  "{\"Rank\":77,\"DateTime\":\"2025-11-18T09:00:00+02:00\",\"PriceNoTax\":0.09781,\"PriceWithTax\":0.12275},"
+  "{\"Rank\":73,\"DateTime\":\"2025-11-18T09:15:00+02:00\",\"PriceNoTax\":0.09627,\"PriceWithTax\":0.12082},"
+  "{\"Rank\":87,\"DateTime\":\"2025-11-18T09:30:00+02:00\",\"PriceNoTax\":0.11132,\"PriceWithTax\":0.13971},"
+  "{\"Rank\":80,\"DateTime\":\"2025-11-18T09:45:00+02:00\",\"PriceNoTax\":0.10219,\"PriceWithTax\":0.12825},"
+  "{\"Rank\":82,\"DateTime\":\"2025-11-18T10:00:00+02:00\",\"PriceNoTax\":0.10378,\"PriceWithTax\":0.13024},"
+  "{\"Rank\":76,\"DateTime\":\"2025-11-18T10:15:00+02:00\",\"PriceNoTax\":0.09773,\"PriceWithTax\":0.12265},"
+  "{\"Rank\":88,\"DateTime\":\"2025-11-18T10:30:00+02:00\",\"PriceNoTax\":0.1126,\"PriceWithTax\":0.14131},"
+  "{\"Rank\":71,\"DateTime\":\"2025-11-18T10:45:00+02:00\",\"PriceNoTax\":0.09471,\"PriceWithTax\":0.11886},"
+  "{\"Rank\":93,\"DateTime\":\"2025-11-18T11:00:00+02:00\",\"PriceNoTax\":0.12357,\"PriceWithTax\":0.15508},"
+  "{\"Rank\":94,\"DateTime\":\"2025-11-18T11:15:00+02:00\",\"PriceNoTax\":0.12863,\"PriceWithTax\":0.16143},"
+  "{\"Rank\":86,\"DateTime\":\"2025-11-18T11:30:00+02:00\",\"PriceNoTax\":0.11126,\"PriceWithTax\":0.13963},"
+  "{\"Rank\":89,\"DateTime\":\"2025-11-18T11:45:00+02:00\",\"PriceNoTax\":0.11268,\"PriceWithTax\":0.14141},"
+  "{\"Rank\":96,\"DateTime\":\"2025-11-18T12:00:00+02:00\",\"PriceNoTax\":0.13451,\"PriceWithTax\":0.16881},"
+  "{\"Rank\":91,\"DateTime\":\"2025-11-18T12:15:00+02:00\",\"PriceNoTax\":0.12094,\"PriceWithTax\":0.15178},"
+  "{\"Rank\":78,\"DateTime\":\"2025-11-18T12:30:00+02:00\",\"PriceNoTax\":0.09968,\"PriceWithTax\":0.1251},"
+  "{\"Rank\":5,\"DateTime\":\"2025-11-18T12:45:00+02:00\",\"PriceNoTax\":-0.00135,\"PriceWithTax\":-0.00135},"
+  "{\"Rank\":67,\"DateTime\":\"2025-11-18T13:00:00+02:00\",\"PriceNoTax\":0.08881,\"PriceWithTax\":0.11146},"
+  "{\"Rank\":95,\"DateTime\":\"2025-11-18T13:15:00+02:00\",\"PriceNoTax\":0.13191,\"PriceWithTax\":0.16555},"
+  "{\"Rank\":6,\"DateTime\":\"2025-11-18T13:30:00+02:00\",\"PriceNoTax\":-0.00101,\"PriceWithTax\":-0.00101},"
+  "{\"Rank\":90,\"DateTime\":\"2025-11-18T13:45:00+02:00\",\"PriceNoTax\":0.11426,\"PriceWithTax\":0.1434},"
+  "{\"Rank\":92,\"DateTime\":\"2025-11-18T14:00:00+02:00\",\"PriceNoTax\":0.12099,\"PriceWithTax\":0.15184},"
+  "{\"Rank\":4,\"DateTime\":\"2025-11-18T14:15:00+02:00\",\"PriceNoTax\":-0.00189,\"PriceWithTax\":-0.00189},"
+  "{\"Rank\":84,\"DateTime\":\"2025-11-18T14:30:00+02:00\",\"PriceNoTax\":0.1042,\"PriceWithTax\":0.13077},"
+  "{\"Rank\":85,\"DateTime\":\"2025-11-18T14:45:00+02:00\",\"PriceNoTax\":0.10954,\"PriceWithTax\":0.13747},"
+  "{\"Rank\":62,\"DateTime\":\"2025-11-18T15:00:00+02:00\",\"PriceNoTax\":0.08658,\"PriceWithTax\":0.10866},"
+  "{\"Rank\":68,\"DateTime\":\"2025-11-18T15:15:00+02:00\",\"PriceNoTax\":0.08958,\"PriceWithTax\":0.11242},"
+  "{\"Rank\":7,\"DateTime\":\"2025-11-18T15:30:00+02:00\",\"PriceNoTax\":-0.00078,\"PriceWithTax\":-0.00078},"
+  "{\"Rank\":66,\"DateTime\":\"2025-11-18T15:45:00+02:00\",\"PriceNoTax\":0.08868,\"PriceWithTax\":0.11129},"
+  "{\"Rank\":81,\"DateTime\":\"2025-11-18T16:00:00+02:00\",\"PriceNoTax\":0.10306,\"PriceWithTax\":0.12934},"
+  "{\"Rank\":56,\"DateTime\":\"2025-11-18T16:15:00+02:00\",\"PriceNoTax\":0.0752,\"PriceWithTax\":0.09438},"
+  "{\"Rank\":72,\"DateTime\":\"2025-11-18T16:30:00+02:00\",\"PriceNoTax\":0.09566,\"PriceWithTax\":0.12005},"
+  "{\"Rank\":69,\"DateTime\":\"2025-11-18T16:45:00+02:00\",\"PriceNoTax\":0.0907,\"PriceWithTax\":0.11383},"
+  "{\"Rank\":58,\"DateTime\":\"2025-11-18T17:00:00+02:00\",\"PriceNoTax\":0.07747,\"PriceWithTax\":0.09722},"
+  "{\"Rank\":65,\"DateTime\":\"2025-11-18T17:15:00+02:00\",\"PriceNoTax\":0.08813,\"PriceWithTax\":0.1106},"
+  "{\"Rank\":64,\"DateTime\":\"2025-11-18T17:30:00+02:00\",\"PriceNoTax\":0.08791,\"PriceWithTax\":0.11033},"
+  "{\"Rank\":48,\"DateTime\":\"2025-11-18T17:45:00+02:00\",\"PriceNoTax\":0.05535,\"PriceWithTax\":0.06946},"
+  "{\"Rank\":59,\"DateTime\":\"2025-11-18T18:00:00+02:00\",\"PriceNoTax\":0.08301,\"PriceWithTax\":0.10418},"
+  "{\"Rank\":49,\"DateTime\":\"2025-11-18T18:15:00+02:00\",\"PriceNoTax\":0.05676,\"PriceWithTax\":0.07123},"
+  "{\"Rank\":50,\"DateTime\":\"2025-11-18T18:30:00+02:00\",\"PriceNoTax\":0.05776,\"PriceWithTax\":0.07249},"
+  "{\"Rank\":55,\"DateTime\":\"2025-11-18T18:45:00+02:00\",\"PriceNoTax\":0.07359,\"PriceWithTax\":0.09236},"
+  "{\"Rank\":53,\"DateTime\":\"2025-11-18T19:00:00+02:00\",\"PriceNoTax\":0.06885,\"PriceWithTax\":0.08641},"
+  "{\"Rank\":33,\"DateTime\":\"2025-11-18T19:15:00+02:00\",\"PriceNoTax\":0.0349,\"PriceWithTax\":0.0438},"
+  "{\"Rank\":42,\"DateTime\":\"2025-11-18T19:30:00+02:00\",\"PriceNoTax\":0.04594,\"PriceWithTax\":0.05765},"
+  "{\"Rank\":34,\"DateTime\":\"2025-11-18T19:45:00+02:00\",\"PriceNoTax\":0.03736,\"PriceWithTax\":0.04689},"
+  "{\"Rank\":22,\"DateTime\":\"2025-11-18T20:00:00+02:00\",\"PriceNoTax\":0.02283,\"PriceWithTax\":0.02865},"
+  "{\"Rank\":43,\"DateTime\":\"2025-11-18T20:15:00+02:00\",\"PriceNoTax\":0.04625,\"PriceWithTax\":0.05804},"
+  "{\"Rank\":30,\"DateTime\":\"2025-11-18T20:30:00+02:00\",\"PriceNoTax\":0.03262,\"PriceWithTax\":0.04094},"
+  "{\"Rank\":19,\"DateTime\":\"2025-11-18T20:45:00+02:00\",\"PriceNoTax\":0.02015,\"PriceWithTax\":0.02529},"
+  "{\"Rank\":27,\"DateTime\":\"2025-11-18T21:00:00+02:00\",\"PriceNoTax\":0.02859,\"PriceWithTax\":0.03588},"
+  "{\"Rank\":32,\"DateTime\":\"2025-11-18T21:15:00+02:00\",\"PriceNoTax\":0.03382,\"PriceWithTax\":0.04244},"
+  "{\"Rank\":16,\"DateTime\":\"2025-11-18T21:30:00+02:00\",\"PriceNoTax\":0.01804,\"PriceWithTax\":0.02264},"
+  "{\"Rank\":35,\"DateTime\":\"2025-11-18T21:45:00+02:00\",\"PriceNoTax\":0.03824,\"PriceWithTax\":0.04799},"
+  "{\"Rank\":23,\"DateTime\":\"2025-11-18T22:00:00+02:00\",\"PriceNoTax\":0.02293,\"PriceWithTax\":0.02878},"
+  "{\"Rank\":21,\"DateTime\":\"2025-11-18T22:15:00+02:00\",\"PriceNoTax\":0.02097,\"PriceWithTax\":0.02632},"
+  "{\"Rank\":18,\"DateTime\":\"2025-11-18T22:30:00+02:00\",\"PriceNoTax\":0.01956,\"PriceWithTax\":0.02455},"
+  "{\"Rank\":10,\"DateTime\":\"2025-11-18T22:45:00+02:00\",\"PriceNoTax\":0.00246,\"PriceWithTax\":0.00309},"
+  "{\"Rank\":25,\"DateTime\":\"2025-11-18T23:00:00+02:00\",\"PriceNoTax\":0.02847,\"PriceWithTax\":0.03573},"
+  "{\"Rank\":13,\"DateTime\":\"2025-11-18T23:15:00+02:00\",\"PriceNoTax\":0.00639,\"PriceWithTax\":0.00802},"
+  "{\"Rank\":9,\"DateTime\":\"2025-11-18T23:30:00+02:00\",\"PriceNoTax\":0.00173,\"PriceWithTax\":0.00217},"
+  "{\"Rank\":12,\"DateTime\":\"2025-11-18T23:45:00+02:00\",\"PriceNoTax\":0.00398,\"PriceWithTax\":0.00499}]";
+
+// 2025-10-26: 25-hour day, 03:00-03:45 appears at +03:00 and +02:00
+static const char PAYLOAD_DST_FALL_BACK[] =
+  "[{\"Rank\":12,\"DateTime\":\"2025-10-26T00:00:00+03:00\",\"PriceNoTax\":0.01127,\"PriceWithTax\":0.01414},"
+  "{\"Rank\":1,\"DateTime\":\"2025-10-26T00:15:00+03:00\",\"PriceNoTax\":-0.00976,\"PriceWithTax\":-0.00976},"
+  "{\"Rank\":31,\"DateTime\":\"2025-10-26T00:30:00+03:00\",\"PriceNoTax\":0.03779,\"PriceWithTax\":0.04743},"
+  "{\"Rank\":11,\"DateTime\":\"2025-10-26T00:45:00+03:00\",\"PriceNoTax\":0.01126,\"PriceWithTax\":0.01413},"
+  "{\"Rank\":27,\"DateTime\":\"2025-10-26T01:00:00+03:00\",\"PriceNoTax\":0.03166,\"PriceWithTax\":0.03973},"
+  "{\"Rank\":2,\"DateTime\":\"2025-10-26T01:15:00+03:00\",\"PriceNoTax\":-0.0066,\"PriceWithTax\":-0.0066},"
+  "{\"Rank\":21,\"DateTime\":\"2025-10-26T01:30:00+03:00\",\"PriceNoTax\":0.02032,\"PriceWithTax\":0.0255},"
+  "{\"Rank\":9,\"DateTime\":\"2025-10-26T01:45:00+03:00\",\"PriceNoTax\":0.0017,\"PriceWithTax\":0.00213},"
+  "{\"Rank\":15,\"DateTime\":\"2025-10-26T02:00:00+03:00\",\"PriceNoTax\":0.01318,\"PriceWithTax\":0.01654},"
+  "{\"Rank\":23,\"DateTime\":\"2025-10-26T02:15:00+03:00\",\"PriceNoTax\":0.0264,\"PriceWithTax\":0.03313},"
+  "{\"Rank\":28,\"DateTime\":\"2025-10-26T02:30:00+03:00\",\"PriceNoTax\":0.0351,\"PriceWithTax\":0.04405},"
+  "{\"Rank\":38,\"DateTime\":\"2025-10-26T02:45:00+03:00\",\"PriceNoTax\":0.04574,\"PriceWithTax\":0.0574},"
+  "{\"Rank\":36,\"DateTime\":\"2025-10-26T03:00:00+03:00\",\"PriceNoTax\":0.04324,\"PriceWithTax\":0.05427},"
+  "{\"Rank\":43,\"DateTime\":\"2025-10-26T03:15:00+03:00\",\"PriceNoTax\":0.04709,\"PriceWithTax\":0.0591},"
+  "{\"Rank\":17,\"DateTime\":\"2025-10-26T03:30:00+03:00\",\"PriceNoTax\":0.01747,\"PriceWithTax\":0.02192},"
+  "{\"Rank\":42,\"DateTime\":\"2025-10-26T03:45:00+03:00\",\"PriceNoTax\":0.04693,\"PriceWithTax\":0.0589},"
+  "{\"Rank\":29,\"DateTime\":\"2025-10-26T03:00:00+02:00\",\"PriceNoTax\":0.03559,\"PriceWithTax\":0.04467},"
+  "{\"Rank\":46,\"DateTime\":\"2025-10-26T03:15:00+02:00\",\"PriceNoTax\":0.05434,\"PriceWithTax\":0.0682},"
+  "{\"Rank\":33,\"DateTime\":\"2025-10-26T03:30:00+02:00\",\"PriceNoTax\":0.04143,\"PriceWithTax\":0.05199},"
+  "{\"Rank\":41,\"DateTime\":\"2025-10-26T03:45:00+02:00\",\"PriceNoTax\":0.04637,\"PriceWithTax\":0.05819},"
+  "{\"Rank\":19,\"DateTime\":\"2025-10-26T04:00:00+02:00\",\"PriceNoTax\":0.02017,\"PriceWithTax\":0.02531},"
+  "{\"Rank\":52,\"DateTime\":\"2025-10-26T04:15:00+02:00\",\"PriceNoTax\":0.06609,\"PriceWithTax\":0.08294},"
+  "{\"Rank\":51,\"DateTime\":\"2025-10-26T04:30:00+02:00\",\"PriceNoTax\":0.06586,\"PriceWithTax\":0.08265},"
+  "{\"Rank\":45,\"DateTime\":\"2025-10-26T04:45:00+02:00\",\"PriceNoTax\":0.04881,\"PriceWithTax\":0.06126},"
+  "{\"Rank\":59,\"DateTime\":\"2025-10-26T05:00:00+02:00\",\"PriceNoTax\":0.07673,\"PriceWithTax\":0.0963},"
+  "{\"Rank\":37,\"DateTime\":\"2025-10-26T05:15:00+02:00\",\"PriceNoTax\":0.04563,\"PriceWithTax\":0.05727},"
+  "{\"Rank\":7,\"DateTime\":\"2025-10-26T05:30:00+02:00\",\"PriceNoTax\":-0.00105,\"PriceWithTax\":-0.00105},"
+  "{\"Rank\":66,\"DateTime\":\"2025-10-26T05:45:00+02:00\",\"PriceNoTax\":0.08527,\"PriceWithTax\":0.10701},"
+  "{\"Rank\":49,\"DateTime\":\"2025-10-26T06:00:00+02:00\",\"PriceNoTax\":0.05778,\"PriceWithTax\":0.07251},"
+  "{\"Rank\":64,\"DateTime\":\"2025-10-26T06:15:00+02:00\",\"PriceNoTax\":0.0844,\"PriceWithTax\":0.10592},"
+  "{\"Rank\":78,\"DateTime\":\"2025-10-26T06:30:00+02:00\",\"PriceNoTax\":0.09642,\"PriceWithTax\":0.12101},"
+  "{\"Rank\":76,\"DateTime\":\"2025-10-26T06:45:00+02:00\",\"PriceNoTax\":0.09449,\"PriceWithTax\":0.11858},"
+  "{\"Rank\":61,\"DateTime\":\"2025-10-26T07:00:00+02:00\",\"PriceNoTax\":0.07961,\"PriceWithTax\":0.09991},"
+  "{\"Rank\":62,\"DateTime\":\"2025-10-26T07:15:00+02:00\",\"PriceNoTax\":0.08,\"PriceWithTax\":0.1004},"
+  "{\"Rank\":63,\"DateTime\":\"2025-10-26T07:30:00+02:00\",\"PriceNoTax\":0.08389,\"PriceWithTax\":0.10528},"
+  "{\"Rank\":54,\"DateTime\":\"2025-10-26T07:45:00+02:00\",\"PriceNoTax\":0.06876,\"PriceWithTax\":0.08629},"
+  "{\"Rank\":5,\"DateTime\":\"2025-10-26T08:00:00+02:00\",\"PriceNoTax\":-0.00238,\"PriceWithTax\":-0.00238},"
+  "{\"Rank\":55,\"DateTime\":\"2025-10-26T08:15:00+02:00\",\"PriceNoTax\":0.06997,\"PriceWithTax\":0.08781},"
+  "{\"Rank\":71,\"DateTime\":\"2025-10-26T08:30:00+02:00\",\"PriceNoTax\":0.09149,\"PriceWithTax\":0.11482},"
+  "{\"Rank\":57,\"DateTime\":\"2025-10-26T08:45:00+02:00\",\"PriceNoTax\":0.07447,\"PriceWithTax\":0.09346},"
+  "{\"Rank\":94,\"DateTime\":\"2025-10-26T09:00:00+02:00\",\"PriceNoTax\":0.11767,\"PriceWithTax\":0.14768},"
+  "{\"Rank\":92,\"DateTime\":\"2025-10-26T09:15:00+02:00\",\"PriceNoTax\":0.11383,\"PriceWithTax\":0.14286},"
+  "{\"Rank\":99,\"DateTime\":\"2025-10-26T09:30:00+02:00\",\"PriceNoTax\":0.12224,\"PriceWithTax\":0.15341},"
+  "{\"Rank\":97,\"DateTime\":\"2025-10-26T09:45:00+02:00\",\"PriceNoTax\":0.11885,\"PriceWithTax\":0.14916},"
+  "{\"Rank\":88,\"DateTime\":\"2025-10-26T10:00:00+02:00\",\"PriceNoTax\":0.11128,\"PriceWithTax\":0.13966},"
+  "{\"Rank\":89,\"DateTime\":\"2025-10-26T10:15:00+02:00\",\"PriceNoTax\":0.11184,\"PriceWithTax\":0.14036},"
+  "{\"Rank\":85,\"DateTime\":\"2025-10-26T10:30:00+02:00\",\"PriceNoTax\":0.10723,\"PriceWithTax\":0.13457},"
+  "{\"Rank\":87,\"DateTime\":\"2025-10-26T10:45:00+02:00\",\"PriceNoTax\":0.11054,\"PriceWithTax\":0.13873},"
+  "{\"Rank\":75,\"DateTime\":\"2025-10-26T11:00:00+02:00\",\"PriceNoTax\":0.09393,\"PriceWithTax\":0.11788},"
+  "{\"Rank\":81,\"DateTime\":\"2025-10-26T11:15:00+02:00\",\"PriceNoTax\":0.0974,\"PriceWithTax\":0.12224},"
+  "{\"Rank\":84,\"DateTime\":\"2025-10-26T11:30:00+02:00\",\"PriceNoTax\":0.1061,\"PriceWithTax\":0.13316},"
+  "{\"Rank\":74,\"DateTime\":\"2025-10-26T11:45:00+02:00\",\"PriceNoTax\":0.09345,\"PriceWithTax\":0.11728},"
+  "{\"Rank\":98,\"DateTime\":\"2025-10-26T12:00:00+02:00\",\"PriceNoTax\":0.11934,\"PriceWithTax\":0.14977},"
+  "{\"Rank\":80,\"DateTime\":\"2025-10-26T12:15:00+02:00\",\"PriceNoTax\":0.09719,\"PriceWithTax\":0.12197},"
+  "{\"Rank\":95,\"DateTime\":\"2025-10-26T12:30:00+02:00\",\"PriceNoTax\":0.11802,\"PriceWithTax\":0.14812},"
+  "{\"Rank\":93,\"DateTime\":\"2025-10-26T12:45:00+02:00\",\"PriceNoTax\":0.11441,\"PriceWithTax\":0.14358},"
+  "{\"Rank\":100,\"DateTime\":\"2025-10-26T13:00:00+02:00\",\"PriceNoTax\":0.13064,\"PriceWithTax\":0.16395},"
+  "{\"Rank\":83,\"DateTime\":\"2025-10-26T13:15:00+02:00\",\"PriceNoTax\":0.1041,\"PriceWithTax\":0.13065},"
+  "{\"Rank\":79,\"DateTime\":\"2025-10-26T13:30:00+02:00\",\"PriceNoTax\":0.09694,\"PriceWithTax\":0.12166},"
+  "{\"Rank\":90,\"DateTime\":\"2025-10-26T13:45:00+02:00\",\"PriceNoTax\":0.11325,\"PriceWithTax\":0.14213},"
+  "{\"Rank\":73,\"DateTime\":\"2025-10-26T14:00:00+02:00\",\"PriceNoTax\":0.09279,\"PriceWithTax\":0.11645},"
+  "{\"Rank\":86,\"DateTime\":\"2025-10-26T14:15:00+02:00\",\"PriceNoTax\":0.10948,\"PriceWithTax\":0.1374},"
+  "{\"Rank\":96,\"DateTime\":\"2025-10-26T14:30:00+02:00\",\"PriceNoTax\":0.11884,\"PriceWithTax\":0.14914},"
+  "{\"Rank\":77,\"DateTime\":\"2025-10-26T14:45:00+02:00\",\"PriceNoTax\":0.0964,\"PriceWithTax\":0.12098},"
+  "{\"Rank\":68,\"DateTime\":\"2025-10-26T15:00:00+02:00\",\"PriceNoTax\":0.08792,\"PriceWithTax\":0.11034},"
+  "{\"Rank\":65,\"DateTime\":\"2025-10-26T15:15:00+02:00\",\"PriceNoTax\":0.0849,\"PriceWithTax\":0.10655},"
+  "{\"Rank\":4,\"DateTime\":\"2025-10-26T15:30:00+02:00\",\"PriceNoTax\":-0.00323,\"PriceWithTax\":-0.00323},"
+  "{\"Rank\":67,\"DateTime\":\"2025-10-26T15:45:00+02:00\",\"PriceNoTax\":0.08543,\"PriceWithTax\":0.10721},"
+  "{\"Rank\":91,\"DateTime\":\"2025-10-26T16:00:00+02:00\",\"PriceNoTax\":0.11346,\"PriceWithTax\":0.14239},"
+  "{\"Rank\":72,\"DateTime\":\"2025-10-26T16:15:00+02:00\",\"PriceNoTax\":0.09223,\"PriceWithTax\":0.11575},"
+  "{\"Rank\":60,\"DateTime\":\"2025-10-26T16:30:00+02:00\",\"PriceNoTax\":0.07673,\"PriceWithTax\":0.0963},"
+  "{\"Rank\":58,\"DateTime\":\"2025-10-26T16:45:00+02:00\",\"PriceNoTax\":0.07633,\"PriceWithTax\":0.09579},"
+  "{\"Rank\":69,\"DateTime\":\"2025-10-26T17:00:00+02:00\",\"PriceNoTax\":0.08951,\"PriceWithTax\":0.11234},"
+  "{\"Rank\":82,\"DateTime\":\"2025-10-26T17:15:00+02:00\",\"PriceNoTax\":0.09787,\"PriceWithTax\":0.12283},"
+  "{\"Rank\":8,\"DateTime\":\"2025-10-26T17:30:00+02:00\",\"PriceNoTax\":-0.00084,\"PriceWithTax\":-0.00084},"
+  "{\"Rank\":56,\"DateTime\":\"2025-10-26T17:45:00+02:00\",\"PriceNoTax\":0.07248,\"PriceWithTax\":0.09096},"
+  "{\"Rank\":70,\"DateTime\":\"2025-10-26T18:00:00+02:00\",\"PriceNoTax\":0.0896,\"PriceWithTax\":0.11245},"
+  "{\"Rank\":48,\"DateTime\":\"2025-10-26T18:15:00+02:00\",\"PriceNoTax\":0.05486,\"PriceWithTax\":0.06885},"
+  "{\"Rank\":44,\"DateTime\":\"2025-10-26T18:30:00+02:00\",\"PriceNoTax\":0.04808,\"PriceWithTax\":0.06034},"
+  "{\"Rank\":50,\"DateTime\":\"2025-10-26T18:45:00+02:00\",\"PriceNoTax\":0.05818,\"PriceWithTax\":0.07302},"
+  "{\"Rank\":35,\"DateTime\":\"2025-10-26T19:00:00+02:00\",\"PriceNoTax\":0.04278,\"PriceWithTax\":0.05369},"
+  "{\"Rank\":53,\"DateTime\":\"2025-10-26T19:15:00+02:00\",\"PriceNoTax\":0.06871,\"PriceWithTax\":0.08623},"
+  "{\"Rank\":40,\"DateTime\":\"2025-10-26T19:30:00+02:00\",\"PriceNoTax\":0.04629,\"PriceWithTax\":0.05809},"
+  "{\"Rank\":25,\"DateTime\":\"2025-10-26T19:45:00+02:00\",\"PriceNoTax\":0.02815,\"PriceWithTax\":0.03533},"
+  "{\"Rank\":30,\"DateTime\":\"2025-10-26T20:00:00+02:00\",\"PriceNoTax\":0.03714,\"PriceWithTax\":0.04661},"
+  "{\"Rank\":24,\"DateTime\":\"2025-10-26T20:15:00+02:00\",\"PriceNoTax\":0.02779,\"PriceWithTax\":0.03488},"
+  "{\"Rank\":47,\"DateTime\":\"2025-10-26T20:30:00+02:00\",\"PriceNoTax\":0.05439,\"PriceWithTax\":0.06826},"
+  "{\"Rank\":20,\"DateTime\":\"2025-10-26T20:45:00+02:00\",\"PriceNoTax\":0.0203,\"PriceWithTax\":0.02548},"
+  "{\"Rank\":34,\"DateTime\":\"2025-10-26T21:00:00+02:00\",\"PriceNoTax\":0.0419,\"PriceWithTax\":0.05258},"
+  "{\"Rank\":18,\"DateTime\":\"2025-10-26T21:15:00+02:00\",\"PriceNoTax\":0.01776,\"PriceWithTax\":0.02229},"
+  "{\"Rank\":13,\"DateTime\":\"2025-10-26T21:30:00+02:00\",\"PriceNoTax\":0.01301,\"PriceWithTax\":0.01633},"
+  "{\"Rank\":39,\"DateTime\":\"2025-10-26T21:45:00+02:00\",\"PriceNoTax\":0.04599,\"PriceWithTax\":0.05772},"
+  "{\"Rank\":32,\"DateTime\":\"2025-10-26T22:00:00+02:00\",\"PriceNoTax\":0.04074,\"PriceWithTax\":0.05113},"
+  "{\"Rank\":10,\"DateTime\":\"2025-10-26T22:15:00+02:00\",\"PriceNoTax\":0.01093,\"PriceWithTax\":0.01372},"
+  "{\"Rank\":6,\"DateTime\":\"2025-10-26T22:30:00+02:00\",\"PriceNoTax\":-0.00195,\"PriceWithTax\":-0.00195},"
+  "{\"Rank\":3,\"DateTime\":\"2025-10-26T22:45:00+02:00\",\"PriceNoTax\":-0.00553,\"PriceWithTax\":-0.00553},"
+  "{\"Rank\":26,\"DateTime\":\"2025-10-26T23:00:00+02:00\",\"PriceNoTax\":0.02855,\"PriceWithTax\":0.03583},"
+  "{\"Rank\":16,\"DateTime\":\"2025-10-26T23:15:00+02:00\",\"PriceNoTax\":0.01435,\"PriceWithTax\":0.01801},"
+  "{\"Rank\":14,\"DateTime\":\"2025-10-26T23:30:00+02:00\",\"PriceNoTax\":0.01301,\"PriceWithTax\":0.01633},"
+  "{\"Rank\":22,\"DateTime\":\"2025-10-26T23:45:00+02:00\",\"PriceNoTax\":0.0225,\"PriceWithTax\":0.02824}]";
+
+// 2025-03-30: 23-hour day, no 03:00-03:45
+static const char PAYLOAD_DST_SPRING_FORWARD[] =
+  "[{\"Rank\":11,\"DateTime\":\"2025-03-30T00:00:00+02:00\",\"PriceNoTax\":0.01266,\"PriceWithTax\":0.01589},"
+  "{\"Rank\":16,\"DateTime\":\"2025-03-30T00:15:00+02:00\",\"PriceNoTax\":0.02088,\"PriceWithTax\":0.0262},"
+  "{\"Rank\":8,\"DateTime\":\"2025-03-30T00:30:00+02:00\",\"PriceNoTax\":0.00643,\"PriceWithTax\":0.00807},"
+  "{\"Rank\":2,\"DateTime\":\"2025-03-30T00:45:00+02:00\",\"PriceNoTax\":-0.00314,\"PriceWithTax\":-0.00314},"
+  "{\"Rank\":22,\"DateTime\":\"2025-03-30T01:00:00+02:00\",\"PriceNoTax\":0.03208,\"PriceWithTax\":0.04026},"
+  "{\"Rank\":24,\"DateTime\":\"2025-03-30T01:15:00+02:00\",\"PriceNoTax\":0.03366,\"PriceWithTax\":0.04224},"
+  "{\"Rank\":20,\"DateTime\":\"2025-03-30T01:30:00+02:00\",\"PriceNoTax\":0.02828,\"PriceWithTax\":0.03549},"
+  "{\"Rank\":3,\"DateTime\":\"2025-03-30T01:45:00+02:00\",\"PriceNoTax\":-0.0017,\"PriceWithTax\":-0.0017},"
+  "{\"Rank\":19,\"DateTime\":\"2025-03-30T02:00:00+02:00\",\"PriceNoTax\":0.02723,\"PriceWithTax\":0.03417},"
+  "{\"Rank\":14,\"DateTime\":\"2025-03-30T02:15:00+02:00\",\"PriceNoTax\":0.01525,\"PriceWithTax\":0.01914},"
+  "{\"Rank\":9,\"DateTime\":\"2025-03-30T02:30:00+02:00\",\"PriceNoTax\":0.01172,\"PriceWithTax\":0.01471},"
+  "{\"Rank\":25,\"DateTime\":\"2025-03-30T02:45:00+02:00\",\"PriceNoTax\":0.03368,\"PriceWithTax\":0.04227},"
+  "{\"Rank\":43,\"DateTime\":\"2025-03-30T04:00:00+03:00\",\"PriceNoTax\":0.06098,\"PriceWithTax\":0.07653},"
+  "{\"Rank\":17,\"DateTime\":\"2025-03-30T04:15:00+03:00\",\"PriceNoTax\":0.02115,\"PriceWithTax\":0.02654},"
+  "{\"Rank\":48,\"DateTime\":\"2025-03-30T04:30:00+03:00\",\"PriceNoTax\":0.0675,\"PriceWithTax\":0.08471},"
+  "{\"Rank\":44,\"DateTime\":\"2025-03-30T04:45:00+03:00\",\"PriceNoTax\":0.06293,\"PriceWithTax\":0.07898},"
+  "{\"Rank\":31,\"DateTime\":\"2025-03-30T05:00:00+03:00\",\"PriceNoTax\":0.04305,\"PriceWithTax\":0.05403},"
+  "{\"Rank\":46,\"DateTime\":\"2025-03-30T05:15:00+03:00\",\"PriceNoTax\":0.06548,\"PriceWithTax\":0.08218},"
+  "{\"Rank\":32,\"DateTime\":\"2025-03-30T05:30:00+03:00\",\"PriceNoTax\":0.04496,\"PriceWithTax\":0.05642},"
+  "{\"Rank\":49,\"DateTime\":\"2025-03-30T05:45:00+03:00\",\"PriceNoTax\":0.07125,\"PriceWithTax\":0.08942},"
+  "{\"Rank\":33,\"DateTime\":\"2025-03-30T06:00:00+03:00\",\"PriceNoTax\":0.04622,\"PriceWithTax\":0.05801},"
+  "{\"Rank\":34,\"DateTime\":\"2025-03-30T06:15:00+03:00\",\"PriceNoTax\":0.04655,\"PriceWithTax\":0.05842},"
+  "{\"Rank\":65,\"DateTime\":\"2025-03-30T06:30:00+03:00\",\"PriceNoTax\":0.09293,\"PriceWithTax\":0.11663},"
+  "{\"Rank\":36,\"DateTime\":\"2025-03-30T06:45:00+03:00\",\"PriceNoTax\":0.05198,\"PriceWithTax\":0.06523},"
+  "{\"Rank\":40,\"DateTime\":\"2025-03-30T07:00:00+03:00\",\"PriceNoTax\":0.05596,\"PriceWithTax\":0.07023},"
+  "{\"Rank\":57,\"DateTime\":\"2025-03-30T07:15:00+03:00\",\"PriceNoTax\":0.08562,\"PriceWithTax\":0.10745},"
+  "{\"Rank\":74,\"DateTime\":\"2025-03-30T07:30:00+03:00\",\"PriceNoTax\":0.10093,\"PriceWithTax\":0.12667},"
+  "{\"Rank\":54,\"DateTime\":\"2025-03-30T07:45:00+03:00\",\"PriceNoTax\":0.08056,\"PriceWithTax\":0.1011},"
+  "{\"Rank\":76,\"DateTime\":\"2025-03-30T08:00:00+03:00\",\"PriceNoTax\":0.10536,\"PriceWithTax\":0.13223},"
+  "{\"Rank\":55,\"DateTime\":\"2025-03-30T08:15:00+03:00\",\"PriceNoTax\":0.08317,\"PriceWithTax\":0.10438},"
+  "{\"Rank\":52,\"DateTime\":\"2025-03-30T08:30:00+03:00\",\"PriceNoTax\":0.07928,\"PriceWithTax\":0.0995},"
+  "{\"Rank\":58,\"DateTime\":\"2025-03-30T08:45:00+03:00\",\"PriceNoTax\":0.0859,\"PriceWithTax\":0.1078},"
+  "{\"Rank\":83,\"DateTime\":\"2025-03-30T09:00:00+03:00\",\"PriceNoTax\":0.11641,\"PriceWithTax\":0.14609},"
+  "{\"Rank\":88,\"DateTime\":\"2025-03-30T09:15:00+03:00\",\"PriceNoTax\":0.12679,\"PriceWithTax\":0.15912},"
+  "{\"Rank\":80,\"DateTime\":\"2025-03-30T09:30:00+03:00\",\"PriceNoTax\":0.11061,\"PriceWithTax\":0.13882},"
+  "{\"Rank\":82,\"DateTime\":\"2025-03-30T09:45:00+03:00\",\"PriceNoTax\":0.11503,\"PriceWithTax\":0.14436},"
+  "{\"Rank\":78,\"DateTime\":\"2025-03-30T10:00:00+03:00\",\"PriceNoTax\":0.10831,\"PriceWithTax\":0.13593},"
+  "{\"Rank\":69,\"DateTime\":\"2025-03-30T10:15:00+03:00\",\"PriceNoTax\":0.09545,\"PriceWithTax\":0.11979},"
+  "{\"Rank\":5,\"DateTime\":\"2025-03-30T10:30:00+03:00\",\"PriceNoTax\":-0.00097,\"PriceWithTax\":-0.00097},"
+  "{\"Rank\":92,\"DateTime\":\"2025-03-30T10:45:00+03:00\",\"PriceNoTax\":0.13571,\"PriceWithTax\":0.17032},"
+  "{\"Rank\":72,\"DateTime\":\"2025-03-30T11:00:00+03:00\",\"PriceNoTax\":0.09601,\"PriceWithTax\":0.12049},"
+  "{\"Rank\":86,\"DateTime\":\"2025-03-30T11:15:00+03:00\",\"PriceNoTax\":0.12021,\"PriceWithTax\":0.15086},"
+  "{\"Rank\":64,\"DateTime\":\"2025-03-30T11:30:00+03:00\",\"PriceNoTax\":0.09282,\"PriceWithTax\":0.11649},"
+  "{\"Rank\":68,\"DateTime\":\"2025-03-30T11:45:00+03:00\",\"PriceNoTax\":0.09504,\"PriceWithTax\":0.11928},"
+  "{\"Rank\":79,\"DateTime\":\"2025-03-30T12:00:00+03:00\",\"PriceNoTax\":0.10932,\"PriceWithTax\":0.1372},"
+  "{\"Rank\":70,\"DateTime\":\"2025-03-30T12:15:00+03:00\",\"PriceNoTax\":0.09547,\"PriceWithTax\":0.11981},"
+  "{\"Rank\":77,\"DateTime\":\"2025-03-30T12:30:00+03:00\",\"PriceNoTax\":0.10603,\"PriceWithTax\":0.13307},"
+  "{\"Rank\":75,\"DateTime\":\"2025-03-30T12:45:00+03:00\",\"PriceNoTax\":0.10257,\"PriceWithTax\":0.12873},"
+  "{\"Rank\":85,\"DateTime\":\"2025-03-30T13:00:00+03:00\",\"PriceNoTax\":0.12002,\"PriceWithTax\":0.15063},"
+  "{\"Rank\":89,\"DateTime\":\"2025-03-30T13:15:00+03:00\",\"PriceNoTax\":0.12786,\"PriceWithTax\":0.16046},"
+  "{\"Rank\":87,\"DateTime\":\"2025-03-30T13:30:00+03:00\",\"PriceNoTax\":0.12407,\"PriceWithTax\":0.15571},"
+  "{\"Rank\":91,\"DateTime\":\"2025-03-30T13:45:00+03:00\",\"PriceNoTax\":0.13263,\"PriceWithTax\":0.16645},"
+  "{\"Rank\":81,\"DateTime\":\"2025-03-30T14:00:00+03:00\",\"PriceNoTax\":0.11292,\"PriceWithTax\":0.14171},"
+  "{\"Rank\":90,\"DateTime\":\"2025-03-30T14:15:00+03:00\",\"PriceNoTax\":0.12897,\"PriceWithTax\":0.16186},"
+  "{\"Rank\":53,\"DateTime\":\"2025-03-30T14:30:00+03:00\",\"PriceNoTax\":0.08016,\"PriceWithTax\":0.1006},"
+  "{\"Rank\":61,\"DateTime\":\"2025-03-30T14:45:00+03:00\",\"PriceNoTax\":0.0865,\"PriceWithTax\":0.10856},"
+  "{\"Rank\":84,\"DateTime\":\"2025-03-30T15:00:00+03:00\",\"PriceNoTax\":0.11992,\"PriceWithTax\":0.1505},"
+  "{\"Rank\":62,\"DateTime\":\"2025-03-30T15:15:00+03:00\",\"PriceNoTax\":0.0871,\"PriceWithTax\":0.10931},"
+  "{\"Rank\":66,\"DateTime\":\"2025-03-30T15:30:00+03:00\",\"PriceNoTax\":0.09372,\"PriceWithTax\":0.11762},"
+  "{\"Rank\":63,\"DateTime\":\"2025-03-30T15:45:00+03:00\",\"PriceNoTax\":0.09099,\"PriceWithTax\":0.11419},"
+  "{\"Rank\":60,\"DateTime\":\"2025-03-30T16:00:00+03:00\",\"PriceNoTax\":0.08628,\"PriceWithTax\":0.10828},"
+  "{\"Rank\":50,\"DateTime\":\"2025-03-30T16:15:00+03:00\",\"PriceNoTax\":0.07517,\"PriceWithTax\":0.09434},"
+  "{\"Rank\":71,\"DateTime\":\"2025-03-30T16:30:00+03:00\",\"PriceNoTax\":0.096,\"PriceWithTax\":0.12048},"
+  "{\"Rank\":59,\"DateTime\":\"2025-03-30T16:45:00+03:00\",\"PriceNoTax\":0.0861,\"PriceWithTax\":0.10806},"
+  "{\"Rank\":56,\"DateTime\":\"2025-03-30T17:00:00+03:00\",\"PriceNoTax\":0.08488,\"PriceWithTax\":0.10652},"
+  "{\"Rank\":73,\"DateTime\":\"2025-03-30T17:15:00+03:00\",\"PriceNoTax\":0.09815,\"PriceWithTax\":0.12318},"
+  "{\"Rank\":67,\"DateTime\":\"2025-03-30T17:30:00+03:00\",\"PriceNoTax\":0.09388,\"PriceWithTax\":0.11782},"
+  "{\"Rank\":51,\"DateTime\":\"2025-03-30T17:45:00+03:00\",\"PriceNoTax\":0.07619,\"PriceWithTax\":0.09562},"
+  "{\"Rank\":42,\"DateTime\":\"2025-03-30T18:00:00+03:00\",\"PriceNoTax\":0.05614,\"PriceWithTax\":0.07046},"
+  "{\"Rank\":41,\"DateTime\":\"2025-03-30T18:15:00+03:00\",\"PriceNoTax\":0.05609,\"PriceWithTax\":0.07039},"
+  "{\"Rank\":38,\"DateTime\":\"2025-03-30T18:30:00+03:00\",\"PriceNoTax\":0.05475,\"PriceWithTax\":0.06871},"
+  "{\"Rank\":37,\"DateTime\":\"2025-03-30T18:45:00+03:00\",\"PriceNoTax\":0.05239,\"PriceWithTax\":0.06575},"
+  "{\"Rank\":47,\"DateTime\":\"2025-03-30T19:00:00+03:00\",\"PriceNoTax\":0.06628,\"PriceWithTax\":0.08318},"
+  "{\"Rank\":35,\"DateTime\":\"2025-03-30T19:15:00+03:00\",\"PriceNoTax\":0.04893,\"PriceWithTax\":0.06141},"
+  "{\"Rank\":45,\"DateTime\":\"2025-03-30T19:30:00+03:00\",\"PriceNoTax\":0.06371,\"PriceWithTax\":0.07996},"
+  "{\"Rank\":21,\"DateTime\":\"2025-03-30T19:45:00+03:00\",\"PriceNoTax\":0.03141,\"PriceWithTax\":0.03942},"
+  "{\"Rank\":30,\"DateTime\":\"2025-03-30T20:00:00+03:00\",\"PriceNoTax\":0.04203,\"PriceWithTax\":0.05275},"
+  "{\"Rank\":39,\"DateTime\":\"2025-03-30T20:15:00+03:00\",\"PriceNoTax\":0.05561,\"PriceWithTax\":0.06979},"
+  "{\"Rank\":15,\"DateTime\":\"2025-03-30T20:30:00+03:00\",\"PriceNoTax\":0.01568,\"PriceWithTax\":0.01968},"
+  "{\"Rank\":10,\"DateTime\":\"2025-03-30T20:45:00+03:00\",\"PriceNoTax\":0.01211,\"PriceWithTax\":0.0152},"
+  "{\"Rank\":23,\"DateTime\":\"2025-03-30T21:00:00+03:00\",\"PriceNoTax\":0.0331,\"PriceWithTax\":0.04154},"
+  "{\"Rank\":18,\"DateTime\":\"2025-03-30T21:15:00+03:00\",\"PriceNoTax\":0.02397,\"PriceWithTax\":0.03008},"
+  "{\"Rank\":29,\"DateTime\":\"2025-03-30T21:30:00+03:00\",\"PriceNoTax\":0.03937,\"PriceWithTax\":0.04941},"
+  "{\"Rank\":13,\"DateTime\":\"2025-03-30T21:45:00+03:00\",\"PriceNoTax\":0.01364,\"PriceWithTax\":0.01712},"
+  "{\"Rank\":12,\"DateTime\":\"2025-03-30T22:00:00+03:00\",\"PriceNoTax\":0.01322,\"PriceWithTax\":0.01659},"
+  "{\"Rank\":27,\"DateTime\":\"2025-03-30T22:15:00+03:00\",\"PriceNoTax\":0.0364,\"PriceWithTax\":0.04568},"
+  "{\"Rank\":7,\"DateTime\":\"2025-03-30T22:30:00+03:00\",\"PriceNoTax\":0.00073,\"PriceWithTax\":0.00092},"
+  "{\"Rank\":1,\"DateTime\":\"2025-03-30T22:45:00+03:00\",\"PriceNoTax\":-0.00391,\"PriceWithTax\":-0.00391},"
+  "{\"Rank\":4,\"DateTime\":\"2025-03-30T23:00:00+03:00\",\"PriceNoTax\":-0.00166,\"PriceWithTax\":-0.00166},"
+  "{\"Rank\":26,\"DateTime\":\"2025-03-30T23:15:00+03:00\",\"PriceNoTax\":0.0341,\"PriceWithTax\":0.0428},"
+  "{\"Rank\":28,\"DateTime\":\"2025-03-30T23:30:00+03:00\",\"PriceNoTax\":0.03722,\"PriceWithTax\":0.04671},"
+  "{\"Rank\":6,\"DateTime\":\"2025-03-30T23:45:00+03:00\",\"PriceNoTax\":-0.00075,\"PriceWithTax\":-0.00075}]";
+
+// Pretty-printed, as a caching proxy may serve it
+static const char PAYLOAD_PRETTY[] =
+  "[\n"
+  "  {\n"
+  "    \"Rank\": 4,\n"
+  "    \"DateTime\": \"2025-11-19T00:00:00+02:00\",\n"
+  "    \"PriceNoTax\": 0.00579,\n"
+  "    \"PriceWithTax\": 0.00727\n"
+  "  },\n"
+  "  {\n"
+  "    \"Rank\": 7,\n"
+  "    \"DateTime\": \"2025-11-19T00:15:00+02:00\",\n"
+  "    \"PriceNoTax\": 0.03011,\n"
+  "    \"PriceWithTax\": 0.03779\n"
+  "  },\n"
+  "  {\n"
+  "    \"Rank\": 2,\n"
+  "    \"DateTime\": \"2025-11-19T00:30:00+02:00\",\n"
+  "    \"PriceNoTax\": -0.00205,\n"
+  "    \"PriceWithTax\": -0.00205\n"
+  "  },\n"
+  "  {\n"
+  "    \"Rank\": 1,\n"
+  "    \"DateTime\": \"2025-11-19T00:45:00+02:00\",\n"
+  "    \"PriceNoTax\": -0.0023,\n"
+  "    \"PriceWithTax\": -0.0023\n"
+  "  },\n"
+  "  {\n"
+  "    \"Rank\": 3,\n"
+  "    \"DateTime\": \"2025-11-19T01:00:00+02:00\",\n"
+  "    \"PriceNoTax\": 0.00455,\n"
+  "    \"PriceWithTax\": 0.00571\n"
+  "  },\n"
+  "  {\n"
+  "    \"Rank\": 5,\n"
+  "    \"DateTime\": \"2025-11-19T01:15:00+02:00\",\n"
+  "    \"PriceNoTax\": 0.00603,\n"
+  "    \"PriceWithTax\": 0.00757\n"
+  "  },\n"
+  "  {\n"
+  "    \"Rank\": 8,\n"
+  "    \"DateTime\": \"2025-11-19T01:30:00+02:00\",\n"
+  "    \"PriceNoTax\": 0.03144,\n"
+  "    \"PriceWithTax\": 0.03946\n"
+  "  },\n"
+  "  {\n"
+  "    \"Rank\": 6,\n"
+  "    \"DateTime\": \"2025-11-19T01:45:00+02:00\",\n"
+  "    \"PriceNoTax\": 0.00615,\n"
+  "    \"PriceWithTax\": 0.00772\n"
+  "  }\n"
+  "]\n";
+
+#endif
@@ -1,50 +1,90 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
 
 // Use test String adapter
-#include "../TestStringAdapter.h"
+#include "../../host/HostString.h"
 #define WString_h
-#define WIFI_CLIENT_SECURE_H
+#define RESUMABLE_TLS_CLIENT_H
 #define HTTP_CLIENT_H
+#include "../../src/pricing/FetchBudget.h"
 
-// Mock WiFi status
-#define WL_CONNECTED 3
-namespace {
-  struct MockWiFiClass {
-    int status() { return mockStatus; }
-    static int mockStatus;
-  } WiFi;
-  int MockWiFiClass::mockStatus = WL_CONNECTED;
-}
+#include "../mocks/MockWiFi.h"
+
+// Mock Stream: hands out `data` at most `segment` bytes per readBytes call,
+// like a socket receiving TCP segments
+class Stream {
+public:
+  std::string data;
+  size_t pos = 0;
+  size_t segment = 7;
+  
+  size_t readBytes(char* buffer, size_t length) {
+    size_t n = std::min(std::min(length, segment), data.size() - pos);
+    memcpy(buffer, data.data() + pos, n);
+    pos += n;
+    return n;
+  }
+};
 
 // Mock WiFiClientSecure
-class WiFiClientSecure {
+class WiFiClientSecure : public Stream {
 public:
   void setInsecure() {}
+  int connect(const char*, uint16_t, FetchBudget&) { return 1; }
 };
 
+#include "../mocks/NoSessionTlsClient.h"
+
 // Mock HTTPClient
 class HTTPClient {
 public:
   bool begin(WiFiClientSecure&, const char*) { return mockBeginSuccess; }
-  int GET() { return mockHttpCode; }
+  void useHTTP10(bool enabled) { http10 = enabled; }
+  void setTimeout(uint16_t ms) { timeout = ms; }
+  void addHeader(const String& name, const String& value) { sentHeaders[name.c_str()] = value.c_str(); }
+  void collectHeaders(const char* keys[], size_t count) { collected = count; (void)keys; }
+  String header(const char* name) {
+    auto it = mockResponseHeaders.find(name);
+    return it == mockResponseHeaders.end() ? String() : String(it->second.c_str());
+  }
+  int GET() {
+    lastSentHeaders = sentHeaders;
+    return mockHttpCode;
+  }
   String getString() { return mockPayload; }
-  void end() {}
+  Stream& getStream() {
+    stream.data = mockPayload.c_str();
+    return stream;
+  }
+  void end() { ended = true; }
   
+  bool http10 = false;
+  uint16_t timeout = 0;
+  bool ended = false;
+  size_t collected = 0;
+  Stream stream;
+  std::map<std::string, std::string> sentHeaders;
   static bool mockBeginSuccess;
   static int mockHttpCode;
   static String mockPayload;
+  static std::map<std::string, std::string> mockResponseHeaders;
+  static std::map<std::string, std::string> lastSentHeaders;
 };
 
 bool HTTPClient::mockBeginSuccess = true;
 int HTTPClient::mockHttpCode = 200;
 String HTTPClient::mockPayload = "{}";
-
-// Prevent including real WiFi.h
-#define WiFi_h
+std::map<std::string, std::string> HTTPClient::mockResponseHeaders;
+std::map<std::string, std::string> HTTPClient::lastSentHeaders;
 
 // Include the actual implementation
 #include "../../src/pricing/IApiClient.h"
+#include "../../src/pricing/InflateBodyReader.cpp"
 #include "../../src/pricing/PriceApiClient.cpp"
+#include "../mocks/RecordingHandler.h"
 
 // Test Suite: WiFi Status Checking
 TEST(PriceApiClient, ReturnsErrorWhenWiFiNotConnected) {
@@ -183,3 +223,134 @@ TEST(PriceApiClient, HandlesLargePayload) {
   EXPECT_EQ(response.httpCode, 200);
   EXPECT_EQ(response.payload.length(), 5000u);
 }
+// Test Suite: Streaming
+TEST(PriceApiClient, StreamJson_HandsBodyToHandler) {
+  PriceApiClient client;
+  MockWiFiClass::mockStatus = WL_CONNECTED;
+  HTTPClient::mockBeginSuccess = true;
+  HTTPClient::mockHttpCode = 200;
+  HTTPClient::mockPayload = "[{\"DateTime\":\"2025-11-18T10:00:00\",\"PriceWithTax\":0.10}]";
+  
+  RecordingHandler handler;
+  auto response = client.streamJson("http://example.com", handler);
+  
+  EXPECT_TRUE(response.success);
+  EXPECT_EQ(response.httpCode, 200);
+  EXPECT_EQ(response.payload.length(), 0u);  // Nothing buffered
+  EXPECT_EQ(handler.calls, 1);
+  EXPECT_EQ(handler.received, std::string(HTTPClient::mockPayload.c_str()));
+}
+
+TEST(PriceApiClient, StreamJson_HttpErrorSkipsHandler) {
+  PriceApiClient client;
+  MockWiFiClass::mockStatus = WL_CONNECTED;
+  HTTPClient::mockBeginSuccess = true;
+  HTTPClient::mockHttpCode = 503;
+  
+  RecordingHandler handler;
+  auto response = client.streamJson("http://example.com", handler);
+  
+  EXPECT_FALSE(response.success);
+  EXPECT_EQ(response.error, String("HTTP error 503"));
+  EXPECT_EQ(handler.calls, 0);
+}
+
+TEST(PriceApiClient, StreamJson_NoWiFiSkipsHandler) {
+  PriceApiClient client;
+  MockWiFiClass::mockStatus = 0;
+  
+  RecordingHandler handler;
+  auto response = client.streamJson("http://example.com", handler);
+  
+  EXPECT_FALSE(response.success);
+  EXPECT_EQ(response.error, String("No WiFi connection"));
+  EXPECT_EQ(handler.calls, 0);
+  MockWiFiClass::mockStatus = WL_CONNECTED;
+}
+
+TEST(PriceApiClient, StreamJson_NotModifiedSkipsHandler) {
+  PriceApiClient client;
+  MockWiFiClass::mockStatus = WL_CONNECTED;
+  HTTPClient::mockBeginSuccess = true;
+  HTTPClient::mockHttpCode = 304;
+  
+  RecordingHandler handler;
+  auto response = client.streamJson("http://example.com", handler);
+  
+  EXPECT_TRUE(response.success);
+  EXPECT_TRUE(response.notModified);
+  EXPECT_EQ(response.httpCode, 304);
+  EXPECT_EQ(handler.calls, 0);
+}
+
+TEST(PriceApiClient, StreamJson_SendsValidatorsFromLastResponse) {
+  PriceApiClient client;
+  MockWiFiClass::mockStatus = WL_CONNECTED;
+  HTTPClient::mockBeginSuccess = true;
+  HTTPClient::mockHttpCode = 200;
+  HTTPClient::mockResponseHeaders = {{"ETag", "\"abc\""}, {"Last-Modified", "Mon, 17 Nov 2025 12:05:00 GMT"}};
+  
+  RecordingHandler handler;
+  client.streamJson("http://example.com", handler);
+  EXPECT_EQ(HTTPClient::lastSentHeaders.count("If-None-Match"), 0u);
+  EXPECT_EQ(HTTPClient::lastSentHeaders.count("If-Modified-Since"), 0u);
+  
+  client.streamJson("http://example.com", handler);
+  EXPECT_EQ(HTTPClient::lastSentHeaders["If-None-Match"], "\"abc\"");
+  EXPECT_EQ(HTTPClient::lastSentHeaders["If-Modified-Since"], "Mon, 17 Nov 2025 12:05:00 GMT");
+  HTTPClient::mockResponseHeaders.clear();
+}
+
+TEST(PriceApiClient, StreamJson_AcceptsCompressedBody) {
+  PriceApiClient client;
+  MockWiFiClass::mockStatus = WL_CONNECTED;
+  HTTPClient::mockBeginSuccess = true;
+  HTTPClient::mockHttpCode = 200;
+  
+  RecordingHandler handler;
+  client.streamJson("http://example.com", handler);
+  
+  EXPECT_EQ(HTTPClient::lastSentHeaders["Accept-Encoding"], "gzip, deflate");
+}
+
+TEST(PriceApiClient, FetchJson_AsksForPlainBody) {
+  PriceApiClient client;
+  MockWiFiClass::mockStatus = WL_CONNECTED;
+  HTTPClient::mockBeginSuccess = true;
+  HTTPClient::mockHttpCode = 200;
+  
+  client.fetchJson("http://example.com");
+  
+  EXPECT_EQ(HTTPClient::lastSentHeaders.count("Accept-Encoding"), 0u);
+}
+
+TEST(PriceApiClient, StreamJson_UnknownEncoding_ReturnsError) {
+  PriceApiClient client;
+  MockWiFiClass::mockStatus = WL_CONNECTED;
+  HTTPClient::mockBeginSuccess = true;
+  HTTPClient::mockHttpCode = 200;
+  HTTPClient::mockResponseHeaders = {{"Content-Encoding", "br"}};
+  
+  RecordingHandler handler;
+  auto response = client.streamJson("http://example.com", handler);
+  
+  EXPECT_FALSE(response.success);
+  EXPECT_EQ(response.error, String("Unsupported Content-Encoding br"));
+  EXPECT_EQ(handler.calls, 0);
+  HTTPClient::mockResponseHeaders.clear();
+}
+
+TEST(StreamBodyReader, ReadBytesAcrossSegments) {
+  Stream stream;
+  stream.data = "0123456789abcdef";
+  StreamBodyReader body(stream);
+  
+  char buffer[16];
+  EXPECT_EQ(body.read(), '0');
+  EXPECT_EQ(body.readBytes(buffer, sizeof(buffer)), 7u);  // One segment
+  EXPECT_EQ(std::string(buffer, 7), "1234567");
+  EXPECT_EQ(body.readBytes(buffer, sizeof(buffer)), 7u);
+  EXPECT_EQ(body.read(), 'f');
+  EXPECT_EQ(body.read(), -1);
+}
+
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+
+// Use test String adapter before including production headers
+#include "../../host/HostString.h"
+#define WString_h  // Prevent Arduino WString.h inclusion
+
+// Now include production headers and implementation
+#include "../../src/pricing/PriceData.h"
+#include "../../src/pricing/PriceAnalyzer.cpp"
+#include "../test_data_helpers.h"
+
+using TestHelpers::makeFlatSeries;
+using TestHelpers::setPrices;
+using TestHelpers::indexAt;
+
+static std::vector<int> pickedSlots(const CheapestSlots& result, int count) {
+  std::vector<int> picked;
+  for (int i = 0; i < count; i++) {
+    if (result.slots.test(i)) picked.push_back(i);
+  }
+  return picked;
+}
+
+// Reference: stable sort of the range by price, first n taken
+static std::vector<int> bruteForce(const PriceSeries& prices, int first, int last, int n) {
+  std::vector<int> order;
+  for (int i = first; i < last; i++) order.push_back(i);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return prices.prices[a] < prices.prices[b]; });
+  order.resize(std::min<size_t>(n, order.size()));
+  std::sort(order.begin(), order.end());
+  return order;
+}
+
+// Test Suite: findCheapestSlots
+
+TEST(CheapestSlots, PicksScatteredCheapSlots) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.20f);
+  prices.prices[indexAt(prices, 2, 0)] = 0.01f;
+  prices.prices[indexAt(prices, 3, 30)] = 0.02f;
+  prices.prices[indexAt(prices, 5, 15)] = 0.03f;
+  prices.prices[indexAt(prices, 22, 0)] = 0.04f;
+  
+  CheapestSlots result = PriceAnalyzer::findCheapestSlots(prices, prices.slotEpoch(0), prices.slotEpoch(96), 3);
+  
+  EXPECT_EQ(result.count, 3);
+  EXPECT_NEAR(result.avg, 0.02f, 0.00001f);
+  std::vector<int> expected = {indexAt(prices, 2, 0), indexAt(prices, 3, 30), indexAt(prices, 5, 15)};
+  EXPECT_EQ(pickedSlots(result, prices.count), expected);
+}
+
+TEST(CheapestSlots, OnlySlotsBeforeDeadline) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.20f);
+  setPrices(prices, indexAt(prices, 7, 0), 4, 0.01f);   // 07:00-08:00
+  setPrices(prices, indexAt(prices, 3, 0), 2, 0.10f);   // 03:00-03:30
+  
+  // Ready by 07:15: only the 07:00 slot of the cheap hour ends in time
+  time_t deadline = prices.slotEpoch(indexAt(prices, 7, 15));
+  CheapestSlots result = PriceAnalyzer::findCheapestSlots(prices, prices.slotEpoch(0), deadline, 3);
+  
+  std::vector<int> expected = {indexAt(prices, 3, 0), indexAt(prices, 3, 15), indexAt(prices, 7, 0)};
+  EXPECT_EQ(pickedSlots(result, prices.count), expected);
+}
+
+TEST(CheapestSlots, CurrentSlotCountsPastOnesDoNot) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.20f);
+  prices.prices[indexAt(prices, 9, 0)] = 0.01f;   // Already over
+  prices.prices[indexAt(prices, 10, 0)] = 0.02f;  // In progress
+  
+  time_t now = prices.slotEpoch(indexAt(prices, 10, 0)) + 600;  // 10:10
+  CheapestSlots result = PriceAnalyzer::findCheapestSlots(prices, now, prices.slotEpoch(96), 1);
+  
+  std::vector<int> expected = {indexAt(prices, 10, 0)};
+  EXPECT_EQ(pickedSlots(result, prices.count), expected);
+}
+
+TEST(CheapestSlots, EqualPricesPreferEarlierSlots) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.10f);
+  
+  CheapestSlots result = PriceAnalyzer::findCheapestSlots(prices, prices.slotEpoch(10), prices.slotEpoch(96), 4);
+  
+  std::vector<int> expected = {10, 11, 12, 13};
+  EXPECT_EQ(pickedSlots(result, prices.count), expected);
+}
+
+TEST(CheapestSlots, MatchesSortReference) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 192, 0.0f);
+  for (int seed = 0; seed < 5; seed++) {
+    for (int i = 0; i < prices.count; i++) {
+      prices.prices[i] = 0.02f + 0.01f * (((i + seed) * 7919) % 23);
+    }
+    const int counts[] = {1, 8, 24, 100, 192};
+    for (int n : counts) {
+      CheapestSlots result = PriceAnalyzer::findCheapestSlots(prices, prices.slotEpoch(seed * 3),
+                                                              prices.slotEpoch(150 + seed), n);
+      std::vector<int> expected = bruteForce(prices, seed * 3, 150 + seed, n);
+      EXPECT_EQ(pickedSlots(result, prices.count), expected) << "seed " << seed << ", n " << n;
+      EXPECT_EQ(result.count, (int)expected.size());
+    }
+  }
+}
+
+TEST(CheapestSlots, MoreThanAvailable_TakesAll) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 20, 0, 16, 0.10f);
+  
+  CheapestSlots result = PriceAnalyzer::findCheapestSlots(prices, prices.slotEpoch(12), prices.slotEpoch(40), 8);
+  
+  EXPECT_EQ(result.count, 4);  // Data ends after four more slots
+  EXPECT_NEAR(result.avg, 0.10f, 0.00001f);
+}
+
+TEST(CheapestSlots, EmptyRange_NothingPicked) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.10f);
+  
+  EXPECT_EQ(PriceAnalyzer::findCheapestSlots(prices, prices.slotEpoch(50), prices.slotEpoch(50), 4).count, 0);
+  EXPECT_EQ(PriceAnalyzer::findCheapestSlots(prices, prices.slotEpoch(96), prices.slotEpoch(120), 4).count, 0);
+  EXPECT_EQ(PriceAnalyzer::findCheapestSlots(prices, prices.slotEpoch(0), prices.slotEpoch(96), 0).avg, -1.0f);
+  EXPECT_EQ(PriceAnalyzer::findCheapestSlots(PriceSeries(), 0, 1000000, 4).count, 0);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+
+// Use test String adapter before including production headers
+#include "../../host/HostString.h"
+#define WString_h  // Prevent Arduino WString.h inclusion
+
+// Now include production headers and implementation
+#include "../../src/pricing/PriceData.h"
+#include "../../src/pricing/PriceAnalyzer.cpp"
+#include "../test_data_helpers.h"
+
+using TestHelpers::makeFlatSeries;
+using TestHelpers::setPrices;
+using TestHelpers::indexAt;
+using TestHelpers::fillPseudoRandom;
+
+// Reference: every valid window sorted by (sum, start), then picked greedily
+static std::vector<int> bruteForceStarts(const PriceSeries& prices, int periods, int k) {
+  AllowedSlots allowed;
+  allowed.build(prices, ALLOWED_START_HOUR * 60, ALLOWED_END_HOUR * 60);
+  SlotMask validStarts;
+  allowed.windowStarts(periods, validStarts);
+  
+  std::vector<std::pair<int64_t, int>> windows;
+  for (int i = 0; i + periods <= prices.count; i++) {
+    if (!validStarts.test(i)) continue;
+    int64_t sum = 0;
+    for (int j = i; j < i + periods; j++) {
+      sum += priceToMicros(prices.prices[j]);
+    }
+    windows.push_back(std::make_pair(sum, i));
+  }
+  std::sort(windows.begin(), windows.end());
+  
+  std::vector<int> picked;
+  for (size_t w = 0; w < windows.size() && (int)picked.size() < k; w++) {
+    bool overlaps = false;
+    for (int start : picked) {
+      if (std::abs(windows[w].second - start) < periods) overlaps = true;
+    }
+    if (!overlaps) picked.push_back(windows[w].second);
+  }
+  return picked;
+}
+
+// Test Suite: findCheapestWindows
+
+TEST(CheapestWindows, ThreeSeparateDips) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.20f);
+  setPrices(prices, indexAt(prices, 8, 0), 6, 0.05f);
+  setPrices(prices, indexAt(prices, 13, 0), 6, 0.02f);
+  setPrices(prices, indexAt(prices, 19, 0), 6, 0.08f);
+  
+  CheapestWindows result = PriceAnalyzer::findCheapestWindows(prices, 6);
+  
+  ASSERT_EQ(result.count, 3);
+  EXPECT_EQ(result.windows[0].startIndex, indexAt(prices, 13, 0));
+  EXPECT_FLOAT_EQ(result.windows[0].avg, 0.02f);
+  EXPECT_EQ(result.windows[1].startIndex, indexAt(prices, 8, 0));
+  EXPECT_FLOAT_EQ(result.windows[1].avg, 0.05f);
+  EXPECT_EQ(result.windows[2].startIndex, indexAt(prices, 19, 0));
+  EXPECT_FLOAT_EQ(result.windows[2].avg, 0.08f);
+}
+
+TEST(CheapestWindows, OverlappingShiftsOfBestAreSkipped) {
+  // One long cheap stretch: the runner-ups must not share a slot with the best
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.20f);
+  setPrices(prices, indexAt(prices, 10, 0), 12, 0.05f);
+  prices.prices[indexAt(prices, 11, 0)] = 0.01f;
+  
+  CheapestWindows result = PriceAnalyzer::findCheapestWindows(prices, 6);
+  
+  ASSERT_EQ(result.count, 3);
+  for (int a = 0; a < result.count; a++) {
+    for (int b = a + 1; b < result.count; b++) {
+      EXPECT_GE(std::abs(result.windows[a].startIndex - result.windows[b].startIndex), 6);
+    }
+  }
+  EXPECT_EQ(result.windows[0].startIndex, indexAt(prices, 10, 0));  // Earliest of the ties
+  EXPECT_LE(result.windows[0].avg, result.windows[1].avg);
+  EXPECT_LE(result.windows[1].avg, result.windows[2].avg);
+}
+
+TEST(CheapestWindows, FirstMatchesSingleCheapest) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 192, 0.0f);
+  for (int seed = 0; seed < 5; seed++) {
+    fillPseudoRandom(prices, seed);
+    CheapestWindows result = PriceAnalyzer::findCheapestWindows(prices, 6);
+    CheapestWindow single = PriceAnalyzer::findCheapest90MinPeriod(prices);
+    ASSERT_GE(result.count, 1);
+    EXPECT_EQ(result.windows[0].startIndex, single.startIndex);
+    EXPECT_FLOAT_EQ(result.windows[0].avg, single.avg);
+  }
+}
+
+TEST(CheapestWindows, MatchesGreedyReference) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 192, 0.0f);
+  const int lengths[] = {1, 4, 6, 8, 16};
+  for (int periods : lengths) {
+    for (int seed = 0; seed < 5; seed++) {
+      fillPseudoRandom(prices, seed);
+      std::vector<int> expected = bruteForceStarts(prices, periods, MAX_CHEAPEST_WINDOWS);
+      CheapestWindows result = PriceAnalyzer::findCheapestWindows(prices, periods);
+      ASSERT_EQ(result.count, (int)expected.size()) << periods << " slots, seed " << seed;
+      for (int k = 0; k < result.count; k++) {
+        EXPECT_EQ(result.windows[k].startIndex, expected[k]) << periods << " slots, seed " << seed;
+      }
+    }
+  }
+}
+
+TEST(CheapestWindows, FewerWindowsThanRequested) {
+  // 21:00-23:00 only leaves room for one 90-minute period
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 21, 0, 8, 0.10f);
+  
+  CheapestWindows result = PriceAnalyzer::findCheapestWindows(prices, 6);
+  
+  EXPECT_EQ(result.count, 1);
+  EXPECT_EQ(result.windows[0].startIndex, 0);
+  EXPECT_EQ(result.windows[1].startIndex, -1);
+}
+
+TEST(CheapestWindows, MaxWindowsLimitsResult) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.10f);
+  
+  EXPECT_EQ(PriceAnalyzer::findCheapestWindows(prices, 6, 1).count, 1);
+  EXPECT_EQ(PriceAnalyzer::findCheapestWindows(prices, 6, 0).count, 0);
+  EXPECT_EQ(PriceAnalyzer::findCheapestWindows(prices, 6, 10).count, MAX_CHEAPEST_WINDOWS);
+}
+
+TEST(CheapestWindows, LongWindowsCappedByCandidateCapacity) {
+  EXPECT_GE(PriceAnalyzer::maxWindowsFor(16), MAX_CHEAPEST_WINDOWS);  // 4 h windows still get three
+  EXPECT_EQ(PriceAnalyzer::maxWindowsFor(0), 0);
+  
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.10f);
+  CheapestWindows result = PriceAnalyzer::findCheapestWindows(prices, 40);
+  EXPECT_EQ(result.count, PriceAnalyzer::maxWindowsFor(40));
+}
+
+TEST(CheapestWindows, EmptySeries) {
+  PriceSeries prices;
+  CheapestWindows result = PriceAnalyzer::findCheapestWindows(prices, 6);
+  EXPECT_EQ(result.count, 0);
+}
+
+// Test Suite: analyzePrices exposes the runner-ups
+
+TEST(CheapestWindows, AnalysisListsTodayAndTomorrow) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 192, 0.20f);
+  setPrices(prices, indexAt(prices, 9, 0), 6, 0.03f);
+  setPrices(prices, indexAt(prices, 20, 0), 6, 0.01f);
+  setPrices(prices, 96 + indexAt(prices, 12, 0), 6, 0.02f);
+  
+  PriceAnalysis analysis = PriceAnalyzer::analyzePrices(prices, prices.slotEpoch(indexAt(prices, 8, 0)));
+  
+  ASSERT_TRUE(analysis.valid);
+  ASSERT_EQ(analysis.cheapestCount, 3);
+  EXPECT_EQ(analysis.cheapestStarts[0], analysis.cheapest90MinStart);
+  EXPECT_FLOAT_EQ(analysis.cheapestAvgs[0], analysis.cheapest90MinAvg);
+  EXPECT_EQ(analysis.cheapestStarts[0], 20 * 60);
+  EXPECT_FALSE(analysis.cheapestTomorrow[0]);
+  EXPECT_EQ(analysis.cheapestStarts[1], 12 * 60);
+  EXPECT_TRUE(analysis.cheapestTomorrow[1]);
+  EXPECT_EQ(analysis.cheapestStarts[2], 9 * 60);
+  EXPECT_FALSE(analysis.cheapestTomorrow[2]);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <string>
+
+// Use test String adapter
+#include "../../host/HostString.h"
+#define WString_h
+#define RESUMABLE_TLS_CLIENT_H
+#define HTTP_CLIENT_H
+
+#include "../mocks/MockWiFi.h"
+
+// Socket-backed HTTPClient talking to a server on the loopback interface
+#include "../../host/HostHttpClient.h"
+#include "../mocks/LocalHttpServer.h"
+#include "../mocks/NoSessionTlsClient.h"
+
+#include "../../src/pricing/IApiClient.h"
+#include "../../src/pricing/InflateBodyReader.cpp"
+#include "../../src/pricing/PriceApiClient.cpp"
+#include "../mocks/RecordingHandler.h"
+
+static const char* BODY_V1 = "[{\"DateTime\":\"2025-11-18T10:00:00\",\"PriceWithTax\":0.10}]";
+static const char* BODY_V2 = "[{\"DateTime\":\"2025-11-18T10:00:00\",\"PriceWithTax\":0.12}]";
+static const char* MODIFIED_V1 = "Mon, 17 Nov 2025 12:05:00 GMT";
+
+// Test Suite: conditional GET against a local stand-in server
+
+TEST(ConditionalFetch, UnchangedListIsNotSentAgain) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY_V1, "\"v1\"", MODIFIED_V1);
+  PriceApiClient client;
+  RecordingHandler handler;
+
+  auto first = client.streamJson(server.url().c_str(), handler);
+  ASSERT_TRUE(first.success);
+  EXPECT_FALSE(first.notModified);
+  EXPECT_EQ(handler.received, BODY_V1);
+
+  auto second = client.streamJson(server.url().c_str(), handler);
+  EXPECT_TRUE(second.success);
+  EXPECT_TRUE(second.notModified);
+  EXPECT_EQ(second.httpCode, 304);
+  EXPECT_EQ(handler.calls, 1);  // No body to parse
+
+  auto requests = server.requests();
+  ASSERT_EQ(requests.size(), 2u);
+  EXPECT_FALSE(requests[0].has("if-none-match"));
+  EXPECT_FALSE(requests[0].has("if-modified-since"));
+  EXPECT_EQ(requests[1].get("if-none-match"), "\"v1\"");
+  EXPECT_EQ(requests[1].get("if-modified-since"), MODIFIED_V1);
+  EXPECT_EQ(server.bodyBytesSent(), strlen(BODY_V1));
+}
+
+TEST(ConditionalFetch, NewListIsSentInFullAndReplacesValidators) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY_V1, "\"v1\"", MODIFIED_V1);
+  PriceApiClient client;
+  RecordingHandler handler;
+
+  client.streamJson(server.url().c_str(), handler);
+  server.setBody(BODY_V2, "\"v2\"", "Tue, 18 Nov 2025 12:05:00 GMT");
+
+  auto changed = client.streamJson(server.url().c_str(), handler);
+  EXPECT_TRUE(changed.success);
+  EXPECT_FALSE(changed.notModified);
+  EXPECT_EQ(handler.received, BODY_V2);
+
+  auto again = client.streamJson(server.url().c_str(), handler);
+  EXPECT_TRUE(again.notModified);
+  EXPECT_EQ(server.requests()[2].get("if-none-match"), "\"v2\"");
+  EXPECT_EQ(server.fullResponses(), 2);
+  EXPECT_EQ(server.notModifiedResponses(), 1);
+}
+
+TEST(ConditionalFetch, LastModifiedAloneIsEnough) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY_V1, "", MODIFIED_V1);
+  PriceApiClient client;
+  RecordingHandler handler;
+
+  client.streamJson(server.url().c_str(), handler);
+  auto second = client.streamJson(server.url().c_str(), handler);
+
+  EXPECT_TRUE(second.notModified);
+  auto requests = server.requests();
+  EXPECT_FALSE(requests[1].has("if-none-match"));
+  EXPECT_EQ(requests[1].get("if-modified-since"), MODIFIED_V1);
+}
+
+TEST(ConditionalFetch, NoValidatorsMeansPlainRequests) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY_V1);
+  PriceApiClient client;
+  RecordingHandler handler;
+
+  client.streamJson(server.url().c_str(), handler);
+  auto second = client.streamJson(server.url().c_str(), handler);
+
+  EXPECT_FALSE(second.notModified);
+  EXPECT_EQ(handler.calls, 2);
+  EXPECT_FALSE(server.requests()[1].has("if-none-match"));
+  EXPECT_FALSE(server.requests()[1].has("if-modified-since"));
+}
+
+TEST(ConditionalFetch, ClearValidatorsForcesFullResponse) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY_V1, "\"v1\"", MODIFIED_V1);
+  PriceApiClient client;
+  RecordingHandler handler;
+
+  client.streamJson(server.url().c_str(), handler);
+  client.clearValidators();  // e.g. the body did not parse
+  auto second = client.streamJson(server.url().c_str(), handler);
+
+  EXPECT_FALSE(second.notModified);
+  EXPECT_EQ(handler.calls, 2);
+  EXPECT_FALSE(server.requests()[1].has("if-none-match"));
+}
+
+TEST(ConditionalFetch, ValidatorsBelongToTheirUrl) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY_V1, "\"v1\"", MODIFIED_V1);
+  PriceApiClient client;
+  RecordingHandler handler;
+
+  client.streamJson(server.url("/today").c_str(), handler);
+  auto other = client.streamJson(server.url("/tomorrow").c_str(), handler);
+
+  EXPECT_FALSE(other.notModified);
+  EXPECT_FALSE(server.requests()[1].has("if-none-match"));
+}
+
+TEST(ConditionalFetch, BufferedFetchUsesValidatorsToo) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY_V1, "\"v1\"", MODIFIED_V1);
+  PriceApiClient client;
+
+  auto first = client.fetchJson(server.url().c_str());
+  auto second = client.fetchJson(server.url().c_str());
+
+  EXPECT_EQ(first.payload, String(BODY_V1));
+  EXPECT_TRUE(second.success);
+  EXPECT_TRUE(second.notModified);
+  EXPECT_EQ(second.payload.length(), 0u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
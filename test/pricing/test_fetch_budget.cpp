@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <chrono>
+#include <string>
+#include <thread>
+
+// Use test String adapter
+#include "../../host/HostString.h"
+#define WString_h
+#define RESUMABLE_TLS_CLIENT_H
+#define HTTP_CLIENT_H
+
+#include "../mocks/MockWiFi.h"
+
+// OpenSSL-backed client and servers on the loopback interface
+#include "../../host/HostTlsClient.h"
+#include "../mocks/LocalTlsServer.h"
+
+#include "../../src/pricing/IApiClient.h"
+#include "../../src/pricing/InflateBodyReader.cpp"
+#include "../../src/pricing/PriceApiClient.cpp"
+#include "../../src/pricing/LanPriceClient.cpp"
+#include "../../src/pricing/SpotPriceTokenizer.cpp"
+#include "spot_hinta_payloads.h"
+
+// Clocks: one the tests move by hand, one that runs like millis()
+static unsigned long fakeMillis = 0;
+static unsigned long fakeClock() { return fakeMillis; }
+
+static unsigned long hostMillis() {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Short stages, so a stalled server is given up on quickly
+static FetchBudget::Limits shortLimits() {
+  FetchBudget::Limits limits = {3000, {1000, 500, 500, 500, 300, 300, 300}};
+  return limits;
+}
+
+static const int STALL_MS = 1000;
+
+// Holds the response back for STALL_MS, before the headers or partway
+// into the body, as a congested link or an overloaded server would
+template <class Server>
+class Stalling : public Server {
+public:
+  enum Where { BEFORE_HEADERS, IN_BODY };
+
+  explicit Stalling(Where where) : where(where) {}
+  ~Stalling() override { this->shutdown(); }
+
+protected:
+  ssize_t transmit(int fd, const char* data, size_t length) override {
+    if (stalled) {
+      return Server::transmit(fd, data, length);
+    }
+    stalled = true;
+    size_t prefix = 0;
+    if (where == IN_BODY) {
+      const char* end = strstr(data, "\r\n\r\n");
+      prefix = end ? (size_t)(end - data) + 4 + 100 : 0;
+    }
+    ssize_t sent = prefix > 0 ? Server::transmit(fd, data, prefix) : 0;
+    std::this_thread::sleep_for(std::chrono::milliseconds(STALL_MS));
+    return prefix > 0 ? sent : Server::transmit(fd, data, length);
+  }
+
+private:
+  Where where;
+  bool stalled = false;
+};
+
+class ParsingHandler : public IApiClient::BodyHandler {
+public:
+  PriceSeries series;
+  int parsed = 0;
+
+  void handleBody(BodyReader& body) override {
+    parsed = SpotPriceTokenizer::parse(body, series, nullptr);
+  }
+};
+
+// Test Suite: FetchBudget accounting
+
+TEST(FetchBudget, StageGetsItsOwnLimit) {
+  fakeMillis = 1000;
+  FetchBudget budget(fakeClock, shortLimits());
+
+  EXPECT_EQ(budget.begin(FetchBudget::WIFI), 1000u);
+  fakeMillis += 400;
+  EXPECT_EQ(budget.begin(FetchBudget::DNS), 500u);
+  EXPECT_FALSE(budget.exhausted());
+  EXPECT_EQ(budget.elapsed(), 400u);
+}
+
+TEST(FetchBudget, StageCutToWhatIsLeft) {
+  fakeMillis = 0;
+  FetchBudget budget(fakeClock, shortLimits());
+
+  budget.begin(FetchBudget::WIFI);
+  fakeMillis = 2800;
+  EXPECT_EQ(budget.begin(FetchBudget::TLS), 200u);
+}
+
+TEST(FetchBudget, ExpiredRecordsTheFirstStageToRunOut) {
+  fakeMillis = 0;
+  FetchBudget budget(fakeClock, shortLimits());
+
+  budget.begin(FetchBudget::CONNECT);
+  fakeMillis = 499;
+  EXPECT_FALSE(budget.expired());
+  fakeMillis = 500;
+  EXPECT_TRUE(budget.expired());
+  EXPECT_EQ(budget.exhaustedStage(), FetchBudget::CONNECT);
+
+  // Later stages get nothing and do not overwrite the culprit
+  EXPECT_EQ(budget.begin(FetchBudget::TLS), 0u);
+  EXPECT_TRUE(budget.expired());
+  EXPECT_EQ(budget.exhaustedStage(), FetchBudget::CONNECT);
+  EXPECT_STREQ(FetchBudget::describe(budget.exhaustedStage()), "connect");
+}
+
+TEST(FetchBudget, SpentTotalEndsTheNextStage) {
+  fakeMillis = 0;
+  FetchBudget budget(fakeClock, shortLimits());
+
+  budget.begin(FetchBudget::WIFI);
+  fakeMillis = 3000;
+  EXPECT_EQ(budget.begin(FetchBudget::BODY), 0u);
+  EXPECT_EQ(budget.exhaustedStage(), FetchBudget::BODY);
+}
+
+TEST(FetchBudget, NoStageNeverExpires) {
+  fakeMillis = 0;
+  FetchBudget budget(fakeClock);
+  fakeMillis = 60000;
+
+  EXPECT_FALSE(budget.expired());
+  EXPECT_EQ(budget.currentStage(), FetchBudget::NONE);
+}
+
+TEST(FetchBudget, HttpTimeoutFitsSixteenBits) {
+  EXPECT_EQ(FetchBudget::httpTimeout(4000), 4000);
+  EXPECT_EQ(FetchBudget::httpTimeout(100000), 0xFFFF);
+}
+
+// Test Suite: budgeted fetches against local servers
+
+TEST(FetchBudgetFetch, FetchWithinBudget) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(PAYLOAD_TWO_DAYS);
+  PriceApiClient client;
+  ParsingHandler handler;
+  FetchBudget budget(hostMillis);
+
+  auto response = client.streamJson(server.url().c_str(), handler, &budget);
+
+  EXPECT_TRUE(response.success) << response.error.c_str();
+  EXPECT_EQ(handler.parsed, 192);
+  EXPECT_FALSE(budget.exhausted());
+  EXPECT_EQ(budget.currentStage(), FetchBudget::BODY);
+}
+
+TEST(FetchBudgetFetch, StalledHandshakeTimesOut) {
+  // Plain HTTP: the TLS client waits for a ServerHello that never comes
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  PriceApiClient client;
+  ParsingHandler handler;
+  FetchBudget budget(hostMillis, shortLimits());
+
+  auto response = client.streamJson(server.url().c_str(), handler, &budget);
+
+  EXPECT_FALSE(response.success);
+  EXPECT_EQ(response.error, String("Timed out: tls"));
+  EXPECT_EQ(budget.exhaustedStage(), FetchBudget::TLS);
+  EXPECT_LT(budget.elapsed(), 1000u);
+}
+
+TEST(FetchBudgetFetch, StalledHeadersTimeOut) {
+  Stalling<LocalTlsServer> server(Stalling<LocalTlsServer>::BEFORE_HEADERS);
+  ASSERT_TRUE(server.listening());
+  server.setBody(PAYLOAD_TWO_DAYS);
+  PriceApiClient client;
+  ParsingHandler handler;
+  FetchBudget budget(hostMillis, shortLimits());
+
+  auto response = client.streamJson(server.url().c_str(), handler, &budget);
+
+  EXPECT_FALSE(response.success);
+  EXPECT_EQ(response.error, String("Timed out: response"));
+  EXPECT_EQ(handler.parsed, 0);
+  EXPECT_LT(budget.elapsed(), (unsigned long)STALL_MS);
+}
+
+TEST(FetchBudgetFetch, StalledBodyTimesOut) {
+  Stalling<LocalTlsServer> server(Stalling<LocalTlsServer>::IN_BODY);
+  ASSERT_TRUE(server.listening());
+  server.setBody(PAYLOAD_TWO_DAYS);
+  PriceApiClient client;
+  ParsingHandler handler;
+  FetchBudget budget(hostMillis, shortLimits());
+
+  auto response = client.streamJson(server.url().c_str(), handler, &budget);
+
+  // What arrived before the stall is not reported as a good fetch
+  EXPECT_FALSE(response.success);
+  EXPECT_EQ(response.error, String("Timed out: body"));
+  EXPECT_EQ(budget.exhaustedStage(), FetchBudget::BODY);
+  EXPECT_LT(budget.elapsed(), (unsigned long)STALL_MS);
+}
+
+TEST(FetchBudgetFetch, StalledLanServerTimesOut) {
+  Stalling<LocalHttpServer> server(Stalling<LocalHttpServer>::BEFORE_HEADERS);
+  ASSERT_TRUE(server.listening());
+  server.setBody("blob");
+  LanPriceClient client;
+  ParsingHandler handler;
+  FetchBudget budget(hostMillis, shortLimits());
+
+  auto response = client.streamJson(server.url().c_str(), handler, &budget);
+
+  EXPECT_FALSE(response.success);
+  EXPECT_EQ(response.error, String("Timed out: connect"));
+  EXPECT_LT(budget.elapsed(), (unsigned long)STALL_MS);
+}
+
+int main(int argc, char **argv) {
+  // A stalled server writes on after the client has given up; SSL_write
+  // has no MSG_NOSIGNAL
+  signal(SIGPIPE, SIG_IGN);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+// Use test String adapter before including production headers
+#include "../../host/HostString.h"
+#define WString_h  // Prevent Arduino WString.h inclusion
+
+#include "../../src/pricing/PriceData.h"
+#include "../../src/pricing/FetchScheduler.h"
+#include "../test_data_helpers.h"
+
+using TestHelpers::makeFlatSeries;
+
+static const int16_t WINTER = 120;  // Finland, UTC+2
+
+// Instant of local HH:MM on 2025-11-(17 + dayOffset)
+static time_t localTime(int dayOffset, int hour, int minute) {
+  time_t midnight = (time_t)PriceTime::daysFromCivil(2025, 11, 17 + dayOffset) * PriceTime::SECONDS_PER_DAY;
+  return midnight + hour * 3600 + minute * 60 - WINTER * 60;
+}
+
+// What the API serves at `now`: today from midnight, and tomorrow once published
+static PriceSeries published(time_t now, int publishMinute) {
+  int32_t day = PriceTime::localDay(now, WINTER);
+  int days = PriceTime::localMinuteOfDay(now, WINTER) >= publishMinute ? 2 : 1;
+  int year = 2025, month = 11;
+  int dayOfMonth = 17 + (int)(day - PriceTime::daysFromCivil(2025, 11, 17));
+  return makeFlatSeries(year, month, dayOfMonth, 0, 0, days * 96, 0.10f, WINTER);
+}
+
+// Test Suite: FetchScheduler
+
+TEST(FetchScheduler, NoPrices_Fetches) {
+  PriceSeries empty;
+  EXPECT_EQ(FetchScheduler::check(empty, localTime(0, 10, 0), 0), FetchScheduler::NO_PRICES);
+}
+
+TEST(FetchScheduler, TodayHeld_MorningUsesCache) {
+  PriceSeries today = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.10f, WINTER);
+  for (int hour = 0; hour < 14; hour++) {
+    EXPECT_EQ(FetchScheduler::check(today, localTime(0, hour, 0), localTime(0, 0, 0)),
+              FetchScheduler::NOT_NEEDED) << hour;
+  }
+}
+
+TEST(FetchScheduler, AfterPublication_FetchesTomorrow) {
+  PriceSeries today = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.10f, WINTER);
+  time_t morning = localTime(0, 8, 0);
+
+  EXPECT_EQ(FetchScheduler::check(today, localTime(0, 14, 0), morning), FetchScheduler::NOT_NEEDED);
+  EXPECT_EQ(FetchScheduler::check(today, localTime(0, 14, 15), morning), FetchScheduler::TOMORROW_MISSING);
+}
+
+TEST(FetchScheduler, TomorrowLate_RetriesHourly) {
+  PriceSeries today = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.10f, WINTER);
+  time_t attempt = localTime(0, 14, 15) + 4;  // The fetch took a few seconds
+
+  EXPECT_EQ(FetchScheduler::check(today, localTime(0, 14, 30), attempt), FetchScheduler::NOT_NEEDED);
+  EXPECT_EQ(FetchScheduler::check(today, localTime(0, 15, 0), attempt), FetchScheduler::NOT_NEEDED);
+  EXPECT_EQ(FetchScheduler::check(today, localTime(0, 15, 15), attempt), FetchScheduler::TOMORROW_MISSING);
+}
+
+TEST(FetchScheduler, TomorrowHeld_NoFetchUntilNextPublication) {
+  PriceSeries twoDays = makeFlatSeries(2025, 11, 17, 0, 0, 192, 0.10f, WINTER);
+  time_t fetched = localTime(0, 14, 15);
+
+  EXPECT_EQ(FetchScheduler::check(twoDays, localTime(0, 23, 45), fetched), FetchScheduler::NOT_NEEDED);
+  EXPECT_EQ(FetchScheduler::check(twoDays, localTime(1, 14, 0), fetched), FetchScheduler::NOT_NEEDED);
+  EXPECT_EQ(FetchScheduler::check(twoDays, localTime(1, 14, 15), fetched), FetchScheduler::TOMORROW_MISSING);
+}
+
+TEST(FetchScheduler, RunningOut_RetriesHourly) {
+  PriceSeries today = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.10f, WINTER);
+  time_t attempt = localTime(0, 21, 15) + 4;
+
+  EXPECT_EQ(FetchScheduler::check(today, localTime(0, 21, 15), localTime(0, 20, 15)), FetchScheduler::RUNNING_OUT);
+  // Every tick after a failed attempt would otherwise fetch again
+  EXPECT_EQ(FetchScheduler::check(today, localTime(0, 21, 30), attempt), FetchScheduler::NOT_NEEDED);
+  EXPECT_EQ(FetchScheduler::check(today, localTime(0, 22, 0), attempt), FetchScheduler::NOT_NEEDED);
+  EXPECT_EQ(FetchScheduler::check(today, localTime(0, 22, 15), attempt), FetchScheduler::RUNNING_OUT);
+  EXPECT_EQ(FetchScheduler::check(today, localTime(1, 0, 15), 0), FetchScheduler::RUNNING_OUT);
+}
+
+TEST(FetchScheduler, ThreeDays_OneOrTwoFetchesPerDay) {
+  struct Case {
+    int publishMinute;
+    int perDay;
+  } cases[] = {
+    {13 * 60 + 55, 1},  // Published on time: one fetch a day
+    {15 * 60 + 10, 2},  // Late: 14:15 misses, 15:15 gets it
+  };
+
+  for (const Case& c : cases) {
+    time_t start = localTime(0, 8, 0);  // Boot
+    PriceSeries held;
+    time_t lastAttempt = 0;
+    std::vector<int> fetchesPerDay(4, 0);
+
+    for (time_t now = start; now < localTime(3, 8, 0); now += 15 * 60) {
+      if (FetchScheduler::check(held, now, lastAttempt) != FetchScheduler::NOT_NEEDED) {
+        held = published(now, c.publishMinute);
+        lastAttempt = now;
+        fetchesPerDay[PriceTime::localDay(now, WINTER) - PriceTime::localDay(start, WINTER)]++;
+      }
+      // The analysis always has its next 90 minutes
+      ASSERT_GE(held.slotEpoch(held.count) - now, 90 * 60) << c.publishMinute;
+    }
+
+    EXPECT_EQ(fetchesPerDay[0], 1 + c.perDay) << c.publishMinute;  // Plus the boot fetch
+    EXPECT_EQ(fetchesPerDay[1], c.perDay) << c.publishMinute;
+    EXPECT_EQ(fetchesPerDay[2], c.perDay) << c.publishMinute;
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
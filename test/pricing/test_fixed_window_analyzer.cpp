@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cstdio>
+
+// Use test String adapter before including production headers
+#include "../../host/HostString.h"
+#define WString_h  // Prevent Arduino WString.h inclusion
+
+// Now include production headers and implementation
+#include "../../src/pricing/PriceData.h"
+#include "../../src/pricing/PriceAnalyzer.cpp"
+#include "../test_data_helpers.h"
+
+using TestHelpers::makeFlatSeries;
+using TestHelpers::setPrices;
+using TestHelpers::indexAt;
+using TestHelpers::fillPseudoRandom;
+
+// Reference: every start re-summed and checked against local time.
+// Local time must advance through the window (no midnight, no DST fall-back).
+template <typename Analyzer>
+bool windowFits(const PriceSeries& prices, int i) {
+  int start = prices.minuteOfDay(i);
+  if (start < Analyzer::EARLIEST_START) return false;
+  for (int j = i + 1; j < i + Analyzer::SLOTS; j++) {
+    if (prices.minuteOfDay(j) <= prices.minuteOfDay(j - 1)) return false;
+  }
+  return prices.minuteOfDay(i + Analyzer::SLOTS - 1) + prices.slotMinutes() <= Analyzer::LATEST_END;
+}
+
+template <typename Analyzer>
+CheapestWindow bruteForce(const PriceSeries& prices) {
+  CheapestWindow result;
+  int64_t cheapestSum = 0;
+  for (int i = 0; i + Analyzer::SLOTS <= prices.count; i++) {
+    if (!windowFits<Analyzer>(prices, i)) {
+      continue;
+    }
+    int64_t sum = 0;
+    for (int j = i; j < i + Analyzer::SLOTS; j++) {
+      sum += priceToMicros(prices.prices[j]);
+    }
+    if (result.startIndex < 0 || sum < cheapestSum) {
+      cheapestSum = sum;
+      result.startIndex = i;
+    }
+  }
+  if (result.startIndex >= 0) {
+    result.avg = (float)((double)cheapestSum / 1000000.0 / Analyzer::SLOTS);
+  }
+  return result;
+}
+
+// Test Suite: FixedWindowAnalyzer, instantiated for several configurations
+
+template <typename Analyzer>
+class FixedWindowAnalyzerTest : public ::testing::Test {
+protected:
+  void expectMatchesReference(const PriceSeries& prices) {
+    CheapestWindow expected = bruteForce<Analyzer>(prices);
+    CheapestWindow actual = Analyzer::findCheapest(prices);
+    EXPECT_EQ(actual.startIndex, expected.startIndex);
+    EXPECT_FLOAT_EQ(actual.avg, expected.avg);
+  }
+};
+
+typedef ::testing::Types<
+  Window90MinAnalyzer,               // Display default: 90 min, 7-23
+  FixedWindowAnalyzer<8, 7, 23>,     // Dishwasher, 2 h
+  FixedWindowAnalyzer<16, 0, 24>,    // Water heater, 4 h, any time
+  FixedWindowAnalyzer<12, 17, 22>,   // Evening-only 3 h
+  FixedWindowAnalyzer<1, 7, 23>,     // Single slot
+  FixedWindowAnalyzer<8, 22, 23>     // Window longer than the allowed hours
+> Configurations;
+TYPED_TEST_SUITE(FixedWindowAnalyzerTest, Configurations);
+
+TYPED_TEST(FixedWindowAnalyzerTest, TwoFullDays) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 192, 0.0f);
+  for (int seed = 0; seed < 5; seed++) {
+    fillPseudoRandom(prices, seed);
+    this->expectMatchesReference(prices);
+  }
+}
+
+TYPED_TEST(FixedWindowAnalyzerTest, StartsMidDay) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 13, 15, 140, 0.0f);
+  fillPseudoRandom(prices, 3);
+  this->expectMatchesReference(prices);
+}
+
+TYPED_TEST(FixedWindowAnalyzerTest, FlatPrices_FirstValidStartWins) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 192, 0.10f);
+  this->expectMatchesReference(prices);
+}
+
+TYPED_TEST(FixedWindowAnalyzerTest, SummerOffset) {
+  PriceSeries prices = makeFlatSeries(2025, 6, 17, 0, 0, 192, 0.0f, 180);
+  fillPseudoRandom(prices, 7);
+  this->expectMatchesReference(prices);
+}
+
+TYPED_TEST(FixedWindowAnalyzerTest, DstFallBack) {
+  // 2025-10-26: offset drops from +03:00 to +02:00 at 04:00 local
+  PriceSeries prices = makeFlatSeries(2025, 10, 25, 0, 0, 100, 0.0f, 180);
+  time_t next = prices.slotEpoch(prices.count);
+  for (int i = 0; i < 90; i++) {
+    ASSERT_TRUE(prices.append(PriceEntry(next + (time_t)i * 900, 120, 0.0f)));
+  }
+  ASSERT_EQ(prices.dstSwitchIndex, 100);
+  for (int seed = 0; seed < 5; seed++) {
+    fillPseudoRandom(prices, seed);
+    this->expectMatchesReference(prices);
+  }
+}
+
+TYPED_TEST(FixedWindowAnalyzerTest, DstSwitchInsideAllowedHours) {
+  // Offset change at 12:00 local exercises windows straddling the switch
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 48, 0.20f, 120);
+  time_t next = prices.slotEpoch(prices.count);
+  for (int i = 0; i < 48; i++) {
+    ASSERT_TRUE(prices.append(PriceEntry(next + (time_t)i * 900, 180, 0.20f)));
+  }
+  setPrices(prices, 44, 8, 0.01f);  // Cheap block across the switch
+  this->expectMatchesReference(prices);
+}
+
+TYPED_TEST(FixedWindowAnalyzerTest, HourlySlots_FallsBackToCheckedScan) {
+  PriceSeries prices;
+  time_t base = (time_t)PriceTime::daysFromCivil(2025, 11, 17) * PriceTime::SECONDS_PER_DAY;
+  for (int i = 0; i < 48; i++) {
+    prices.append(PriceEntry(base + (time_t)i * 3600, 0, 0.0f));
+  }
+  fillPseudoRandom(prices, 1);
+  this->expectMatchesReference(prices);
+}
+
+TYPED_TEST(FixedWindowAnalyzerTest, ShorterThanWindow_ReturnsInvalid) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 10, 0, TypeParam::SLOTS - 1, 0.10f);
+  CheapestWindow result = TypeParam::findCheapest(prices);
+  EXPECT_EQ(result.startIndex, -1);
+  EXPECT_EQ(result.avg, -1.0f);
+}
+
+// Test Suite: compile-time bounds
+
+TEST(FixedWindowAnalyzer, CompileTimeBounds) {
+  static_assert(Window90MinAnalyzer::FIRST_START_SLOT == 28, "7:00");
+  static_assert(Window90MinAnalyzer::LAST_START_SLOT == 86, "21:30");
+  static_assert(FixedWindowAnalyzer<16, 0, 24>::LAST_START_SLOT == 80, "20:00");
+  static_assert(FixedWindowAnalyzer<8, 22, 23>::LAST_START_SLOT < FixedWindowAnalyzer<8, 22, 23>::FIRST_START_SLOT,
+                "window cannot fit");
+  EXPECT_EQ(Window90MinAnalyzer::SLOTS, 6);
+}
+
+TEST(FixedWindowAnalyzer, DefaultMatchesRuntimeAnalyzer) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 192, 0.20f);
+  setPrices(prices, indexAt(prices, 14, 30), 6, 0.04f);
+
+  CheapestWindow fixed = Window90MinAnalyzer::findCheapest(prices);
+  CheapestWindow runtime = PriceAnalyzer::findCheapestPeriod(prices, 6);
+
+  EXPECT_EQ(fixed.startIndex, indexAt(prices, 14, 30));
+  EXPECT_EQ(fixed.startIndex, runtime.startIndex);
+  EXPECT_FLOAT_EQ(fixed.avg, runtime.avg);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
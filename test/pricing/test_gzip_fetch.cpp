@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <string>
+
+// Use test String adapter
+#include "../../host/HostString.h"
+#define WString_h
+#define RESUMABLE_TLS_CLIENT_H
+#define HTTP_CLIENT_H
+
+#include "../mocks/MockWiFi.h"
+
+// Socket-backed HTTPClient talking to a server on the loopback interface
+#include "../../host/HostHttpClient.h"
+#include "../mocks/LocalHttpServer.h"
+#include "../mocks/NoSessionTlsClient.h"
+
+#include "../../src/pricing/IApiClient.h"
+#include "../../src/pricing/InflateBodyReader.cpp"
+#include "../../src/pricing/PriceApiClient.cpp"
+#include "../mocks/RecordingHandler.h"
+#include "../../src/pricing/SpotPriceTokenizer.cpp"
+#include "spot_hinta_payloads.h"
+
+// The server's side of the encoding, done with zlib; link with -lz
+static std::string compress(const std::string& text, int windowBits) {
+  z_stream stream = {};
+  deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+  std::string out(deflateBound(&stream, text.size()) + 32, '\0');
+  stream.next_in = (Bytef*)text.data();
+  stream.avail_in = (uInt)text.size();
+  stream.next_out = (Bytef*)&out[0];
+  stream.avail_out = (uInt)out.size();
+  deflate(&stream, Z_FINISH);
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+  return out;
+}
+
+static std::string gzip(const std::string& text) { return compress(text, 15 + 16); }
+
+// Parses the way PriceMonitor does, leaving the rest of the body unread
+class TokenizingHandler : public IApiClient::BodyHandler {
+public:
+  PriceSeries series;
+  int count = 0;
+
+  void handleBody(BodyReader& body) override { count = SpotPriceTokenizer::parse(body, series, nullptr); }
+};
+
+// Test Suite: compressed responses from a local stand-in server
+
+TEST(GzipFetch, GzipBodyIsInflatedForTheParser) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  std::string json = PAYLOAD_TWO_DAYS;
+  std::string compressed = gzip(json);
+  server.setBody(json);
+  server.setEncodedBody("gzip", compressed);
+  PriceApiClient client;
+  RecordingHandler handler;
+
+  auto response = client.streamJson(server.url().c_str(), handler);
+
+  ASSERT_TRUE(response.success);
+  EXPECT_EQ(handler.received, json);
+  EXPECT_EQ(response.compressedBytes, compressed.size());
+  EXPECT_EQ(response.inflatedBytes, json.size());
+  EXPECT_EQ(server.encodedResponses(), 1);
+  EXPECT_NE(server.requests()[0].get("accept-encoding").find("gzip"), std::string::npos);
+}
+
+TEST(GzipFetch, FewerBytesOnAir) {
+  LocalHttpServer plainServer;
+  LocalHttpServer gzipServer;
+  ASSERT_TRUE(plainServer.listening());
+  ASSERT_TRUE(gzipServer.listening());
+  std::string json = PAYLOAD_TWO_DAYS;
+  plainServer.setBody(json);
+  gzipServer.setBody(json);
+  gzipServer.setEncodedBody("gzip", gzip(json));
+  PriceApiClient client;
+  TokenizingHandler plain;
+  TokenizingHandler inflated;
+
+  client.streamJson(plainServer.url().c_str(), plain);
+  client.streamJson(gzipServer.url().c_str(), inflated);
+
+  ASSERT_GT(plain.count, 0);
+  EXPECT_EQ(inflated.count, plain.count);
+  EXPECT_EQ(inflated.series.checksum(), plain.series.checksum());
+  EXPECT_LT(gzipServer.bodyBytesSent() * 5, plainServer.bodyBytesSent());
+  printf("Body on the wire: %zu bytes plain, %zu gzip\n", plainServer.bodyBytesSent(),
+         gzipServer.bodyBytesSent());
+}
+
+TEST(GzipFetch, DeflateEncoding) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  std::string json = PAYLOAD_TWO_DAYS;
+  server.setBody(json);
+  server.setEncodedBody("deflate", compress(json, 15));
+  PriceApiClient client;
+  RecordingHandler handler;
+
+  auto response = client.streamJson(server.url().c_str(), handler);
+
+  ASSERT_TRUE(response.success);
+  EXPECT_EQ(handler.received, json);
+}
+
+TEST(GzipFetch, PlainBodyWhenServerDoesNotCompress) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  std::string json = PAYLOAD_TWO_DAYS;
+  server.setBody(json);
+  PriceApiClient client;
+  RecordingHandler handler;
+
+  auto response = client.streamJson(server.url().c_str(), handler);
+
+  ASSERT_TRUE(response.success);
+  EXPECT_EQ(handler.received, json);
+  EXPECT_EQ(response.compressedBytes, 0u);
+}
+
+TEST(GzipFetch, BufferedFetchAsksForPlainBody) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  std::string json = PAYLOAD_TWO_DAYS;
+  server.setBody(json);
+  server.setEncodedBody("gzip", gzip(json));
+  PriceApiClient client;
+
+  auto response = client.fetchJson(server.url().c_str());
+
+  ASSERT_TRUE(response.success);
+  EXPECT_EQ(response.payload, String(json));
+  EXPECT_FALSE(server.requests()[0].has("accept-encoding"));
+}
+
+TEST(GzipFetch, CorruptBodyFailsAndKeepsNoValidators) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  std::string json = PAYLOAD_TWO_DAYS;
+  std::string damaged = gzip(json);
+  damaged[damaged.size() - 8] ^= 0x01;  // CRC-32
+  server.setBody(json, "\"v1\"");
+  server.setEncodedBody("gzip", damaged);
+  PriceApiClient client;
+  TokenizingHandler handler;
+
+  auto response = client.streamJson(server.url().c_str(), handler);
+  EXPECT_FALSE(response.success);
+  EXPECT_EQ(response.httpCode, 200);
+  EXPECT_EQ(response.error, String("Corrupt compressed body"));
+  EXPECT_GT(handler.count, 0);  // Parsed before the checksum came in
+
+  // Nothing from that response is trusted, its ETag included
+  client.streamJson(server.url().c_str(), handler);
+  EXPECT_FALSE(server.requests()[1].has("if-none-match"));
+}
+
+TEST(GzipFetch, TruncatedBodyFails) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  std::string json = PAYLOAD_TWO_DAYS;
+  std::string compressed = gzip(json);
+  server.setBody(json);
+  server.setEncodedBody("gzip", compressed.substr(0, compressed.size() / 2));
+  PriceApiClient client;
+  RecordingHandler handler;
+
+  auto response = client.streamJson(server.url().c_str(), handler);
+
+  EXPECT_FALSE(response.success);
+  EXPECT_LT(handler.received.size(), json.size());
+}
+
+TEST(GzipFetch, NotModifiedStillHasNoBody) {
+  LocalHttpServer server;
+  ASSERT_TRUE(server.listening());
+  std::string json = PAYLOAD_TWO_DAYS;
+  server.setBody(json, "\"v1\"");
+  server.setEncodedBody("gzip", gzip(json));
+  PriceApiClient client;
+  RecordingHandler handler;
+
+  client.streamJson(server.url().c_str(), handler);
+  auto second = client.streamJson(server.url().c_str(), handler);
+
+  EXPECT_TRUE(second.success);
+  EXPECT_TRUE(second.notModified);
+  EXPECT_EQ(handler.calls, 1);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <string>
+#include <vector>
+
+#include "../../src/pricing/InflateBodyReader.cpp"
+#include "spot_hinta_payloads.h"
+
+// zlib is the reference encoder here; link with -lz
+static const int GZIP_BITS = 15 + 16;
+static const int ZLIB_BITS = 15;
+static const int RAW_BITS = -15;
+
+static std::string deflateWith(const std::string& text, int windowBits, int level = Z_DEFAULT_COMPRESSION,
+                               int strategy = Z_DEFAULT_STRATEGY, gz_header* header = nullptr) {
+  z_stream stream = {};
+  deflateInit2(&stream, level, Z_DEFLATED, windowBits, 8, strategy);
+  if (header) {
+    deflateSetHeader(&stream, header);
+  }
+  std::string out(deflateBound(&stream, text.size()) + 64, '\0');
+  stream.next_in = (Bytef*)text.data();
+  stream.avail_in = (uInt)text.size();
+  stream.next_out = (Bytef*)&out[0];
+  stream.avail_out = (uInt)out.size();
+  deflate(&stream, Z_FINISH);
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+  return out;
+}
+
+static std::string gzip(const std::string& text, int level = Z_DEFAULT_COMPRESSION) {
+  return deflateWith(text, GZIP_BITS, level);
+}
+
+// Reads the whole body one byte at a time, as the tokenizer does
+static std::string readAll(InflateBodyReader& reader) {
+  std::string text;
+  int c;
+  while ((c = reader.read()) >= 0) {
+    text += (char)c;
+  }
+  return text;
+}
+
+// Text longer than the window, with repeats near and far
+static std::string longText() {
+  std::string text;
+  unsigned seed = 12345;
+  while (text.size() < 3 * InflateBodyReader::WINDOW_SIZE) {
+    seed = seed * 1103515245u + 12345u;
+    text += PAYLOAD_TWO_DAYS + (seed >> 16) % 4000;
+    text.resize(text.size() - (seed >> 8) % 3000);
+    text += std::to_string(seed);
+  }
+  return text;
+}
+
+class InflateTest : public ::testing::Test {
+protected:
+  std::string inflate(const std::string& compressed, InflateBodyReader::Format format, bool* intact = nullptr) {
+    StringBodyReader source(compressed.data(), compressed.size());
+    InflateBodyReader reader(source, format, window.data());
+    std::string text = readAll(reader);
+    if (intact) {
+      *intact = reader.intact();
+    }
+    return text;
+  }
+
+  std::vector<uint8_t> window = std::vector<uint8_t>(InflateBodyReader::WINDOW_SIZE);
+};
+
+// Test Suite: block types and wrappers
+
+TEST_F(InflateTest, GzipPayload) {
+  std::string json = PAYLOAD_TWO_DAYS;
+  std::string compressed = gzip(json);
+  bool intact = false;
+
+  EXPECT_EQ(inflate(compressed, InflateBodyReader::GZIP, &intact), json);
+  EXPECT_TRUE(intact);
+  EXPECT_LT(compressed.size() * 5, json.size());
+}
+
+TEST_F(InflateTest, EveryLevel) {
+  std::string json = PAYLOAD_TWO_DAYS;
+  for (int level = 0; level <= 9; level++) {
+    bool intact = false;
+    EXPECT_EQ(inflate(gzip(json, level), InflateBodyReader::GZIP, &intact), json) << "level " << level;
+    EXPECT_TRUE(intact) << "level " << level;
+  }
+}
+
+TEST_F(InflateTest, FixedAndSingleCodeBlocks) {
+  std::string json = PAYLOAD_TWO_DAYS;
+  int strategies[] = {Z_FIXED, Z_HUFFMAN_ONLY, Z_RLE, Z_FILTERED};
+  for (int strategy : strategies) {
+    bool intact = false;
+    std::string compressed = deflateWith(json, GZIP_BITS, 9, strategy);
+    EXPECT_EQ(inflate(compressed, InflateBodyReader::GZIP, &intact), json) << "strategy " << strategy;
+    EXPECT_TRUE(intact) << "strategy " << strategy;
+  }
+  // A one-byte body has a distance code with a single code, or none
+  bool intact = false;
+  EXPECT_EQ(inflate(gzip("["), InflateBodyReader::GZIP, &intact), "[");
+  EXPECT_TRUE(intact);
+}
+
+TEST_F(InflateTest, EmptyBody) {
+  bool intact = false;
+  EXPECT_EQ(inflate(gzip(""), InflateBodyReader::GZIP, &intact), "");
+  EXPECT_TRUE(intact);
+}
+
+TEST_F(InflateTest, ZlibWrappedDeflate) {
+  std::string json = PAYLOAD_TWO_DAYS;
+  bool intact = false;
+
+  EXPECT_EQ(inflate(deflateWith(json, ZLIB_BITS), InflateBodyReader::DEFLATE, &intact), json);
+  EXPECT_TRUE(intact);
+}
+
+TEST_F(InflateTest, RawDeflate) {
+  std::string json = PAYLOAD_TWO_DAYS;
+  for (int level = 0; level <= 9; level += 3) {
+    bool intact = false;
+    EXPECT_EQ(inflate(deflateWith(json, RAW_BITS, level), InflateBodyReader::DEFLATE, &intact), json);
+    EXPECT_TRUE(intact);
+  }
+}
+
+TEST_F(InflateTest, GzipHeaderFields) {
+  std::string json = PAYLOAD_TWO_DAYS;
+  gz_header header = {};
+  unsigned char extra[] = "AB\x04\x00test";
+  header.extra = extra;
+  header.extra_len = 8;
+  header.name = (Bytef*)"prices.json";
+  header.comment = (Bytef*)"spot prices";
+  header.hcrc = 1;
+  bool intact = false;
+
+  std::string compressed = deflateWith(json, GZIP_BITS, 6, Z_DEFAULT_STRATEGY, &header);
+
+  EXPECT_EQ(inflate(compressed, InflateBodyReader::GZIP, &intact), json);
+  EXPECT_TRUE(intact);
+}
+
+TEST_F(InflateTest, BodyLongerThanWindow) {
+  std::string text = longText();
+  std::string compressed = gzip(text, 9);
+  StringBodyReader source(compressed.data(), compressed.size());
+  InflateBodyReader reader(source, InflateBodyReader::GZIP, window.data());
+
+  // Odd-sized chunks cross the end of the window
+  std::string inflated;
+  char buffer[1000];
+  size_t n;
+  while ((n = reader.readBytes(buffer, sizeof(buffer))) > 0) {
+    inflated.append(buffer, n);
+  }
+
+  EXPECT_EQ(inflated, text);
+  EXPECT_TRUE(reader.intact());
+  EXPECT_EQ(reader.compressedBytes(), compressed.size());
+}
+
+TEST_F(InflateTest, StopsAtEndOfStream) {
+  std::string compressed = gzip("[1,2,3]") + "trailing garbage";
+  StringBodyReader source(compressed.data(), compressed.size());
+  InflateBodyReader reader(source, InflateBodyReader::GZIP, window.data());
+
+  EXPECT_EQ(readAll(reader), "[1,2,3]");
+  EXPECT_TRUE(reader.intact());
+  EXPECT_EQ(source.read(), 't');
+}
+
+// Test Suite: damaged streams
+
+TEST_F(InflateTest, TruncatedStream) {
+  std::string json = PAYLOAD_TWO_DAYS;
+  std::string compressed = gzip(json);
+  size_t cuts[] = {0, 5, 10, compressed.size() / 2, compressed.size() - 8, compressed.size() - 1};
+  for (size_t cut : cuts) {
+    StringBodyReader source(compressed.data(), cut);
+    InflateBodyReader reader(source, InflateBodyReader::GZIP, window.data());
+    std::string text = readAll(reader);
+    EXPECT_FALSE(reader.intact()) << "cut at " << cut;
+    EXPECT_TRUE(reader.failed()) << "cut at " << cut;
+    EXPECT_EQ(json.compare(0, text.size(), text), 0) << "cut at " << cut;
+  }
+}
+
+TEST_F(InflateTest, ChecksumMismatch) {
+  std::string compressed = gzip(PAYLOAD_TWO_DAYS);
+  std::string badCrc = compressed;
+  badCrc[badCrc.size() - 8] ^= 0x01;
+  std::string badSize = compressed;
+  badSize[badSize.size() - 1] ^= 0x01;
+  bool intact = true;
+
+  EXPECT_EQ(inflate(badCrc, InflateBodyReader::GZIP, &intact), PAYLOAD_TWO_DAYS);
+  EXPECT_FALSE(intact);
+  EXPECT_EQ(inflate(badSize, InflateBodyReader::GZIP, &intact), PAYLOAD_TWO_DAYS);
+  EXPECT_FALSE(intact);
+
+  std::string badAdler = deflateWith(PAYLOAD_TWO_DAYS, ZLIB_BITS);
+  badAdler[badAdler.size() - 1] ^= 0x01;
+  inflate(badAdler, InflateBodyReader::DEFLATE, &intact);
+  EXPECT_FALSE(intact);
+}
+
+TEST_F(InflateTest, CorruptDataNeverIntact) {
+  std::string compressed = gzip(PAYLOAD_TWO_DAYS);
+  for (size_t i = 10; i < compressed.size() - 8; i += 7) {
+    std::string damaged = compressed;
+    damaged[i] ^= (char)(1 << (i % 8));
+    bool intact = true;
+    inflate(damaged, InflateBodyReader::GZIP, &intact);
+    EXPECT_FALSE(intact) << "byte " << i;
+  }
+}
+
+TEST_F(InflateTest, NotGzip) {
+  bool intact = true;
+  std::string json = "[{\"DateTime\":\"2025-11-18T10:00:00\"}]";
+
+  EXPECT_EQ(inflate(json, InflateBodyReader::GZIP, &intact), "");
+  EXPECT_FALSE(intact);
+}
+
+TEST_F(InflateTest, ReferenceBeforeStart) {
+  // Fixed block: a match of length 3 at distance 1 before any literal
+  const char stream[] = {0x03, 0x02, 0x00, 0x00};
+  bool intact = true;
+
+  EXPECT_EQ(inflate(std::string(stream, sizeof(stream)), InflateBodyReader::DEFLATE, &intact), "");
+  EXPECT_FALSE(intact);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+
+// Use test String adapter before including production headers
+#include "../../host/HostString.h"
+#define WString_h  // Prevent Arduino WString.h inclusion
+
+#include <ArduinoJson.h>
+
+#include "../../src/pricing/BodyReader.h"
+#include "../../src/pricing/PriceJsonFilter.h"
+#include "spot_hinta_payloads.h"
+
+// Tracks the bytes a JsonDocument holds and their high-water mark
+class CountingAllocator : public ArduinoJson::Allocator {
+public:
+  void* allocate(size_t size) override {
+    void* ptr = malloc(size);
+    if (ptr) {
+      sizes[ptr] = size;
+      add(size);
+    }
+    return ptr;
+  }
+
+  void deallocate(void* ptr) override {
+    if (!ptr) return;
+    current -= sizes[ptr];
+    sizes.erase(ptr);
+    free(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t newSize) override {
+    size_t oldSize = ptr ? sizes[ptr] : 0;
+    void* moved = realloc(ptr, newSize);
+    if (!moved) return nullptr;
+    if (ptr) sizes.erase(ptr);
+    sizes[moved] = newSize;
+    current -= oldSize;
+    add(newSize);
+    return moved;
+  }
+
+  size_t current = 0;
+  size_t peak = 0;
+
+private:
+  void add(size_t size) {
+    current += size;
+    if (current > peak) peak = current;
+  }
+
+  std::map<void*, size_t> sizes;
+};
+
+// Peak bytes for the whole response held as one document
+static size_t wholeDocumentPeak(const char* json, const PriceJsonFilter* filter) {
+  CountingAllocator allocator;
+  {
+    JsonDocument doc(&allocator);
+    DeserializationError error = filter ? deserializeJson(doc, json, strlen(json), filter->option())
+                                        : deserializeJson(doc, json, strlen(json));
+    EXPECT_FALSE(error) << error.c_str();
+    JsonArray entries = doc.as<JsonArray>();
+    EXPECT_EQ(entries.size(), 192u);
+    EXPECT_STREQ(entries[0]["DateTime"].as<const char*>(), "2025-11-17T00:00:00+02:00");
+  }
+  EXPECT_EQ(allocator.current, 0u);
+  return allocator.peak;
+}
+
+// Test Suite: document memory for a 192-entry response
+
+TEST(JsonMemory, FilterShrinksWholeDocument) {
+  PriceJsonFilter filter(true);
+  size_t unfiltered = wholeDocumentPeak(PAYLOAD_TWO_DAYS, nullptr);
+  size_t filtered = wholeDocumentPeak(PAYLOAD_TWO_DAYS, &filter);
+
+  printf("whole document peak: %zu bytes unfiltered, %zu bytes filtered\n", unfiltered, filtered);
+  RecordProperty("UnfilteredPeakBytes", (int)unfiltered);
+  RecordProperty("FilteredPeakBytes", (int)filtered);
+  EXPECT_LT(filtered, unfiltered);
+}
+
+TEST(JsonMemory, FilteredEntryKeepsOnlyUsedFields) {
+  const char* element = R"({"Rank":12,"DateTime":"2025-11-17T00:00:00+02:00","PriceNoTax":0.0331,"PriceWithTax":0.04154})";
+  PriceJsonFilter filter;
+  CountingAllocator allocator;
+  JsonDocument doc(&allocator);
+  StringBodyReader body(element, strlen(element));
+
+  ASSERT_FALSE(deserializeJson(doc, body, filter.option()));
+
+  JsonObject entry = doc.as<JsonObject>();
+  EXPECT_STREQ(entry["DateTime"].as<const char*>(), "2025-11-17T00:00:00+02:00");
+  EXPECT_FLOAT_EQ(entry["PriceWithTax"].as<float>(), 0.04154f);
+  EXPECT_TRUE(entry["Rank"].isNull());
+  EXPECT_TRUE(entry["PriceNoTax"].isNull());
+}
+
+TEST(JsonMemory, PerEntryDocumentStaysBelowWholeDocument) {
+  // The streamed path holds one entry at a time
+  PriceJsonFilter filter;
+  CountingAllocator allocator;
+  StringBodyReader body(PAYLOAD_TWO_DAYS, strlen(PAYLOAD_TWO_DAYS));
+  ASSERT_EQ(body.read(), '[');
+  int entries = 0;
+  {
+    JsonDocument doc(&allocator);
+    for (;;) {
+      ASSERT_FALSE(deserializeJson(doc, body, filter.option()));
+      entries++;
+      int c = body.read();
+      if (c != ',') {
+        EXPECT_EQ(c, ']');
+        break;
+      }
+    }
+  }
+  EXPECT_EQ(entries, 192);
+
+  PriceJsonFilter wholeFilter(true);
+  size_t whole = wholeDocumentPeak(PAYLOAD_TWO_DAYS, &wholeFilter);
+  printf("per-entry document peak: %zu bytes\n", allocator.peak);
+  RecordProperty("PerEntryPeakBytes", (int)allocator.peak);
+  EXPECT_LT(allocator.peak * 10, whole);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -4,7 +4,7 @@
 #include <ctime>
 
 // Use test String adapter before including production headers
-#include "../TestStringAdapter.h"
+#include "../../host/HostString.h"
 #define WString_h  // Prevent Arduino WString.h inclusion
 
 // Include production headers and implementation
@@ -20,25 +20,31 @@ String makeTimestamp(int year, int month, int day, int hour, int minute) {
 }
 
 // Helper to create a full day of price data starting from a specific hour
-std::vector<PriceEntry> createDayPrices(int year, int month, int day, int startHour, float basePrice) {
-  std::vector<PriceEntry> prices;
+PriceSeries createDayPrices(int year, int month, int day, int startHour, float basePrice) {
+  PriceSeries prices;
   
   for (int hour = startHour; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
       PriceEntry entry;
-      entry.dateTime = makeTimestamp(year, month, day, hour, minute);
+      entry = PriceEntry(makeTimestamp(year, month, day, hour, minute).c_str(), 0.0f);
       entry.priceWithTax = basePrice + (hour * 0.01f) + (minute * 0.0001f);
-      prices.push_back(entry);
+      prices.append(entry);
     }
   }
   
   return prices;
 }
 
+// UTC epoch for a wall-clock time (test data carries no offset)
+time_t epochAt(int year, int month, int day, int hour, int minute) {
+  return (time_t)PriceTime::daysFromCivil(year, month, day) * PriceTime::SECONDS_PER_DAY
+       + hour * 3600 + minute * 60;
+}
+
 // Test Suite: analyzePrices integration tests
 
 TEST(AnalyzePrices, EmptyDataset_ReturnsInvalid) {
-  std::vector<PriceEntry> empty;
+  PriceSeries empty;
   
   PriceAnalysis result = PriceAnalyzer::analyzePrices(empty);
   
@@ -48,42 +54,36 @@ TEST(AnalyzePrices, EmptyDataset_ReturnsInvalid) {
 }
 
 TEST(AnalyzePrices, ValidDataset_PopulatesAllFields) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Create a dataset for 2025-11-17 from 10:00 to 15:00
   for (int hour = 10; hour <= 14; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
       PriceEntry entry;
-      entry.dateTime = makeTimestamp(2025, 11, 17, hour, minute);
+      entry = PriceEntry(makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.0f);
       entry.priceWithTax = 0.10f + (hour - 10) * 0.01f;
-      prices.push_back(entry);
+      prices.append(entry);
     }
   }
   
-  // Mock current time by manipulating the first entry to match "now"
-  // Note: This test assumes findCurrentPriceIndex will find the first entry
-  // In production, this relies on system time
+  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices, epochAt(2025, 11, 17, 10, 0));
   
-  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices);
-  
-  // Since findCurrentPriceIndex uses system time, we can't easily control it
-  // So we test the structure is populated when valid
-  if (result.valid) {
-    EXPECT_NE(result.currentPeriodStartTime, String(""));
-    EXPECT_GE(result.next90MinAvg, 0.0f);
-    EXPECT_GE(result.cheapest90MinAvg, 0.0f);
-    EXPECT_NE(result.cheapest90MinTime, String(""));
-  }
+  ASSERT_TRUE(result.valid);
+  EXPECT_EQ(result.currentPeriodStart, 10 * 60);
+  // Four 10:xx slots at 0.10 and two 11:xx slots at 0.11
+  EXPECT_NEAR(result.next90MinAvg, 0.62f / 6, 0.0001f);
+  EXPECT_NEAR(result.cheapest90MinAvg, 0.62f / 6, 0.0001f);
+  EXPECT_EQ(result.cheapest90MinStart, 10 * 60);
 }
 
 TEST(AnalyzePrices, CheapestPeriodExtraction_CorrectTime) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Create dataset with obvious cheapest period at 12:00
   for (int hour = 10; hour <= 15; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
       PriceEntry entry;
-      entry.dateTime = makeTimestamp(2025, 11, 17, hour, minute);
+      entry = PriceEntry(makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.0f);
       
       // Make 12:00-13:30 period the cheapest
       if (hour == 12 && minute < 90) {
@@ -95,49 +95,47 @@ TEST(AnalyzePrices, CheapestPeriodExtraction_CorrectTime) {
       } else {
         entry.priceWithTax = 0.20f;
       }
-      prices.push_back(entry);
+      prices.append(entry);
     }
   }
   
-  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices);
+  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices, epochAt(2025, 11, 17, 10, 0));
   
-  if (result.valid) {
-    EXPECT_EQ(result.cheapest90MinTime, String("12:00"));
-    EXPECT_NEAR(result.cheapest90MinAvg, 0.05f, 0.001f);
-  }
+  ASSERT_TRUE(result.valid);
+  EXPECT_EQ(result.cheapest90MinStart, 12 * 60);
+  EXPECT_NEAR(result.cheapest90MinAvg, 0.05f, 0.001f);
 }
 
 TEST(AnalyzePrices, TomorrowDetection_SameDay) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // All data from same day
   for (int hour = 10; hour <= 20; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
       PriceEntry entry;
-      entry.dateTime = makeTimestamp(2025, 11, 17, hour, minute);
+      entry = PriceEntry(makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.0f);
       entry.priceWithTax = 0.10f;
-      prices.push_back(entry);
+      prices.append(entry);
     }
   }
   
-  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices);
+  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices, epochAt(2025, 11, 17, 10, 0));
   
-  if (result.valid) {
-    // All on same day, so cheapest should not be tomorrow
-    EXPECT_FALSE(result.cheapestIsTomorrow);
-  }
+  ASSERT_TRUE(result.valid);
+  // All on same day, so cheapest should not be tomorrow
+  EXPECT_FALSE(result.cheapestIsTomorrow);
 }
 
 TEST(AnalyzePrices, TomorrowDetection_NextDay) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Data from today (expensive)
   for (int hour = 10; hour <= 23; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
       PriceEntry entry;
-      entry.dateTime = makeTimestamp(2025, 11, 17, hour, minute);
+      entry = PriceEntry(makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.0f);
       entry.priceWithTax = 0.20f;
-      prices.push_back(entry);
+      prices.append(entry);
     }
   }
   
@@ -145,46 +143,43 @@ TEST(AnalyzePrices, TomorrowDetection_NextDay) {
   for (int hour = 0; hour <= 10; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
       PriceEntry entry;
-      entry.dateTime = makeTimestamp(2025, 11, 18, hour, minute);
+      entry = PriceEntry(makeTimestamp(2025, 11, 18, hour, minute).c_str(), 0.0f);
       entry.priceWithTax = 0.05f;
-      prices.push_back(entry);
+      prices.append(entry);
     }
   }
   
-  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices);
+  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices, epochAt(2025, 11, 17, 10, 0));
   
-  if (result.valid) {
-    // Cheapest period should be from tomorrow (but might be constrained by 7:00-23:00 rule)
-    // The 7:00 period from tomorrow should be cheapest valid period
-    if (result.cheapest90MinTime == String("07:00")) {
-      EXPECT_TRUE(result.cheapestIsTomorrow);
-    }
-  }
+  ASSERT_TRUE(result.valid);
+  // Tomorrow's cheap night is excluded, so the 7:00 period is the cheapest valid one
+  EXPECT_EQ(result.cheapest90MinStart, 7 * 60);
+  EXPECT_TRUE(result.cheapestIsTomorrow);
 }
 
 TEST(AnalyzePrices, NotEnoughDataForAnalysis_ReturnsInvalid) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Only 3 entries - not enough for 90min window
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 30), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 30).c_str(), 0.12f});
   
-  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices);
+  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices, epochAt(2025, 11, 17, 10, 0));
   
   EXPECT_FALSE(result.valid);
 }
 
 TEST(AnalyzePrices, TimeConstraints_OnlyNightPrices_FindsDaytimePeriod) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Very cheap night prices (should be ignored)
   for (int hour = 0; hour < 7; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
       PriceEntry entry;
-      entry.dateTime = makeTimestamp(2025, 11, 17, hour, minute);
+      entry = PriceEntry(makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.0f);
       entry.priceWithTax = 0.01f;  // Very cheap
-      prices.push_back(entry);
+      prices.append(entry);
     }
   }
   
@@ -192,43 +187,97 @@ TEST(AnalyzePrices, TimeConstraints_OnlyNightPrices_FindsDaytimePeriod) {
   for (int hour = 7; hour <= 22; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
       PriceEntry entry;
-      entry.dateTime = makeTimestamp(2025, 11, 17, hour, minute);
+      entry = PriceEntry(makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.0f);
       entry.priceWithTax = 0.15f;
-      prices.push_back(entry);
+      prices.append(entry);
     }
   }
   
-  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices);
+  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices, epochAt(2025, 11, 17, 10, 0));
   
-  if (result.valid) {
-    // Should pick a daytime period, not the cheap night period
-    String cheapTime = result.cheapest90MinTime;
-    int hour = (cheapTime.c_str()[0] - '0') * 10 + (cheapTime.c_str()[1] - '0');
-    EXPECT_GE(hour, 7);
-    EXPECT_NEAR(result.cheapest90MinAvg, 0.15f, 0.001f);
-  }
+  ASSERT_TRUE(result.valid);
+  // Should pick a daytime period, not the cheap night period
+  int hour = result.cheapest90MinStart / 60;
+  EXPECT_GE(hour, 7);
+  EXPECT_NEAR(result.cheapest90MinAvg, 0.15f, 0.001f);
 }
 
 TEST(AnalyzePrices, CurrentPeriodTimeExtraction_CorrectFormat) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Create dataset
   for (int hour = 10; hour <= 15; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
       PriceEntry entry;
-      entry.dateTime = makeTimestamp(2025, 11, 17, hour, minute);
+      entry = PriceEntry(makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.0f);
       entry.priceWithTax = 0.10f;
-      prices.push_back(entry);
+      prices.append(entry);
     }
   }
   
-  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices);
+  PriceAnalysis result = PriceAnalyzer::analyzePrices(prices, epochAt(2025, 11, 17, 10, 7));
   
-  if (result.valid) {
-    // Check format is HH:MM
-    EXPECT_EQ(result.currentPeriodStartTime.length(), static_cast<size_t>(5));
-    EXPECT_EQ(result.currentPeriodStartTime.c_str()[2], ':');
+  ASSERT_TRUE(result.valid);
+  // 10:07 falls in the slot starting at 10:00
+  EXPECT_EQ(result.currentPeriodStart, 10 * 60);
+}
+
+TEST(AnalyzePrices, AdvanceMatchesFullAnalysisEveryQuarter) {
+  // Two days with repeating dips, so the cheapest windows keep starting
+  PriceSeries prices;
+  for (int day = 17; day <= 18; day++) {
+    for (int hour = 0; hour < 24; hour++) {
+      for (int minute = 0; minute < 60; minute += 15) {
+        float price = 0.05f + 0.01f * (((hour * 4 + minute / 15) * 37 + day) % 19);
+        prices.append(PriceEntry(makeTimestamp(2025, 11, day, hour, minute).c_str(), price));
+      }
+    }
   }
+  ASSERT_EQ(prices.count, 192);
+  
+  PricePrefixSums sums;
+  sums.build(prices);
+  AllowedSlots allowed;
+  allowed.build(prices, ALLOWED_START_HOUR * 60, ALLOWED_END_HOUR * 60);
+  SlotMask validStarts;
+  allowed.windowStarts(Window90MinAnalyzer::SLOTS, validStarts);
+  
+  CheapestWindows windows;
+  PriceAnalysis advanced = PriceAnalyzer::analyzePrices(prices, validStarts, prices.slotEpoch(0), windows);
+  for (int i = 1; i < prices.count; i++) {
+    PriceAnalyzer::advanceAnalysis(prices, sums, validStarts, prices.slotEpoch(i), windows, advanced);
+    PriceAnalysis full = PriceAnalyzer::analyzePrices(prices, prices.slotEpoch(i));
+    
+    ASSERT_EQ(advanced.valid, full.valid) << "slot " << i;
+    EXPECT_EQ(advanced.currentPeriodStart, full.currentPeriodStart);
+    EXPECT_EQ(advanced.next90MinAvg, full.next90MinAvg) << "slot " << i;
+    ASSERT_EQ(advanced.cheapestCount, full.cheapestCount) << "slot " << i;
+    for (int k = 0; k < full.cheapestCount; k++) {
+      EXPECT_EQ(advanced.cheapestStarts[k], full.cheapestStarts[k]) << "slot " << i;
+      EXPECT_EQ(advanced.cheapestTomorrow[k], full.cheapestTomorrow[k]) << "slot " << i;
+    }
+    if (!advanced.valid) {
+      break;  // Past the last start; a real caller fetches again
+    }
+  }
+}
+
+TEST(AnalyzePrices, CheapestIgnoresPeriodsAlreadyStarted) {
+  PriceSeries prices;
+  for (int hour = 7; hour < 23; hour++) {
+    for (int minute = 0; minute < 60; minute += 15) {
+      float price = (hour == 8) ? 0.01f : 0.10f;
+      prices.append(PriceEntry(makeTimestamp(2025, 11, 17, hour, minute).c_str(), price));
+    }
+  }
+  
+  PriceAnalysis before = PriceAnalyzer::analyzePrices(prices, epochAt(2025, 11, 17, 7, 30));
+  PriceAnalysis after = PriceAnalyzer::analyzePrices(prices, epochAt(2025, 11, 17, 8, 30));
+  
+  ASSERT_TRUE(before.valid);
+  ASSERT_TRUE(after.valid);
+  EXPECT_EQ(before.cheapest90MinStart, 8 * 60 - 30);   // 07:30, covering the whole cheap hour
+  EXPECT_EQ(after.cheapest90MinStart, 8 * 60 + 30);    // Earliest start still ahead
 }
 
 int main(int argc, char **argv) {
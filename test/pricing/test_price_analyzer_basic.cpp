@@ -3,32 +3,36 @@
 #include <cstdio>
 
 // Use test String adapter before including production headers
-#include "../TestStringAdapter.h"
+#include "../../host/HostString.h"
 #define WString_h  // Prevent Arduino WString.h inclusion
 
 // Now include production headers and implementation
 #include "../../src/pricing/PriceData.h"
 #include "../../src/pricing/PriceAnalyzer.cpp"
+#include "../test_data_helpers.h"
+
+using TestHelpers::makeSeries;
+using TestHelpers::makeFlatSeries;
 
 // Test Suite: calculate90MinAverage
 TEST(Calculate90MinAverage, ValidInput_Exactly6Periods) {
-  std::vector<PriceEntry> prices = {
+  PriceSeries prices = makeSeries({
     {"2025-11-15T10:00:00", 0.10f},
     {"2025-11-15T10:15:00", 0.11f},
     {"2025-11-15T10:30:00", 0.12f},
     {"2025-11-15T10:45:00", 0.13f},
     {"2025-11-15T11:00:00", 0.14f},
     {"2025-11-15T11:15:00", 0.15f}
-  };
+  });
   
   float avg = PriceAnalyzer::calculate90MinAverage(prices, 0);
   EXPECT_NEAR(avg, 0.125f, 0.0001f);
 }
 
 TEST(Calculate90MinAverage, ValidInput_MoreThan6Periods) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices = makeFlatSeries(2025, 11, 15, 10, 0, 20, 0.0f);
   for (int i = 0; i < 20; i++) {
-    prices.push_back({"2025-11-15T10:00:00", 0.10f + i * 0.01f});
+    prices.prices[i] = 0.10f + i * 0.01f;
   }
   
   float avg = PriceAnalyzer::calculate90MinAverage(prices, 0);
@@ -37,24 +41,21 @@ TEST(Calculate90MinAverage, ValidInput_MoreThan6Periods) {
 }
 
 TEST(Calculate90MinAverage, NotEnoughPeriodsRemaining) {
-  std::vector<PriceEntry> prices;
-  for (int i = 0; i < 6; i++) {
-    prices.push_back({"2025-11-15T10:00:00", 0.10f});
-  }
+  PriceSeries prices = makeFlatSeries(2025, 11, 15, 10, 0, 6, 0.10f);
   
   float avg = PriceAnalyzer::calculate90MinAverage(prices, 1);
   EXPECT_EQ(avg, -1.0f);
 }
 
 TEST(Calculate90MinAverage, EmptyDataset) {
-  std::vector<PriceEntry> empty;
+  PriceSeries empty;
   float avg = PriceAnalyzer::calculate90MinAverage(empty, 0);
   EXPECT_EQ(avg, -1.0f);
 }
 
 // Test Suite: findCheapest90MinPeriod
 TEST(FindCheapest90MinPeriod, MultipleWindows_ReturnsLowest) {
-  std::vector<PriceEntry> prices = {
+  PriceSeries prices = makeSeries({
     {"2025-11-15T10:00:00", 0.10f},
     {"2025-11-15T10:15:00", 0.12f},
     {"2025-11-15T10:30:00", 0.03f},  // Cheapest period starts here
@@ -64,7 +65,7 @@ TEST(FindCheapest90MinPeriod, MultipleWindows_ReturnsLowest) {
     {"2025-11-15T11:30:00", 0.03f},
     {"2025-11-15T11:45:00", 0.05f},
     {"2025-11-15T12:00:00", 0.10f}
-  };
+  });
   
   Cheapest90Min result = PriceAnalyzer::findCheapest90MinPeriod(prices);
   
@@ -73,9 +74,9 @@ TEST(FindCheapest90MinPeriod, MultipleWindows_ReturnsLowest) {
 }
 
 TEST(FindCheapest90MinPeriod, SingleValidWindow) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices = makeFlatSeries(2025, 11, 15, 10, 0, 6, 0.0f);
   for (int i = 0; i < 6; i++) {
-    prices.push_back({"2025-11-15T10:00:00", 0.10f + i * 0.01f});
+    prices.prices[i] = 0.10f + i * 0.01f;
   }
   
   Cheapest90Min result = PriceAnalyzer::findCheapest90MinPeriod(prices);
@@ -85,10 +86,7 @@ TEST(FindCheapest90MinPeriod, SingleValidWindow) {
 }
 
 TEST(FindCheapest90MinPeriod, AllPricesEqual_ReturnsFirst) {
-  std::vector<PriceEntry> prices;
-  for (int i = 0; i < 10; i++) {
-    prices.push_back({"2025-11-15T10:00:00", 0.10f});
-  }
+  PriceSeries prices = makeFlatSeries(2025, 11, 15, 10, 0, 10, 0.10f);
   
   Cheapest90Min result = PriceAnalyzer::findCheapest90MinPeriod(prices);
   
@@ -97,11 +95,11 @@ TEST(FindCheapest90MinPeriod, AllPricesEqual_ReturnsFirst) {
 }
 
 TEST(FindCheapest90MinPeriod, FewerThan6Periods_ReturnsInvalid) {
-  std::vector<PriceEntry> prices = {
+  PriceSeries prices = makeSeries({
     {"2025-11-15T10:00:00", 0.10f},
     {"2025-11-15T10:15:00", 0.11f},
     {"2025-11-15T10:30:00", 0.12f}
-  };
+  });
   
   Cheapest90Min result = PriceAnalyzer::findCheapest90MinPeriod(prices);
   
@@ -110,13 +108,61 @@ TEST(FindCheapest90MinPeriod, FewerThan6Periods_ReturnsInvalid) {
 }
 
 TEST(FindCheapest90MinPeriod, EmptyDataset) {
-  std::vector<PriceEntry> empty;
+  PriceSeries empty;
   Cheapest90Min result = PriceAnalyzer::findCheapest90MinPeriod(empty);
   
   EXPECT_EQ(result.avg, -1.0f);
   EXPECT_EQ(result.startIndex, -1);
 }
 
+// Test Suite: findCheapestPeriod (any window length)
+TEST(FindCheapestPeriod, TwoHourWindow_ReturnsLowest) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 15, 10, 0, 24, 0.10f);
+  // 8-slot dip starting at 12:00 (index 8)
+  TestHelpers::setPrices(prices, 8, 8, 0.02f);
+  
+  Cheapest90Min result = PriceAnalyzer::findCheapestPeriod(prices, 8);
+  
+  EXPECT_EQ(result.startIndex, 8);
+  EXPECT_NEAR(result.avg, 0.02f, 0.0001f);
+}
+
+TEST(FindCheapestPeriod, RollingSumMatchesFullResum) {
+  // 64 slots cover exactly 07:00-23:00, so every window is time-valid
+  PriceSeries prices = makeFlatSeries(2025, 11, 15, 7, 0, 64, 0.0f);
+  for (int i = 0; i < 64; i++) {
+    prices.prices[i] = 0.05f + ((i * 37) % 11) * 0.013f;
+  }
+  
+  for (int periods = 1; periods <= 12; periods++) {
+    float bestAvg = 999999.0f;
+    int bestIdx = -1;
+    for (int i = 0; i + periods <= prices.count; i++) {
+      float sum = 0;
+      for (int k = 0; k < periods; k++) sum += prices.prices[i + k];
+      if (sum / periods < bestAvg - 0.00001f) {
+        bestAvg = sum / periods;
+        bestIdx = i;
+      }
+    }
+    
+    Cheapest90Min result = PriceAnalyzer::findCheapestPeriod(prices, periods);
+    
+    EXPECT_EQ(result.startIndex, bestIdx) << "periods=" << periods;
+    EXPECT_NEAR(result.avg, bestAvg, 0.0001f) << "periods=" << periods;
+  }
+}
+
+TEST(FindCheapestPeriod, ZeroLengthWindow_ReturnsInvalid) {
+  PriceSeries prices = makeSeries({
+    {"2025-11-15T10:00:00", 0.10f}
+  });
+  
+  Cheapest90Min result = PriceAnalyzer::findCheapestPeriod(prices, 0);
+  
+  EXPECT_EQ(result.startIndex, -1);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
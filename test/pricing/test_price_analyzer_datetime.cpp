@@ -10,52 +10,65 @@
 
 // Test edge case: DateTime with timezone offset
 TEST(PriceAnalyzerEdgeCases, DateTimeWithTimezoneOffset) {
-  PriceEntry entry;
-  entry.dateTime = String("2025-11-15T14:30:00+02:00");
-  entry.priceWithTax = 0.10f;
+  PriceEntry entry("2025-11-15T14:30:00+02:00", 0.10f);
   
-  // Extract time as PriceAnalyzer does
-  String extracted = entry.dateTime.substring(11, 16);
+  // Local time of day is kept, epoch is UTC
+  EXPECT_EQ(entry.minuteOfDay(), 14 * 60 + 30);
+  EXPECT_EQ(entry.utcOffsetMin, 120);
+  EXPECT_EQ(entry.epoch, (time_t)1763209800);  // 2025-11-15T12:30:00Z
+}
+
+// Test edge case: Summer time offset
+TEST(PriceAnalyzerEdgeCases, DateTimeWithSummerOffset) {
+  PriceEntry entry("2025-06-15T00:15:00+03:00", 0.10f);
   
-  EXPECT_EQ(extracted, String("14:30"));
+  EXPECT_EQ(entry.minuteOfDay(), 15);
+  EXPECT_EQ(entry.localDay(), PriceTime::daysFromCivil(2025, 6, 15));
+  EXPECT_EQ(entry.utcOffsetMin, 180);
 }
 
 // Test edge case: Malformed DateTime
 TEST(PriceAnalyzerEdgeCases, MalformedDateTime_TooShort) {
-  PriceEntry entry;
-  entry.dateTime = String("2025-11-15");  // Too short
-  entry.priceWithTax = 0.10f;
-  
-  // This will try to extract beyond string bounds
-  String extracted = entry.dateTime.substring(11, 16);
+  time_t epoch = 0;
+  int16_t offset = 0;
   
-  // Our mock String should handle this, but real Arduino String might crash
-  EXPECT_TRUE(extracted.length() == 0 || extracted.length() == 5);
+  // Parser must stop at the terminator instead of reading past it
+  EXPECT_FALSE(PriceTime::parseIso8601("2025-11-15", epoch, offset));
+  EXPECT_FALSE(PriceTime::parseIso8601("2025-11-15T14:3", epoch, offset));
+  EXPECT_FALSE(PriceTime::parseIso8601("2025-11-15T14:30:00+02", epoch, offset));
 }
 
 // Test edge case: Empty DateTime
 TEST(PriceAnalyzerEdgeCases, EmptyDateTime) {
-  PriceEntry entry;
-  entry.dateTime = String("");
-  entry.priceWithTax = 0.10f;
+  time_t epoch = 0;
+  int16_t offset = 0;
   
-  String extracted = entry.dateTime.substring(11, 16);
+  EXPECT_FALSE(PriceTime::parseIso8601("", epoch, offset));
+  EXPECT_FALSE(PriceTime::parseIso8601(nullptr, epoch, offset));
+  EXPECT_FALSE(PriceTime::parseIso8601("18-11-2025 10:00", epoch, offset));
+}
+
+// Test edge case: Formatting minutes back to HH:MM
+TEST(PriceAnalyzerEdgeCases, FormatMinuteOfDay) {
+  char buf[6];
   
-  EXPECT_EQ(extracted.length(), static_cast<size_t>(0));
+  PriceTime::formatMinuteOfDay(14 * 60 + 5, buf);
+  EXPECT_STREQ(buf, "14:05");
+  PriceTime::formatMinuteOfDay(0, buf);
+  EXPECT_STREQ(buf, "00:00");
+  PriceTime::formatMinuteOfDay(-1, buf);
+  EXPECT_STREQ(buf, "--:--");
 }
 
 // Test edge case: Price exactly at cheapest sentinel value
 TEST(PriceAnalyzerEdgeCases, PriceAtSentinelValue) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Create prices all at the sentinel value
   for (int i = 0; i < 10; i++) {
-    PriceEntry entry;
     char dt[25];
     snprintf(dt, sizeof(dt), "2025-11-15T%02d:00:00", 10 + i);
-    entry.dateTime = String(dt);
-    entry.priceWithTax = 999999.0f;  // Same as sentinel
-    prices.push_back(entry);
+    prices.append({dt, 999999.0f});  // Same as sentinel
   }
   
   // This tests if the sentinel comparison is strict
@@ -65,15 +78,12 @@ TEST(PriceAnalyzerEdgeCases, PriceAtSentinelValue) {
 
 // Test edge case: Negative prices
 TEST(PriceAnalyzerEdgeCases, NegativePrices) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   for (int i = 0; i < 10; i++) {
-    PriceEntry entry;
     char dt[25];
     snprintf(dt, sizeof(dt), "2025-11-15T%02d:00:00", 10 + i);
-    entry.dateTime = String(dt);
-    entry.priceWithTax = -0.05f;  // Negative price (unusual but possible)
-    prices.push_back(entry);
+    prices.append({dt, -0.05f});  // Negative price (unusual but possible)
   }
   
   // Should handle negative prices correctly
@@ -82,15 +92,12 @@ TEST(PriceAnalyzerEdgeCases, NegativePrices) {
 
 // Test edge case: Very large price values
 TEST(PriceAnalyzerEdgeCases, VeryLargePrices) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   for (int i = 0; i < 10; i++) {
-    PriceEntry entry;
     char dt[25];
     snprintf(dt, sizeof(dt), "2025-11-15T%02d:00:00", 10 + i);
-    entry.dateTime = String(dt);
-    entry.priceWithTax = 1000000.0f;  // Much larger than sentinel
-    prices.push_back(entry);
+    prices.append({dt, 1000000.0f});  // Much larger than sentinel
   }
 }
 
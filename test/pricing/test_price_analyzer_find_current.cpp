@@ -2,10 +2,9 @@
 #include <vector>
 #include <cstdio>
 #include <ctime>
-#include <cstring>
 
 // Use test String adapter before including production headers
-#include "../TestStringAdapter.h"
+#include "../../host/HostString.h"
 #define WString_h  // Prevent Arduino WString.h inclusion
 
 // Include production headers and implementation
@@ -20,9 +19,8 @@ String makeTimestamp(int year, int month, int day, int hour, int minute) {
   return String(buf);
 }
 
-// Mock time for testing - these will be used by time() and localtime()
+// Mock time for testing - returned by time()
 static time_t mock_time_value = 0;
-static struct tm mock_tm_value;
 static bool use_mock_time = false;
 
 // Override time() for testing
@@ -37,25 +35,16 @@ extern "C" time_t time(time_t* arg) {
   return result;
 }
 
-// Override localtime() for testing
-extern "C" struct tm* localtime(const time_t* timer) {
-  if (use_mock_time) {
-    return &mock_tm_value;
-  }
-  // Fall back to real localtime if not mocking
-  return std::localtime(timer);
+// UTC epoch for a wall-clock time at the given offset
+time_t epochAt(int year, int month, int day, int hour, int minute, int utcOffsetMin = 0) {
+  return (time_t)PriceTime::daysFromCivil(year, month, day) * PriceTime::SECONDS_PER_DAY
+       + hour * 3600 + minute * 60 - utcOffsetMin * 60;
 }
 
-// Helper to set mock time
+// Helper to set mock time (test data carries no offset, so this is UTC)
 void setMockTime(int year, int month, int day, int hour, int minute) {
   use_mock_time = true;
-  mock_tm_value.tm_year = year - 1900;
-  mock_tm_value.tm_mon = month - 1;
-  mock_tm_value.tm_mday = day;
-  mock_tm_value.tm_hour = hour;
-  mock_tm_value.tm_min = minute;
-  mock_tm_value.tm_sec = 0;
-  mock_time_value = 0; // We don't actually need this for our test
+  mock_time_value = epochAt(year, month, day, hour, minute);
 }
 
 void disableMockTime() {
@@ -65,14 +54,14 @@ void disableMockTime() {
 // Test Suite: findCurrentPriceIndex
 
 TEST(FindCurrentPriceIndex, ExactMatch_FirstEntry) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-17 10:00
   setMockTime(2025, 11, 17, 10, 0);
   
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 30), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 30).c_str(), 0.12f});
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
@@ -82,15 +71,15 @@ TEST(FindCurrentPriceIndex, ExactMatch_FirstEntry) {
 }
 
 TEST(FindCurrentPriceIndex, ExactMatch_MiddleEntry) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-17 10:30
   setMockTime(2025, 11, 17, 10, 30);
   
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 30), 0.12f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 45), 0.13f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 30).c_str(), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 45).c_str(), 0.13f});
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
@@ -100,15 +89,15 @@ TEST(FindCurrentPriceIndex, ExactMatch_MiddleEntry) {
 }
 
 TEST(FindCurrentPriceIndex, ExactMatch_LastEntry) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-17 10:45
   setMockTime(2025, 11, 17, 10, 45);
   
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 30), 0.12f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 45), 0.13f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 30).c_str(), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 45).c_str(), 0.13f});
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
@@ -118,14 +107,14 @@ TEST(FindCurrentPriceIndex, ExactMatch_LastEntry) {
 }
 
 TEST(FindCurrentPriceIndex, RoundDown_To15MinuteBoundary) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-17 10:07 (should round down to 10:00)
   setMockTime(2025, 11, 17, 10, 7);
   
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 30), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 30).c_str(), 0.12f});
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
@@ -135,15 +124,15 @@ TEST(FindCurrentPriceIndex, RoundDown_To15MinuteBoundary) {
 }
 
 TEST(FindCurrentPriceIndex, RoundDown_To30MinuteBoundary) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-17 10:42 (should round down to 10:30)
   setMockTime(2025, 11, 17, 10, 42);
   
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 30), 0.12f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 45), 0.13f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 30).c_str(), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 45).c_str(), 0.13f});
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
@@ -153,15 +142,15 @@ TEST(FindCurrentPriceIndex, RoundDown_To30MinuteBoundary) {
 }
 
 TEST(FindCurrentPriceIndex, RoundDown_To45MinuteBoundary) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-17 10:59 (should round down to 10:45)
   setMockTime(2025, 11, 17, 10, 59);
   
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 30), 0.12f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 45), 0.13f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 30).c_str(), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 45).c_str(), 0.13f});
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
@@ -171,78 +160,78 @@ TEST(FindCurrentPriceIndex, RoundDown_To45MinuteBoundary) {
 }
 
 TEST(FindCurrentPriceIndex, NoMatch_BeforeDataStarts) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-17 09:00 (before data starts at 10:00)
   setMockTime(2025, 11, 17, 9, 0);
   
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 30), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 30).c_str(), 0.12f});
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
-  EXPECT_EQ(idx, -1);
+  EXPECT_EQ(idx, PriceSeries::OUTSIDE_SERIES);
   
   disableMockTime();
 }
 
 TEST(FindCurrentPriceIndex, NoMatch_AfterDataEnds) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-17 11:00 (after data ends at 10:45)
   setMockTime(2025, 11, 17, 11, 0);
   
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 30), 0.12f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 45), 0.13f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 30).c_str(), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 45).c_str(), 0.13f});
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
-  EXPECT_EQ(idx, -1);
+  EXPECT_EQ(idx, PriceSeries::OUTSIDE_SERIES);
   
   disableMockTime();
 }
 
 TEST(FindCurrentPriceIndex, NoMatch_WrongDay) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-18 10:00 (data is from 2025-11-17)
   setMockTime(2025, 11, 18, 10, 0);
   
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 30), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 30).c_str(), 0.12f});
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
-  EXPECT_EQ(idx, -1);
+  EXPECT_EQ(idx, PriceSeries::OUTSIDE_SERIES);
   
   disableMockTime();
 }
 
 TEST(FindCurrentPriceIndex, EmptyDataset_ReturnsNegative) {
-  std::vector<PriceEntry> empty;
+  PriceSeries empty;
   
   setMockTime(2025, 11, 17, 10, 0);
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(empty);
   
-  EXPECT_EQ(idx, -1);
+  EXPECT_EQ(idx, PriceSeries::OUTSIDE_SERIES);
   
   disableMockTime();
 }
 
 TEST(FindCurrentPriceIndex, MidnightBoundary_00_00) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-17 00:00
   setMockTime(2025, 11, 17, 0, 0);
   
-  prices.push_back({makeTimestamp(2025, 11, 17, 0, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 0, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 0, 30), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 0, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 0, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 0, 30).c_str(), 0.12f});
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
@@ -252,15 +241,15 @@ TEST(FindCurrentPriceIndex, MidnightBoundary_00_00) {
 }
 
 TEST(FindCurrentPriceIndex, MidnightBoundary_23_45) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-17 23:55 (should round down to 23:45)
   setMockTime(2025, 11, 17, 23, 55);
   
-  prices.push_back({makeTimestamp(2025, 11, 17, 23, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 23, 15), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 23, 30), 0.12f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 23, 45), 0.13f});
+  prices.append({makeTimestamp(2025, 11, 17, 23, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 23, 15).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 23, 30).c_str(), 0.12f});
+  prices.append({makeTimestamp(2025, 11, 17, 23, 45).c_str(), 0.13f});
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
@@ -270,36 +259,85 @@ TEST(FindCurrentPriceIndex, MidnightBoundary_23_45) {
 }
 
 TEST(FindCurrentPriceIndex, DataSpanningTwoDays_FindsTodayEntry) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Set mock time to 2025-11-17 14:00
   setMockTime(2025, 11, 17, 14, 0);
   
-  // Data from yesterday evening
-  prices.push_back({makeTimestamp(2025, 11, 16, 22, 0), 0.08f});
-  prices.push_back({makeTimestamp(2025, 11, 16, 22, 15), 0.09f});
-  prices.push_back({makeTimestamp(2025, 11, 16, 22, 30), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 16, 22, 45), 0.11f});
-  prices.push_back({makeTimestamp(2025, 11, 16, 23, 0), 0.12f});
+  // Data from yesterday evening (22:00-23:45, contiguous with today)
+  for (int slot = 0; slot < 8; slot++) {
+    prices.append({makeTimestamp(2025, 11, 16, 22 + slot / 4, (slot % 4) * 15).c_str(), 0.08f + slot * 0.01f});
+  }
   
   // Today's data
   for (int hour = 0; hour <= 14; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 17, hour, minute), 0.15f});
+      prices.append({makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.15f});
     }
   }
   
   int idx = PriceAnalyzer::findCurrentPriceIndex(prices);
   
   // Should find today's 14:00 entry, not yesterday's data
-  EXPECT_GE(idx, 5);  // After yesterday's 5 entries
+  EXPECT_GE(idx, 8);  // After yesterday's 8 entries
   if (idx >= 0) {
-    EXPECT_TRUE(prices[idx].dateTime.startsWith(String("2025-11-17T14:00")));
+    EXPECT_EQ(prices.localDay(idx), PriceTime::daysFromCivil(2025, 11, 17));
+    EXPECT_EQ(prices.minuteOfDay(idx), 14 * 60);
   }
   
   disableMockTime();
 }
 
+TEST(FindCurrentPriceIndex, ExplicitNow_IgnoresSystemClock) {
+  PriceSeries prices;
+  
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 10, 15).c_str(), 0.11f});
+  
+  EXPECT_EQ(PriceAnalyzer::findCurrentPriceIndex(prices, epochAt(2025, 11, 17, 10, 29)), 1);
+  EXPECT_EQ(PriceAnalyzer::findCurrentPriceIndex(prices, epochAt(2025, 11, 17, 10, 30)),
+            PriceSeries::OUTSIDE_SERIES);
+  EXPECT_EQ(PriceAnalyzer::findCurrentPriceIndex(prices, epochAt(2025, 11, 17, 9, 59)),
+            PriceSeries::OUTSIDE_SERIES);
+}
+
+TEST(FindCurrentPriceIndex, DstFallBack_RepeatedHourMapsToDistinctSlots) {
+  PriceSeries prices;
+  
+  // 2025-10-26 in Finland: 04:00 +03:00 becomes 03:00 +02:00, so 03:xx happens twice
+  prices.append({"2025-10-26T03:45:00+03:00", 0.10f});
+  prices.append({"2025-10-26T03:00:00+02:00", 0.20f});
+  prices.append({"2025-10-26T03:15:00+02:00", 0.30f});
+  
+  EXPECT_EQ(PriceAnalyzer::findCurrentPriceIndex(prices, epochAt(2025, 10, 26, 3, 50, 180)), 0);
+  EXPECT_EQ(PriceAnalyzer::findCurrentPriceIndex(prices, epochAt(2025, 10, 26, 3, 5, 120)), 1);
+  EXPECT_EQ(PriceAnalyzer::findCurrentPriceIndex(prices, epochAt(2025, 10, 26, 3, 20, 120)), 2);
+}
+
+TEST(FindCurrentPriceIndex, DstSpringForward_SkippedHourDoesNotShiftIndex) {
+  PriceSeries prices;
+  
+  // 2025-03-30 in Finland: 03:00 +02:00 becomes 04:00 +03:00
+  prices.append({"2025-03-30T02:45:00+02:00", 0.10f});
+  prices.append({"2025-03-30T04:00:00+03:00", 0.20f});
+  prices.append({"2025-03-30T04:15:00+03:00", 0.30f});
+  
+  ASSERT_EQ(prices.count, 3);
+  EXPECT_EQ(PriceAnalyzer::findCurrentPriceIndex(prices, epochAt(2025, 3, 30, 4, 20, 180)), 2);
+  EXPECT_EQ(prices.minuteOfDay(2), 4 * 60 + 15);
+}
+
+TEST(FindCurrentPriceIndex, HourlySlots_UsesSeriesSlotLength) {
+  PriceSeries prices;
+  
+  prices.append({makeTimestamp(2025, 11, 17, 10, 0).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 11, 0).c_str(), 0.11f});
+  prices.append({makeTimestamp(2025, 11, 17, 12, 0).c_str(), 0.12f});
+  
+  EXPECT_EQ(PriceAnalyzer::findCurrentPriceIndex(prices, epochAt(2025, 11, 17, 11, 59)), 1);
+  EXPECT_EQ(PriceAnalyzer::findCurrentPriceIndex(prices, epochAt(2025, 11, 17, 12, 45)), 2);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
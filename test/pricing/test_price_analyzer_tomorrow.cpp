@@ -3,7 +3,7 @@
 #include <cstdio>
 
 // Use test String adapter before including production headers
-#include "../TestStringAdapter.h"
+#include "../../host/HostString.h"
 #define WString_h  // Prevent Arduino WString.h inclusion
 
 // Include production headers and implementation
@@ -19,14 +19,15 @@ String makeTimestamp(int year, int month, int day, int hour, int minute) {
 }
 
 // Test Suite: Tomorrow detection and date comparison logic
+// Multi-day data covers whole days because a PriceSeries must be contiguous
 
 TEST(TomorrowDetection, SameDay_AllEntriesSameDate) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // All entries from 2025-11-17
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 17, hour, minute), 0.10f});
+      prices.append({makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.10f});
     }
   }
   
@@ -35,27 +36,27 @@ TEST(TomorrowDetection, SameDay_AllEntriesSameDate) {
   ASSERT_GE(cheapest.startIndex, 0);
   
   // Extract dates from first entry and cheapest entry
-  String firstDate = prices[0].dateTime.substring(0, 10);
-  String cheapestDate = prices[cheapest.startIndex].dateTime.substring(0, 10);
+  int32_t firstDate = prices.localDay(0);
+  int32_t cheapestDate = prices.localDay(cheapest.startIndex);
   
   EXPECT_EQ(firstDate, cheapestDate);
-  EXPECT_EQ(firstDate, String("2025-11-17"));
+  EXPECT_EQ(firstDate, PriceTime::daysFromCivil(2025, 11, 17));
 }
 
 TEST(TomorrowDetection, TwoDays_CheapestToday) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Today (2025-11-17) - cheap during day
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 17, hour, minute), 0.08f});
+      prices.append({makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.08f});
     }
   }
   
   // Tomorrow (2025-11-18) - expensive
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 18, hour, minute), 0.20f});
+      prices.append({makeTimestamp(2025, 11, 18, hour, minute).c_str(), 0.20f});
     }
   }
   
@@ -64,24 +65,23 @@ TEST(TomorrowDetection, TwoDays_CheapestToday) {
   ASSERT_GE(cheapest.startIndex, 0);
   
   // Cheapest should be from today
-  String cheapestDate = prices[cheapest.startIndex].dateTime.substring(0, 10);
-  EXPECT_EQ(cheapestDate, String("2025-11-17"));
+  EXPECT_EQ(prices.localDay(cheapest.startIndex), PriceTime::daysFromCivil(2025, 11, 17));
 }
 
 TEST(TomorrowDetection, TwoDays_CheapestTomorrow) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Today (2025-11-17) - expensive during day
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 17, hour, minute), 0.20f});
+      prices.append({makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.20f});
     }
   }
   
   // Tomorrow (2025-11-18) - cheap
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 18, hour, minute), 0.08f});
+      prices.append({makeTimestamp(2025, 11, 18, hour, minute).c_str(), 0.08f});
     }
   }
   
@@ -90,24 +90,23 @@ TEST(TomorrowDetection, TwoDays_CheapestTomorrow) {
   ASSERT_GE(cheapest.startIndex, 0);
   
   // Cheapest should be from tomorrow
-  String cheapestDate = prices[cheapest.startIndex].dateTime.substring(0, 10);
-  EXPECT_EQ(cheapestDate, String("2025-11-18"));
+  EXPECT_EQ(prices.localDay(cheapest.startIndex), PriceTime::daysFromCivil(2025, 11, 18));
 }
 
 TEST(TomorrowDetection, MonthBoundary_CheapestNextMonth) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // End of November (2025-11-30) - expensive
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 30, hour, minute), 0.20f});
+      prices.append({makeTimestamp(2025, 11, 30, hour, minute).c_str(), 0.20f});
     }
   }
   
   // Start of December (2025-12-01) - cheap
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 12, 1, hour, minute), 0.08f});
+      prices.append({makeTimestamp(2025, 12, 1, hour, minute).c_str(), 0.08f});
     }
   }
   
@@ -116,24 +115,23 @@ TEST(TomorrowDetection, MonthBoundary_CheapestNextMonth) {
   ASSERT_GE(cheapest.startIndex, 0);
   
   // Cheapest should be from December
-  String cheapestDate = prices[cheapest.startIndex].dateTime.substring(0, 10);
-  EXPECT_EQ(cheapestDate, String("2025-12-01"));
+  EXPECT_EQ(prices.localDay(cheapest.startIndex), PriceTime::daysFromCivil(2025, 12, 1));
 }
 
 TEST(TomorrowDetection, YearBoundary_CheapestNextYear) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // End of year (2025-12-31) - expensive
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 12, 31, hour, minute), 0.20f});
+      prices.append({makeTimestamp(2025, 12, 31, hour, minute).c_str(), 0.20f});
     }
   }
   
   // New year (2026-01-01) - cheap
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2026, 1, 1, hour, minute), 0.08f});
+      prices.append({makeTimestamp(2026, 1, 1, hour, minute).c_str(), 0.08f});
     }
   }
   
@@ -142,31 +140,32 @@ TEST(TomorrowDetection, YearBoundary_CheapestNextYear) {
   ASSERT_GE(cheapest.startIndex, 0);
   
   // Cheapest should be from 2026
-  String cheapestDate = prices[cheapest.startIndex].dateTime.substring(0, 10);
-  EXPECT_EQ(cheapestDate, String("2026-01-01"));
+  EXPECT_EQ(prices.localDay(cheapest.startIndex), PriceTime::daysFromCivil(2026, 1, 1));
 }
 
 TEST(TomorrowDetection, ThreeDays_CheapestOnDayThree) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
+  // Three days do not fit in a series, so take the afternoon of day 1 and the
+  // morning of day 3 around a full day 2
   // Day 1 (2025-11-17) - expensive
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 12; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 17, hour, minute), 0.20f});
+      prices.append({makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.20f});
     }
   }
   
   // Day 2 (2025-11-18) - moderate
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 18, hour, minute), 0.15f});
+      prices.append({makeTimestamp(2025, 11, 18, hour, minute).c_str(), 0.15f});
     }
   }
   
   // Day 3 (2025-11-19) - cheap
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 9; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 19, hour, minute), 0.05f});
+      prices.append({makeTimestamp(2025, 11, 19, hour, minute).c_str(), 0.05f});
     }
   }
   
@@ -175,70 +174,60 @@ TEST(TomorrowDetection, ThreeDays_CheapestOnDayThree) {
   ASSERT_GE(cheapest.startIndex, 0);
   
   // Cheapest should be from day 3
-  String cheapestDate = prices[cheapest.startIndex].dateTime.substring(0, 10);
-  EXPECT_EQ(cheapestDate, String("2025-11-19"));
+  EXPECT_EQ(prices.localDay(cheapest.startIndex), PriceTime::daysFromCivil(2025, 11, 19));
 }
 
-TEST(TomorrowDetection, DateSubstring_CorrectLength) {
-  std::vector<PriceEntry> prices;
+TEST(TomorrowDetection, LocalDay_AdvancesAtLocalMidnight) {
+  PriceSeries prices;
   
-  // Add some entries
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 0), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 15), 0.11f});
-  
-  // Test that substring(0, 10) gives YYYY-MM-DD
-  String date = prices[0].dateTime.substring(0, 10);
+  // 23:45 and 00:00 local (+02:00) straddle midnight but are 21:45/22:00 UTC
+  prices.append({"2025-11-17T23:45:00+02:00", 0.10f});
+  prices.append({"2025-11-18T00:00:00+02:00", 0.11f});
   
-  EXPECT_EQ(date.length(), static_cast<size_t>(10));
-  EXPECT_EQ(date.c_str()[4], '-');
-  EXPECT_EQ(date.c_str()[7], '-');
+  EXPECT_EQ(prices.localDay(0), PriceTime::daysFromCivil(2025, 11, 17));
+  EXPECT_EQ(prices.localDay(1), PriceTime::daysFromCivil(2025, 11, 18));
+  EXPECT_EQ(prices.slotEpoch(1) - prices.slotEpoch(0), 900);
 }
 
-TEST(TomorrowDetection, TimeSubstring_CorrectLength) {
-  std::vector<PriceEntry> prices;
+TEST(TomorrowDetection, MinuteOfDay_FromTimestamp) {
+  PriceSeries prices;
   
   // Add some entries
-  prices.push_back({makeTimestamp(2025, 11, 17, 10, 30), 0.10f});
-  prices.push_back({makeTimestamp(2025, 11, 17, 14, 45), 0.11f});
-  
-  // Test that substring(11, 16) gives HH:MM
-  String time1 = prices[0].dateTime.substring(11, 16);
-  String time2 = prices[1].dateTime.substring(11, 16);
+  prices.append({makeTimestamp(2025, 11, 17, 10, 30).c_str(), 0.10f});
+  prices.append({makeTimestamp(2025, 11, 17, 14, 45).c_str(), 0.11f});
   
-  EXPECT_EQ(time1, String("10:30"));
-  EXPECT_EQ(time2, String("14:45"));
-  EXPECT_EQ(time1.length(), static_cast<size_t>(5));
-  EXPECT_EQ(time2.length(), static_cast<size_t>(5));
+  EXPECT_EQ(prices.minuteOfDay(0), 10 * 60 + 30);
+  EXPECT_EQ(prices.minuteOfDay(1), 14 * 60 + 45);
 }
 
 TEST(TomorrowDetection, MixedDates_CheapestInMiddle) {
-  std::vector<PriceEntry> prices;
+  PriceSeries prices;
   
   // Yesterday evening (2025-11-16) - moderate
   for (int hour = 20; hour <= 23; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 16, hour, minute), 0.15f});
+      prices.append({makeTimestamp(2025, 11, 16, hour, minute).c_str(), 0.15f});
     }
   }
   
   // Today early morning (2025-11-17) - expensive (before 7:00, will be ignored)
   for (int hour = 0; hour < 7; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 17, hour, minute), 0.25f});
+      prices.append({makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.25f});
     }
   }
   
   // Today daytime (2025-11-17) - cheap
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 7; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 17, hour, minute), 0.08f});
+      prices.append({makeTimestamp(2025, 11, 17, hour, minute).c_str(), 0.08f});
     }
   }
   
   // Tomorrow (2025-11-18) - expensive
-  for (int hour = 7; hour <= 22; hour++) {
+  for (int hour = 0; hour < 24; hour++) {
     for (int minute = 0; minute < 60; minute += 15) {
-      prices.push_back({makeTimestamp(2025, 11, 18, hour, minute), 0.20f});
+      prices.append({makeTimestamp(2025, 11, 18, hour, minute).c_str(), 0.20f});
     }
   }
   
@@ -247,23 +236,21 @@ TEST(TomorrowDetection, MixedDates_CheapestInMiddle) {
   ASSERT_GE(cheapest.startIndex, 0);
   
   // Cheapest should be from today's daytime
-  String cheapestDate = prices[cheapest.startIndex].dateTime.substring(0, 10);
-  EXPECT_EQ(cheapestDate, String("2025-11-17"));
+  EXPECT_EQ(prices.localDay(cheapest.startIndex), PriceTime::daysFromCivil(2025, 11, 17));
   
-  String cheapestTime = prices[cheapest.startIndex].dateTime.substring(11, 16);
-  int hour = (cheapestTime.c_str()[0] - '0') * 10 + (cheapestTime.c_str()[1] - '0');
+  int hour = prices.minuteOfDay(cheapest.startIndex) / 60;
   EXPECT_GE(hour, 7);  // Should be in valid time range
 }
 
-TEST(TomorrowDetection, IdenticalDates_StringComparison) {
-  String date1 = String("2025-11-17");
-  String date2 = String("2025-11-17");
-  String date3 = String("2025-11-18");
+TEST(TomorrowDetection, IdenticalDates_DayNumberComparison) {
+  int32_t date1 = PriceTime::daysFromCivil(2025, 11, 17);
+  int32_t date2 = PriceTime::daysFromCivil(2025, 11, 17);
+  int32_t date3 = PriceTime::daysFromCivil(2025, 11, 18);
   
   EXPECT_EQ(date1, date2);
-  EXPECT_NE(date1, date3);
-  EXPECT_TRUE(date1 == date2);
-  EXPECT_FALSE(date1 == date3);
+  EXPECT_EQ(date3, date1 + 1);
+  EXPECT_EQ(PriceTime::daysFromCivil(1970, 1, 1), 0);
+  EXPECT_EQ(PriceTime::daysFromCivil(2026, 1, 1) - PriceTime::daysFromCivil(2025, 12, 31), 1);
 }
 
 int main(int argc, char **argv) {
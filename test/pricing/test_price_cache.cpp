@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+// Use test String adapter before including production headers
+#include "../../host/HostString.h"
+#define WString_h  // Prevent Arduino WString.h inclusion
+
+#include "../../src/pricing/PriceData.h"
+#include "../../src/pricing/PriceCache.cpp"
+#include "../mocks/FilePriceStorage.h"
+#include "../test_data_helpers.h"
+
+using TestHelpers::makeFlatSeries;
+
+// Two days around the autumn switch: 25 hours of +180 and +120 slots
+static PriceSeries fallBackSeries() {
+  PriceSeries series;
+  time_t start = (time_t)PriceTime::daysFromCivil(2025, 10, 26) * PriceTime::SECONDS_PER_DAY - 180 * 60;
+  for (int i = 0; i < 100; i++) {
+    time_t epoch = start + (time_t)i * 900;
+    int16_t offset = i < 16 ? 180 : 120;  // 04:00 +03:00 becomes 03:00 +02:00
+    series.append(PriceEntry(epoch, offset, 0.05f + 0.001f * i));
+  }
+  return series;
+}
+
+static PriceAnalysis sampleAnalysis() {
+  PriceAnalysis analysis;
+  analysis.valid = true;
+  analysis.next90MinAvg = 0.1234f;
+  analysis.cheapest90MinAvg = -0.0042f;
+  analysis.cheapest90MinStart = 3 * 60 + 15;
+  analysis.currentPeriodStart = 22 * 60 + 45;
+  analysis.lastFetchTime = 14 * 60 + 17;
+  analysis.cheapestIsTomorrow = true;
+  analysis.cheapestCount = 2;
+  analysis.cheapestAvgs[0] = -0.0042f;
+  analysis.cheapestStarts[0] = 3 * 60 + 15;
+  analysis.cheapestTomorrow[0] = true;
+  analysis.cheapestAvgs[1] = 0.061f;
+  analysis.cheapestStarts[1] = 23 * 60;
+  return analysis;
+}
+
+static std::vector<uint8_t> encoded(const PriceSeries& series, const PriceAnalysis& analysis, time_t fetchedAt) {
+  std::vector<uint8_t> buffer(PriceCache::MAX_BYTES);
+  size_t length = PriceCache::encode(series, analysis, fetchedAt, buffer.data(), buffer.size());
+  buffer.resize(length);
+  return buffer;
+}
+
+// Test Suite: PriceCache
+
+TEST(PriceCache, RoundTrip_KeepsSeriesAndAnalysis) {
+  PriceSeries series = fallBackSeries();
+  ASSERT_EQ(series.count, 100);
+  ASSERT_EQ(series.dstSwitchIndex, 16);
+  PriceAnalysis analysis = sampleAnalysis();
+
+  std::vector<uint8_t> bytes = encoded(series, analysis, 1761400000);
+  ASSERT_FALSE(bytes.empty());
+
+  PriceCache::Contents cached;
+  ASSERT_TRUE(PriceCache::decode(bytes.data(), bytes.size(), cached));
+  EXPECT_EQ(cached.fetchedAt, 1761400000);
+  EXPECT_EQ(cached.series.checksum(), series.checksum());
+  EXPECT_EQ(cached.series.baseEpoch, series.baseEpoch);
+  EXPECT_EQ(cached.series.altOffsetMin, 120);
+  EXPECT_EQ(cached.series.minuteOfDay(99), series.minuteOfDay(99));
+
+  const PriceAnalysis& restored = cached.analysis;
+  EXPECT_TRUE(restored.valid);
+  EXPECT_TRUE(restored.cheapestIsTomorrow);
+  EXPECT_FLOAT_EQ(restored.next90MinAvg, analysis.next90MinAvg);
+  EXPECT_FLOAT_EQ(restored.cheapest90MinAvg, analysis.cheapest90MinAvg);
+  EXPECT_EQ(restored.cheapest90MinStart, analysis.cheapest90MinStart);
+  EXPECT_EQ(restored.currentPeriodStart, analysis.currentPeriodStart);
+  EXPECT_EQ(restored.lastFetchTime, analysis.lastFetchTime);
+  EXPECT_EQ(restored.cheapestCount, 2);
+  for (int k = 0; k < MAX_CHEAPEST_WINDOWS; k++) {
+    EXPECT_FLOAT_EQ(restored.cheapestAvgs[k], analysis.cheapestAvgs[k]) << k;
+    EXPECT_EQ(restored.cheapestStarts[k], analysis.cheapestStarts[k]) << k;
+    EXPECT_EQ(restored.cheapestTomorrow[k], analysis.cheapestTomorrow[k]) << k;
+  }
+}
+
+TEST(PriceCache, RoundTrip_EmptySeries) {
+  PriceSeries empty;
+  std::vector<uint8_t> bytes = encoded(empty, PriceAnalysis(), 0);
+
+  PriceCache::Contents cached;
+  cached.series = fallBackSeries();
+  ASSERT_TRUE(PriceCache::decode(bytes.data(), bytes.size(), cached));
+  EXPECT_EQ(cached.series.count, 0);
+  EXPECT_FALSE(cached.analysis.valid);
+}
+
+TEST(PriceCache, Size_TwoDaysFitInAboutAKilobyte) {
+  PriceSeries twoDays = makeFlatSeries(2025, 11, 17, 0, 0, 192, 0.10f, 120);
+  std::vector<uint8_t> bytes = encoded(twoDays, sampleAnalysis(), 1);
+
+  EXPECT_EQ(bytes.size(), PriceCache::HEADER_BYTES + 8 + PriceCache::SERIES_BYTES +
+                          192 * 4 + PriceCache::ANALYSIS_BYTES);
+  EXPECT_LT(bytes.size(), 1024u);
+  EXPECT_LE(bytes.size(), PriceCache::MAX_BYTES);
+}
+
+TEST(PriceCache, Encode_BufferTooSmall_ReturnsZero) {
+  PriceSeries series = fallBackSeries();
+  std::vector<uint8_t> full = encoded(series, sampleAnalysis(), 1);
+  std::vector<uint8_t> buffer(full.size() - 1);
+
+  EXPECT_EQ(PriceCache::encode(series, sampleAnalysis(), 1, buffer.data(), buffer.size()), 0u);
+}
+
+TEST(PriceCache, Decode_AnyChangedByte_Rejected) {
+  std::vector<uint8_t> bytes = encoded(fallBackSeries(), sampleAnalysis(), 1761400000);
+  PriceCache::Contents cached;
+
+  for (size_t i = 0; i < bytes.size(); i++) {
+    std::vector<uint8_t> damaged = bytes;
+    damaged[i] ^= 0x10;
+    EXPECT_FALSE(PriceCache::decode(damaged.data(), damaged.size(), cached)) << i;
+  }
+  EXPECT_EQ(cached.series.count, 0);  // Untouched on failure
+}
+
+TEST(PriceCache, Decode_TornWrite_Rejected) {
+  std::vector<uint8_t> bytes = encoded(fallBackSeries(), sampleAnalysis(), 1761400000);
+  PriceCache::Contents cached;
+
+  for (size_t length = 0; length < bytes.size(); length++) {
+    EXPECT_FALSE(PriceCache::decode(bytes.data(), length, cached)) << length;
+  }
+  bytes.push_back(0);
+  EXPECT_FALSE(PriceCache::decode(bytes.data(), bytes.size(), cached));
+}
+
+TEST(PriceCache, Decode_OtherVersion_Rejected) {
+  std::vector<uint8_t> bytes = encoded(fallBackSeries(), sampleAnalysis(), 1761400000);
+  bytes[4] = (uint8_t)(PriceCache::VERSION + 1);  // Version follows the magic
+  PriceCache::Contents cached;
+
+  EXPECT_FALSE(PriceCache::decode(bytes.data(), bytes.size(), cached));
+}
+
+// Test Suite: FilePriceStorage
+
+TEST(FilePriceStorage, SaveThenLoad) {
+  std::string path = ::testing::TempDir() + "file_storage.bin";
+  FilePriceStorage storage(path);
+  storage.remove();
+  uint8_t buffer[16];
+
+  EXPECT_EQ(storage.load(buffer, sizeof(buffer)), 0u);
+
+  const uint8_t blob[] = {1, 2, 3, 4, 5};
+  ASSERT_TRUE(storage.save(blob, sizeof(blob)));
+  ASSERT_EQ(storage.load(buffer, sizeof(buffer)), sizeof(blob));
+  EXPECT_EQ(memcmp(buffer, blob, sizeof(blob)), 0);
+
+  // Larger than the caller's buffer: treated as nothing stored
+  EXPECT_EQ(storage.load(buffer, 4), 0u);
+  storage.remove();
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
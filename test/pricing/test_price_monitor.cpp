@@ -8,7 +8,7 @@ using ::testing::Eq;
 using ::testing::InSequence;
 
 // Test String adapter
-#include "../TestStringAdapter.h"
+#include "../../host/HostString.h"
 #define WString_h
 
 // Mock time functions
@@ -17,7 +17,8 @@ static int mock_minute = 30;
 
 extern "C" {
   time_t time(time_t* t) {
-    time_t now = 1700000000;
+    // 2025-11-18 at mock_hour:mock_minute UTC, matching the test data
+    time_t now = 1763424000 + mock_hour * 3600 + mock_minute * 60;
     if (t) *t = now;
     return now;
   }
@@ -57,6 +58,7 @@ namespace {
 #include "../../src/pricing/FetchGuard.h"
 #include "../../src/display/IDisplay.h"
 #include "../../src/pricing/IApiClient.h"
+#include "../mocks/FilePriceStorage.h"
 
 // gMock display
 class MockDisplay : public IDisplay {
@@ -76,12 +78,16 @@ public:
 class MockApiClient : public IApiClient {
 public:
   MOCK_METHOD(ApiResponse, fetchJson, (const char* url), (override));
+  MOCK_METHOD(void, clearValidators, (), (override));
 };
 
 extern const char* API_URL;
 const char* API_URL = "mock://api";
 
 #include "../../src/pricing/PriceAnalyzer.cpp"
+#include "../../src/pricing/WindowPlanner.cpp"
+#include "../../src/pricing/SpotPriceTokenizer.cpp"
+#include "../../src/pricing/PriceCache.cpp"
 #include "../../src/pricing/PriceMonitor.cpp"
 
 // Helper to generate valid test JSON with 15-minute intervals
@@ -173,6 +179,38 @@ TEST(PriceMonitor, FetchAndAnalyze_HttpFailure_ShowsError) {
   EXPECT_FALSE(result);
 }
 
+// Streams the body to the parser, then reports it failed its checksum
+class CorruptBodyApiClient : public MockApiClient {
+public:
+  ApiResponse streamJson(const char* url, BodyHandler& handler, FetchBudget*) override {
+    ApiResponse response = fetchJson(url);
+    StringBodyReader body(response.payload.c_str(), response.payload.length());
+    handler.handleBody(body);
+    response.payload = String();
+    response.success = false;
+    response.error = "Corrupt compressed body";
+    return response;
+  }
+};
+
+TEST(PriceMonitor, FetchAndAnalyze_CorruptCompressedBody_DiscardsParsedPrices) {
+  MockDisplay mockDisplay;
+  CorruptBodyApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  IApiClient::ApiResponse response;
+  response.success = true;
+  response.payload = generateValidPriceJson();
+  response.httpCode = 200;
+  
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(response));
+  EXPECT_CALL(mockDisplay, showText(Eq("HTTP FAILED"), Eq("Corrupt compressed body"))).Times(1);
+  EXPECT_CALL(mockApiClient, clearValidators()).Times(0);
+  
+  EXPECT_FALSE(monitor.fetchAndAnalyzePrices());
+  EXPECT_FALSE(monitor.refreshAnalysis());
+}
+
 TEST(PriceMonitor, FetchAndAnalyze_InvalidJson_ShowsError) {
   MockDisplay mockDisplay;
   MockApiClient mockApiClient;
@@ -185,6 +223,7 @@ TEST(PriceMonitor, FetchAndAnalyze_InvalidJson_ShowsError) {
   
   EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(response));
   EXPECT_CALL(mockDisplay, showText(Eq("JSON ERROR"), _)).Times(1);
+  EXPECT_CALL(mockApiClient, clearValidators()).Times(1);
   
   bool result = monitor.fetchAndAnalyzePrices();
   
@@ -203,6 +242,7 @@ TEST(PriceMonitor, FetchAndAnalyze_EmptyArray_ShowsError) {
   
   EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(response));
   EXPECT_CALL(mockDisplay, showText(Eq("JSON ERROR"), _)).Times(1);
+  EXPECT_CALL(mockApiClient, clearValidators()).Times(1);
   
   bool result = monitor.fetchAndAnalyzePrices();
   
@@ -272,7 +312,7 @@ TEST(PriceMonitor, FetchAndAnalyze_Success_StampsTime) {
   
   monitor.fetchAndAnalyzePrices();
   
-  EXPECT_EQ(monitor.getLastAnalysis().lastFetchTime, String("14:25"));
+  EXPECT_EQ(monitor.getLastAnalysis().lastFetchTime, 14 * 60 + 25);
 }
 
 TEST(PriceMonitor, FetchAndAnalyze_SecondFetch_ShowsLoadingIndicator) {
@@ -296,6 +336,426 @@ TEST(PriceMonitor, FetchAndAnalyze_SecondFetch_ShowsLoadingIndicator) {
   monitor.fetchAndAnalyzePrices();
 }
 
+TEST(PriceMonitor, FetchAndAnalyze_Success_PlansWindows) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  IApiClient::ApiResponse response;
+  response.success = true;
+  response.payload = generateValidPriceJson();
+  response.httpCode = 200;
+  
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(response));
+  monitor.fetchAndAnalyzePrices();
+  
+  // One hour anywhere in the allowed hours, and 30 minutes that must end by 11:00
+  WindowRequest requests[] = {WindowRequest(4), WindowRequest(2, 7 * 60, 11 * 60)};
+  CheapestWindow results[2];
+  
+  ASSERT_TRUE(monitor.planWindows(requests, 2, results));
+  EXPECT_EQ(results[0].startIndex, 15);  // 13:45
+  EXPECT_NEAR(results[0].avg, 0.10f, 0.0001f);
+  EXPECT_EQ(results[1].startIndex, 0);   // 10:00
+  EXPECT_NEAR(results[1].avg, 0.16f, 0.0001f);
+}
+
+// ============================================================================
+// Refresh Tests
+// ============================================================================
+
+static IApiClient::ApiResponse validResponse() {
+  IApiClient::ApiResponse response;
+  response.success = true;
+  response.payload = generateValidPriceJson();
+  response.httpCode = 200;
+  return response;
+}
+
+// Analysis a fresh monitor makes at the current mock time
+static PriceAnalysis freshAnalysis() {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(validResponse()));
+  monitor.fetchAndAnalyzePrices();
+  return monitor.getLastAnalysis();
+}
+
+static void expectSameAnalysis(const PriceAnalysis& actual, const PriceAnalysis& expected) {
+  EXPECT_EQ(actual.valid, expected.valid);
+  EXPECT_EQ(actual.currentPeriodStart, expected.currentPeriodStart);
+  EXPECT_FLOAT_EQ(actual.next90MinAvg, expected.next90MinAvg);
+  EXPECT_EQ(actual.cheapest90MinStart, expected.cheapest90MinStart);
+  EXPECT_FLOAT_EQ(actual.cheapest90MinAvg, expected.cheapest90MinAvg);
+  ASSERT_EQ(actual.cheapestCount, expected.cheapestCount);
+  for (int k = 0; k < actual.cheapestCount; k++) {
+    EXPECT_EQ(actual.cheapestStarts[k], expected.cheapestStarts[k]);
+  }
+}
+
+TEST(PriceMonitor, RefreshAnalysis_BeforeFetch_ReturnsFalse) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  EXPECT_FALSE(monitor.refreshAnalysis());
+  EXPECT_FALSE(monitor.getLastAnalysis().valid);
+}
+
+TEST(PriceMonitor, RefreshAnalysis_AdvancesWithoutFetching) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  mock_hour = 12;
+  mock_minute = 30;
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(validResponse()));
+  monitor.fetchAndAnalyzePrices();
+  
+  mock_hour = 13;
+  mock_minute = 0;
+  ASSERT_TRUE(monitor.refreshAnalysis());
+  
+  const PriceAnalysis& analysis = monitor.getLastAnalysis();
+  EXPECT_EQ(analysis.currentPeriodStart, 13 * 60);
+  EXPECT_NEAR(analysis.next90MinAvg, 0.91f / 6, 0.0001f);  // 13:00-14:30
+  EXPECT_EQ(analysis.lastFetchTime, 12 * 60 + 30);        // Not a fetch
+  expectSameAnalysis(analysis, freshAnalysis());
+}
+
+TEST(PriceMonitor, RefreshAnalysis_StartedCheapestIsReplaced) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  mock_hour = 12;
+  mock_minute = 30;
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(validResponse()));
+  monitor.fetchAndAnalyzePrices();
+  // 13:30 and 13:45 tie; the earlier one wins
+  EXPECT_EQ(monitor.getLastAnalysis().cheapest90MinStart, 13 * 60 + 30);
+  
+  mock_hour = 13;
+  mock_minute = 45;
+  ASSERT_TRUE(monitor.refreshAnalysis());
+  EXPECT_EQ(monitor.getLastAnalysis().cheapest90MinStart, 13 * 60 + 45);
+  expectSameAnalysis(monitor.getLastAnalysis(), freshAnalysis());
+}
+
+TEST(PriceMonitor, RefreshAnalysis_PastEndOfData_ReturnsFalse) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  mock_hour = 12;
+  mock_minute = 30;
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(validResponse()));
+  monitor.fetchAndAnalyzePrices();
+  
+  mock_hour = 16;
+  mock_minute = 30;
+  EXPECT_FALSE(monitor.refreshAnalysis());
+  EXPECT_FALSE(monitor.getLastAnalysis().valid);
+}
+
+TEST(PriceMonitor, FetchAndAnalyze_SamePrices_MatchesFullAnalysis) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillRepeatedly(Return(validResponse()));
+  EXPECT_CALL(mockDisplay, showLoadingIndicator()).Times(::testing::AnyNumber());
+  
+  mock_hour = 10;
+  mock_minute = 0;
+  ASSERT_TRUE(monitor.fetchAndAnalyzePrices());
+  
+  // Quarter-hour refetches of the same prices advance the analysis
+  for (int minute = 10 * 60 + 15; minute <= 14 * 60 + 30; minute += 15) {
+    mock_hour = minute / 60;
+    mock_minute = minute % 60;
+    ASSERT_TRUE(monitor.fetchAndAnalyzePrices()) << minute;
+    EXPECT_EQ(monitor.getLastAnalysis().lastFetchTime, minute);
+    expectSameAnalysis(monitor.getLastAnalysis(), freshAnalysis());
+  }
+}
+
+static IApiClient::ApiResponse notModifiedResponse() {
+  IApiClient::ApiResponse response;
+  response.success = true;
+  response.httpCode = 304;
+  response.notModified = true;
+  return response;
+}
+
+TEST(PriceMonitor, FetchAndAnalyze_NotModified_KeepsPricesAndAdvances) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  EXPECT_CALL(mockApiClient, fetchJson(_))
+    .WillOnce(Return(validResponse()))
+    .WillOnce(Return(notModifiedResponse()));
+  EXPECT_CALL(mockDisplay, showLoadingIndicator()).Times(::testing::AnyNumber());
+  EXPECT_CALL(mockDisplay, showText(_, _)).Times(0);
+  EXPECT_CALL(mockApiClient, clearValidators()).Times(0);
+  
+  mock_hour = 12;
+  mock_minute = 30;
+  ASSERT_TRUE(monitor.fetchAndAnalyzePrices());
+  
+  mock_hour = 13;
+  mock_minute = 0;
+  ASSERT_TRUE(monitor.fetchAndAnalyzePrices());
+  EXPECT_EQ(monitor.getLastAnalysis().currentPeriodStart, 13 * 60);
+  EXPECT_EQ(monitor.getLastAnalysis().lastFetchTime, 13 * 60);
+  expectSameAnalysis(monitor.getLastAnalysis(), freshAnalysis());
+}
+
+TEST(PriceMonitor, FetchAndAnalyze_NotModifiedWithoutPrices_ShowsError) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(notModifiedResponse()));
+  EXPECT_CALL(mockDisplay, showText(Eq("JSON ERROR"), _)).Times(1);
+  EXPECT_CALL(mockApiClient, clearValidators()).Times(1);
+  
+  EXPECT_FALSE(monitor.fetchAndAnalyzePrices());
+}
+
+// Streams the body the mock returns even when the response failed, as a
+// socket dropped mid-body or a spent budget leaves it
+class CutShortApiClient : public MockApiClient {
+public:
+  ApiResponse streamJson(const char* url, BodyHandler& handler, FetchBudget*) override {
+    ApiResponse response = fetchJson(url);
+    if (!response.notModified) {
+      StringBodyReader body(response.payload.c_str(), response.payload.length());
+      handler.handleBody(body);
+    }
+    response.payload = String();
+    return response;
+  }
+};
+
+TEST(PriceMonitor, FetchAndAnalyze_TruncatedBody_KeepsHeldPrices) {
+  MockDisplay mockDisplay;
+  CutShortApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  String json = generateValidPriceJson();
+  IApiClient::ApiResponse timedOut;
+  timedOut.success = false;
+  timedOut.httpCode = 200;
+  timedOut.error = "Timed out: body";
+  timedOut.payload = json.substring(0, json.length() / 2);
+  IApiClient::ApiResponse dropped = validResponse();  // The socket closed early
+  dropped.payload = json.substring(0, json.length() / 3);
+  
+  EXPECT_CALL(mockApiClient, fetchJson(_))
+    .WillOnce(Return(validResponse()))
+    .WillOnce(Return(timedOut))
+    .WillOnce(Return(dropped));
+  EXPECT_CALL(mockDisplay, showLoadingIndicator()).Times(::testing::AnyNumber());
+  EXPECT_CALL(mockDisplay, showText(Eq("HTTP FAILED"), Eq("Timed out: body"))).Times(1);
+  EXPECT_CALL(mockDisplay, showText(Eq("JSON ERROR"), _)).Times(1);
+  // Only the body that arrived whole but did not parse voids the validators
+  EXPECT_CALL(mockApiClient, clearValidators()).Times(1);
+  
+  mock_hour = 12;
+  mock_minute = 30;
+  ASSERT_TRUE(monitor.fetchAndAnalyzePrices());
+  EXPECT_FALSE(monitor.fetchAndAnalyzePrices());
+  EXPECT_FALSE(monitor.fetchAndAnalyzePrices());
+  EXPECT_TRUE(monitor.getLastAnalysis().valid);
+  
+  mock_hour = 13;
+  mock_minute = 0;
+  ASSERT_TRUE(monitor.refreshAnalysis());
+  EXPECT_EQ(monitor.getLastAnalysis().currentPeriodStart, 13 * 60);
+  EXPECT_EQ(monitor.getLastAnalysis().lastFetchTime, 12 * 60 + 30);
+  expectSameAnalysis(monitor.getLastAnalysis(), freshAnalysis());
+  EXPECT_EQ(monitor.fetchNeeded(time(nullptr)), FetchScheduler::NOT_NEEDED);
+}
+
+// ============================================================================
+// Cache Tests
+// ============================================================================
+
+static std::string cachePath(const char* name) {
+  std::string path = ::testing::TempDir() + name;
+  std::remove(path.c_str());
+  return path;
+}
+
+TEST(PriceMonitor, FetchAndAnalyze_Success_SavesCache) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  FilePriceStorage storage(cachePath("monitor_saves.bin"));
+  PriceMonitor monitor(&mockDisplay, &mockApiClient, &storage);
+  
+  EXPECT_CALL(mockApiClient, fetchJson(_))
+    .WillOnce(Return(IApiClient::ApiResponse()))  // Failed: nothing new to keep
+    .WillOnce(Return(validResponse()));
+  EXPECT_CALL(mockDisplay, showText(_, _)).Times(::testing::AnyNumber());
+  
+  EXPECT_FALSE(monitor.fetchAndAnalyzePrices());
+  EXPECT_EQ(storage.saves, 0);
+  EXPECT_TRUE(monitor.fetchAndAnalyzePrices());
+  EXPECT_EQ(storage.saves, 1);
+}
+
+TEST(PriceMonitor, LoadCache_AfterReset_NoFetchNeeded) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  FilePriceStorage storage(cachePath("monitor_reset.bin"));
+  
+  mock_hour = 12;
+  mock_minute = 30;
+  {
+    PriceMonitor before(&mockDisplay, &mockApiClient, &storage);
+    EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(validResponse()));
+    ASSERT_TRUE(before.fetchAndAnalyzePrices());
+  }
+  
+  mock_hour = 13;
+  mock_minute = 0;
+  PriceMonitor after(&mockDisplay, &mockApiClient, &storage);
+  EXPECT_CALL(mockApiClient, fetchJson(_)).Times(0);
+  ASSERT_TRUE(after.loadCache());
+  
+  EXPECT_EQ(after.fetchNeeded(time(nullptr)), FetchScheduler::NOT_NEEDED);
+  EXPECT_EQ(after.getLastAnalysis().lastFetchTime, 12 * 60 + 30);
+  PriceAnalysis expected = freshAnalysis();
+  expectSameAnalysis(after.getLastAnalysis(), expected);
+  
+  // Quarter-hour refreshes carry on from the restored prices
+  mock_minute = 45;
+  ASSERT_TRUE(after.refreshAnalysis());
+  expectSameAnalysis(after.getLastAnalysis(), freshAnalysis());
+}
+
+TEST(PriceMonitor, LoadCache_ClockNotSet_KeepsSavedAnalysis) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  FilePriceStorage storage(cachePath("monitor_clock.bin"));
+  
+  mock_hour = 12;
+  mock_minute = 30;
+  PriceMonitor before(&mockDisplay, &mockApiClient, &storage);
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(validResponse()));
+  ASSERT_TRUE(before.fetchAndAnalyzePrices());
+  
+  // Power-on: the RTC starts from the epoch until NTP has run
+  PriceMonitor after(&mockDisplay, &mockApiClient, &storage);
+  EXPECT_FALSE(after.loadCache(0));
+  EXPECT_TRUE(after.getLastAnalysis().valid);
+  expectSameAnalysis(after.getLastAnalysis(), before.getLastAnalysis());
+  
+  // Once the clock is set the stored prices analyze from scratch
+  mock_hour = 13;
+  mock_minute = 15;
+  ASSERT_TRUE(after.refreshAnalysis());
+  expectSameAnalysis(after.getLastAnalysis(), freshAnalysis());
+}
+
+TEST(PriceMonitor, LoadCache_Corrupted_StartsEmpty) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  std::string path = cachePath("monitor_corrupt.bin");
+  FilePriceStorage storage(path);
+  
+  PriceMonitor before(&mockDisplay, &mockApiClient, &storage);
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(validResponse()));
+  ASSERT_TRUE(before.fetchAndAnalyzePrices());
+  
+  // One price changes on flash
+  FILE* file = fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  fseek(file, PriceCache::HEADER_BYTES + 8 + PriceCache::SERIES_BYTES + 2, SEEK_SET);
+  fputc(0x7F, file);
+  fclose(file);
+  
+  PriceMonitor after(&mockDisplay, &mockApiClient, &storage);
+  EXPECT_FALSE(after.loadCache());
+  EXPECT_FALSE(after.getLastAnalysis().valid);
+  EXPECT_EQ(after.fetchNeeded(time(nullptr)), FetchScheduler::NO_PRICES);
+}
+
+TEST(PriceMonitor, LoadCache_NothingStored_ReturnsFalse) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  FilePriceStorage storage(cachePath("monitor_missing.bin"));
+  PriceMonitor withStorage(&mockDisplay, &mockApiClient, &storage);
+  PriceMonitor withoutStorage(&mockDisplay, &mockApiClient);
+  
+  EXPECT_FALSE(withStorage.loadCache());
+  EXPECT_FALSE(withoutStorage.loadCache());
+  EXPECT_FALSE(withStorage.getLastAnalysis().valid);
+}
+
+// ============================================================================
+// Price Blob Tests
+// ============================================================================
+
+// The cache a monitor saves, as the LAN aggregator would serve it
+static IApiClient::ApiResponse blobResponse(const char* name) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  std::string path = cachePath(name);
+  FilePriceStorage storage(path);
+  PriceMonitor aggregator(&mockDisplay, &mockApiClient, &storage);
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(validResponse()));
+  aggregator.fetchAndAnalyzePrices();
+
+  uint8_t blob[PriceCache::MAX_BYTES];
+  size_t length = storage.load(blob, sizeof(blob));
+  IApiClient::ApiResponse response;
+  response.success = length > 0;
+  response.httpCode = 200;
+  response.payload = String(std::string((const char*)blob, length));
+  return response;
+}
+
+TEST(PriceMonitor, FetchAndAnalyze_PriceBlob_MatchesJson) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  mock_hour = 12;
+  mock_minute = 30;
+  IApiClient::ApiResponse blob = blobResponse("monitor_blob.bin");
+  ASSERT_LT(blob.payload.length(), generateValidPriceJson().length());
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(blob));
+  EXPECT_CALL(mockDisplay, showText(_, _)).Times(0);
+  
+  ASSERT_TRUE(monitor.fetchAndAnalyzePrices());
+  expectSameAnalysis(monitor.getLastAnalysis(), freshAnalysis());
+  EXPECT_EQ(monitor.fetchNeeded(time(nullptr)), FetchScheduler::NOT_NEEDED);
+}
+
+TEST(PriceMonitor, FetchAndAnalyze_CorruptPriceBlob_ShowsError) {
+  MockDisplay mockDisplay;
+  MockApiClient mockApiClient;
+  PriceMonitor monitor(&mockDisplay, &mockApiClient);
+  
+  IApiClient::ApiResponse damaged = blobResponse("monitor_blob_damaged.bin");
+  std::string bytes(damaged.payload.c_str(), damaged.payload.length());
+  bytes[PriceCache::HEADER_BYTES + 8 + PriceCache::SERIES_BYTES + 2] ^= 0x40;
+  damaged.payload = String(bytes);
+  IApiClient::ApiResponse truncated = blobResponse("monitor_blob_truncated.bin");
+  truncated.payload = String(std::string(truncated.payload.c_str(), PriceCache::HEADER_BYTES + 20));
+  EXPECT_CALL(mockApiClient, fetchJson(_)).WillOnce(Return(damaged)).WillOnce(Return(truncated));
+  EXPECT_CALL(mockDisplay, showText(Eq("JSON ERROR"), _)).Times(2);
+  EXPECT_CALL(mockApiClient, clearValidators()).Times(2);
+  
+  EXPECT_FALSE(monitor.fetchAndAnalyzePrices());
+  EXPECT_FALSE(monitor.fetchAndAnalyzePrices());
+  EXPECT_EQ(monitor.fetchNeeded(time(nullptr)), FetchScheduler::NO_PRICES);
+}
+
 // ============================================================================
 // Scheduling Tests
 // ============================================================================
@@ -1,8 +1,9 @@
 #include <gtest/gtest.h>
-#include <vector>
+#include <string>
+#include <cstdio>
 
 // Use test String adapter before including production headers
-#include "../TestStringAdapter.h"
+#include "../../host/HostString.h"
 #define WString_h  // Prevent Arduino WString.h inclusion
 
 // Mock Serial for testing
@@ -50,18 +51,54 @@ const char* API_URL = "mock";
 
 // Include actual PriceAnalyzer and PriceMonitor implementations
 #include "../../src/pricing/PriceAnalyzer.cpp"
+#include "../../src/pricing/WindowPlanner.cpp"
+#include "../../src/pricing/SpotPriceTokenizer.cpp"
+#include "../../src/pricing/PriceCache.cpp"
 #include "../../src/pricing/PriceMonitor.cpp"
+#include "spot_hinta_payloads.h"
 
 // Test wrapper to access private methods
 class PriceMonitorTestWrapper : public PriceMonitor {
 public:
   PriceMonitorTestWrapper() : PriceMonitor(nullptr, nullptr) {}
   
-  std::vector<PriceEntry> testParseJsonToEntries(const String& json) {
-    return parseJsonToEntries(json);
+  int testParseJsonToEntries(const String& json, PriceSeries& out) {
+    return parseJsonToEntries(json, out);
   }
+  
+  int testParseJsonStream(BodyReader& body, PriceSeries& out) {
+    return parseJsonStream(body, out);
+  }
+  
+  int testParseJsonStreamDocument(BodyReader& body, PriceSeries& out) {
+    return parseJsonStreamDocument(body, out);
+  }
+};
+
+// Body that arrives one byte per read and remembers how much was consumed
+class TrickleReader : public BodyReader {
+public:
+  explicit TrickleReader(const std::string& text) : data(text) {}
+  
+  int read() override { return consumed < data.size() ? (uint8_t)data[consumed++] : -1; }
+  size_t readBytes(char* buffer, size_t length) override {
+    if (length == 0 || consumed >= data.size()) return 0;
+    buffer[0] = data[consumed++];
+    return 1;
+  }
+  
+  std::string data;
+  size_t consumed = 0;
 };
 
+// Expected epoch for a timestamp literal
+static time_t isoEpoch(const char* iso) {
+  time_t epoch = 0;
+  int16_t offset = 0;
+  PriceTime::parseIso8601(iso, epoch, offset);
+  return epoch;
+}
+
 // Test Suite: Core Functionality
 TEST(ParseJsonToEntries, ValidJsonArray_BasicEntries) {
   PriceMonitorTestWrapper harness;
@@ -72,15 +109,16 @@ TEST(ParseJsonToEntries, ValidJsonArray_BasicEntries) {
     {"DateTime":"2025-11-18T10:30:00","PriceWithTax":0.12}
   ])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(3));
-  EXPECT_EQ(result[0].dateTime, String("2025-11-18T10:00:00"));
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, 0.10f);
-  EXPECT_EQ(result[1].dateTime, String("2025-11-18T10:15:00"));
-  EXPECT_FLOAT_EQ(result[1].priceWithTax, 0.11f);
-  EXPECT_EQ(result[2].dateTime, String("2025-11-18T10:30:00"));
-  EXPECT_FLOAT_EQ(result[2].priceWithTax, 0.12f);
+  ASSERT_EQ(result.count, 3);
+  EXPECT_EQ(result.slotEpoch(0), isoEpoch("2025-11-18T10:00:00"));
+  EXPECT_FLOAT_EQ(result.prices[0], 0.10f);
+  EXPECT_EQ(result.slotEpoch(1), isoEpoch("2025-11-18T10:15:00"));
+  EXPECT_FLOAT_EQ(result.prices[1], 0.11f);
+  EXPECT_EQ(result.slotEpoch(2), isoEpoch("2025-11-18T10:30:00"));
+  EXPECT_FLOAT_EQ(result.prices[2], 0.12f);
 }
 
 TEST(ParseJsonToEntries, ValidJsonArray_SingleEntry) {
@@ -88,11 +126,12 @@ TEST(ParseJsonToEntries, ValidJsonArray_SingleEntry) {
   
   String json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.15}])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_EQ(result[0].dateTime, String("2025-11-18T10:00:00"));
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, 0.15f);
+  ASSERT_EQ(result.count, 1);
+  EXPECT_EQ(result.slotEpoch(0), isoEpoch("2025-11-18T10:00:00"));
+  EXPECT_FLOAT_EQ(result.prices[0], 0.15f);
 }
 
 TEST(ParseJsonToEntries, ValidJsonArray_EmptyArray) {
@@ -100,25 +139,30 @@ TEST(ParseJsonToEntries, ValidJsonArray_EmptyArray) {
   
   String json = "[]";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  EXPECT_EQ(result.size(), static_cast<size_t>(0));
+  EXPECT_EQ(result.count, 0);
 }
 
 TEST(ParseJsonToEntries, ValidJsonArray_LargeArray) {
   PriceMonitorTestWrapper harness;
   
-  // Build JSON with 50 entries
+  // Build JSON with 50 consecutive 15-minute entries from 10:00
   std::string json = "[";
+  char entry[64];
   for (int i = 0; i < 50; i++) {
     if (i > 0) json += ",";
-    json += R"({"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.10})";
+    snprintf(entry, sizeof(entry), R"({"DateTime":"2025-11-18T%02d:%02d:00","PriceWithTax":0.10})",
+             10 + i / 4, (i % 4) * 15);
+    json += entry;
   }
   json += "]";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(String(json.c_str()));
+  PriceSeries result;
+  harness.testParseJsonToEntries(String(json.c_str()), result);
   
-  EXPECT_EQ(result.size(), static_cast<size_t>(50));
+  EXPECT_EQ(result.count, 50);
 }
 
 // Test Suite: Error Handling
@@ -127,9 +171,10 @@ TEST(ParseJsonToEntries, InvalidJson_MalformedSyntax) {
   
   String json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.10,}])"; // trailing comma
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  EXPECT_EQ(result.size(), static_cast<size_t>(0)); // empty = error
+  EXPECT_EQ(result.count, 0); // empty = error
 }
 
 TEST(ParseJsonToEntries, InvalidJson_NotArray_Object) {
@@ -137,9 +182,10 @@ TEST(ParseJsonToEntries, InvalidJson_NotArray_Object) {
   
   String json = R"({"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.10})";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  EXPECT_EQ(result.size(), static_cast<size_t>(0));
+  EXPECT_EQ(result.count, 0);
 }
 
 TEST(ParseJsonToEntries, InvalidJson_NotArray_String) {
@@ -147,9 +193,10 @@ TEST(ParseJsonToEntries, InvalidJson_NotArray_String) {
   
   String json = R"("not an array")";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  EXPECT_EQ(result.size(), static_cast<size_t>(0));
+  EXPECT_EQ(result.count, 0);
 }
 
 TEST(ParseJsonToEntries, InvalidJson_CompletelyBroken) {
@@ -157,9 +204,10 @@ TEST(ParseJsonToEntries, InvalidJson_CompletelyBroken) {
   
   String json = "this is not json at all!@#$%";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  EXPECT_EQ(result.size(), static_cast<size_t>(0));
+  EXPECT_EQ(result.count, 0);
 }
 
 TEST(ParseJsonToEntries, InvalidJson_EmptyString) {
@@ -167,9 +215,10 @@ TEST(ParseJsonToEntries, InvalidJson_EmptyString) {
   
   String json = "";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  EXPECT_EQ(result.size(), static_cast<size_t>(0));
+  EXPECT_EQ(result.count, 0);
 }
 
 TEST(ParseJsonToEntries, InvalidJson_UnclosedBracket) {
@@ -177,9 +226,10 @@ TEST(ParseJsonToEntries, InvalidJson_UnclosedBracket) {
   
   String json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.10})";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  EXPECT_EQ(result.size(), static_cast<size_t>(0));
+  EXPECT_EQ(result.count, 0);
 }
 
 // Test Suite: Field Validation
@@ -188,11 +238,10 @@ TEST(ParseJsonToEntries, MissingField_DateTime) {
   
   String json = R"([{"PriceWithTax":0.10}])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_EQ(result[0].dateTime, String("")); // Empty string for missing field
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, 0.10f);
+  EXPECT_EQ(result.count, 0); // Entry cannot be placed in time
 }
 
 TEST(ParseJsonToEntries, MissingField_PriceWithTax) {
@@ -200,11 +249,12 @@ TEST(ParseJsonToEntries, MissingField_PriceWithTax) {
   
   String json = R"([{"DateTime":"2025-11-18T10:00:00"}])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_EQ(result[0].dateTime, String("2025-11-18T10:00:00"));
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, 0.0f); // Default value
+  ASSERT_EQ(result.count, 1);
+  EXPECT_EQ(result.slotEpoch(0), isoEpoch("2025-11-18T10:00:00"));
+  EXPECT_FLOAT_EQ(result.prices[0], 0.0f); // Default value
 }
 
 TEST(ParseJsonToEntries, MissingFields_Both) {
@@ -212,11 +262,10 @@ TEST(ParseJsonToEntries, MissingFields_Both) {
   
   String json = R"([{}])"; // Empty object
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_EQ(result[0].dateTime, String(""));
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, 0.0f);
+  EXPECT_EQ(result.count, 0);
 }
 
 TEST(ParseJsonToEntries, ExtraFields_ShouldIgnore) {
@@ -229,11 +278,12 @@ TEST(ParseJsonToEntries, ExtraFields_ShouldIgnore) {
     "AnotherField":123
   }])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_EQ(result[0].dateTime, String("2025-11-18T10:00:00"));
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, 0.10f);
+  ASSERT_EQ(result.count, 1);
+  EXPECT_EQ(result.slotEpoch(0), isoEpoch("2025-11-18T10:00:00"));
+  EXPECT_FLOAT_EQ(result.prices[0], 0.10f);
 }
 
 // Test Suite: Data Types
@@ -242,11 +292,12 @@ TEST(ParseJsonToEntries, WrongType_PriceAsString) {
   
   String json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":"0.10"}])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
+  ASSERT_EQ(result.count, 1);
   // ArduinoJson will attempt conversion
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, 0.10f);
+  EXPECT_FLOAT_EQ(result.prices[0], 0.10f);
 }
 
 TEST(ParseJsonToEntries, NegativePrice) {
@@ -254,10 +305,11 @@ TEST(ParseJsonToEntries, NegativePrice) {
   
   String json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":-0.05}])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, -0.05f);
+  ASSERT_EQ(result.count, 1);
+  EXPECT_FLOAT_EQ(result.prices[0], -0.05f);
 }
 
 TEST(ParseJsonToEntries, VeryLargePrice) {
@@ -265,10 +317,11 @@ TEST(ParseJsonToEntries, VeryLargePrice) {
   
   String json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":999999.99}])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_NEAR(result[0].priceWithTax, 999999.99f, 0.01f);
+  ASSERT_EQ(result.count, 1);
+  EXPECT_NEAR(result.prices[0], 999999.99f, 0.01f);
 }
 
 TEST(ParseJsonToEntries, ZeroPrice) {
@@ -276,10 +329,11 @@ TEST(ParseJsonToEntries, ZeroPrice) {
   
   String json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.0}])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, 0.0f);
+  ASSERT_EQ(result.count, 1);
+  EXPECT_FLOAT_EQ(result.prices[0], 0.0f);
 }
 
 // Test Suite: DateTime Formats
@@ -288,10 +342,11 @@ TEST(ParseJsonToEntries, DateTimeFormat_WithMilliseconds) {
   
   String json = R"([{"DateTime":"2025-11-18T10:00:00.000","PriceWithTax":0.10}])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_EQ(result[0].dateTime, String("2025-11-18T10:00:00.000"));
+  ASSERT_EQ(result.count, 1);
+  EXPECT_EQ(result.slotEpoch(0), isoEpoch("2025-11-18T10:00:00"));
 }
 
 TEST(ParseJsonToEntries, DateTimeFormat_WithTimezone) {
@@ -299,21 +354,29 @@ TEST(ParseJsonToEntries, DateTimeFormat_WithTimezone) {
   
   String json = R"([{"DateTime":"2025-11-18T10:00:00+02:00","PriceWithTax":0.10}])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_EQ(result[0].dateTime, String("2025-11-18T10:00:00+02:00"));
+  ASSERT_EQ(result.count, 1);
+  EXPECT_EQ(result.slotEpoch(0), isoEpoch("2025-11-18T08:00:00Z"));
+  EXPECT_EQ(result.offsetAt(0), 120);
+  EXPECT_EQ(result.minuteOfDay(0), 10 * 60);
 }
 
 TEST(ParseJsonToEntries, DateTimeFormat_Unusual) {
   PriceMonitorTestWrapper harness;
   
-  String json = R"([{"DateTime":"18-11-2025 10:00","PriceWithTax":0.10}])";
+  String json = R"([
+    {"DateTime":"18-11-2025 10:00","PriceWithTax":0.10},
+    {"DateTime":"2025-11-18T10:15:00","PriceWithTax":0.11}
+  ])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_EQ(result[0].dateTime, String("18-11-2025 10:00"));
+  // Unparseable timestamp is skipped, the rest is kept
+  ASSERT_EQ(result.count, 1);
+  EXPECT_EQ(result.slotEpoch(0), isoEpoch("2025-11-18T10:15:00"));
 }
 
 // Test Suite: Edge Cases
@@ -329,11 +392,12 @@ TEST(ParseJsonToEntries, WhitespaceVariations) {
     ]
   )";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_EQ(result[0].dateTime, String("2025-11-18T10:00:00"));
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, 0.10f);
+  ASSERT_EQ(result.count, 1);
+  EXPECT_EQ(result.slotEpoch(0), isoEpoch("2025-11-18T10:00:00"));
+  EXPECT_FLOAT_EQ(result.prices[0], 0.10f);
 }
 
 TEST(ParseJsonToEntries, MultipleEntries_MixedValues) {
@@ -341,18 +405,37 @@ TEST(ParseJsonToEntries, MultipleEntries_MixedValues) {
   
   String json = R"([
     {"DateTime":"2025-11-18T00:00:00","PriceWithTax":0.05},
-    {"DateTime":"2025-11-18T06:00:00","PriceWithTax":0.12},
-    {"DateTime":"2025-11-18T12:00:00","PriceWithTax":0.18},
-    {"DateTime":"2025-11-18T18:00:00","PriceWithTax":0.15},
-    {"DateTime":"2025-11-18T23:45:00","PriceWithTax":0.08}
+    {"DateTime":"2025-11-18T00:15:00","PriceWithTax":0.12},
+    {"DateTime":"2025-11-18T00:30:00","PriceWithTax":0.18},
+    {"DateTime":"2025-11-18T00:45:00","PriceWithTax":0.15},
+    {"DateTime":"2025-11-18T01:00:00","PriceWithTax":0.08}
+  ])";
+  
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
+  
+  ASSERT_EQ(result.count, 5);
+  EXPECT_FLOAT_EQ(result.prices[0], 0.05f);
+  EXPECT_FLOAT_EQ(result.prices[2], 0.18f);
+  EXPECT_FLOAT_EQ(result.prices[4], 0.08f);
+}
+
+TEST(ParseJsonToEntries, GapInTimestamps_StopsAtGap) {
+  PriceMonitorTestWrapper harness;
+  
+  String json = R"([
+    {"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.10},
+    {"DateTime":"2025-11-18T10:15:00","PriceWithTax":0.11},
+    {"DateTime":"2025-11-18T11:00:00","PriceWithTax":0.12}
   ])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  int count = harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(5));
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, 0.05f);
-  EXPECT_FLOAT_EQ(result[2].priceWithTax, 0.18f);
-  EXPECT_FLOAT_EQ(result[4].priceWithTax, 0.08f);
+  // Slots are addressed by index, so data after a gap cannot be kept
+  EXPECT_EQ(count, 2);
+  ASSERT_EQ(result.count, 2);
+  EXPECT_EQ(result.slotEpoch(1), isoEpoch("2025-11-18T10:15:00"));
 }
 
 TEST(ParseJsonToEntries, RealWorldExample_TypicalApiResponse) {
@@ -366,24 +449,163 @@ TEST(ParseJsonToEntries, RealWorldExample_TypicalApiResponse) {
     {"DateTime":"2025-11-18T00:45:00+02:00","PriceWithTax":0.0476}
   ])";
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(4));
-  EXPECT_TRUE(result[0].dateTime.startsWith(String("2025-11-18T00:00")));
-  EXPECT_NEAR(result[0].priceWithTax, 0.0543f, 0.0001f);
-  EXPECT_NEAR(result[3].priceWithTax, 0.0476f, 0.0001f);
+  ASSERT_EQ(result.count, 4);
+  EXPECT_EQ(result.localDay(0), PriceTime::daysFromCivil(2025, 11, 18));
+  EXPECT_EQ(result.minuteOfDay(0), 0);
+  EXPECT_EQ(result.slotEpoch(3) - result.slotEpoch(0), 45 * 60);
+  EXPECT_NEAR(result.prices[0], 0.0543f, 0.0001f);
+  EXPECT_NEAR(result.prices[3], 0.0476f, 0.0001f);
 }
 
 TEST(ParseJsonToEntries, NullValues_InObject) {
   PriceMonitorTestWrapper harness;
   
-  String json = R"([{"DateTime":null,"PriceWithTax":null}])";
+  String json = R"([
+    {"DateTime":null,"PriceWithTax":null},
+    {"DateTime":"2025-11-18T10:00:00","PriceWithTax":null}
+  ])";
+  
+  PriceSeries result;
+  harness.testParseJsonToEntries(json, result);
+  
+  ASSERT_EQ(result.count, 1);
+  EXPECT_EQ(result.slotEpoch(0), isoEpoch("2025-11-18T10:00:00"));
+  EXPECT_FLOAT_EQ(result.prices[0], 0.0f);
+}
+
+// Test Suite: Streaming
+TEST(ParseJsonStream, TwoDaysByteByByte) {
+  PriceMonitorTestWrapper harness;
+  
+  std::string json = "[";
+  char entry[80];
+  for (int i = 0; i < 192; i++) {
+    if (i > 0) json += ",\n";
+    snprintf(entry, sizeof(entry), R"({"DateTime":"2025-11-%02dT%02d:%02d:00+02:00","PriceWithTax":%.4f})",
+             18 + i / 96, (i / 4) % 24, (i % 4) * 15, 0.05 + 0.001 * i);
+    json += entry;
+  }
+  json += "]";
+  
+  TrickleReader body(json);
+  PriceSeries result;
+  
+  ASSERT_EQ(harness.testParseJsonStream(body, result), 192);
+  EXPECT_EQ(result.minuteOfDay(191), 23 * 60 + 45);
+  EXPECT_NEAR(result.prices[191], 0.05f + 0.191f, 0.0001f);
+  EXPECT_EQ(body.consumed, json.size());
+}
+
+TEST(ParseJsonStream, StopsReadingAtClosingBracket) {
+  PriceMonitorTestWrapper harness;
+  
+  // Anything after the array (e.g. a connection that stays open) is left alone
+  std::string json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.10}]  TRAILING)";
+  TrickleReader body(json);
+  PriceSeries result;
+  
+  EXPECT_EQ(harness.testParseJsonStream(body, result), 1);
+  EXPECT_EQ(body.consumed, json.find(']') + 1);
+}
+
+TEST(ParseJsonStream, StopsReadingAtGap) {
+  PriceMonitorTestWrapper harness;
+  
+  std::string json = R"([
+    {"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.10},
+    {"DateTime":"2025-11-18T10:15:00","PriceWithTax":0.11},
+    {"DateTime":"2025-11-18T11:00:00","PriceWithTax":0.12},
+    {"DateTime":"2025-11-18T11:15:00","PriceWithTax":0.13}
+  ])";
+  TrickleReader body(json);
+  PriceSeries result;
+  
+  EXPECT_EQ(harness.testParseJsonStream(body, result), 2);
+  EXPECT_LT(body.consumed, json.find("11:15"));
+}
+
+TEST(ParseJsonStream, TruncatedBody_DiscardsSeries) {
+  PriceMonitorTestWrapper harness;
+  
+  // Connection dropped mid-entry
+  std::string json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.10},{"DateTime":"2025-11-18T10:15)";
+  TrickleReader body(json);
+  PriceSeries result;
   
-  std::vector<PriceEntry> result = harness.testParseJsonToEntries(json);
+  EXPECT_EQ(harness.testParseJsonStream(body, result), 0);
+  EXPECT_EQ(result.count, 0);
+}
+
+TEST(ParseJsonStream, MissingSeparator_DiscardsSeries) {
+  PriceMonitorTestWrapper harness;
   
-  ASSERT_EQ(result.size(), static_cast<size_t>(1));
-  EXPECT_EQ(result[0].dateTime, String(""));
-  EXPECT_FLOAT_EQ(result[0].priceWithTax, 0.0f);
+  std::string json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.10} {"DateTime":"2025-11-18T10:15:00","PriceWithTax":0.11}])";
+  TrickleReader body(json);
+  PriceSeries result;
+  
+  EXPECT_EQ(harness.testParseJsonStream(body, result), 0);
+}
+
+// Test Suite: Tokenizer against ArduinoJson
+// Both paths must build the same series from the same body
+
+static void expectSameAsDocumentParse(const std::string& json) {
+  PriceMonitorTestWrapper harness;
+  PriceSeries fast;
+  PriceSeries reference;
+  TrickleReader fastBody(json);
+  TrickleReader referenceBody(json);
+  
+  int fastCount = harness.testParseJsonStream(fastBody, fast);
+  int referenceCount = harness.testParseJsonStreamDocument(referenceBody, reference);
+  
+  ASSERT_EQ(fastCount, referenceCount);
+  ASSERT_EQ(fast.count, reference.count);
+  EXPECT_EQ(fastBody.consumed, referenceBody.consumed);
+  for (int i = 0; i < fast.count; i++) {
+    EXPECT_EQ(fast.slotEpoch(i), reference.slotEpoch(i)) << "slot " << i;
+    EXPECT_EQ(fast.offsetAt(i), reference.offsetAt(i)) << "slot " << i;
+    EXPECT_FLOAT_EQ(fast.prices[i], reference.prices[i]) << "slot " << i;
+  }
+}
+
+TEST(ParseJsonDifferential, RecordedPayloads) {
+  expectSameAsDocumentParse(PAYLOAD_TWO_DAYS);
+  expectSameAsDocumentParse(PAYLOAD_DST_FALL_BACK);
+  expectSameAsDocumentParse(PAYLOAD_DST_SPRING_FORWARD);
+  expectSameAsDocumentParse(PAYLOAD_PRETTY);
+}
+
+TEST(ParseJsonDifferential, RecordedPayloadPrefixes) {
+  // Cut anywhere, the body is truncated and both must discard it
+  std::string json = PAYLOAD_DST_FALL_BACK;
+  for (size_t length = 0; length < 400; length += 7) {
+    expectSameAsDocumentParse(json.substr(0, length));
+  }
+}
+
+TEST(ParseJsonDifferential, ElementsNeedingFallback) {
+  expectSameAsDocumentParse(R"([
+    {"DateTime":"2025-11-18T10:00:00+02:00","PriceWithTax":"0.25"},
+    {"Extra":{"a":[1,2]},"DateTime":"2025-11-18T10:15:00+02:00","PriceWithTax":0.5},
+    {"DateTime":"2025-11-18T10:30:00\u002B02:00","PriceWithTax":0.75},
+    {"DateTime":"2025-11-18T10:45:00+02:00","PriceWithTax":true},
+    {"DateTime":"2025-11-18T11:00:00+02:00","PriceWithTax":0.1}
+  ])");
+}
+
+TEST(ParseJsonDifferential, SkippedAndGapEntries) {
+  expectSameAsDocumentParse(R"([
+    {"DateTime":"bad","PriceWithTax":0.1},
+    {"DateTime":"2025-11-18T10:00:00","PriceWithTax":null},
+    {"PriceWithTax":0.2},
+    {"DateTime":"2025-11-18T10:15:00","PriceWithTax":0.3},
+    {"DateTime":"2025-11-18T11:00:00","PriceWithTax":0.4},
+    {"DateTime":"2025-11-18T11:15:00","PriceWithTax":0.5}
+  ])");
 }
 
 int main(int argc, char **argv) {
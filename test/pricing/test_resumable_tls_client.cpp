@@ -0,0 +1,391 @@
+#include <gtest/gtest.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Use test String adapter
+#include "../../host/HostString.h"
+#define WString_h
+#define Arduino_h
+#define WiFi_h
+#define WIFI_CLIENT_H
+
+// The device's mbedTLS client itself, over a POSIX WiFiClient
+#include "../mocks/HostWiFiClient.h"
+#include "../mocks/LocalTlsServer.h"
+#include "../../src/pricing/ResumableTlsClient.cpp"
+
+static const char* BODY = "[{\"DateTime\":\"2025-11-18T10:00:00\",\"PriceWithTax\":0.10}]";
+static const size_t SESSION_BYTES = 2048;  // TlsSessionCache::MAX_SESSION_BYTES
+
+static uint16_t portOf(const std::string& url) {
+  return (uint16_t)atoi(url.c_str() + url.rfind(':') + 1);
+}
+
+static bool sendGet(ResumableTlsClient& client, const char* path) {
+  std::string request = std::string("GET ") + path + " HTTP/1.0\r\nHost: 127.0.0.1\r\n\r\n";
+  return client.write((const uint8_t*)request.data(), request.size()) == request.size();
+}
+
+// Everything up to the end of the connection, the way StreamBodyReader
+// polls: read() returns at once, connected() tells waiting from done
+static std::string readToEnd(ResumableTlsClient& client, unsigned long timeoutMs = 3000) {
+  std::string text;
+  unsigned long started = millis();
+  while (millis() - started < timeoutMs) {
+    uint8_t buffer[64];
+    int n = client.read(buffer, sizeof(buffer));
+    if (n > 0) {
+      text.append((const char*)buffer, n);
+    } else if (!client.connected()) {
+      break;
+    } else {
+      delay(1);
+    }
+  }
+  return text;
+}
+
+static std::string bodyOf(const std::string& response) {
+  size_t end = response.find("\r\n\r\n");
+  return end == std::string::npos ? std::string() : response.substr(end + 4);
+}
+
+// Connects, fetches and keeps the session the handshake produced
+static bool fetchOnce(uint16_t port, std::vector<uint8_t>& session, bool& resumed, std::string* body = nullptr) {
+  ResumableTlsClient client;
+  if (!session.empty() && !client.setSession(session.data(), session.size())) {
+    return false;
+  }
+  if (!client.connect("127.0.0.1", port) || !sendGet(client, "/prices")) {
+    return false;
+  }
+  resumed = client.sessionResumed();
+  std::string response = readToEnd(client);
+  if (body) {
+    *body = bodyOf(response);
+  }
+  session.resize(SESSION_BYTES);
+  session.resize(client.getSession(session.data(), session.size()));
+  client.stop();
+  return !session.empty();
+}
+
+// Test Suite: handshakes against a local OpenSSL server
+
+TEST(ResumableTlsClient, FullThenResumedFromTicket) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY);
+  uint16_t port = portOf(server.url());
+  std::vector<uint8_t> session;
+  bool resumed = true;
+  std::string body;
+
+  ASSERT_TRUE(fetchOnce(port, session, resumed, &body));
+  EXPECT_FALSE(resumed);
+  EXPECT_EQ(body, BODY);
+
+  ASSERT_TRUE(fetchOnce(port, session, resumed, &body));
+  EXPECT_TRUE(resumed);
+  EXPECT_EQ(body, BODY);
+
+  // Resumed again from the session the resumed handshake left
+  ASSERT_TRUE(fetchOnce(port, session, resumed));
+  EXPECT_TRUE(resumed);
+  EXPECT_EQ(server.fullHandshakes(), 1);
+  EXPECT_EQ(server.resumedHandshakes(), 2);
+}
+
+TEST(ResumableTlsClient, ResumesFromSessionIdWithoutTickets) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setTickets(false);
+  server.setBody(BODY);
+  uint16_t port = portOf(server.url());
+  std::vector<uint8_t> session;
+  bool resumed = true;
+
+  ASSERT_TRUE(fetchOnce(port, session, resumed));
+  EXPECT_FALSE(resumed);
+  ASSERT_TRUE(fetchOnce(port, session, resumed));
+  EXPECT_TRUE(resumed);
+  EXPECT_EQ(server.resumedHandshakes(), 1);
+}
+
+TEST(ResumableTlsClient, ForgottenSessionIsAFullHandshake) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY);
+  uint16_t port = portOf(server.url());
+  std::vector<uint8_t> session;
+  bool resumed = true;
+  ASSERT_TRUE(fetchOnce(port, session, resumed));
+  std::vector<uint8_t> stale = session;
+
+  // The server offers a new session, with a new master secret
+  server.forgetSessions();
+  ASSERT_TRUE(fetchOnce(port, session, resumed));
+  EXPECT_FALSE(resumed);
+  EXPECT_NE(session, stale);
+
+  // And the client keeps that one, not the one it offered
+  ASSERT_TRUE(fetchOnce(port, session, resumed));
+  EXPECT_TRUE(resumed);
+  EXPECT_EQ(server.fullHandshakes(), 2);
+  EXPECT_EQ(server.resumedHandshakes(), 1);
+}
+
+TEST(ResumableTlsClient, DamagedSessionIsNotOffered) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY);
+  std::vector<uint8_t> session;
+  bool resumed = true;
+  ASSERT_TRUE(fetchOnce(portOf(server.url()), session, resumed));
+
+  ResumableTlsClient client;
+  EXPECT_FALSE(client.setSession(session.data(), session.size() / 2));
+  ASSERT_TRUE(client.connect("127.0.0.1", portOf(server.url())));
+  EXPECT_FALSE(client.sessionResumed());
+  EXPECT_GT(client.handshakeMicros(), 0u);
+}
+
+TEST(ResumableTlsClient, NoSessionBeforeConnectOrAfterStop) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  ResumableTlsClient client;
+  uint8_t session[SESSION_BYTES];
+
+  EXPECT_EQ(client.getSession(session, sizeof(session)), 0u);
+  ASSERT_TRUE(client.connect("127.0.0.1", portOf(server.url())));
+  EXPECT_GT(client.getSession(session, sizeof(session)), 0u);
+  EXPECT_EQ(client.getSession(session, 16), 0u);  // Does not fit
+  client.stop();
+  EXPECT_EQ(client.getSession(session, sizeof(session)), 0u);
+  EXPECT_FALSE(client.connected());
+  client.stop();  // Twice is harmless
+}
+
+// Test Suite: reading
+
+TEST(ResumableTlsClient, ReadDoesNotWaitForData) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY);
+  ResumableTlsClient client;
+  ASSERT_TRUE(client.connect("127.0.0.1", portOf(server.url())));
+
+  // Nothing is sent before the request
+  unsigned long started = millis();
+  uint8_t buffer[16];
+  EXPECT_EQ(client.read(buffer, sizeof(buffer)), -1);
+  EXPECT_EQ(client.read(), -1);
+  EXPECT_EQ(client.peek(), -1);
+  EXPECT_EQ(client.available(), 0);
+  EXPECT_LT(millis() - started, 100u);
+  EXPECT_TRUE(client.connected());
+
+  ASSERT_TRUE(sendGet(client, "/prices"));
+  EXPECT_EQ(bodyOf(readToEnd(client)), BODY);
+}
+
+TEST(ResumableTlsClient, PeekedByteIsReadOnce) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY);
+  ResumableTlsClient client;
+  ASSERT_TRUE(client.connect("127.0.0.1", portOf(server.url())));
+  ASSERT_TRUE(sendGet(client, "/prices"));
+
+  unsigned long started = millis();
+  while (client.available() == 0 && millis() - started < 3000) {
+    delay(1);
+  }
+  int available = client.available();
+  ASSERT_GT(available, 0);
+  EXPECT_EQ(client.peek(), 'H');
+  EXPECT_EQ(client.peek(), 'H');
+  EXPECT_EQ(client.available(), available);  // The peeked byte still counts
+  EXPECT_EQ(client.read(), 'H');
+  EXPECT_EQ(client.read(), 'T');
+
+  std::string rest = readToEnd(client);
+  EXPECT_EQ(rest.compare(0, 6, "TP/1.0"), 0);
+  EXPECT_EQ(bodyOf(rest), BODY);
+}
+
+// close_notify, then the TCP close, ends the stream; so does the TCP close alone
+class EndOfStreamTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(EndOfStreamTest, EndsAtClose) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setCloseNotify(GetParam());
+  server.setBody(BODY);
+  ResumableTlsClient client;
+  client.setTimeout(2000);
+  ASSERT_TRUE(client.connect("127.0.0.1", portOf(server.url())));
+  ASSERT_TRUE(sendGet(client, "/prices"));
+
+  // readBytes() stops at the end instead of waiting out its timeout
+  char response[1024];
+  unsigned long started = millis();
+  size_t length = client.readBytes(response, sizeof(response));
+  EXPECT_LT(millis() - started, 1000u);
+  EXPECT_EQ(bodyOf(std::string(response, length)), BODY);
+
+  EXPECT_EQ(client.read(), -1);
+  EXPECT_EQ(client.peek(), -1);
+  EXPECT_EQ(client.available(), 0);
+  EXPECT_FALSE(client.connected());
+  EXPECT_EQ(client.write((const uint8_t*)"x", 1), 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(CloseNotify, EndOfStreamTest, ::testing::Bool());
+
+// Test Suite: the budgeted connect
+
+static unsigned long clockMs() { return millis(); }
+
+TEST(ResumableTlsClient, BudgetedConnectRunsItsStages) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  SpanRecorder spans(micros);
+  spans.beginSession();
+  FetchBudget budget(clockMs);
+  budget.setTrace(&spans);
+  ResumableTlsClient client;
+
+  ASSERT_TRUE(client.connect("localhost", portOf(server.url()), budget));
+  spans.endSession();
+  EXPECT_FALSE(budget.exhausted());
+  ASSERT_EQ(spans.session(0).count, 3);
+  EXPECT_STREQ(spans.session(0).spans[0].name, FetchBudget::describe(FetchBudget::DNS));
+  EXPECT_STREQ(spans.session(0).spans[2].name, FetchBudget::describe(FetchBudget::TLS));
+}
+
+TEST(ResumableTlsClient, RefusedConnectIsNotATimeout) {
+  uint16_t closedPort;
+  {
+    LocalTlsServer server;  // Gone again, its port with it
+    closedPort = portOf(server.url());
+  }
+  FetchBudget budget(clockMs);
+  ResumableTlsClient client;
+
+  EXPECT_FALSE(client.connect("127.0.0.1", closedPort, budget));
+  EXPECT_FALSE(budget.exhausted());
+  EXPECT_FALSE(client.connected());
+}
+
+// Test Suite: against `openssl s_server -www`, which says in its status
+// page whether it resumed the session, independently of the client's own
+// master-secret comparison. Skipped when the openssl tool is missing.
+
+class OpenSslServer {
+public:
+  OpenSslServer() {
+    std::string dir = ::testing::TempDir();
+    cert = dir + "s_server_cert.pem";
+    key = dir + "s_server_key.pem";
+    std::string make = "openssl req -x509 -newkey ec -pkeyopt ec_paramgen_curve:prime256v1 -nodes -days 1"
+                       " -subj /CN=127.0.0.1 -keyout " + key + " -out " + cert + " >/dev/null 2>&1";
+    if (system(make.c_str()) != 0) {
+      return;
+    }
+    {
+      LocalHttpServer probe;  // Takes a free port and gives it back
+      listenPort = portOf(probe.url());
+    }
+    std::string accept = "127.0.0.1:" + std::to_string(listenPort);
+
+    int out[2];
+    if (pipe(out) != 0) {
+      return;
+    }
+    pid = fork();
+    if (pid == 0) {
+      dup2(out[1], STDOUT_FILENO);
+      close(out[0]);
+      execlp("openssl", "openssl", "s_server", "-accept", accept.c_str(), "-cert", cert.c_str(),
+             "-key", key.c_str(), "-www", "-tls1_2", (char*)nullptr);
+      _exit(127);
+    }
+    close(out[1]);
+    output = fdopen(out[0], "r");
+    // It prints ACCEPT once listening, or exits
+    char line[256];
+    while (pid > 0 && fgets(line, sizeof(line), output)) {
+      if (strncmp(line, "ACCEPT", 6) == 0) {
+        listening = true;
+        break;
+      }
+    }
+  }
+
+  ~OpenSslServer() {
+    if (pid > 0) {
+      kill(pid, SIGTERM);
+      waitpid(pid, nullptr, 0);
+    }
+    if (output) {
+      fclose(output);
+    }
+  }
+
+  bool ready() const { return listening; }
+  uint16_t port() const { return listenPort; }
+
+private:
+  std::string cert;
+  std::string key;
+  uint16_t listenPort = 0;
+  pid_t pid = -1;
+  FILE* output = nullptr;
+  bool listening = false;
+};
+
+// The status page as s_server serves it to one connection
+static std::string statusPage(uint16_t port, std::vector<uint8_t>& session, bool& resumed) {
+  ResumableTlsClient client;
+  if (!session.empty()) {
+    client.setSession(session.data(), session.size());
+  }
+  if (!client.connect("127.0.0.1", port) || !sendGet(client, "/")) {
+    return std::string();
+  }
+  resumed = client.sessionResumed();
+  std::string page = readToEnd(client);
+  session.resize(SESSION_BYTES);
+  session.resize(client.getSession(session.data(), session.size()));
+  return page;
+}
+
+TEST(ResumableTlsClientOpenSslServer, FullThenResumed) {
+  OpenSslServer server;
+  if (!server.ready()) {
+    GTEST_SKIP() << "openssl s_server did not start";
+  }
+  std::vector<uint8_t> session;
+  bool resumed = true;
+
+  std::string first = statusPage(server.port(), session, resumed);
+  EXPECT_NE(first.find("New, TLSv1.2"), std::string::npos) << first;
+  EXPECT_FALSE(resumed);
+  ASSERT_FALSE(session.empty());
+
+  std::string second = statusPage(server.port(), session, resumed);
+  EXPECT_NE(second.find("Reused, TLSv1.2"), std::string::npos) << second;
+  EXPECT_TRUE(resumed);
+}
+
+int main(int argc, char **argv) {
+  // close_notify to a server that already hung up; lwIP has no SIGPIPE
+  signal(SIGPIPE, SIG_IGN);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cstdio>
+
+// Use test String adapter before including production headers
+#include "../../host/HostString.h"
+#define WString_h  // Prevent Arduino WString.h inclusion
+
+// Now include production headers
+#include "../../src/pricing/PriceData.h"
+#include "../../src/pricing/SlotMask.h"
+#include "../test_data_helpers.h"
+
+using TestHelpers::makeFlatSeries;
+using TestHelpers::indexAt;
+
+static int countBits(const SlotMask& mask, int count) {
+  int bits = 0;
+  for (int i = 0; i < count; i++) {
+    bits += mask.test(i);
+  }
+  return bits;
+}
+
+// Series of `slots` 15-minute slots from local midnight, switching UTC
+// offset after `switchAfter` slots (DST change)
+static PriceSeries makeDstSeries(int year, int month, int day, int slots, int switchAfter,
+                                 int16_t offsetBefore, int16_t offsetAfter) {
+  PriceSeries series = makeFlatSeries(year, month, day, 0, 0, switchAfter, 0.10f, offsetBefore);
+  time_t next = series.slotEpoch(series.count);
+  for (int i = 0; series.count < slots; i++) {
+    series.append(PriceEntry(next + (time_t)i * 900, offsetAfter, 0.10f));
+  }
+  return series;
+}
+
+// Test Suite: SlotMask
+
+TEST(SlotMask, SetAndTestAcrossWords) {
+  SlotMask mask;
+  mask.set(0);
+  mask.set(63);
+  mask.set(64);
+  mask.set(PriceSeries::MAX_SLOTS - 1);
+
+  EXPECT_TRUE(mask.test(0));
+  EXPECT_TRUE(mask.test(63));
+  EXPECT_TRUE(mask.test(64));
+  EXPECT_FALSE(mask.test(65));
+  EXPECT_TRUE(mask.test(PriceSeries::MAX_SLOTS - 1));
+  EXPECT_EQ(countBits(mask, PriceSeries::MAX_SLOTS), 4);
+}
+
+TEST(SlotMask, AndShiftedDown_CrossesWordBoundary) {
+  SlotMask mask;
+  SlotMask other;
+  for (int i = 0; i < 130; i++) {
+    mask.set(i);
+  }
+  other.set(66);
+  other.set(129);
+
+  mask.andShiftedDown(other, 3);
+
+  // Bit i survives only where other has bit i + 3
+  EXPECT_TRUE(mask.test(63));
+  EXPECT_TRUE(mask.test(126));
+  EXPECT_EQ(countBits(mask, PriceSeries::MAX_SLOTS), 2);
+}
+
+TEST(SlotMask, ClearBelow_KeepsLaterBits) {
+  const int cuts[] = {0, 1, 63, 64, 65, 130, PriceSeries::MAX_SLOTS};
+  for (int cut : cuts) {
+    SlotMask mask;
+    for (int i = 0; i < PriceSeries::MAX_SLOTS; i++) {
+      mask.set(i);
+    }
+    mask.clearBelow(cut);
+    EXPECT_EQ(countBits(mask, PriceSeries::MAX_SLOTS), PriceSeries::MAX_SLOTS - cut) << cut;
+    if (cut < PriceSeries::MAX_SLOTS) {
+      EXPECT_TRUE(mask.test(cut)) << cut;
+    }
+  }
+}
+
+// Test Suite: AllowedSlots
+
+TEST(AllowedSlots, DefaultHours_NormalDay) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.10f);
+  AllowedSlots allowed;
+  allowed.build(prices, 7 * 60, 23 * 60);
+
+  SlotMask starts;
+  allowed.windowStarts(6, starts);
+
+  // 07:00 through 21:30 inclusive
+  EXPECT_EQ(countBits(starts, prices.count), 87 - 28);
+  EXPECT_TRUE(starts.test(indexAt(prices, 7, 0)));
+  EXPECT_TRUE(starts.test(indexAt(prices, 21, 30)));
+  EXPECT_FALSE(starts.test(indexAt(prices, 6, 45)));
+  EXPECT_FALSE(starts.test(indexAt(prices, 21, 45)));
+}
+
+TEST(AllowedSlots, SameMaskServesAnyWindowLength) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 192, 0.10f);
+  AllowedSlots allowed;
+  allowed.build(prices, 7 * 60, 23 * 60);
+
+  const int lengths[] = {1, 4, 6, 8, 16, 64, 65};
+  for (int slots : lengths) {
+    SlotMask starts;
+    allowed.windowStarts(slots, starts);
+    int perDay = 64 - slots + 1 > 0 ? 64 - slots + 1 : 0;  // 64 allowed slots per day
+    EXPECT_EQ(countBits(starts, prices.count), 2 * perDay) << slots << " slots";
+  }
+}
+
+TEST(AllowedSlots, WholeDay_WindowsNeverCrossMidnight) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 20, 0, 32, 0.10f);  // 20:00-03:45
+  AllowedSlots allowed;
+  allowed.build(prices, 0, 24 * 60);
+
+  SlotMask starts;
+  allowed.windowStarts(4, starts);
+
+  EXPECT_TRUE(starts.test(indexAt(prices, 23, 0)));
+  EXPECT_FALSE(starts.test(indexAt(prices, 23, 15)));  // Would run past midnight
+  EXPECT_TRUE(starts.test(indexAt(prices, 0, 0)));
+  EXPECT_EQ(countBits(starts, prices.count), 13 + 13);
+}
+
+TEST(AllowedSlots, DstLongDay_RepeatedHourBreaksWindows) {
+  // 2025-10-26: 25-hour day, 04:00 +03:00 becomes 03:00 +02:00
+  PriceSeries prices = makeDstSeries(2025, 10, 26, 100, 16, 180, 120);
+  ASSERT_EQ(prices.count, 100);
+  ASSERT_EQ(prices.minuteOfDay(15), 3 * 60 + 45);
+  ASSERT_EQ(prices.minuteOfDay(16), 3 * 60);
+
+  AllowedSlots allowed;
+  allowed.build(prices, 0, 24 * 60);
+
+  SlotMask starts;
+  allowed.windowStarts(4, starts);
+
+  EXPECT_TRUE(starts.test(12));   // 03:00-03:45 before the change
+  EXPECT_FALSE(starts.test(13));  // Would include the step back
+  EXPECT_TRUE(starts.test(16));   // 03:00-03:45 after the change
+  // Two day-runs: 16 slots before the change and 84 after it
+  EXPECT_EQ(countBits(starts, prices.count), 13 + 81);
+}
+
+TEST(AllowedSlots, DstShortDay_SkippedHourHasNoSlots) {
+  // 2025-03-30: 23-hour day, 03:00 +02:00 becomes 04:00 +03:00
+  PriceSeries prices = makeDstSeries(2025, 3, 30, 92, 12, 120, 180);
+  ASSERT_EQ(prices.count, 92);
+  ASSERT_EQ(prices.minuteOfDay(12), 4 * 60);
+
+  AllowedSlots allowed;
+  allowed.build(prices, 7 * 60, 23 * 60);
+
+  SlotMask starts;
+  allowed.windowStarts(6, starts);
+
+  EXPECT_FALSE(starts.test(indexAt(prices, 6, 45)));
+  EXPECT_TRUE(starts.test(indexAt(prices, 7, 0)));
+  EXPECT_TRUE(starts.test(indexAt(prices, 21, 30)));
+  EXPECT_EQ(countBits(starts, prices.count), 87 - 28);
+
+  // Local time jumps forward, so a window over the skipped hour is fine
+  allowed.build(prices, 0, 24 * 60);
+  allowed.windowStarts(4, starts);
+  EXPECT_TRUE(starts.test(10));  // 02:30, 02:45, 04:00, 04:15
+}
+
+TEST(AllowedSlots, HourlySlots_UseSlotLength) {
+  PriceSeries prices;
+  time_t base = (time_t)PriceTime::daysFromCivil(2025, 11, 17) * PriceTime::SECONDS_PER_DAY;
+  for (int i = 0; i < 24; i++) {
+    prices.append(PriceEntry(base + (time_t)i * 3600, 0, 0.10f));
+  }
+
+  AllowedSlots allowed;
+  allowed.build(prices, 7 * 60, 23 * 60);
+
+  SlotMask starts;
+  allowed.windowStarts(2, starts);
+
+  EXPECT_TRUE(starts.test(7));
+  EXPECT_TRUE(starts.test(21));   // 21:00-23:00
+  EXPECT_FALSE(starts.test(22));
+  EXPECT_EQ(countBits(starts, prices.count), 15);
+}
+
+TEST(AllowedSlots, ZeroLengthWindow_NoStarts) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 10, 0, 8, 0.10f);
+  AllowedSlots allowed;
+  allowed.build(prices, 7 * 60, 23 * 60);
+
+  SlotMask starts;
+  allowed.windowStarts(0, starts);
+  EXPECT_EQ(countBits(starts, PriceSeries::MAX_SLOTS), 0);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <cstring>
+
+// Use test String adapter before including production headers
+#include "../../host/HostString.h"
+#define WString_h  // Prevent Arduino WString.h inclusion
+
+#include "../../src/pricing/PriceData.h"
+#include "../../src/pricing/BodyReader.h"
+#include "../../src/pricing/SpotPriceTokenizer.cpp"
+#include "spot_hinta_payloads.h"
+
+// Stand-in for the ArduinoJson fallback: records what it was shown and
+// answers with a fixed entry
+static std::string fallbackSeen;
+static int fallbackCalls = 0;
+static bool fallbackResult = true;
+
+static void resetFallback() {
+  fallbackSeen.clear();
+  fallbackCalls = 0;
+  fallbackResult = true;
+}
+
+// Reads the element up to its closing brace (no braces inside strings here)
+static bool recordingFallback(BodyReader& element, PriceEntry& entry, bool& hasTime) {
+  fallbackCalls++;
+  int depth = 0;
+  int c;
+  while ((c = element.read()) >= 0) {
+    fallbackSeen += (char)c;
+    if (c == '{') depth++;
+    if (c == '}' && --depth <= 0) break;
+  }
+  hasTime = PriceTime::parseIso8601("2025-11-18T10:15:00+02:00", entry.epoch, entry.utcOffsetMin);
+  entry.priceWithTax = 0.5f;
+  return fallbackResult;
+}
+
+static int parse(const std::string& json, PriceSeries& out, SpotPriceTokenizer::Stats* stats = nullptr) {
+  StringBodyReader body(json.c_str(), json.size());
+  return SpotPriceTokenizer::parse(body, out, &recordingFallback, stats);
+}
+
+static time_t isoEpoch(const char* iso) {
+  time_t epoch = 0;
+  int16_t offset = 0;
+  PriceTime::parseIso8601(iso, epoch, offset);
+  return epoch;
+}
+
+// Test Suite: fast path
+
+TEST(SpotPriceTokenizer, ReadsOnlyDateTimeAndPrice) {
+  resetFallback();
+  PriceSeries out;
+  SpotPriceTokenizer::Stats stats;
+  int count = parse(R"([{"Rank":3,"DateTime":"2025-11-18T10:00:00+02:00","PriceNoTax":0.08,"PriceWithTax":0.1004},)"
+                    R"({"Rank":1,"DateTime":"2025-11-18T10:15:00+02:00","PriceNoTax":-0.001,"PriceWithTax":-0.001}])",
+                    out, &stats);
+
+  ASSERT_EQ(count, 2);
+  EXPECT_EQ(out.slotEpoch(0), isoEpoch("2025-11-18T10:00:00+02:00"));
+  EXPECT_EQ(out.offsetAt(0), 120);
+  EXPECT_FLOAT_EQ(out.prices[0], 0.1004f);
+  EXPECT_FLOAT_EQ(out.prices[1], -0.001f);
+  EXPECT_EQ(stats.elements, 2);
+  EXPECT_EQ(stats.fallbacks, 0);
+  EXPECT_EQ(fallbackCalls, 0);
+}
+
+TEST(SpotPriceTokenizer, WhitespaceAndFieldOrder) {
+  resetFallback();
+  PriceSeries out;
+  int count = parse(" [ { \"PriceWithTax\" : 1.5e-1 , \"DateTime\" : \"2025-11-18T10:00:00\" , \"Flag\" : true } ,\n"
+                    "{\"DateTime\":\"2025-11-18T10:15:00\",\"Note\":\"a \\\"quoted\\\" word\",\"PriceWithTax\":0} ] ",
+                    out);
+
+  ASSERT_EQ(count, 2);
+  EXPECT_FLOAT_EQ(out.prices[0], 0.15f);
+  EXPECT_FLOAT_EQ(out.prices[1], 0.0f);
+  EXPECT_EQ(fallbackCalls, 0);  // Escapes are fine in fields we skip
+}
+
+TEST(SpotPriceTokenizer, NullPriceIsZeroAndNullTimeIsSkipped) {
+  resetFallback();
+  PriceSeries out;
+  SpotPriceTokenizer::Stats stats;
+  int count = parse(R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":null},)"
+                    R"({"DateTime":null,"PriceWithTax":0.2},)"
+                    R"({"PriceWithTax":0.3},)"
+                    R"({"DateTime":"not a time","PriceWithTax":0.4},)"
+                    R"({"DateTime":"2025-11-18T10:15:00","PriceWithTax":0.5}])",
+                    out, &stats);
+
+  ASSERT_EQ(count, 2);
+  EXPECT_FLOAT_EQ(out.prices[0], 0.0f);
+  EXPECT_FLOAT_EQ(out.prices[1], 0.5f);
+  EXPECT_EQ(stats.elements, 5);
+  EXPECT_EQ(stats.skipped, 3);
+}
+
+TEST(SpotPriceTokenizer, EmptyArray) {
+  resetFallback();
+  PriceSeries out;
+  EXPECT_EQ(parse(" [ ] ", out), 0);
+  EXPECT_EQ(out.count, 0);
+}
+
+TEST(SpotPriceTokenizer, StopsAtGapWithoutReadingFurther) {
+  resetFallback();
+  std::string json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.1},)"
+                     R"({"DateTime":"2025-11-18T10:15:00","PriceWithTax":0.1},)"
+                     R"({"DateTime":"2025-11-18T11:00:00","PriceWithTax":0.1},)"
+                     R"({"DateTime":"2025-11-18T11:15:00","PriceWithTax":0.1}])";
+  StringBodyReader body(json.c_str(), json.size());
+  PriceSeries out;
+
+  EXPECT_EQ(SpotPriceTokenizer::parse(body, out, &recordingFallback), 2);
+
+  // The element after the gap was the last one read
+  int c = body.read();
+  EXPECT_EQ(c, ',');
+}
+
+// Test Suite: syntax errors clear the series
+
+TEST(SpotPriceTokenizer, SyntaxErrors) {
+  const char* bad[] = {
+    "",
+    "{}",
+    "[",
+    R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.1})",
+    R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.1},])",
+    R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.1} {"DateTime":"2025-11-18T10:15:00"}])",
+    R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":0.1},,{}])",
+  };
+  for (const char* json : bad) {
+    resetFallback();
+    fallbackResult = false;  // As ArduinoJson would for a broken element
+    PriceSeries out;
+    EXPECT_EQ(parse(json, out), 0) << json;
+    EXPECT_EQ(out.count, 0) << json;
+  }
+}
+
+// Test Suite: fallback
+
+TEST(SpotPriceTokenizer, UnexpectedElementsGoToFallbackFromTheirStart) {
+  const char* unusual[] = {
+    R"({"DateTime":"2025-11-18T10:15:00+02:00","PriceWithTax":"0.5"})",             // Price as string
+    R"({"Extra":{"a":1},"DateTime":"2025-11-18T10:15:00+02:00","PriceWithTax":0.5})", // Nested value
+    R"({"DateTime":"2025-11-18T10:15:00\u002B02:00","PriceWithTax":0.5})",    // Escape in a kept field
+    R"({"DateTime":"2025-11-18T10:15:00+02:00","PriceWithTax":.5})",                // Not a JSON number
+    R"({"DateTime":"x","DateTime":"2025-11-18T10:15:00+02:00","PriceWithTax":0.5})",  // Duplicate key
+  };
+  for (const char* element : unusual) {
+    resetFallback();
+    std::string json = std::string(R"([{"DateTime":"2025-11-18T10:00:00+02:00","PriceWithTax":0.1},)") +
+                       element + R"(,{"DateTime":"2025-11-18T10:30:00+02:00","PriceWithTax":0.2}])";
+    PriceSeries out;
+    SpotPriceTokenizer::Stats stats;
+
+    ASSERT_EQ(parse(json, out, &stats), 3) << element;
+    EXPECT_EQ(fallbackSeen, element);
+    EXPECT_EQ(stats.fallbacks, 1);
+    EXPECT_FLOAT_EQ(out.prices[1], 0.5f);
+    EXPECT_FLOAT_EQ(out.prices[2], 0.2f);
+  }
+}
+
+TEST(SpotPriceTokenizer, ElementTooLongToReplay) {
+  resetFallback();
+  std::string element = R"({"DateTime":"2025-11-18T10:00:00","Note":")" + std::string(300, 'x') + R"(","Extra":[1]})";
+  PriceSeries out;
+  EXPECT_EQ(parse("[" + element + "]", out), 0);
+  EXPECT_EQ(fallbackCalls, 0);
+}
+
+TEST(SpotPriceTokenizer, NoFallbackMeansUnexpectedIsAnError) {
+  std::string json = R"([{"DateTime":"2025-11-18T10:00:00","PriceWithTax":"0.1"}])";
+  StringBodyReader body(json.c_str(), json.size());
+  PriceSeries out;
+  EXPECT_EQ(SpotPriceTokenizer::parse(body, out, nullptr), 0);
+}
+
+// Test Suite: recorded payloads
+
+TEST(SpotPriceTokenizer, RecordedPayloadsNeedNoFallback) {
+  const char* payloads[] = {PAYLOAD_TWO_DAYS, PAYLOAD_DST_FALL_BACK, PAYLOAD_DST_SPRING_FORWARD, PAYLOAD_PRETTY};
+  const int expected[] = {192, 100, 92, 8};
+  for (int i = 0; i < 4; i++) {
+    resetFallback();
+    PriceSeries out;
+    SpotPriceTokenizer::Stats stats;
+    EXPECT_EQ(parse(payloads[i], out, &stats), expected[i]) << i;
+    EXPECT_EQ(stats.fallbacks, 0) << i;
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
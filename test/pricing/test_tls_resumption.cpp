@@ -0,0 +1,296 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+// Use test String adapter
+#include "../../host/HostString.h"
+#define WString_h
+#define RESUMABLE_TLS_CLIENT_H
+#define HTTP_CLIENT_H
+
+#include "../mocks/MockWiFi.h"
+
+// OpenSSL-backed client and server on the loopback interface
+#include "../../host/HostTlsClient.h"
+#include "../mocks/LocalTlsServer.h"
+#include "../mocks/FilePriceStorage.h"
+
+#include "../../src/pricing/IApiClient.h"
+#include "../../src/pricing/InflateBodyReader.cpp"
+#include "../../src/pricing/PriceApiClient.cpp"
+#include "../mocks/RecordingHandler.h"
+
+static const char* BODY = "[{\"DateTime\":\"2025-11-18T10:00:00\",\"PriceWithTax\":0.10}]";
+
+// RTC memory after power-on holds whatever the cells settled to
+static void powerOn(TlsSessionCache::Slot& slot, uint8_t fill = 0xA5) {
+  memset(&slot, fill, sizeof(slot));
+}
+
+static std::string storagePath(const char* name) {
+  std::string path = ::testing::TempDir() + name;
+  std::remove(path.c_str());
+  return path;
+}
+
+// Test Suite: PriceApiClient against a local TLS server
+
+TEST(TlsResumption, SecondFetchResumesFromTicket) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY);
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  TlsSessionCache sessions(slot);
+  PriceApiClient client(&sessions);
+
+  auto first = client.fetchJson(server.url().c_str());
+  ASSERT_TRUE(first.success);
+  EXPECT_EQ(first.payload, String(BODY));
+  EXPECT_FALSE(first.tlsResumed);
+  EXPECT_GT(first.tlsHandshakeMicros, 0u);
+
+  auto second = client.fetchJson(server.url().c_str());
+  ASSERT_TRUE(second.success);
+  EXPECT_EQ(second.payload, String(BODY));
+  EXPECT_TRUE(second.tlsResumed);
+  EXPECT_GT(second.tlsHandshakeMicros, 0u);
+
+  EXPECT_EQ(server.fullHandshakes(), 1);
+  EXPECT_EQ(server.resumedHandshakes(), 1);
+}
+
+TEST(TlsResumption, SessionIdWithoutTickets) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setTickets(false);
+  server.setBody(BODY);
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  TlsSessionCache sessions(slot);
+  PriceApiClient client(&sessions);
+
+  client.fetchJson(server.url().c_str());
+  auto second = client.fetchJson(server.url().c_str());
+
+  EXPECT_TRUE(second.tlsResumed);
+  EXPECT_EQ(server.resumedHandshakes(), 1);
+}
+
+TEST(TlsResumption, StreamedFetchResumes) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY);
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  TlsSessionCache sessions(slot);
+  PriceApiClient client(&sessions);
+
+  RecordingHandler first;
+  RecordingHandler second;
+  client.streamJson(server.url().c_str(), first);
+  auto response = client.streamJson(server.url().c_str(), second);
+
+  EXPECT_TRUE(response.tlsResumed);
+  EXPECT_EQ(second.received, BODY);
+}
+
+TEST(TlsResumption, RtcSlotSurvivesSleep) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY);
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  {
+    TlsSessionCache sessions(slot);
+    PriceApiClient client(&sessions);
+    ASSERT_TRUE(client.fetchJson(server.url().c_str()).success);
+  }
+
+  // Wake-up: objects are rebuilt, the RTC slot is as it was left
+  TlsSessionCache sessions(slot);
+  PriceApiClient client(&sessions);
+  auto response = client.fetchJson(server.url().c_str());
+
+  EXPECT_TRUE(response.tlsResumed);
+}
+
+TEST(TlsResumption, StorageCoversPowerLoss) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY);
+  FilePriceStorage storage(storagePath("tls_power_loss.bin"));
+  {
+    TlsSessionCache::Slot slot;
+    powerOn(slot);
+    TlsSessionCache sessions(slot, &storage);
+    PriceApiClient client(&sessions);
+    ASSERT_TRUE(client.fetchJson(server.url().c_str()).success);
+  }
+
+  TlsSessionCache::Slot slot;
+  powerOn(slot, 0x00);
+  TlsSessionCache sessions(slot, &storage);
+  PriceApiClient client(&sessions);
+  auto response = client.fetchJson(server.url().c_str());
+
+  EXPECT_TRUE(response.tlsResumed);
+  storage.remove();
+}
+
+TEST(TlsResumption, ForgottenSessionFallsBackToFullHandshake) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY);
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  TlsSessionCache sessions(slot);
+  PriceApiClient client(&sessions);
+
+  client.fetchJson(server.url().c_str());
+  server.forgetSessions();  // Restarted, or the ticket expired
+
+  auto refused = client.fetchJson(server.url().c_str());
+  ASSERT_TRUE(refused.success);
+  EXPECT_FALSE(refused.tlsResumed);
+  EXPECT_EQ(refused.payload, String(BODY));
+
+  auto again = client.fetchJson(server.url().c_str());
+  EXPECT_TRUE(again.tlsResumed);
+  EXPECT_EQ(server.fullHandshakes(), 2);
+  EXPECT_EQ(server.resumedHandshakes(), 1);
+}
+
+TEST(TlsResumption, FailedConnectionForgetsOfferedSession) {
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  TlsSessionCache sessions(slot);
+  std::string url;
+  {
+    LocalTlsServer server;
+    ASSERT_TRUE(server.listening());
+    server.setBody(BODY);
+    url = server.url();
+    PriceApiClient client(&sessions);
+    ASSERT_TRUE(client.fetchJson(url.c_str()).success);
+  }
+  String host = urlAuthority(url.c_str());
+  size_t length = 0;
+  ASSERT_NE(sessions.find(host.c_str(), length), nullptr);
+
+  PriceApiClient client(&sessions);
+  auto response = client.fetchJson(url.c_str());  // Nothing listens there now
+
+  EXPECT_FALSE(response.success);
+  EXPECT_EQ(response.tlsHandshakeMicros, 0u);
+  EXPECT_EQ(sessions.find(host.c_str(), length), nullptr);
+}
+
+TEST(TlsResumption, ResumedHandshakeIsShorter) {
+  LocalTlsServer server;
+  ASSERT_TRUE(server.listening());
+  server.setBody(BODY);
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  TlsSessionCache sessions(slot);
+  PriceApiClient resuming(&sessions);
+  PriceApiClient plain;
+
+  unsigned long fullBest = ~0ul;
+  unsigned long resumedBest = ~0ul;
+  resuming.fetchJson(server.url().c_str());
+  for (int i = 0; i < 5; i++) {
+    auto full = plain.fetchJson(server.url().c_str());
+    auto resumed = resuming.fetchJson(server.url().c_str());
+    ASSERT_FALSE(full.tlsResumed);
+    ASSERT_TRUE(resumed.tlsResumed);
+    fullBest = std::min(fullBest, full.tlsHandshakeMicros);
+    resumedBest = std::min(resumedBest, resumed.tlsHandshakeMicros);
+  }
+
+  // No certificate or key exchange: the public-key work is skipped
+  EXPECT_LT(resumedBest, fullBest);
+  printf("Best TLS handshake on loopback: full %lu us, resumed %lu us\n", fullBest, resumedBest);
+}
+
+// Test Suite: TlsSessionCache
+
+TEST(TlsSessionCache, GarbageSlotHasNoSession) {
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  TlsSessionCache sessions(slot);
+  size_t length = 0;
+
+  EXPECT_EQ(sessions.find("api.spot-hinta.fi", length), nullptr);
+}
+
+TEST(TlsSessionCache, SessionBelongsToItsHost) {
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  TlsSessionCache sessions(slot);
+  const uint8_t session[] = {1, 2, 3};
+  size_t length = 0;
+
+  sessions.store("api.spot-hinta.fi", session, sizeof(session));
+
+  const uint8_t* found = sessions.find("api.spot-hinta.fi", length);
+  ASSERT_NE(found, nullptr);
+  EXPECT_EQ(length, sizeof(session));
+  EXPECT_EQ(memcmp(found, session, length), 0);
+  EXPECT_EQ(sessions.find("192.168.1.20:8080", length), nullptr);
+}
+
+TEST(TlsSessionCache, UnchangedSessionIsNotWrittenAgain) {
+  FilePriceStorage storage(storagePath("tls_unchanged.bin"));
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  TlsSessionCache sessions(slot, &storage);
+  const uint8_t session[] = {1, 2, 3};
+  const uint8_t renewed[] = {1, 2, 4};
+
+  sessions.store("api.spot-hinta.fi", session, sizeof(session));
+  sessions.store("api.spot-hinta.fi", session, sizeof(session));
+  EXPECT_EQ(storage.saves, 1);
+
+  sessions.store("api.spot-hinta.fi", renewed, sizeof(renewed));
+  EXPECT_EQ(storage.saves, 2);
+  storage.remove();
+}
+
+TEST(TlsSessionCache, OversizedSessionIsNotKept) {
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  TlsSessionCache sessions(slot);
+  std::string huge(TlsSessionCache::MAX_SESSION_BYTES + 1, 'x');
+  size_t length = 0;
+
+  sessions.store("api.spot-hinta.fi", (const uint8_t*)huge.data(), huge.size());
+
+  EXPECT_EQ(sessions.find("api.spot-hinta.fi", length), nullptr);
+}
+
+TEST(TlsSessionCache, ForgetReachesStorage) {
+  FilePriceStorage storage(storagePath("tls_forget.bin"));
+  const uint8_t session[] = {1, 2, 3};
+  size_t length = 0;
+  {
+    TlsSessionCache::Slot slot;
+    powerOn(slot);
+    TlsSessionCache sessions(slot, &storage);
+    sessions.store("api.spot-hinta.fi", session, sizeof(session));
+    sessions.forget();
+    EXPECT_EQ(sessions.find("api.spot-hinta.fi", length), nullptr);
+  }
+
+  TlsSessionCache::Slot slot;
+  powerOn(slot);
+  TlsSessionCache sessions(slot, &storage);
+  EXPECT_EQ(sessions.find("api.spot-hinta.fi", length), nullptr);
+  storage.remove();
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
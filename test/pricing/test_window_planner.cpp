@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cstdio>
+
+// Use test String adapter before including production headers
+#include "../../host/HostString.h"
+#define WString_h  // Prevent Arduino WString.h inclusion
+
+// Now include production headers and implementation
+#include "../../src/pricing/PriceData.h"
+#include "../../src/pricing/PriceAnalyzer.cpp"
+#include "../../src/pricing/WindowPlanner.cpp"
+#include "../test_data_helpers.h"
+
+using TestHelpers::makeFlatSeries;
+using TestHelpers::setPrices;
+using TestHelpers::indexAt;
+
+// Test Suite: PricePrefixSums
+
+TEST(PricePrefixSums, WindowSumMatchesDirectSum) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.0f);
+  for (int i = 0; i < prices.count; i++) {
+    prices.prices[i] = 0.05f + 0.01f * ((i * 37) % 11);
+  }
+
+  PricePrefixSums sums;
+  sums.build(prices);
+
+  ASSERT_EQ(sums.count, prices.count);
+  for (int start = 0; start + 8 <= prices.count; start += 5) {
+    int64_t direct = 0;
+    for (int i = start; i < start + 8; i++) {
+      direct += priceToMicros(prices.prices[i]);
+    }
+    EXPECT_EQ(sums.windowSum(start, 8), direct) << "start " << start;
+  }
+}
+
+// Test Suite: WindowPlanner
+
+TEST(WindowPlanner, HouseholdAppliances_EachGetsOwnCheapestStart) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.20f);
+  setPrices(prices, indexAt(prices, 9, 0), 6, 0.05f);    // 90 min cheap at 9:00
+  setPrices(prices, indexAt(prices, 13, 0), 16, 0.08f);  // 4 h moderate from 13:00
+
+  PricePrefixSums sums;
+  sums.build(prices);
+
+  WindowRequest requests[] = {
+    WindowRequest(8),   // Dishwasher, 2 h
+    WindowRequest(6),   // Washing machine, 90 min
+    WindowRequest(12),  // Dryer, 3 h
+    WindowRequest(16)   // Water heater, 4 h
+  };
+  CheapestWindow results[4];
+
+  ASSERT_TRUE(WindowPlanner::plan(prices, sums, requests, 4, results));
+
+  // 2 h from 9:00 averages 0.0875 (six cheap slots, two at 0.20), so the 13:00 block wins
+  EXPECT_EQ(prices.minuteOfDay(results[0].startIndex), 13 * 60);
+  EXPECT_NEAR(results[0].avg, 0.08f, 0.0001f);
+  EXPECT_EQ(prices.minuteOfDay(results[1].startIndex), 9 * 60);
+  EXPECT_NEAR(results[1].avg, 0.05f, 0.0001f);
+  EXPECT_EQ(prices.minuteOfDay(results[2].startIndex), 13 * 60);
+  EXPECT_EQ(prices.minuteOfDay(results[3].startIndex), 13 * 60);
+  EXPECT_NEAR(results[3].avg, 0.08f, 0.0001f);
+}
+
+TEST(WindowPlanner, MatchesAnalyzerForDefaultHours) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 192, 0.0f);
+  for (int i = 0; i < prices.count; i++) {
+    prices.prices[i] = 0.03f + 0.01f * ((i * 7919) % 23);
+  }
+
+  PricePrefixSums sums;
+  sums.build(prices);
+
+  WindowRequest requests[] = {WindowRequest(4), WindowRequest(6), WindowRequest(8), WindowRequest(16)};
+  CheapestWindow results[4];
+  ASSERT_TRUE(WindowPlanner::plan(prices, sums, requests, 4, results));
+
+  for (int k = 0; k < 4; k++) {
+    CheapestWindow expected = PriceAnalyzer::findCheapestPeriod(prices, requests[k].slots);
+    EXPECT_EQ(results[k].startIndex, expected.startIndex) << requests[k].slots << " slots";
+    EXPECT_FLOAT_EQ(results[k].avg, expected.avg) << requests[k].slots << " slots";
+  }
+}
+
+TEST(WindowPlanner, PerRequestAllowedHours) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.20f);
+  setPrices(prices, indexAt(prices, 2, 0), 16, 0.02f);   // Cheap night 2:00-6:00
+  setPrices(prices, indexAt(prices, 12, 0), 16, 0.10f);  // Midday dip 12:00-16:00
+
+  PricePrefixSums sums;
+  sums.build(prices);
+
+  WindowRequest requests[] = {
+    WindowRequest(16, 0, 24 * 60),      // Water heater may run at night
+    WindowRequest(16),                  // Default 7:00-23:00
+    WindowRequest(4, 17 * 60, 20 * 60)  // Evening-only, 1 h
+  };
+  CheapestWindow results[3];
+  ASSERT_TRUE(WindowPlanner::plan(prices, sums, requests, 3, results));
+
+  EXPECT_EQ(prices.minuteOfDay(results[0].startIndex), 2 * 60);
+  EXPECT_EQ(prices.minuteOfDay(results[1].startIndex), 12 * 60);
+  EXPECT_EQ(prices.minuteOfDay(results[2].startIndex), 17 * 60);
+  EXPECT_NEAR(results[2].avg, 0.20f, 0.0001f);
+}
+
+TEST(WindowPlanner, WindowMustEndByLatestEnd) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 0, 0, 96, 0.20f);
+  setPrices(prices, indexAt(prices, 21, 45), 6, 0.01f);  // 21:45-23:15
+
+  PricePrefixSums sums;
+  sums.build(prices);
+
+  WindowRequest requests[] = {WindowRequest(6), WindowRequest(6, 7 * 60, 24 * 60)};
+  CheapestWindow results[2];
+  ASSERT_TRUE(WindowPlanner::plan(prices, sums, requests, 2, results));
+
+  // Ending at 23:15 breaks the default rule; the latest allowed start is 21:30
+  EXPECT_EQ(prices.minuteOfDay(results[0].startIndex), 21 * 60 + 30);
+  EXPECT_EQ(prices.minuteOfDay(results[1].startIndex), 21 * 60 + 45);
+}
+
+TEST(WindowPlanner, NoValidWindow_LeavesResultInvalid) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 10, 0, 8, 0.10f);
+
+  PricePrefixSums sums;
+  sums.build(prices);
+
+  WindowRequest requests[] = {WindowRequest(9), WindowRequest(0), WindowRequest(4, 0, 6 * 60), WindowRequest(4)};
+  CheapestWindow results[4];
+  ASSERT_TRUE(WindowPlanner::plan(prices, sums, requests, 4, results));
+
+  EXPECT_EQ(results[0].startIndex, -1);  // Longer than the series
+  EXPECT_EQ(results[1].startIndex, -1);  // Zero length
+  EXPECT_EQ(results[2].startIndex, -1);  // Allowed hours not covered
+  EXPECT_EQ(results[2].avg, -1.0f);
+  EXPECT_EQ(results[3].startIndex, 0);   // Other requests unaffected
+}
+
+TEST(WindowPlanner, StaleSums_Rejected) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 10, 0, 8, 0.10f);
+  PricePrefixSums sums;  // Never built
+
+  WindowRequest request(4);
+  CheapestWindow result;
+  EXPECT_FALSE(WindowPlanner::plan(prices, sums, &request, 1, &result));
+
+  sums.build(prices);
+  EXPECT_TRUE(WindowPlanner::plan(prices, sums, &request, 1, &result));
+}
+
+TEST(WindowPlanner, TooManyRequests_Rejected) {
+  PriceSeries prices = makeFlatSeries(2025, 11, 17, 10, 0, 8, 0.10f);
+  PricePrefixSums sums;
+  sums.build(prices);
+
+  WindowRequest requests[WindowPlanner::MAX_REQUESTS + 1];
+  CheapestWindow results[WindowPlanner::MAX_REQUESTS + 1];
+  EXPECT_FALSE(WindowPlanner::plan(prices, sums, requests, WindowPlanner::MAX_REQUESTS + 1, results));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
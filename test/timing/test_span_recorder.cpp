@@ -0,0 +1,382 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Use test String adapter
+#include "../../host/HostString.h"
+#define WString_h
+
+// 2025-11-18 12:30 UTC, within the test payload
+extern "C" time_t time(time_t* t) {
+  time_t now = 1763424000 + 12 * 3600 + 30 * 60;
+  if (t) *t = now;
+  return now;
+}
+
+bool getLocalTime(struct tm* info) {
+  time_t now = time(nullptr);
+  return gmtime_r(&now, info) != nullptr;
+}
+
+namespace {
+  struct MockSerial {
+    void printf(const char*, ...) {}
+    void println(const char*) {}
+    void println(const String&) {}
+  } Serial;
+}
+
+// Mock WiFi constants and configuration
+#define WL_CONNECTED 3
+#define WL_DISCONNECTED 6
+#define WIFI_STA 1
+#define WIFI_OFF 0
+const char* WIFI_SSID = "TestSSID";
+const char* WIFI_PASS = "TestPassword";
+const char* NTP_SERVER = "pool.ntp.org";
+const long GMT_OFFSET_SEC = 7200;
+const int DAYLIGHT_OFFSET_SEC = 3600;
+const char* API_URL = "https://api.example/prices";
+
+#include <ArduinoJson.h>
+#include "../../src/timing/SpanRecorder.h"
+#include "../mocks/ScriptedWiFiHardware.h"
+#include "../mocks/MockDisplay.h"
+#include "../../src/network/WiFiManager.cpp"
+#include "../../src/pricing/PriceAnalyzer.cpp"
+#include "../../src/pricing/WindowPlanner.cpp"
+#include "../../src/pricing/SpotPriceTokenizer.cpp"
+#include "../../src/pricing/PriceCache.cpp"
+#include "../../src/pricing/PriceMonitor.cpp"
+#include "../pricing/spot_hinta_payloads.h"
+
+// Collects a dump
+struct TextOutput {
+  std::string text;
+  void print(const char* s) { text += s; }
+};
+
+static unsigned long fakeMicros = 0;
+static unsigned long fakeClock() { return fakeMicros; }
+
+static std::vector<std::string> names(const SpanRecorder::Session& session) {
+  std::vector<std::string> result;
+  for (int i = 0; i < session.count; i++) {
+    result.push_back(std::string(session.spans[i].depth * 2, ' ') + session.spans[i].name);
+  }
+  return result;
+}
+
+// Test Suite: recording
+
+TEST(SpanRecorder, SpansNestAndStagesClose) {
+  fakeMicros = 5000000;
+  SpanRecorder spans(fakeClock);
+  spans.beginSession();
+
+  spans.stage("wifi");
+  fakeMicros += 100;
+  int scan = spans.begin("scan");
+  fakeMicros += 2000;
+  spans.begin("assoc");  // Left open: stage() closes it
+  fakeMicros += 300;
+  spans.end(scan);
+  spans.stage("dns");
+  fakeMicros += 40;
+  spans.endSession();
+
+  ASSERT_EQ(spans.sessionCount(), 1);
+  const SpanRecorder::Session& session = spans.session(0);
+  EXPECT_EQ(names(session), (std::vector<std::string>{"wifi", "  scan", "    assoc", "dns"}));
+  EXPECT_EQ(session.spans[0].durationUs, 2400u);
+  EXPECT_EQ(session.spans[1].startUs, 100u);
+  EXPECT_EQ(session.spans[1].durationUs, 2300u);
+  EXPECT_EQ(session.spans[2].durationUs, 300u);
+  EXPECT_EQ(session.spans[3].startUs, 2400u);
+  EXPECT_EQ(session.durationUs, 2440u);
+}
+
+TEST(SpanRecorder, ScopeEndsItsSpan) {
+  fakeMicros = 0;
+  SpanRecorder spans(fakeClock);
+  spans.beginSession();
+  spans.stage("body");
+  {
+    SpanRecorder::Scope parse(&spans, "parse");
+    fakeMicros += 700;
+  }
+  fakeMicros += 50;
+  {
+    SpanRecorder::Scope phase(&spans, "assoc");
+    fakeMicros += 10;
+    phase.next("dhcp");
+    fakeMicros += 20;
+  }
+  spans.endSession();
+
+  const SpanRecorder::Session& session = spans.session(0);
+  EXPECT_EQ(names(session), (std::vector<std::string>{"body", "  parse", "  assoc", "  dhcp"}));
+  EXPECT_EQ(session.spans[1].durationUs, 700u);
+  EXPECT_EQ(session.spans[2].durationUs, 10u);
+  EXPECT_EQ(session.spans[3].startUs, 760u);
+  EXPECT_EQ(session.spans[3].durationUs, 20u);
+
+  // Without a recorder or a session nothing happens
+  SpanRecorder::Scope none(nullptr, "parse");
+  EXPECT_EQ(spans.begin("late"), SpanRecorder::NO_SPAN);
+}
+
+TEST(SpanRecorder, RingKeepsTheNewestSessions) {
+  fakeMicros = 0;
+  SpanRecorder spans(fakeClock);
+  for (int i = 1; i <= SpanRecorder::MAX_SESSIONS + 3; i++) {
+    spans.beginSession();
+    spans.stage("wifi");
+    fakeMicros += 1000 * i;
+    spans.endSession();
+  }
+
+  ASSERT_EQ(spans.sessionCount(), SpanRecorder::MAX_SESSIONS);
+  EXPECT_EQ(spans.session(0).number, 4u);
+  EXPECT_EQ(spans.session(SpanRecorder::MAX_SESSIONS - 1).number, (uint32_t)SpanRecorder::MAX_SESSIONS + 3);
+  EXPECT_EQ(spans.session(0).durationUs, 4000u);
+
+  // The one being recorded is not listed, and takes the oldest slot
+  spans.beginSession();
+  EXPECT_EQ(spans.sessionCount(), SpanRecorder::MAX_SESSIONS - 1);
+  EXPECT_EQ(spans.session(0).number, 5u);
+}
+
+TEST(SpanRecorder, OverflowIsCountedNotKept) {
+  fakeMicros = 0;
+  SpanRecorder spans(fakeClock);
+  spans.beginSession();
+  for (int i = 0; i < SpanRecorder::MAX_SPANS + 5; i++) {
+    spans.stage("retry");
+  }
+  spans.stage("deep");
+  for (int i = 0; i < SpanRecorder::MAX_DEPTH + 1; i++) {
+    spans.begin("inner");
+  }
+  spans.endSession();
+
+  EXPECT_EQ(spans.session(0).count, SpanRecorder::MAX_SPANS);
+  EXPECT_EQ(spans.session(0).dropped, 5 + 1 + SpanRecorder::MAX_DEPTH + 1);
+}
+
+TEST(SpanRecorder, MicrosecondClockWraps) {
+  fakeMicros = 0xFFFFFF00UL;
+  SpanRecorder spans(fakeClock);
+  spans.beginSession();
+  spans.stage("tls");
+  fakeMicros = (fakeMicros + 0x200) & 0xFFFFFFFFUL;  // micros() on the device is 32 bits
+  spans.endSession();
+
+  EXPECT_EQ(spans.session(0).spans[0].durationUs, 0x200u);
+}
+
+// Test Suite: dumps
+
+TEST(SpanRecorderDump, TextIsOneLinePerSpan) {
+  fakeMicros = 0;
+  SpanRecorder spans(fakeClock);
+  spans.beginSession();
+  spans.stage("tls");
+  fakeMicros += 1450250;
+  spans.begin("parse");
+  fakeMicros += 3;
+  spans.endSession();
+
+  TextOutput out;
+  spans.printText(out);
+  EXPECT_EQ(out.text,
+            "fetch 1: 1450.253 ms\n"
+            "  tls                       0.000   1450.253\n"
+            "    parse                1450.250      0.003\n");
+}
+
+TEST(SpanRecorderDump, TextCanBeLimitedToTheNewest) {
+  fakeMicros = 0;
+  SpanRecorder spans(fakeClock);
+  for (int i = 0; i < 3; i++) {
+    spans.beginSession();
+    spans.endSession();
+  }
+
+  TextOutput out;
+  spans.printText(out, 1);
+  EXPECT_EQ(out.text, "fetch 3: 0.000 ms\n");
+}
+
+TEST(SpanRecorderDump, JsonIsChromeTraceEvents) {
+  fakeMicros = 0;
+  SpanRecorder spans(fakeClock);
+  spans.beginSession();
+  spans.stage("dns");
+  fakeMicros += 35;
+  spans.endSession();
+
+  TextOutput out;
+  spans.printJson(out);
+  EXPECT_EQ(out.text,
+            "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"fetch 1\"}},\n"
+            "{\"name\":\"dns\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":0,\"dur\":35}\n"
+            "]}\n");
+
+  SpanRecorder empty(fakeClock);
+  TextOutput none;
+  empty.printJson(none);
+  EXPECT_EQ(none.text, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n]}\n");
+}
+
+// Test Suite: a simulated fetch through the real WiFiManager and
+// PriceMonitor. The radio and network run on ScriptedWiFiHardware's virtual
+// clock; the parse and analysis take the host's real time on top.
+
+static ScriptedWiFiHardware* radio = nullptr;
+static std::chrono::steady_clock::time_point hostStart = std::chrono::steady_clock::now();
+
+static unsigned long simMillis() { return radio->clockMs; }
+
+static unsigned long simMicros() {
+  auto host = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostStart);
+  return radio->clockMs * 1000 + (unsigned long)host.count();
+}
+
+// A body arriving one TCP segment at a time
+class TrickleBodyReader : public BodyReader {
+public:
+  TrickleBodyReader(const char* text, unsigned long segmentMs)
+    : body(text, strlen(text)), segmentMs(segmentMs), untilNext(0) {}
+
+  int read() override {
+    arrive(1);
+    return body.read();
+  }
+
+  size_t readBytes(char* buffer, size_t length) override {
+    size_t n = 0;
+    while (n < length) {
+      arrive(1);
+      int c = body.read();
+      if (c < 0) {
+        break;
+      }
+      buffer[n++] = (char)c;
+    }
+    return n;
+  }
+
+private:
+  void arrive(size_t bytes) {
+    if (untilNext < bytes) {
+      radio->clockMs += segmentMs;
+      untilNext += 1460;
+    }
+    untilNext -= bytes;
+  }
+
+  StringBodyReader body;
+  unsigned long segmentMs;
+  size_t untilNext;
+};
+
+// Walks the budget's stages as PriceApiClient does, each taking its time
+// on the virtual clock
+class SimulatedApiClient : public IApiClient {
+public:
+  ApiResponse fetchJson(const char*) override {
+    ApiResponse response;
+    response.success = false;
+    response.httpCode = -1;
+    return response;
+  }
+
+  ApiResponse streamJson(const char*, BodyHandler& handler, FetchBudget* budget) override {
+    const FetchBudget::Stage stages[] = {FetchBudget::DNS, FetchBudget::CONNECT, FetchBudget::TLS,
+                                         FetchBudget::RESPONSE};
+    const unsigned long stageMs[] = {35, 60, 1450, 380};
+    for (int i = 0; i < 4; i++) {
+      budget->begin(stages[i]);
+      radio->clockMs += stageMs[i];
+    }
+    budget->begin(FetchBudget::BODY);
+    TrickleBodyReader body(PAYLOAD_TWO_DAYS, 20);
+    handler.handleBody(body);
+
+    ApiResponse response;
+    response.success = true;
+    response.httpCode = 200;
+    return response;
+  }
+};
+
+TEST(SpanRecorderSession, FetchTimeline) {
+  ScriptedWiFiHardware wifi;
+  radio = &wifi;
+  WiFiLinkCache::Slot linkSlot = {};
+  WiFiLinkCache links(linkSlot);
+  WiFiManager manager(&wifi, &links);
+  MockDisplay display;
+  SimulatedApiClient api;
+  PriceMonitor monitor(&display, &api);
+  SpanRecorder spans(simMicros);
+
+  // A first fetch that scans, then one that rejoins directly, as App runs them
+  for (int fetch = 0; fetch < 2; fetch++) {
+    spans.beginSession();
+    FetchBudget budget(simMillis);
+    budget.setTrace(&spans);
+    ASSERT_TRUE(manager.connect(&budget));
+    ASSERT_TRUE(monitor.fetchAndAnalyzePrices(&budget));
+    spans.stage("display");
+    display.showAnalysis(monitor.getLastAnalysis());
+    spans.stage("radio off");
+    manager.disconnect();
+    spans.endSession();
+    wifi.sleep();
+    wifi.clockMs += 15 * 60 * 1000;
+  }
+
+  ASSERT_EQ(spans.sessionCount(), 2);
+  EXPECT_EQ(names(spans.session(0)),
+            (std::vector<std::string>{"wifi", "  scan", "    assoc", "    dhcp", "dns", "connect", "tls", "response",
+                                      "body", "  parse", "analyze", "save", "display", "radio off"}));
+  EXPECT_EQ(names(spans.session(1)),
+            (std::vector<std::string>{"wifi", "  directed", "    assoc", "    address", "dns", "connect", "tls",
+                                      "response", "body", "  parse", "analyze", "save", "display", "radio off"}));
+
+  // Virtual time is exact to the millisecond; host time only adds to it
+  const SpanRecorder::Session& scanned = spans.session(0);
+  EXPECT_GE(scanned.spans[0].durationUs, 2500000u);  // Settle, association, DHCP
+  EXPECT_LT(scanned.spans[0].durationUs, 2600000u);
+  EXPECT_GE(scanned.spans[3].durationUs, 300000u);   // DHCP
+  EXPECT_GE(scanned.spans[6].durationUs, 1450000u);  // TLS
+  EXPECT_GE(spans.session(1).spans[0].durationUs, 150000u);
+  EXPECT_LT(spans.session(1).spans[0].durationUs, 250000u);
+
+  // The whole body is parsed while it streams in
+  EXPECT_GE(scanned.spans[9].durationUs, 200000u);
+  EXPECT_GE(scanned.spans[8].durationUs, scanned.spans[9].durationUs);
+
+  // FETCH_TRACE=fetch.json names a file for chrome://tracing or Perfetto
+  const char* path = getenv("FETCH_TRACE");
+  if (path) {
+    struct FileOutput {
+      FILE* file;
+      void print(const char* s) { fputs(s, file); }
+    } out = {fopen(path, "w")};
+    ASSERT_NE(out.file, nullptr);
+    spans.printJson(out);
+    fclose(out.file);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <cstring>
+
+#include "../../src/timing/TimeSyncPolicy.h"
+
+static const time_t T0 = 1763460000;  // 2025-11-18 10:00 UTC
+
+// RTC memory after power-on holds whatever the cells settled to
+static void powerOn(TimeSyncPolicy::Slot& slot) {
+  memset(&slot, 0xA5, sizeof(slot));
+}
+
+TEST(TimeSyncPolicy, PowerOnWaitsForSync) {
+  TimeSyncPolicy::Slot slot;
+  powerOn(slot);
+  TimeSyncPolicy policy(slot);
+
+  EXPECT_FALSE(policy.trusted(T0));
+  EXPECT_EQ(policy.decide(T0), TimeSyncPolicy::SYNC_AND_WAIT);
+}
+
+TEST(TimeSyncPolicy, ResetClockWaitsForSync) {
+  TimeSyncPolicy::Slot slot;
+  powerOn(slot);
+  TimeSyncPolicy policy(slot);
+  policy.synced(T0, 0);
+
+  // A reset keeps RTC memory but time() starts again from 1970
+  EXPECT_EQ(policy.decide(12), TimeSyncPolicy::SYNC_AND_WAIT);
+  EXPECT_EQ(policy.decide(T0 - 60), TimeSyncPolicy::SYNC_AND_WAIT);
+}
+
+TEST(TimeSyncPolicy, UnmeasuredDriftSyncsAboutHourly) {
+  TimeSyncPolicy::Slot slot;
+  powerOn(slot);
+  TimeSyncPolicy policy(slot);
+  policy.synced(T0, 0);
+
+  // 500 ppm assumed: 50 ms + 0.5 ms per second
+  EXPECT_EQ(policy.expectedErrorMs(T0 + 900), 500);
+  EXPECT_EQ(policy.decide(T0 + 900), TimeSyncPolicy::SKIP);
+  EXPECT_EQ(policy.decide(T0 + 2 * 3600), TimeSyncPolicy::SYNC_IN_BACKGROUND);
+  EXPECT_EQ(policy.decide(T0 + 48 * 3600), TimeSyncPolicy::SYNC_AND_WAIT);
+}
+
+TEST(TimeSyncPolicy, MeasuredDriftStretchesTheInterval) {
+  TimeSyncPolicy::Slot slot;
+  powerOn(slot);
+  TimeSyncPolicy policy(slot);
+  policy.synced(T0, 0);
+
+  // 0.36 s slow over two hours: 50 ppm
+  policy.synced(T0 + 7200, 360);
+  EXPECT_EQ(policy.driftPpm(), 50);
+  EXPECT_EQ(policy.decide(T0 + 7200 + 5 * 3600), TimeSyncPolicy::SKIP);
+  EXPECT_EQ(policy.decide(T0 + 7200 + 6 * 3600), TimeSyncPolicy::SYNC_IN_BACKGROUND);
+}
+
+TEST(TimeSyncPolicy, FastClockDriftsToo) {
+  TimeSyncPolicy::Slot slot;
+  powerOn(slot);
+  TimeSyncPolicy policy(slot);
+  policy.synced(T0, 0);
+
+  // 2 s fast over 10000 s
+  policy.synced(T0 + 10000, -2000);
+  EXPECT_NEAR(policy.driftPpm(), -200, 1);
+  EXPECT_NEAR(policy.expectedErrorMs(T0 + 10000 + 3600), 50 + 720, 4);
+}
+
+TEST(TimeSyncPolicy, EstimatesAreAveraged) {
+  TimeSyncPolicy::Slot slot;
+  powerOn(slot);
+  TimeSyncPolicy policy(slot);
+  policy.synced(T0, 0);
+  policy.synced(T0 + 10000, 1000);   // 100 ppm
+  policy.synced(T0 + 20000, 3000);   // 300 ppm
+
+  EXPECT_EQ(policy.driftPpm(), 150);
+}
+
+TEST(TimeSyncPolicy, ShortSpansAndResetsDoNotMeasure) {
+  TimeSyncPolicy::Slot slot;
+  powerOn(slot);
+  TimeSyncPolicy policy(slot);
+  policy.synced(T0, 0);
+  policy.synced(T0 + 7200, 360);
+
+  // Two minutes: the correction is SNTP jitter, not drift
+  policy.synced(T0 + 7320, 80);
+  EXPECT_EQ(policy.driftPpm(), 50);
+
+  // From 1970 after a reset: a 55-year correction is not drift either
+  policy.synced(T0 + 9000, (long)(T0 + 9000 - 20) * 1000);
+  EXPECT_EQ(policy.driftPpm(), 50);
+  EXPECT_TRUE(policy.trusted(T0 + 9000));
+}
+
+TEST(TimeSyncPolicy, CorruptSlotIsNotTrusted) {
+  TimeSyncPolicy::Slot slot;
+  powerOn(slot);
+  TimeSyncPolicy policy(slot);
+  policy.synced(T0, 0);
+
+  slot.driftPpm ^= 4;  // A flipped bit in RTC memory
+  EXPECT_EQ(policy.decide(T0 + 60), TimeSyncPolicy::SYNC_AND_WAIT);
+  EXPECT_EQ(policy.driftPpm(), TimeSyncPolicy::DEFAULT_DRIFT_PPM);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}